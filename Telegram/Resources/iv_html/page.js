@@ -114,6 +114,7 @@ var IV = {
 		const was = IV.lastScrollTop;
 		IV.lastScrollTop = IV.findPageScroll().scrollTop;
 		IV.updateJumpToTop(was < IV.lastScrollTop);
+		IV.checkPhotos();
 		IV.checkVideos();
 	},
 	updateJumpToTop: function (scrolledDown) {
@@ -266,26 +267,18 @@ var IV = {
 	},
 	initMedia: function () {
 		var scroll = IV.findPageScroll();
+		IV.photos = [];
 		const photos = scroll.getElementsByClassName('photo');
 		for (let i = 0; i < photos.length; ++i) {
 			const photo = photos[i];
-			if (photo.classList.contains('loaded')) {
+			if (photo.classList.contains('loaded')
+				|| !photo.hasAttribute('data-src')) {
 				continue;
 			}
-
-			const url = photo.style.backgroundImage;
-			if (!url || url.length < 7) {
-				continue;
-			}
-			var img = new Image();
-			img.onload = function () {
-				photo.classList.add('loaded');
-			}
-			img.src = url.substr(5, url.length - 7);
-			if (img.complete) {
-				photo.classList.add('loaded');
-				IV.stopAnimations(photo);
-			}
+			IV.photos.push({
+				element: photo,
+				src: String(photo.getAttribute('data-src')),
+			});
 		}
 		IV.videos = [];
 		const videos = scroll.getElementsByClassName('video');
@@ -302,6 +295,38 @@ var IV = {
 			});
 		}
 	},
+	checkPhotos: function () {
+		const visibleTop = IV.lastScrollTop;
+		const pageHeight = IV.findPageScroll().offsetHeight;
+		const visibleBottom = visibleTop + pageHeight;
+		const photos = IV.photos;
+		for (let i = 0; i < photos.length; ++i) {
+			const photo = photos[i];
+			if (photo.started) {
+				continue;
+			}
+			const element = photo.element;
+			const wrap = element.offsetParent; // photo-wrap
+			const top = IV.getElementTop(wrap);
+			const bottom = top + wrap.offsetHeight;
+			// Start loading one viewport ahead of the visible area.
+			if (top < visibleBottom + pageHeight
+				&& bottom > visibleTop - pageHeight) {
+				photo.started = true;
+				element.style.backgroundImage =
+					"url('" + photo.src + "')";
+				var img = new Image();
+				img.onload = function () {
+					element.classList.add('loaded');
+				}
+				img.src = photo.src;
+				if (img.complete) {
+					element.classList.add('loaded');
+					IV.stopAnimations(element);
+				}
+			}
+		}
+	},
 	checkVideos: function () {
 		const visibleTop = IV.lastScrollTop;
 		const visibleBottom = visibleTop + IV.findPageScroll().offsetHeight;
@@ -430,6 +455,13 @@ var IV = {
 					&& (fromEl.getAttribute('data-src')
 						== toEl.getAttribute('data-src'))) {
 					return false;
+				} else if (fromEl.classList.contains('photo')
+					&& toEl.classList.contains('photo')
+					&& fromEl.hasAttribute('data-src')
+					&& toEl.hasAttribute('data-src')
+					&& (fromEl.getAttribute('data-src')
+						== toEl.getAttribute('data-src'))) {
+					return false;
 				} else if (fromEl.tagName == 'SECTION'
 					&& fromEl.classList.contains('channel')
 					&& fromEl.hasAttribute('data-context')
@@ -447,6 +479,7 @@ var IV = {
 		});
 		morphdom(footer(from), footer(to));
 		IV.initMedia();
+		IV.checkPhotos();
 		eval(data.js);
 	},
 	loadPage: function (index) {
@@ -636,6 +669,7 @@ var IV = {
 		document.body.appendChild(blocker);
 	},
 
+	photos: {},
 	videos: {},
 	videosPlaying: {},
 
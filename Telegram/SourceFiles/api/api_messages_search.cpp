@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_channel.h"
 #include "data/data_histories.h"
 #include "data/data_message_reaction_id.h"
+#include "data/data_message_reactions.h"
 #include "data/data_peer.h"
 #include "data/data_session.h"
 #include "history/history.h"
@@ -61,6 +62,10 @@ constexpr auto kSearchPerPage = 50;
 	return result;
 }
 
+[[nodiscard]] QString PageToken(const QString &token, MsgId offsetId) {
+	return token + '\n' + QString::number(offsetId.bare);
+}
+
 } // namespace
 
 MessagesSearch::MessagesSearch(not_null<History*> history)
@@ -70,6 +75,8 @@ MessagesSearch::MessagesSearch(not_null<History*> history)
 MessagesSearch::~MessagesSearch() {
 	_history->owner().histories().cancelRequest(
 		base::take(_searchInHistoryRequest));
+	_history->session().api().request(
+		base::take(_prefetchRequestId)).cancel();
 }
 
 void MessagesSearch::searchMessages(Request request) {
@@ -87,42 +94,28 @@ void MessagesSearch::searchMore() {
 
 void MessagesSearch::searchRequest() {
 	const auto nextToken = RequestToToken(_request);
+	const auto pageKey = PageToken(nextToken, _offsetId);
+	const auto i = _cachedPages.find(pageKey);
+	if (i != end(_cachedPages)) {
+		_requestId = 0;
+		searchReceived(i->second, _requestId, nextToken);
+		return;
+	} else if (_prefetchRequestId && _prefetchKey == pageKey) {
+		// This page is already on its way, serve it as soon as it lands.
+		_waitingForPrefetch = true;
+		return;
+	}
+	_waitingForPrefetch = false;
 	if (!_offsetId) {
-		const auto it = _cacheOfStartByToken.find(nextToken);
-		if (it != end(_cacheOfStartByToken)) {
-			_requestId = 0;
-			searchReceived(it->second, _requestId, nextToken);
-			return;
-		}
+		serveLocalTagResults(nextToken);
 	}
 	auto callback = [=](Fn<void()> finish) {
-		using Flag = MTPmessages_Search::Flag;
-		const auto from = _request.from;
-		const auto fromPeer = _history->peer->isUser() ? nullptr : from;
-		const auto savedPeer = _history->peer->isSelf() ? from : nullptr;
-		_requestId = _history->session().api().request(MTPmessages_Search(
-			MTP_flags((fromPeer ? Flag::f_from_id : Flag())
-				| (savedPeer ? Flag::f_saved_peer_id : Flag())
-				| (_request.tags.empty() ? Flag() : Flag::f_saved_reaction)),
-			_history->peer->input,
-			MTP_string(_request.query),
-			(fromPeer ? fromPeer->input : MTP_inputPeerEmpty()),
-			(savedPeer ? savedPeer->input : MTP_inputPeerEmpty()),
-			MTP_vector_from_range(_request.tags | ranges::views::transform(
-				Data::ReactionToMTP
-			)),
-			MTPint(), // top_msg_id
-			MTP_inputMessagesFilterEmpty(),
-			MTP_int(0), // min_date
-			MTP_int(0), // max_date
-			MTP_int(_offsetId), // offset_id
-			MTP_int(0), // add_offset
-			MTP_int(kSearchPerPage),
-			MTP_int(0), // max_id
-			MTP_int(0), // min_id
-			MTP_long(0) // hash
-		)).done([=](const TLMessages &result, mtpRequestId id) {
+		const auto offset = _offsetId;
+		_requestId = _history->session().api().request(
+			prepareRequest(offset)
+		).done([=](const TLMessages &result, mtpRequestId id) {
 			_searchInHistoryRequest = 0;
+			_cachedPages.emplace(PageToken(nextToken, offset), result);
 			searchReceived(result, id, nextToken);
 			finish();
 		}).fail([=](const MTP::Error &error, mtpRequestId id) {
@@ -145,6 +138,105 @@ void MessagesSearch::searchRequest() {
 		std::move(callback));
 }
 
+void MessagesSearch::serveLocalTagResults(const QString &token) {
+	// Pure tag filters in Saved Messages can be answered from the local
+	// tag index right away. The results are fired under a distinct token,
+	// so the authoritative server page replaces them wholesale when it
+	// arrives instead of being appended after them.
+	if (_request.tags.empty()
+		|| !_request.query.isEmpty()
+		|| _request.from
+		|| !_history->peer->isSelf()) {
+		return;
+	}
+	const auto ids = _history->owner().reactions().tagged(_request.tags);
+	if (ids.empty()) {
+		return;
+	}
+	auto messages = MessageIdsList();
+	messages.reserve(ids.size());
+	const auto peerId = _history->peer->id;
+	for (const auto &id : ids) {
+		messages.push_back(FullMsgId(peerId, id));
+	}
+	_messagesFounds.fire({
+		int(messages.size()),
+		std::move(messages),
+		token + u"\nlocal"_q,
+	});
+}
+
+MTPmessages_Search MessagesSearch::prepareRequest(MsgId offsetId) const {
+	using Flag = MTPmessages_Search::Flag;
+	const auto from = _request.from;
+	const auto fromPeer = _history->peer->isUser() ? nullptr : from;
+	const auto savedPeer = _history->peer->isSelf() ? from : nullptr;
+	return MTPmessages_Search(
+		MTP_flags((fromPeer ? Flag::f_from_id : Flag())
+			| (savedPeer ? Flag::f_saved_peer_id : Flag())
+			| (_request.tags.empty() ? Flag() : Flag::f_saved_reaction)),
+		_history->peer->input,
+		MTP_string(_request.query),
+		(fromPeer ? fromPeer->input : MTP_inputPeerEmpty()),
+		(savedPeer ? savedPeer->input : MTP_inputPeerEmpty()),
+		MTP_vector_from_range(_request.tags | ranges::views::transform(
+			Data::ReactionToMTP
+		)),
+		MTPint(), // top_msg_id
+		MTP_inputMessagesFilterEmpty(),
+		MTP_int(0), // min_date
+		MTP_int(0), // max_date
+		MTP_int(offsetId), // offset_id
+		MTP_int(0), // add_offset
+		MTP_int(kSearchPerPage),
+		MTP_int(0), // max_id
+		MTP_int(0), // min_id
+		MTP_long(0)); // hash
+}
+
+void MessagesSearch::prefetchNextPage(
+		const QString &token,
+		MsgId offsetId) {
+	const auto pageKey = PageToken(token, offsetId);
+	if (_prefetchRequestId
+		|| _requestId
+		|| _searchInHistoryRequest
+		|| (RequestToToken(_request) != token)
+		|| (_cachedPages.find(pageKey) != end(_cachedPages))) {
+		return;
+	}
+	_prefetchKey = pageKey;
+	_prefetchRequestId = _history->session().api().request(
+		prepareRequest(offsetId)
+	).done([=](const TLMessages &result) {
+		_prefetchRequestId = 0;
+		const auto process = [&](const auto &data) {
+			auto &owner = _history->owner();
+			owner.processUsers(data.vusers());
+			owner.processChats(data.vchats());
+		};
+		result.match([](const MTPDmessages_messagesNotModified &) {
+		}, [&](const MTPDmessages_channelMessages &data) {
+			process(data);
+			if (const auto channel = _history->peer->asChannel()) {
+				channel->ptsReceived(data.vpts().v);
+				channel->processTopics(data.vtopics());
+			}
+		}, [&](const auto &data) {
+			process(data);
+		});
+		_cachedPages.emplace(pageKey, result);
+		if (base::take(_waitingForPrefetch)) {
+			searchRequest();
+		}
+	}).fail([=] {
+		_prefetchRequestId = 0;
+		if (base::take(_waitingForPrefetch)) {
+			searchRequest();
+		}
+	}).send();
+}
+
 void MessagesSearch::searchReceived(
 		const TLMessages &result,
 		mtpRequestId requestId,
@@ -195,14 +287,18 @@ void MessagesSearch::searchReceived(
 	}, [](const MTPDmessages_messagesNotModified &data) {
 		return FoundMessages{};
 	});
-	if (!_offsetId) {
-		_cacheOfStartByToken.emplace(nextToken, result);
-	}
 	_requestId = 0;
 	_offsetId = found.messages.empty()
 		? MsgId()
 		: found.messages.back().msg;
+	const auto prefetchOffsetId = _offsetId;
 	_messagesFounds.fire(std::move(found));
+	if (prefetchOffsetId) {
+		// Request the next page right away, so that by the time the
+		// results are rendered and the user scrolls to the end of them
+		// searchMore() is served from _cachedPages without a round trip.
+		prefetchNextPage(nextToken, prefetchOffsetId);
+	}
 }
 
 rpl::producer<FoundMessages> MessagesSearch::messagesFounds() const {
@@ -56,16 +56,24 @@ private:
 		const TLMessages &result,
 		mtpRequestId requestId,
 		const QString &nextToken);
+	[[nodiscard]] MTPmessages_Search prepareRequest(MsgId offsetId) const;
+	void prefetchNextPage(const QString &token, MsgId offsetId);
+	void serveLocalTagResults(const QString &token);
 
 	const not_null<History*> _history;
 
-	base::flat_map<QString, TLMessages> _cacheOfStartByToken;
+	// Every received page is kept by query token and offset, so paging
+	// is instant and going back to a refined query refetches nothing.
+	base::flat_map<QString, TLMessages> _cachedPages;
 
 	Request _request;
 	MsgId _offsetId;
 
 	int _searchInHistoryRequest = 0; // Not real mtpRequestId.
 	mtpRequestId _requestId = 0;
+	mtpRequestId _prefetchRequestId = 0;
+	QString _prefetchKey;
+	bool _waitingForPrefetch = false;
 
 	rpl::event_stream<FoundMessages> _messagesFounds;
 
@@ -25,6 +25,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history_item_helpers.h" // NewMessageFlags.
 #include "chat_helpers/message_field.h" // ConvertTextTagsToEntities.
 #include "chat_helpers/stickers_dice_pack.h" // DicePacks::kDiceString.
+#include "core/send_latency.h"
 #include "ui/text/text_entity.h" // TextWithEntities.
 #include "ui/item_text_options.h" // Ui::ItemTextOptions.
 #include "main/main_session.h"
@@ -219,6 +220,9 @@ void SendExistingMedia(
 		.postAuthor = NewMessagePostAuthor(action),
 		.effectId = action.options.effectId,
 	}, media, caption);
+	Core::SendLatency::Instance().mark(
+		newId,
+		Core::SendLatency::Stage::Queued);
 
 	const auto performRequest = [=](const auto &repeatRequest) -> void {
 		auto &histories = history->owner().histories();
@@ -474,6 +478,8 @@ void SendConfirmedFile(
 		it->msgId = newId;
 	}
 
+	file->sentId = newId;
+
 	const auto itemToEdit = isEditing
 		? session->data().message(newId)
 		: nullptr;
@@ -490,7 +496,9 @@ void SendConfirmedFile(
 			file->to.replyTo.topicRootId);
 	}
 
-	session->uploader().upload(newId, file);
+	if (!file->previewOnly) {
+		session->uploader().upload(newId, file);
+	}
 
 	auto action = SendAction(history, file->to.options);
 	action.clearDraft = false;
@@ -604,6 +612,10 @@ void SendConfirmedFile(
 			.groupedId = groupId,
 			.effectId = file->to.options.effectId,
 		}, caption, media);
+		Core::SendLatency::Instance().mark(
+			newId,
+			Core::SendLatency::Stage::Queued,
+			file->queuedAt);
 	}
 
 	if (isEditing) {
@@ -620,4 +632,19 @@ void SendConfirmedFile(
 	}
 }
 
+void FinishConfirmedFile(
+		not_null<Main::Session*> session,
+		const std::shared_ptr<FilePrepareResult> &file,
+		FullMsgId msgId) {
+	if (!session->data().message(msgId)) {
+		// The preview message was deleted while preparing the file.
+		return;
+	}
+	if (file->type == SendMediaType::Photo) {
+		// Replace the preview-only photo record with the full one.
+		session->data().processPhoto(file->photo);
+	}
+	session->uploader().upload(msgId, file);
+}
+
 } // namespace Api
@@ -53,4 +53,11 @@ void SendConfirmedFile(
 	not_null<Main::Session*> session,
 	const std::shared_ptr<FilePrepareResult> &file);
 
+// Finishes a file whose message was already created from the early
+// preview result: pushes the final media and starts the upload.
+void FinishConfirmedFile(
+	not_null<Main::Session*> session,
+	const std::shared_ptr<FilePrepareResult> &file,
+	FullMsgId msgId);
+
 } // namespace Api
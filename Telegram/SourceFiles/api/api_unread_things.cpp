@@ -23,6 +23,7 @@ namespace {
 constexpr auto kPreloadIfLess = 5;
 constexpr auto kFirstRequestLimit = 10;
 constexpr auto kNextRequestLimit = 100;
+constexpr auto kRetryAfterFailTimeout = 10 * crl::time(1000);
 
 } // namespace
 
@@ -88,6 +89,8 @@ void UnreadThings::cancelRequests(not_null<Data::Thread*> thread) {
 	if (const auto requestId = _reactionsRequests.take(thread)) {
 		_api->request(*requestId).cancel();
 	}
+	_mentionsRetryAt.remove(thread);
+	_reactionsRetryAt.remove(thread);
 }
 
 void UnreadThings::requestMentions(
@@ -96,6 +99,15 @@ void UnreadThings::requestMentions(
 	if (_mentionsRequests.contains(thread)) {
 		return;
 	}
+	// The preload is retried on every scroll tick, so after a failed
+	// request wait a bit instead of spamming the same slice query.
+	if (const auto i = _mentionsRetryAt.find(thread)
+		; i != end(_mentionsRetryAt)) {
+		if (crl::now() < i->second) {
+			return;
+		}
+		_mentionsRetryAt.erase(i);
+	}
 	const auto offsetId = std::max(
 		thread->unreadMentions().maxLoaded(),
 		MsgId(1));
@@ -120,6 +132,7 @@ void UnreadThings::requestMentions(
 		thread->unreadMentions().addSlice(result, loaded);
 	}).fail([=] {
 		_mentionsRequests.remove(thread);
+		_mentionsRetryAt[thread] = crl::now() + kRetryAfterFailTimeout;
 	}).send();
 	_mentionsRequests.emplace(thread, requestId);
 }
@@ -130,6 +143,13 @@ void UnreadThings::requestReactions(
 	if (_reactionsRequests.contains(thread)) {
 		return;
 	}
+	if (const auto i = _reactionsRetryAt.find(thread)
+		; i != end(_reactionsRetryAt)) {
+		if (crl::now() < i->second) {
+			return;
+		}
+		_reactionsRetryAt.erase(i);
+	}
 	const auto offsetId = loaded
 		? std::max(thread->unreadReactions().maxLoaded(), MsgId(1))
 		: MsgId(1);
@@ -154,6 +174,7 @@ void UnreadThings::requestReactions(
 		thread->unreadReactions().addSlice(result, loaded);
 	}).fail([=] {
 		_reactionsRequests.remove(thread);
+		_reactionsRetryAt[thread] = crl::now() + kRetryAfterFailTimeout;
 	}).send();
 	_reactionsRequests.emplace(thread, requestId);
 }
@@ -43,6 +43,8 @@ private:
 
 	base::flat_map<not_null<Data::Thread*>, mtpRequestId> _mentionsRequests;
 	base::flat_map<not_null<Data::Thread*>, mtpRequestId> _reactionsRequests;
+	base::flat_map<not_null<Data::Thread*>, crl::time> _mentionsRetryAt;
+	base::flat_map<not_null<Data::Thread*>, crl::time> _reactionsRetryAt;
 
 };
 
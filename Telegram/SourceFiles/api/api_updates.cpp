@@ -23,6 +23,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/mtproto_dc_options.h"
 #include "data/business/data_shortcut_messages.h"
 #include "data/components/credits.h"
+#include "data/components/recent_peers.h"
 #include "data/components/scheduled_messages.h"
 #include "data/components/top_peers.h"
 #include "data/notify/data_notify_settings.h"
@@ -78,6 +79,16 @@ constexpr auto kNoUpdatesTimeout = 60 * 1000;
 // If nothing is received in 1 min when was a sleepmode we ping.
 constexpr auto kNoUpdatesAfterSleepTimeout = 60 * crl::time(1000);
 
+// How many recently active channels get a speculative difference
+// request right after a wake from sleep.
+constexpr auto kWakeDifferencePrefetchLimit = 5;
+
+// Apply difference messages in chunks of this size at most.
+constexpr auto kDifferenceApplyChunk = 100;
+
+// Spend at most this time on difference messages per event loop cycle.
+constexpr auto kDifferenceApplyTimeBudget = crl::time(8);
+
 enum class DataIsLoadedResult {
 	NotLoaded = 0,
 	FromNotLoaded = 1,
@@ -294,6 +305,32 @@ void Updates::checkLastUpdate(bool afterSleep) {
 	if (_lastUpdateTime && now > _lastUpdateTime + skip) {
 		_lastUpdateTime = now;
 		sendPing();
+		if (afterSleep) {
+			prefetchRecentChannelsDifference();
+		}
+	}
+}
+
+// Wake fast path. The global difference is requested serially after
+// the connection gets usable, so right after a wake from sleep the
+// recently active channels are asked for their difference in parallel
+// instead of waiting for the getState -> getDifference chain.
+void Updates::prefetchRecentChannelsDifference() {
+	auto left = kWakeDifferencePrefetchLimit;
+	for (const auto &peer : _session->recentPeers().list()) {
+		const auto channel = peer->asChannel();
+		if (!channel || !channel->ptsInited() || channel->ptsRequesting()) {
+			continue;
+		}
+		MTP_LOG(0, ("getChannelDifference "
+			"{ after sleep, from recent peers }%1"
+			).arg(_session->mtp().isTestMode() ? " TESTMODE" : ""));
+		getChannelDifference(
+			channel,
+			ChannelDifferenceRequest::PtsGapOrShortPoll);
+		if (!--left) {
+			break;
+		}
 	}
 }
 
@@ -492,23 +529,35 @@ void Updates::differenceDone(const MTPupdates_Difference &result) {
 	} break;
 	case mtpc_updates_differenceSlice: {
 		auto &d = result.c_updates_differenceSlice();
-		feedDifference(d.vusers(), d.vchats(), d.vnew_messages(), d.vother_updates());
-
 		auto &s = d.vintermediate_state().c_updates_state();
-		setState(s.vpts().v, s.vdate().v, s.vqts().v, s.vseq().v);
-
-		_ptsWaiter.setRequesting(false);
-
-		MTP_LOG(0, ("getDifference "
-			"{ good - after a slice of difference was received }%1"
-			).arg(_session->mtp().isTestMode() ? " TESTMODE" : ""));
-		getDifference();
+		const auto pts = s.vpts().v;
+		const auto date = s.vdate().v;
+		const auto qts = s.vqts().v;
+		const auto seq = s.vseq().v;
+		feedDifference(
+			d.vusers(),
+			d.vchats(),
+			d.vnew_messages(),
+			d.vother_updates(),
+			[=] {
+				setState(pts, date, qts, seq);
+
+				_ptsWaiter.setRequesting(false);
+
+				MTP_LOG(0, ("getDifference "
+					"{ good - after a slice of difference was received }%1"
+					).arg(_session->mtp().isTestMode() ? " TESTMODE" : ""));
+				getDifference();
+			});
 	} break;
 	case mtpc_updates_difference: {
 		auto &d = result.c_updates_difference();
-		feedDifference(d.vusers(), d.vchats(), d.vnew_messages(), d.vother_updates());
-
-		stateDone(d.vstate());
+		feedDifference(
+			d.vusers(),
+			d.vchats(),
+			d.vnew_messages(),
+			d.vother_updates(),
+			[=, state = d.vstate()] { stateDone(state); });
 	} break;
 	case mtpc_updates_differenceTooLong: {
 		LOG(("API Error: updates.differenceTooLong is not supported by Telegram Desktop!"));
@@ -605,14 +654,71 @@ void Updates::feedDifference(
 		const MTPVector<MTPUser> &users,
 		const MTPVector<MTPChat> &chats,
 		const MTPVector<MTPMessage> &msgs,
-		const MTPVector<MTPUpdate> &other) {
+		const MTPVector<MTPUpdate> &other,
+		Fn<void()> done) {
 	Core::App().checkAutoLock();
 	session().data().processUsers(users);
 	session().data().processChats(chats);
 	applyConvertToScheduledOnSend(other);
 	feedMessageIds(other);
-	session().data().processMessages(msgs, NewMessageType::Unread);
-	feedUpdateVector(other, SkipUpdatePolicy::SkipMessageIds);
+	if (msgs.v.size() <= kDifferenceApplyChunk) {
+		session().data().processMessages(msgs, NewMessageType::Unread);
+		feedUpdateVector(other, SkipUpdatePolicy::SkipMessageIds);
+		done();
+		return;
+	}
+
+	// A long offline gap brings thousands of messages at once and
+	// applying them in one go freezes the UI for seconds. Sort them
+	// by id the way a single processMessages() call would, move the
+	// active chats to the front and drain the list in time-budgeted
+	// chunks, so the UI paints in between and the open chat fills
+	// first. Realtime updates keep being rejected by the pts waiter
+	// until the whole difference is applied.
+	auto list = msgs.v;
+	ranges::stable_sort(list, std::less<>(), [](const MTPMessage &message) {
+		return IdFromMessage(message).bare;
+	});
+	ranges::stable_partition(list, [&](const MTPMessage &message) {
+		const auto peerId = PeerFromMessage(message);
+		const auto peer = peerId
+			? session().data().peerLoaded(peerId)
+			: nullptr;
+		return peer && inActiveChats(peer);
+	});
+	_differenceMessages = std::move(list);
+	_differenceMessagesOffset = 0;
+	_differenceFinish = [=] {
+		feedUpdateVector(other, SkipUpdatePolicy::SkipMessageIds);
+		done();
+	};
+	applyDifferenceChunk();
+}
+
+void Updates::applyDifferenceChunk() {
+	const auto till = crl::now() + kDifferenceApplyTimeBudget;
+	while (_differenceMessagesOffset < _differenceMessages.size()) {
+		const auto count = std::min(
+			kDifferenceApplyChunk,
+			int(_differenceMessages.size()) - _differenceMessagesOffset);
+		session().data().processMessages(
+			_differenceMessages.mid(_differenceMessagesOffset, count),
+			NewMessageType::Unread);
+		_differenceMessagesOffset += count;
+		if (crl::now() >= till) {
+			break;
+		}
+	}
+	if (_differenceMessagesOffset < _differenceMessages.size()) {
+		session().data().sendHistoryChangeNotifications();
+		crl::on_main(&session(), [=] { applyDifferenceChunk(); });
+		return;
+	}
+	_differenceMessages = QVector<MTPMessage>();
+	_differenceMessagesOffset = 0;
+	if (const auto finish = base::take(_differenceFinish)) {
+		finish();
+	}
 }
 
 void Updates::differenceFail(const MTP::Error &error) {
@@ -1758,7 +1864,9 @@ void Updates::feedUpdate(const MTPUpdate &update) {
 				peer,
 				d.vmsg_id().v);
 			if (item) {
-				item->updateReactions(&d.vreactions());
+				session().data().reactions().queueUpdate(
+					item,
+					d.vreactions());
 			} else {
 				const auto hasUnreadReaction = Data::Reactions::HasUnread(
 					d.vreactions());
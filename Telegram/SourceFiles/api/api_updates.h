@@ -98,6 +98,7 @@ private:
 	void sendPing();
 	void getDifferenceByPts();
 	void getDifferenceAfterFail();
+	void prefetchRecentChannelsDifference();
 
 	[[nodiscard]] bool requestingDifference() const {
 		return _ptsWaiter.requesting();
@@ -111,7 +112,9 @@ private:
 		const MTPVector<MTPUser> &users,
 		const MTPVector<MTPChat> &chats,
 		const MTPVector<MTPMessage> &msgs,
-		const MTPVector<MTPUpdate> &other);
+		const MTPVector<MTPUpdate> &other,
+		Fn<void()> done);
+	void applyDifferenceChunk();
 	void stateDone(const MTPupdates_State &state);
 	void setState(int32 pts, int32 date, int32 qts, int32 seq);
 	void channelDifferenceDone(
@@ -202,6 +205,10 @@ private:
 	crl::time _lastUpdateTime = 0;
 	bool _handlingChannelDifference = false;
 
+	QVector<MTPMessage> _differenceMessages;
+	int _differenceMessagesOffset = 0;
+	Fn<void()> _differenceFinish;
+
 	base::flat_map<int, ActiveChatTracker> _activeChats;
 	base::flat_map<
 		not_null<PeerData*>,
@@ -53,6 +53,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_history_messages.h"
 #include "core/core_cloud_password.h"
 #include "core/application.h"
+#include "core/send_latency.h"
 #include "base/unixtime.h"
 #include "base/random.h"
 #include "base/call_delayed.h"
@@ -512,6 +513,9 @@ void ApiWrap::sendMessageFail(
 		not_null<PeerData*> peer,
 		uint64 randomId,
 		FullMsgId itemId) {
+	if (itemId) {
+		Core::SendLatency::Instance().discard(itemId);
+	}
 	const auto show = ShowForPeer(peer);
 	if (show && error == u"PEER_FLOOD"_q) {
 		show->showBox(
@@ -1432,6 +1436,11 @@ void ApiWrap::scheduleStickerSetRequest(uint64 setId, uint64 access) {
 }
 
 void ApiWrap::requestStickerSets() {
+	if (_stickerSetRequests.size() > 1) {
+		// The whole bunch of responses is fed as one batch, with a
+		// single disk write and panel refresh after the last one.
+		_session->data().stickers().startBatchFeed();
+	}
 	for (auto &[id, info] : _stickerSetRequests) {
 		if (info.id) {
 			continue;
@@ -1445,6 +1454,9 @@ void ApiWrap::requestStickerSets() {
 			gotStickerSet(setId, result);
 		}).fail([=, setId = id] {
 			_stickerSetRequests.remove(setId);
+			if (_stickerSetRequests.empty()) {
+				_session->data().stickers().finishBatchFeed();
+			}
 		}).afterDelay(kSmallDelayMs).send();
 	}
 }
@@ -2263,6 +2275,9 @@ void ApiWrap::gotStickerSet(
 	}, [](const MTPDmessages_stickerSetNotModified &) {
 		LOG(("API Error: Unexpected messages.stickerSetNotModified."));
 	});
+	if (_stickerSetRequests.empty()) {
+		_session->data().stickers().finishBatchFeed();
+	}
 }
 
 void ApiWrap::requestWebPageDelayed(not_null<WebPageData*> page) {
@@ -2983,16 +2998,23 @@ void ApiWrap::resolveJumpToDate(
 	if (const auto peer = chat.peer()) {
 		const auto topic = chat.topic();
 		const auto rootId = topic ? topic->rootId() : 0;
-		resolveJumpToHistoryDate(peer, rootId, date, std::move(callback));
+		_tasks.add(resolveJumpToHistoryDate(
+			peer,
+			rootId,
+			date,
+			std::move(callback)));
 	}
 }
 
-template <typename Callback>
-void ApiWrap::requestMessageAfterDate(
+MTP::Task ApiWrap::resolveJumpToHistoryDate(
 		not_null<PeerData*> peer,
 		MsgId topicRootId,
 		const QDate &date,
-		Callback &&callback) {
+		Fn<void(not_null<PeerData*>, MsgId)> callback) {
+	while (const auto channel = peer->migrateTo()) {
+		peer = channel;
+	}
+
 	// API returns a message with date <= offset_date.
 	// So we request a message with offset_date = desired_date - 1 and add_offset = -1.
 	// This should give us the first message with date >= desired_date.
@@ -3004,51 +3026,65 @@ void ApiWrap::requestMessageAfterDate(
 	const auto minId = 0;
 	const auto historyHash = uint64(0);
 
-	auto send = [&](auto &&serialized) {
-		request(std::move(serialized)).done([
-			=,
-			callback = std::forward<Callback>(callback)
-		](const MTPmessages_Messages &result) {
-			const auto handleMessages = [&](auto &messages) {
-				_session->data().processUsers(messages.vusers());
-				_session->data().processChats(messages.vchats());
-				return &messages.vmessages().v;
-			};
-			const auto list = result.match([&](
-					const MTPDmessages_messages &data) {
-				return handleMessages(data);
-			}, [&](const MTPDmessages_messagesSlice &data) {
-				return handleMessages(data);
-			}, [&](const MTPDmessages_channelMessages &data) {
-				if (const auto channel = peer->asChannel()) {
-					channel->ptsReceived(data.vpts().v);
-					channel->processTopics(data.vtopics());
-				} else {
-					LOG(("API Error: received messages.channelMessages when "
-						"no channel was passed! (ApiWrap::jumpToDate)"));
-				}
-				return handleMessages(data);
-			}, [&](const MTPDmessages_messagesNotModified &) {
-				LOG(("API Error: received messages.messagesNotModified! "
-					"(ApiWrap::jumpToDate)"));
-				return (const QVector<MTPMessage>*)nullptr;
-			});
-			if (list) {
-				_session->data().processMessages(
-					*list,
-					NewMessageType::Existing);
-				for (const auto &message : *list) {
-					if (DateFromMessage(message) >= offsetDate) {
-						callback(IdFromMessage(message));
-						return;
-					}
+	const auto messageAfterDate = [&](
+			not_null<PeerData*> in,
+			const MTPmessages_Messages &result) {
+		const auto handleMessages = [&](auto &messages) {
+			_session->data().processUsers(messages.vusers());
+			_session->data().processChats(messages.vchats());
+			return &messages.vmessages().v;
+		};
+		const auto list = result.match([&](
+				const MTPDmessages_messages &data) {
+			return handleMessages(data);
+		}, [&](const MTPDmessages_messagesSlice &data) {
+			return handleMessages(data);
+		}, [&](const MTPDmessages_channelMessages &data) {
+			if (const auto channel = in->asChannel()) {
+				channel->ptsReceived(data.vpts().v);
+				channel->processTopics(data.vtopics());
+			} else {
+				LOG(("API Error: received messages.channelMessages when "
+					"no channel was passed! (ApiWrap::jumpToDate)"));
+			}
+			return handleMessages(data);
+		}, [&](const MTPDmessages_messagesNotModified &) {
+			LOG(("API Error: received messages.messagesNotModified! "
+				"(ApiWrap::jumpToDate)"));
+			return (const QVector<MTPMessage>*)nullptr;
+		});
+		if (list) {
+			_session->data().processMessages(
+				*list,
+				NewMessageType::Existing);
+			for (const auto &message : *list) {
+				if (DateFromMessage(message) >= offsetDate) {
+					return IdFromMessage(message);
 				}
 			}
-			callback(ShowAtUnreadMsgId);
-		}).send();
+		}
+		return ShowAtUnreadMsgId;
 	};
-	if (topicRootId) {
-		send(MTPmessages_GetReplies(
+
+	if (const auto chat = topicRootId ? nullptr : peer->migrateFrom()) {
+		const auto result = co_await MTP::Send(this, MTPmessages_GetHistory(
+			chat->input,
+			MTP_int(offsetId),
+			MTP_int(offsetDate),
+			MTP_int(addOffset),
+			MTP_int(limit),
+			MTP_int(maxId),
+			MTP_int(minId),
+			MTP_long(historyHash)));
+		if (!result) {
+			co_return;
+		} else if (const auto itemId = messageAfterDate(chat, *result)) {
+			callback(chat, itemId);
+			co_return;
+		}
+	}
+	const auto result = topicRootId
+		? co_await MTP::Send(this, MTPmessages_GetReplies(
 			peer->input,
 			MTP_int(topicRootId),
 			MTP_int(offsetId),
@@ -3057,9 +3093,8 @@ void ApiWrap::requestMessageAfterDate(
 			MTP_int(limit),
 			MTP_int(maxId),
 			MTP_int(minId),
-			MTP_long(historyHash)));
-	} else {
-		send(MTPmessages_GetHistory(
+			MTP_long(historyHash)))
+		: co_await MTP::Send(this, MTPmessages_GetHistory(
 			peer->input,
 			MTP_int(offsetId),
 			MTP_int(offsetDate),
@@ -3068,36 +3103,8 @@ void ApiWrap::requestMessageAfterDate(
 			MTP_int(maxId),
 			MTP_int(minId),
 			MTP_long(historyHash)));
-	}
-}
-
-void ApiWrap::resolveJumpToHistoryDate(
-		not_null<PeerData*> peer,
-		MsgId topicRootId,
-		const QDate &date,
-		Fn<void(not_null<PeerData*>, MsgId)> callback) {
-	if (const auto channel = peer->migrateTo()) {
-		return resolveJumpToHistoryDate(
-			channel,
-			topicRootId,
-			date,
-			std::move(callback));
-	}
-	const auto jumpToDateInPeer = [=] {
-		requestMessageAfterDate(peer, topicRootId, date, [=](MsgId itemId) {
-			callback(peer, itemId);
-		});
-	};
-	if (const auto chat = topicRootId ? nullptr : peer->migrateFrom()) {
-		requestMessageAfterDate(chat, 0, date, [=](MsgId itemId) {
-			if (itemId) {
-				callback(chat, itemId);
-			} else {
-				jumpToDateInPeer();
-			}
-		});
-	} else {
-		jumpToDateInPeer();
+	if (result) {
+		callback(peer, messageAfterDate(peer, *result));
 	}
 }
 
@@ -3158,6 +3165,28 @@ void ApiWrap::requestSharedMedia(
 		return;
 	}
 
+	if (!messageId) {
+		// A zero-limit request asks only for the full count. A profile
+		// fires those for all media types at once and each would go
+		// separately through the serialized history requests queue,
+		// so gather them into a single counters request instead.
+		const auto countKey = SharedMediaCountKey(peer, topicRootId);
+		const auto i = _sharedMediaCountRequests.find(countKey);
+		if (i != end(_sharedMediaCountRequests)
+			&& i->second.contains(type)) {
+			return;
+		}
+		_sharedMediaCountsScheduled[countKey].emplace(type);
+		if (!_sharedMediaCountsFlushScheduled) {
+			_sharedMediaCountsFlushScheduled = true;
+			crl::on_main(_session, [=] {
+				_sharedMediaCountsFlushScheduled = false;
+				sendSharedMediaCountRequests();
+			});
+		}
+		return;
+	}
+
 	const auto prepared = Api::PrepareSearchRequest(
 		peer,
 		topicRootId,
@@ -3219,6 +3248,56 @@ void ApiWrap::sharedMediaDone(
 	}
 }
 
+void ApiWrap::sendSharedMediaCountRequests() {
+	for (auto &[key, types] : base::take(_sharedMediaCountsScheduled)) {
+		const auto peer = key.first;
+		const auto topicRootId = key.second;
+		auto filters = QVector<MTPMessagesFilter>();
+		filters.reserve(types.size());
+		auto &requested = _sharedMediaCountRequests[key];
+		for (const auto type : types) {
+			const auto filter = Api::PrepareSearchFilter(type);
+			if (filter.type() != mtpc_inputMessagesFilterEmpty) {
+				filters.push_back(filter);
+				requested.emplace(type);
+			}
+		}
+		if (filters.isEmpty()) {
+			_sharedMediaCountRequests.remove(key);
+			continue;
+		}
+		using Flag = MTPmessages_GetSearchCounters::Flag;
+		request(MTPmessages_GetSearchCounters(
+			MTP_flags(topicRootId ? Flag::f_top_msg_id : Flag()),
+			peer->input,
+			MTPInputPeer(), // saved_peer_id
+			MTP_int(topicRootId),
+			MTP_vector<MTPMessagesFilter>(filters)
+		)).done([=](const MTPVector<MTPmessages_SearchCounter> &result) {
+			_sharedMediaCountRequests.remove(
+				SharedMediaCountKey(peer, topicRootId));
+			for (const auto &counter : result.v) {
+				const auto &data = counter.data();
+				const auto type = Api::SharedMediaTypeFromFilter(
+					data.vfilter());
+				if (!type) {
+					continue;
+				}
+				_session->storage().add(Storage::SharedMediaAddSlice(
+					peer->id,
+					topicRootId,
+					*type,
+					{},
+					MsgRange(),
+					data.vcount().v));
+			}
+		}).fail([=] {
+			_sharedMediaCountRequests.remove(
+				SharedMediaCountKey(peer, topicRootId));
+		}).send();
+	}
+}
+
 void ApiWrap::sendAction(const SendAction &action) {
 	if (!action.options.scheduled
 		&& !action.options.shortcutId
@@ -3523,7 +3602,7 @@ void ApiWrap::sendVoiceMessage(
 		const SendAction &action) {
 	const auto caption = TextWithTags();
 	const auto to = FileLoadTaskOptions(action);
-	_fileLoader->addTask(std::make_unique<FileLoadTask>(
+	_fileLoader->addPriorityTask(std::make_unique<FileLoadTask>(
 		&session(),
 		result,
 		duration,
@@ -3834,6 +3913,9 @@ void ApiWrap::sendMessage(MessageToSend &&message) {
 			.postAuthor = NewMessagePostAuthor(action),
 			.effectId = action.options.effectId,
 		}, sending, media);
+		Core::SendLatency::Instance().mark(
+			newId,
+			Core::SendLatency::Stage::Queued);
 		const auto done = [=](
 				const MTPUpdates &result,
 				const MTP::Response &response) {
@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_common.h"
 #include "base/timer.h"
 #include "mtproto/sender.h"
+#include "mtproto/sender_coroutine.h"
 #include "data/stickers/data_stickers_set.h"
 #include "data/data_messages.h"
 
@@ -492,23 +493,18 @@ private:
 	void requestSavedGifs(TimeId now);
 	void readFeaturedSets();
 
-	void resolveJumpToHistoryDate(
+	[[nodiscard]] MTP::Task resolveJumpToHistoryDate(
 		not_null<PeerData*> peer,
 		MsgId topicRootId,
 		const QDate &date,
 		Fn<void(not_null<PeerData*>, MsgId)> callback);
-	template <typename Callback>
-	void requestMessageAfterDate(
-		not_null<PeerData*> peer,
-		MsgId topicRootId,
-		const QDate &date,
-		Callback &&callback);
 
 	void sharedMediaDone(
 		not_null<PeerData*> peer,
 		MsgId topicRootId,
 		SharedMediaType type,
 		Api::SearchResult &&parsed);
+	void sendSharedMediaCountRequests();
 
 	void sendSharedContact(
 		const QString &phone,
@@ -661,6 +657,15 @@ private:
 	};
 	base::flat_set<SharedMediaRequest> _sharedMediaRequests;
 
+	using SharedMediaCountKey = std::pair<not_null<PeerData*>, MsgId>;
+	base::flat_map<
+		SharedMediaCountKey,
+		base::flat_set<SharedMediaType>> _sharedMediaCountsScheduled;
+	base::flat_map<
+		SharedMediaCountKey,
+		base::flat_set<SharedMediaType>> _sharedMediaCountRequests;
+	bool _sharedMediaCountsFlushScheduled = false;
+
 	struct HistoryRequest {
 		not_null<PeerData*> peer;
 		MsgId aroundId = 0;
@@ -765,4 +770,6 @@ private:
 	base::flat_map<FullMsgId, QString> _unlikelyMessageLinks;
 	base::flat_map<FullStoryId, QString> _unlikelyStoryLinks;
 
+	MTP::TaskList _tasks;
+
 };
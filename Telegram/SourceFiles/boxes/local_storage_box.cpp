@@ -18,6 +18,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/text/format_values.h"
 #include "ui/emoji_config.h"
 #include "storage/storage_account.h"
+#include "storage/storage_hot_blob_cache.h"
 #include "storage/cache/storage_cache_database.h"
 #include "data/data_session.h"
 #include "lang/lang_keys.h"
@@ -350,6 +351,7 @@ auto LocalStorageBox::summary() const -> Database::TaggedSummary {
 }
 
 void LocalStorageBox::clearByTag(uint16 tag) {
+	_session->data().hotBlobCache().clear();
 	if (tag == kFakeMediaCacheTag) {
 		_dbBig->clear();
 	} else if (tag) {
@@ -595,6 +595,12 @@ void PeerListRow::preloadUserpic() {
 	}
 }
 
+void PeerListRow::cancelUserpicLoad() {
+	if (_peer) {
+		_peer->cancelUserpicLoad();
+	}
+}
+
 void PeerListRow::setCustomStatus(const QString &status, bool active) {
 	setStatusText(status);
 	_statusType = active ? StatusType::CustomActive : StatusType::Custom;
@@ -1018,7 +1024,7 @@ PeerListContent::PeerListContent(
 		invalidatePixmapsCache();
 	}, lifetime());
 
-	_repaintByStatus.setCallback([this] { update(); });
+	_repaintByStatus.setCallback([this] { repaintStatusRegions(); });
 }
 
 void PeerListContent::setMode(Mode mode) {
@@ -1119,6 +1125,7 @@ void PeerListContent::addRowEntry(not_null<PeerListRow*> row) {
 	if (!row->special()) {
 		_rowsByPeer[row->peer()].push_back(row);
 	}
+	++_rowsRevision;
 	if (addingToSearchIndex()) {
 		addToSearchIndex(row);
 	}
@@ -1136,7 +1143,20 @@ void PeerListContent::invalidatePixmapsCache() {
 
 bool PeerListContent::addingToSearchIndex() const {
 	// If we started indexing already, we continue.
-	return (_searchMode != PeerListSearchMode::Disabled) || !_searchIndex.empty();
+	return _searchIndexBuilt;
+}
+
+void PeerListContent::fillSearchIndex() {
+	// Indexing rows eagerly on append makes restoring a long list from
+	// a saved state pay for a search that may never happen, so the index
+	// is filled on the first real query and maintained incrementally.
+	if (_searchIndexBuilt) {
+		return;
+	}
+	_searchIndexBuilt = true;
+	for (const auto &row : _rows) {
+		addToSearchIndex(row.get());
+	}
 }
 
 void PeerListContent::addToSearchIndex(not_null<PeerListRow*> row) {
@@ -1285,6 +1305,7 @@ void PeerListContent::clearAllContent() {
 	_rowsByPeer.clear();
 	_filterResults.clear();
 	_searchIndex.clear();
+	_searchIndexBuilt = false;
 	_rows.clear();
 	_searchRows.clear();
 	_searchQuery
@@ -1434,11 +1455,6 @@ void PeerListContent::refreshRows() {
 
 void PeerListContent::setSearchMode(PeerListSearchMode mode) {
 	if (_searchMode != mode) {
-		if (!addingToSearchIndex()) {
-			for (const auto &row : _rows) {
-				addToSearchIndex(row.get());
-			}
-		}
 		_searchMode = mode;
 		if (_controller->hasComplexSearch()) {
 			if (_mode == Mode::Custom) {
@@ -2069,6 +2085,20 @@ void PeerListContent::loadProfilePhotos() {
 			for (auto index = from; index != to; ++index) {
 				getRow(RowIndex(index))->preloadUserpic();
 			}
+
+			// Rows that were flung past before their userpics arrived
+			// shouldn't keep their downloads in flight, a fast scroll
+			// through a large members list would pile up thousands of
+			// them. Scrolling back restarts the load from here.
+			const auto wasFrom = std::min(_userpicsPreloadFrom, rowsCount);
+			const auto wasTo = std::min(_userpicsPreloadTo, rowsCount);
+			for (auto index = wasFrom; index != wasTo; ++index) {
+				if (index < from || index >= to) {
+					getRow(RowIndex(index))->cancelUserpicLoad();
+				}
+			}
+			_userpicsPreloadFrom = from;
+			_userpicsPreloadTo = to;
 		}
 	}
 }
@@ -2082,6 +2112,24 @@ void PeerListContent::checkScrollForPreload() {
 PeerListContent::IsEmpty PeerListContent::searchQueryChanged(QString query) {
 	const auto searchWordsList = TextUtilities::PrepareSearchWords(query);
 	const auto normalizedQuery = searchWordsList.join(' ');
+
+	// Typing on only narrows the current results, so reuse them as the
+	// candidates list when no rows were added since they were filtered.
+	auto refineFrom = std::optional<std::vector<not_null<PeerListRow*>>>();
+	if (!_normalizedSearchQuery.isEmpty()
+		&& normalizedQuery.startsWith(_normalizedSearchQuery)
+		&& _hiddenRows.empty()
+		&& _rowsRevision == _filteredRowsRevision) {
+		auto candidates = std::vector<not_null<PeerListRow*>>();
+		candidates.reserve(_filterResults.size());
+		for (const auto &row : _filterResults) {
+			if (!row->isSearchResult()) {
+				candidates.push_back(row);
+			}
+		}
+		refineFrom = std::move(candidates);
+	}
+
 	if (_ignoreHiddenRowsOnSearch && !normalizedQuery.isEmpty()) {
 		_filterResults.clear();
 	}
@@ -2090,46 +2138,57 @@ PeerListContent::IsEmpty PeerListContent::searchQueryChanged(QString query) {
 		if (_controller->searchInLocal() && !searchWordsList.isEmpty()) {
 			Assert(_hiddenRows.empty() || _ignoreHiddenRowsOnSearch);
 
-			auto minimalList = (const std::vector<not_null<PeerListRow*>>*)nullptr;
-			for (const auto &searchWord : searchWordsList) {
-				auto searchWordStart = searchWord[0].toLower();
-				auto it = _searchIndex.find(searchWordStart);
-				if (it == _searchIndex.cend()) {
-					// Some word can't be found in any row.
-					minimalList = nullptr;
-					break;
-				} else if (!minimalList || minimalList->size() > it->second.size()) {
-					minimalList = &it->second;
-				}
-			}
-			if (minimalList) {
-				auto searchWordInNames = [](
-						not_null<PeerListRow*> row,
-						const QString &searchWord) {
-					for (auto &nameWord : row->generateNameWords()) {
-						if (nameWord.startsWith(searchWord)) {
-							return true;
-						}
+			fillSearchIndex();
+			auto searchWordInNames = [](
+					not_null<PeerListRow*> row,
+					const QString &searchWord) {
+				for (auto &nameWord : row->generateNameWords()) {
+					if (nameWord.startsWith(searchWord)) {
+						return true;
 					}
-					return false;
-				};
-				auto allSearchWordsInNames = [&](
-						not_null<PeerListRow*> row) {
-					for (const auto &searchWord : searchWordsList) {
-						if (!searchWordInNames(row, searchWord)) {
-							return false;
-						}
+				}
+				return false;
+			};
+			auto allSearchWordsInNames = [&](
+					not_null<PeerListRow*> row) {
+				for (const auto &searchWord : searchWordsList) {
+					if (!searchWordInNames(row, searchWord)) {
+						return false;
 					}
-					return true;
-				};
+				}
+				return true;
+			};
 
-				_filterResults.reserve(minimalList->size());
-				for (const auto &row : *minimalList) {
+			if (refineFrom) {
+				_filterResults.reserve(refineFrom->size());
+				for (const auto &row : *refineFrom) {
 					if (allSearchWordsInNames(row)) {
 						_filterResults.push_back(row);
 					}
 				}
+			} else {
+				auto minimalList = (const std::vector<not_null<PeerListRow*>>*)nullptr;
+				for (const auto &searchWord : searchWordsList) {
+					auto searchWordStart = searchWord[0].toLower();
+					auto it = _searchIndex.find(searchWordStart);
+					if (it == _searchIndex.cend()) {
+						// Some word can't be found in any row.
+						minimalList = nullptr;
+						break;
+					} else if (!minimalList || minimalList->size() > it->second.size()) {
+						minimalList = &it->second;
+					}
+				}
+				if (minimalList) {
+					_filterResults.reserve(minimalList->size());
+					for (const auto &row : *minimalList) {
+						if (allSearchWordsInNames(row)) {
+							_filterResults.push_back(row);
+						}
+					}
+				}
 			}
+			_filteredRowsRevision = _rowsRevision;
 		}
 		if (_controller->hasComplexSearch()) {
 			_controller->search(_searchQuery);
@@ -2343,6 +2402,42 @@ int PeerListContent::getRowTop(RowIndex index) const {
 	return -1;
 }
 
+void PeerListContent::repaintStatusRegions() {
+	// Only the status texts tick by this timer, so invalidate just the
+	// status line of the rows that are due for a refresh instead of the
+	// whole list - the names, userpics and ripples don't change.
+	const auto now = crl::now();
+	const auto count = shownRowsCount();
+	const auto top = rowsTop();
+	auto scheduleAfter = crl::time(-1);
+	for (auto index = 0; index != count; ++index) {
+		const auto row = getRow(RowIndex(index));
+		const auto refreshAt = row->refreshStatusTime();
+		if (refreshAt <= 0) {
+			continue;
+		} else if (refreshAt > now) {
+			// Not painted since the timer was scheduled, keep ticking.
+			const auto after = refreshAt - now;
+			if (scheduleAfter < 0 || after < scheduleAfter) {
+				scheduleAfter = after;
+			}
+			continue;
+		} else if (_mode == Mode::Custom) {
+			updateRow(RowIndex(index));
+			continue;
+		}
+		const auto &st = row->computeSt(_st.item);
+		update(
+			0,
+			top + index * _rowHeight + st.statusPosition.y(),
+			width(),
+			st::contactsStatusFont->height);
+	}
+	if (scheduleAfter > 0) {
+		_repaintByStatus.callOnce(scheduleAfter);
+	}
+}
+
 void PeerListContent::updateRow(not_null<PeerListRow*> row, RowIndex hint) {
 	updateRow(findRowIndex(row, hint));
 }
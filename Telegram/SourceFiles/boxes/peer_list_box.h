@@ -104,6 +104,7 @@ public:
 		const style::PeerListItem &st) const;
 
 	virtual void preloadUserpic();
+	virtual void cancelUserpicLoad();
 
 	void setCustomStatus(const QString &status, bool active = false);
 	void clearCustomStatus();
@@ -804,6 +805,7 @@ private:
 
 	void updateRow(not_null<PeerListRow*> row, RowIndex hint);
 	void updateRow(RowIndex row);
+	void repaintStatusRegions();
 	int getRowTop(RowIndex row) const;
 	PeerListRow *getRow(RowIndex element);
 	RowIndex findRowIndex(
@@ -824,6 +826,7 @@ private:
 	crl::time paintRow(Painter &p, crl::time now, RowIndex index);
 
 	void addRowEntry(not_null<PeerListRow*> row);
+	void fillSearchIndex();
 	void addToSearchIndex(not_null<PeerListRow*> row);
 	bool addingToSearchIndex() const;
 	void removeFromSearchIndex(not_null<PeerListRow*> row);
@@ -856,6 +859,8 @@ private:
 	int _rowHeight = 0;
 	int _visibleTop = 0;
 	int _visibleBottom = 0;
+	int _userpicsPreloadFrom = 0;
+	int _userpicsPreloadTo = 0;
 
 	Selected _selected;
 	Selected _pressed;
@@ -873,11 +878,14 @@ private:
 	std::map<PeerData*, std::vector<not_null<PeerListRow*>>> _rowsByPeer;
 
 	std::map<QChar, std::vector<not_null<PeerListRow*>>> _searchIndex;
+	bool _searchIndexBuilt = false;
 	QString _searchQuery;
 	QString _normalizedSearchQuery;
 	QString _mentionHighlight;
 	std::vector<not_null<PeerListRow*>> _filterResults;
 	base::flat_set<not_null<PeerListRow*>> _hiddenRows;
+	int _rowsRevision = 0;
+	int _filteredRowsRevision = -1;
 
 	int _aboveHeight = 0;
 	int _belowHeight = 0;
@@ -129,7 +129,7 @@ auto Colors() {
 
 class DebugInfoBox : public Ui::BoxContent {
 public:
-	DebugInfoBox(QWidget*, base::weak_ptr<Call> call);
+	DebugInfoBox(QWidget*, Fn<QString()> getText);
 
 protected:
 	void prepare() override;
@@ -137,14 +137,14 @@ protected:
 private:
 	void updateText();
 
-	base::weak_ptr<Call> _call;
+	Fn<QString()> _getText;
 	QPointer<Ui::FlatLabel> _text;
 	base::Timer _updateTextTimer;
 
 };
 
-DebugInfoBox::DebugInfoBox(QWidget*, base::weak_ptr<Call> call)
-: _call(call) {
+DebugInfoBox::DebugInfoBox(QWidget*, Fn<QString()> getText)
+: _getText(std::move(getText)) {
 }
 
 void DebugInfoBox::prepare() {
@@ -164,8 +164,8 @@ void DebugInfoBox::prepare() {
 }
 
 void DebugInfoBox::updateText() {
-	if (auto call = _call.get()) {
-		_text->setText(call->getDebugLog());
+	if (auto text = _getText(); !text.isEmpty()) {
+		_text->setText(text);
 	}
 }
 
@@ -407,17 +407,32 @@ void TopBar::initControls() {
 
 	setInfoLabels();
 	_info->setClickedCallback([=] {
+		const auto debug = Logs::DebugEnabled()
+			&& (_info->clickModifiers() & Qt::ControlModifier);
 		if (const auto call = _call.get()) {
-			if (Logs::DebugEnabled()
-				&& (_info->clickModifiers() & Qt::ControlModifier)) {
+			if (debug) {
+				const auto weak = _call;
 				_show->showBox(
-					Box<DebugInfoBox>(_call),
+					Box<DebugInfoBox>([=] {
+						const auto strong = weak.get();
+						return strong ? strong->getDebugLog() : QString();
+					}),
 					Ui::LayerOption::CloseOther);
 			} else {
 				Core::App().calls().showInfoPanel(call);
 			}
 		} else if (const auto group = _groupCall.get()) {
-			Core::App().calls().showInfoPanel(group);
+			if (debug) {
+				const auto weak = _groupCall;
+				_show->showBox(
+					Box<DebugInfoBox>([=] {
+						const auto strong = weak.get();
+						return strong ? strong->statsDump() : QString();
+					}),
+					Ui::LayerOption::CloseOther);
+			} else {
+				Core::App().calls().showInfoPanel(group);
+			}
 		}
 	});
 	_hangup->setClickedCallback([this] {
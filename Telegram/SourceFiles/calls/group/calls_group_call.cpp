@@ -45,6 +45,7 @@ namespace {
 
 constexpr auto kMaxInvitePerSlice = 10;
 constexpr auto kCheckLastSpokeInterval = crl::time(1000);
+constexpr auto kStatsUpdateInterval = crl::time(1000);
 constexpr auto kCheckJoinedTimeout = 4 * crl::time(1000);
 constexpr auto kUpdateSendActionEach = crl::time(500);
 constexpr auto kPlayConnectingEach = crl::time(1056) + 2 * crl::time(1000);
@@ -3017,6 +3018,7 @@ void GroupCall::audioLevelsUpdated(const tgcalls::GroupLevelsUpdate &data) {
 		const auto level = value.level;
 		const auto voice = value.voice;
 		const auto me = (ssrc == _joinState.ssrc);
+		updateAudioStats(ssrc, now);
 		const auto ignore = me && meMuted();
 		_levelUpdates.fire(LevelUpdate{
 			.ssrc = ssrc,
@@ -3062,6 +3064,69 @@ void GroupCall::audioLevelsUpdated(const tgcalls::GroupLevelsUpdate &data) {
 	} else if (check && !_lastSpokeCheckTimer.isActive()) {
 		_lastSpokeCheckTimer.callEach(kCheckLastSpokeInterval / 2);
 	}
+	if (now >= _statsFiredAt + kStatsUpdateInterval) {
+		_statsFiredAt = now;
+		_statsUpdates.fire(stats());
+	}
+}
+
+void GroupCall::updateAudioStats(uint32 ssrc, crl::time now) {
+	auto &stats = _audioStats[ssrc];
+	if (!stats.ssrc) {
+		stats.ssrc = ssrc;
+	} else {
+		const auto gap = now - stats.lastUpdate;
+		if (!stats.interval) {
+			stats.interval = gap;
+		} else {
+			// Smooth the cadence and its deviation the way RFC 3550
+			// estimates interarrival jitter, one sixteenth per sample.
+			stats.jitter += (std::abs(gap - stats.interval)
+				- stats.jitter) / 16;
+			stats.interval += (gap - stats.interval) / 16;
+		}
+		stats.maxGap = std::max(stats.maxGap, gap);
+	}
+	stats.lastUpdate = now;
+	++stats.updates;
+}
+
+GroupCallAudioStats GroupCall::stats() const {
+	auto result = GroupCallAudioStats();
+	result.participants.reserve(_audioStats.size());
+	for (const auto &[ssrc, stats] : _audioStats) {
+		result.participants.push_back(stats);
+	}
+	result.networkDrops = _networkDrops;
+	result.disconnectedTotal = _disconnectedTotal
+		+ (_disconnectedSince ? (crl::now() - _disconnectedSince) : 0);
+	return result;
+}
+
+QString GroupCall::statsDump() const {
+	const auto snapshot = stats();
+	const auto real = lookupReal();
+	const auto now = crl::now();
+	auto participants = QJsonArray();
+	for (const auto &stats : snapshot.participants) {
+		const auto peer = real
+			? real->participantPeerByAudioSsrc(stats.ssrc)
+			: nullptr;
+		participants.push_back(QJsonObject{
+			{ u"ssrc"_q, qint64(stats.ssrc) },
+			{ u"peer"_q, peer ? peer->name() : QString() },
+			{ u"updates"_q, stats.updates },
+			{ u"interval_ms"_q, qint64(stats.interval) },
+			{ u"jitter_ms"_q, qint64(stats.jitter) },
+			{ u"max_gap_ms"_q, qint64(stats.maxGap) },
+			{ u"last_update_ago_ms"_q, qint64(now - stats.lastUpdate) },
+		});
+	}
+	return QString::fromUtf8(QJsonDocument(QJsonObject{
+		{ u"network_drops"_q, snapshot.networkDrops },
+		{ u"disconnected_total_ms"_q, qint64(snapshot.disconnectedTotal) },
+		{ u"participants"_q, participants },
+	}).toJson(QJsonDocument::Indented));
 }
 
 void GroupCall::checkLastSpoke() {
@@ -3158,6 +3223,15 @@ void GroupCall::setInstanceConnected(
 		&& _instanceTransitioning
 		&& !inTransit
 		&& (muted() == MuteState::Muted);
+	if (connected && _disconnectedSince) {
+		_disconnectedTotal += crl::now() - _disconnectedSince;
+		_disconnectedSince = 0;
+	} else if (!connected
+		&& !_disconnectedSince
+		&& _instanceState.current() != InstanceState::Disconnected) {
+		++_networkDrops;
+		_disconnectedSince = crl::now();
+	}
 	_instanceTransitioning = inTransit;
 	_instanceState = instanceState;
 	if (state() == State::Connecting && connected) {
@@ -80,6 +80,21 @@ struct LevelUpdate {
 	bool me = false;
 };
 
+struct ParticipantAudioStats {
+	uint32 ssrc = 0;
+	int updates = 0;
+	crl::time lastUpdate = 0;
+	crl::time interval = 0; // Smoothed cadence of audio level updates.
+	crl::time jitter = 0; // Smoothed deviation from that cadence.
+	crl::time maxGap = 0; // Worst observed gap, a stall indicator.
+};
+
+struct GroupCallAudioStats {
+	std::vector<ParticipantAudioStats> participants;
+	int networkDrops = 0;
+	crl::time disconnectedTotal = 0;
+};
+
 enum class VideoEndpointType {
 	Camera,
 	Screen,
@@ -328,6 +343,11 @@ public:
 	[[nodiscard]] rpl::producer<LevelUpdate> levelUpdates() const {
 		return _levelUpdates.events();
 	}
+	[[nodiscard]] rpl::producer<GroupCallAudioStats> statsUpdates() const {
+		return _statsUpdates.events();
+	}
+	[[nodiscard]] GroupCallAudioStats stats() const;
+	[[nodiscard]] QString statsDump() const;
 	[[nodiscard]] auto videoStreamActiveUpdates() const
 	-> rpl::producer<VideoStateToggle> {
 		return _videoStreamActiveUpdates.events();
@@ -520,6 +540,7 @@ private:
 	void checkNextJoinAction();
 
 	void audioLevelsUpdated(const tgcalls::GroupLevelsUpdate &data);
+	void updateAudioStats(uint32 ssrc, crl::time now);
 	void setInstanceConnected(tgcalls::GroupNetworkState networkState);
 	void setInstanceMode(InstanceMode mode);
 	void setScreenInstanceConnected(tgcalls::GroupNetworkState networkState);
@@ -665,6 +686,12 @@ private:
 	rpl::variable<bool> _videoEndpointPinned = false;
 	crl::time _videoLargeTillTime = 0;
 	base::flat_map<uint32, Data::LastSpokeTimes> _lastSpoke;
+	base::flat_map<uint32, ParticipantAudioStats> _audioStats;
+	rpl::event_stream<GroupCallAudioStats> _statsUpdates;
+	crl::time _statsFiredAt = 0;
+	int _networkDrops = 0;
+	crl::time _disconnectedSince = 0;
+	crl::time _disconnectedTotal = 0;
 	rpl::event_stream<Group::RejoinEvent> _rejoinEvents;
 	rpl::event_stream<> _allowedToSpeakNotifications;
 	rpl::event_stream<> _titleChanged;
@@ -766,13 +766,22 @@ void Viewport::RendererGL::paintTile(
 		unscaled,
 		geometry.size(),
 		_factor);
+	const auto blurChanged = (tileData.textureBlurSize != blurSize)
+		|| (tileData.blurRotation != frameRotation)
+		|| (tileData.blurMirror != tile->mirror());
 	prepareObjects(f, tileData, blurSize);
-	f.glViewport(0, 0, blurSize.width(), blurSize.height());
 
-	bindFrame(f, data, tileData, _downscaleProgram);
-
-	drawDownscalePass(f, tileData);
-	drawFirstBlurPass(f, tileData, blurSize);
+	const auto uploaded = bindFrame(f, data, tileData, _downscaleProgram);
+	if (uploaded || blurChanged) {
+		// The blurred background is kept in per-tile textures, so the
+		// downscale and blur passes run only when the frame data or its
+		// transform changed, not on each paint of a static grid.
+		tileData.blurRotation = frameRotation;
+		tileData.blurMirror = tile->mirror();
+		f.glViewport(0, 0, blurSize.width(), blurSize.height());
+		drawDownscalePass(f, tileData);
+		drawFirstBlurPass(f, tileData, blurSize);
+	}
 
 	f.glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject);
 	setDefaultViewport(f);
@@ -955,7 +964,7 @@ float64 Viewport::RendererGL::countExpandRatio(
 		: animation.ratio;
 }
 
-void Viewport::RendererGL::bindFrame(
+bool Viewport::RendererGL::bindFrame(
 		QOpenGLFunctions &f,
 		const Webrtc::FrameWithInfo &data,
 		TileData &tileData,
@@ -1034,6 +1043,7 @@ void Viewport::RendererGL::bindFrame(
 		program.yuv420->setUniformValue("u_texture", GLint(1));
 		program.yuv420->setUniformValue("v_texture", GLint(2));
 	}
+	return upload;
 }
 
 void Viewport::RendererGL::uploadTexture(
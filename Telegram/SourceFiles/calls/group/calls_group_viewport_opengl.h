@@ -58,6 +58,8 @@ private:
 		mutable QSize textureSize;
 		mutable QSize textureChromaSize;
 		mutable QSize textureBlurSize;
+		int blurRotation = -1;
+		bool blurMirror = false;
 		bool stale = false;
 		bool pause = false;
 		bool outline = false;
@@ -83,7 +85,7 @@ private:
 		QOpenGLFunctions &f,
 		TileData &tileData,
 		QSize blurSize);
-	void bindFrame(
+	bool bindFrame(
 		QOpenGLFunctions &f,
 		const Webrtc::FrameWithInfo &data,
 		TileData &tileData,
@@ -41,7 +41,10 @@ struct LangPackEmoji {
 struct LangPackData {
 	int version = 0;
 	int maxKeyLength = 0;
-	std::map<QString, std::vector<LangPackEmoji>> emoji;
+
+	// Kept sorted in contiguous storage, so the per-keystroke prefix
+	// lookup is a binary search plus a linear cache-friendly walk.
+	base::flat_map<QString, std::vector<LangPackEmoji>> emoji;
 };
 
 [[nodiscard]] bool MustAddPostfix(const QString &text) {
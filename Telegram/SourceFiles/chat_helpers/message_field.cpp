@@ -62,6 +62,7 @@ using EditLinkSelection = Ui::InputField::EditLinkSelection;
 constexpr auto kParseLinksTimeout = crl::time(1000);
 constexpr auto kTypesDuration = 4 * crl::time(1000);
 constexpr auto kCodeLanguageLimit = 32;
+constexpr auto kUndoHistoryCharsLimit = 2 * 1024 * 1024;
 
 constexpr auto kLinkProtocols = {
     "http://",
@@ -335,6 +336,32 @@ TextWithEntities StripSupportHashtag(TextWithEntities text) {
 	return text;
 }
 
+void InitFieldUndoHistoryLimit(not_null<Ui::InputField*> field) {
+	// Qt keeps full copies of the inserted / removed text for each undo
+	// step, so repeatedly pasting a huge text into the compose field can
+	// retain hundreds of megabytes. Estimate the retained size by the
+	// text churn and drop the history when it crosses the limit.
+	struct State {
+		int lastLength = 0;
+		int64 retained = 0;
+	};
+	const auto state = field->lifetime().make_state<State>();
+	state->lastLength = field->rawTextEdit()->document()->characterCount();
+	field->changes(
+	) | rpl::start_with_next([=] {
+		const auto document = field->rawTextEdit()->document();
+		const auto length = document->characterCount();
+		state->retained += std::abs(length - state->lastLength);
+		state->lastLength = length;
+		if (!document->availableUndoSteps()) {
+			state->retained = 0;
+		} else if (state->retained > kUndoHistoryCharsLimit) {
+			document->clearUndoRedoStacks();
+			state->retained = 0;
+		}
+	}, field->lifetime());
+}
+
 } // namespace
 
 QString PrepareMentionTag(not_null<UserData*> user) {
@@ -462,6 +489,7 @@ void InitMessageFieldHandlers(MessageFieldHandlersArgs &&args) {
 		const auto colorIndex = session->user()->colorIndex();
 		return style->coloredQuoteCache(false, colorIndex).get();
 	});
+	InitFieldUndoHistoryLimit(field);
 }
 
 [[nodiscard]] bool IsGoodFactcheckUrl(QStringView url) {
@@ -29,7 +29,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace ChatHelpers {
 namespace {
 
-constexpr auto kDontCacheLottieAfterArea = 512 * 512;
+// Covers chat-size stickers up to 3x device pixel ratio (256 * 3 = 768).
+constexpr auto kDontCacheLottieAfterArea = 1024 * 1024;
 
 } // namespace
 
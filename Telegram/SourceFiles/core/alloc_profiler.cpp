@@ -0,0 +1,282 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/alloc_profiler.h"
+
+#include "logs.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+
+#ifdef TDESKTOP_ALLOCATION_TRACKING
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else // Q_OS_WIN
+#include <execinfo.h>
+#endif // Q_OS_WIN
+
+namespace Core {
+namespace {
+
+constexpr auto kMaxFrames = 16;
+constexpr auto kSkipFrames = 2;
+
+// Allocations at least this large are always tracked, smaller ones are
+// sampled one in kSampleOneIn and scaled by the sampling factor, so the
+// reported live bytes stay a fair estimate at a fraction of the cost.
+constexpr auto kAlwaysTrackFrom = std::size_t(16 * 1024);
+constexpr auto kSampleOneIn = 101;
+constexpr auto kReportSites = 64;
+
+struct Site {
+	void *frames[kMaxFrames] = { nullptr };
+	int depth = 0;
+	qint64 liveBytes = 0;
+	qint64 liveCount = 0;
+	qint64 totalBytes = 0;
+	qint64 totalCount = 0;
+};
+
+struct Allocation {
+	quint64 site = 0;
+	qint64 weightedSize = 0;
+};
+
+std::atomic<bool> Tracking/* = false*/;
+std::atomic<bool> HaveRecords/* = false*/;
+thread_local bool InsideTracker/* = false*/;
+thread_local quint32 SampleCountdown/* = 0*/;
+
+std::mutex Mutex;
+std::unordered_map<quint64, Site> Sites;
+std::unordered_map<void*, Allocation> Allocations;
+
+[[nodiscard]] int CaptureStack(void **frames) {
+#ifdef Q_OS_WIN
+	return int(CaptureStackBackTrace(
+		kSkipFrames,
+		kMaxFrames,
+		frames,
+		nullptr));
+#else // Q_OS_WIN
+	void *raw[kMaxFrames + kSkipFrames];
+	const auto count = backtrace(raw, kMaxFrames + kSkipFrames);
+	const auto take = std::max(count - kSkipFrames, 0);
+	std::memcpy(frames, raw + kSkipFrames, take * sizeof(void*));
+	return take;
+#endif // Q_OS_WIN
+}
+
+[[nodiscard]] quint64 HashStack(void **frames, int depth) {
+	auto result = quint64(0xCBF29CE484222325ULL);
+	for (auto i = 0; i != depth; ++i) {
+		result ^= quint64(quintptr(frames[i]));
+		result *= 0x100000001B3ULL;
+	}
+	return result ? result : 1;
+}
+
+void TrackAllocation(void *pointer, std::size_t size) {
+	if (!Tracking.load(std::memory_order_relaxed) || InsideTracker) {
+		return;
+	}
+	auto weighted = qint64(size);
+	if (size < kAlwaysTrackFrom) {
+		if (SampleCountdown > 0) {
+			--SampleCountdown;
+			return;
+		}
+		SampleCountdown = kSampleOneIn - 1;
+		weighted = qint64(size) * kSampleOneIn;
+	}
+	InsideTracker = true;
+	const auto guard = gsl::finally([] { InsideTracker = false; });
+
+	void *frames[kMaxFrames] = { nullptr };
+	const auto depth = CaptureStack(frames);
+	const auto hash = HashStack(frames, depth);
+
+	auto lock = std::lock_guard(Mutex);
+	auto &site = Sites[hash];
+	if (!site.depth && depth) {
+		std::memcpy(site.frames, frames, depth * sizeof(void*));
+		site.depth = depth;
+	}
+	site.liveBytes += weighted;
+	++site.liveCount;
+	site.totalBytes += weighted;
+	++site.totalCount;
+	Allocations[pointer] = { hash, weighted };
+	HaveRecords.store(true, std::memory_order_relaxed);
+}
+
+void TrackFree(void *pointer) {
+	if (!HaveRecords.load(std::memory_order_relaxed) || InsideTracker) {
+		return;
+	}
+	InsideTracker = true;
+	const auto guard = gsl::finally([] { InsideTracker = false; });
+
+	auto lock = std::lock_guard(Mutex);
+	const auto i = Allocations.find(pointer);
+	if (i == end(Allocations)) {
+		return;
+	}
+	const auto j = Sites.find(i->second.site);
+	if (j != end(Sites)) {
+		j->second.liveBytes -= i->second.weightedSize;
+		--j->second.liveCount;
+	}
+	Allocations.erase(i);
+}
+
+} // namespace
+
+bool AllocationTrackingAvailable() {
+	return true;
+}
+
+bool AllocationTrackingEnabled() {
+	return Tracking.load(std::memory_order_relaxed);
+}
+
+void StartAllocationTracking() {
+	InsideTracker = true;
+	{
+		auto lock = std::lock_guard(Mutex);
+		HaveRecords.store(false, std::memory_order_relaxed);
+		Allocations.clear();
+		Sites.clear();
+		Tracking.store(true, std::memory_order_release);
+	}
+	InsideTracker = false;
+	LOG(("Memory Report: Allocation tracking started."));
+}
+
+void StopAllocationTracking() {
+	Tracking.store(false, std::memory_order_release);
+	LOG(("Memory Report: Allocation tracking stopped."));
+}
+
+QString SaveAllocationReport() {
+	InsideTracker = true;
+	const auto guard = gsl::finally([] { InsideTracker = false; });
+
+	auto sites = std::vector<Site>();
+	{
+		auto lock = std::lock_guard(Mutex);
+		sites.reserve(Sites.size());
+		for (const auto &[hash, site] : Sites) {
+			sites.push_back(site);
+		}
+	}
+	if (sites.empty()) {
+		return QString();
+	}
+	ranges::sort(sites, ranges::greater(), &Site::liveBytes);
+	if (int(sites.size()) > kReportSites) {
+		sites.resize(kReportSites);
+	}
+
+	auto report = QString();
+	report += u"Top allocation sites by live bytes.\n"_q;
+	report += u"Sampled one in %1 below %2 bytes, sizes are estimates.\n"_q
+		.arg(kSampleOneIn)
+		.arg(kAlwaysTrackFrom);
+	for (const auto &site : sites) {
+		report += u"\n%1 live bytes in %2 blocks "_q
+			u"(%3 bytes in %4 allocations total):\n"_q
+			.arg(site.liveBytes)
+			.arg(site.liveCount)
+			.arg(site.totalBytes)
+			.arg(site.totalCount);
+#ifdef Q_OS_WIN
+		for (auto i = 0; i != site.depth; ++i) {
+			report += u"  0x%1\n"_q.arg(
+				quint64(quintptr(site.frames[i])),
+				0,
+				16);
+		}
+#else // Q_OS_WIN
+		const auto symbols = backtrace_symbols(site.frames, site.depth);
+		for (auto i = 0; i != site.depth; ++i) {
+			report += u"  %1\n"_q.arg(symbols
+				? QString::fromUtf8(symbols[i])
+				: u"0x%1"_q.arg(quint64(quintptr(site.frames[i])), 0, 16));
+		}
+		std::free(symbols);
+#endif // Q_OS_WIN
+	}
+
+	const auto path = cWorkingDir()
+		+ u"alloc_report_%1.txt"_q.arg(
+			QDateTime::currentDateTime().toString(u"yyyyMMdd_hhmmss"_q));
+	auto file = QFile(path);
+	if (!file.open(QIODevice::WriteOnly)) {
+		return QString();
+	}
+	file.write(report.toUtf8());
+	LOG(("Memory Report: Saved allocation report to %1.").arg(path));
+	return path;
+}
+
+} // namespace Core
+
+void *operator new(std::size_t size) {
+	while (true) {
+		if (const auto result = std::malloc(size ? size : 1)) {
+			Core::TrackAllocation(result, size);
+			return result;
+		}
+		const auto handler = std::get_new_handler();
+		if (!handler) {
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+void operator delete(void *pointer) noexcept {
+	if (pointer) {
+		Core::TrackFree(pointer);
+	}
+	std::free(pointer);
+}
+
+#else // TDESKTOP_ALLOCATION_TRACKING
+
+namespace Core {
+
+bool AllocationTrackingAvailable() {
+	return false;
+}
+
+bool AllocationTrackingEnabled() {
+	return false;
+}
+
+void StartAllocationTracking() {
+}
+
+void StopAllocationTracking() {
+}
+
+QString SaveAllocationReport() {
+	return QString();
+}
+
+} // namespace Core
+
+#endif // TDESKTOP_ALLOCATION_TRACKING
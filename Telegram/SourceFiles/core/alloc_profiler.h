@@ -0,0 +1,28 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Core {
+
+// Opt-in allocation tracking for diagnosing in-field memory growth
+// without external tooling. The global operator new / delete hooks are
+// compiled in only when TDESKTOP_ALLOCATION_TRACKING is defined, so
+// regular builds pay nothing. With the hooks present, tracking is
+// toggled at runtime and samples allocations with their call stacks.
+
+[[nodiscard]] bool AllocationTrackingAvailable();
+[[nodiscard]] bool AllocationTrackingEnabled();
+void StartAllocationTracking();
+void StopAllocationTracking();
+
+// Writes the top allocation sites by estimated live bytes to a report
+// file in the working directory. Returns the path of the written file
+// or an empty string when there is nothing to report.
+[[nodiscard]] QString SaveAllocationReport();
+
+} // namespace Core
@@ -130,6 +130,25 @@ base::options::toggle OptionSkipUrlSchemeRegister({
 	.description = "Don't re-register tg:// URL scheme on autoupdate.",
 });
 
+void WarmupFontFallbacks() {
+	// Measuring a sample of each script makes Qt resolve and cache the
+	// font fallback chain for it, so the first paint of a multilingual
+	// chat doesn't block on per-run fontconfig lookups.
+	const auto samples = {
+		u"Абв"_q, // Cyrillic.
+		u"你好"_q, // CJK ideographs.
+		u"あア"_q, // Hiragana and Katakana.
+		u"가나"_q, // Hangul.
+		u"ابت"_q, // Arabic.
+		u"אבג"_q, // Hebrew.
+		u"กข"_q, // Thai.
+		u"कख"_q, // Devanagari.
+	};
+	for (const auto &sample : samples) {
+		st::normalFont->width(sample);
+	}
+}
+
 } // namespace
 
 Application *Application::Instance = nullptr;
@@ -319,6 +338,9 @@ void Application::run() {
 	// Create mime database, so it won't be slow later.
 	QMimeDatabase().mimeTypeForName(u"text/plain"_q);
 
+	// Resolve font fallbacks, so they won't be slow later.
+	WarmupFontFallbacks();
+
 	// Check now to avoid re-entrance later.
 	[[maybe_unused]] const auto ivSupported = Iv::ShowButton();
 
@@ -534,8 +556,10 @@ void Application::startMediaView() {
 	const auto current = _lastActivePrimaryWindow->widget()->geometry();
 	_mediaView = std::make_unique<Media::View::OverlayWidget>();
 	_lastActivePrimaryWindow->widget()->Ui::RpWidget::setGeometry(current);
+	_mediaView->prewarmRenderer();
 #else
 	_mediaView = std::make_unique<Media::View::OverlayWidget>();
+	_mediaView->prewarmRenderer();
 #endif // Q_OS_MAC || Q_OS_WIN
 }
 
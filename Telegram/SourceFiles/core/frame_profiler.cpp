@@ -0,0 +1,92 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/frame_profiler.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
+
+namespace Core {
+
+FrameProfiler &FrameProfiler::Instance() {
+	static auto result = FrameProfiler();
+	return result;
+}
+
+void FrameProfiler::start() {
+	if (_events.empty()) {
+		_events.resize(kRingSize);
+	} else {
+		ranges::fill(_events, Event());
+	}
+	_index.store(0, std::memory_order_relaxed);
+	_enabled.store(true, std::memory_order_release);
+}
+
+void FrameProfiler::stop() {
+	_enabled.store(false, std::memory_order_release);
+}
+
+void FrameProfiler::record(
+		const char *name,
+		qint64 start,
+		qint64 duration) {
+	if (!enabled() || _events.empty()) {
+		return;
+	}
+	const auto index = _index.fetch_add(1, std::memory_order_relaxed);
+	auto &event = _events[index % kRingSize];
+	event.name = name;
+	event.start = start;
+	event.duration = duration;
+	event.thread = quint64(quintptr(QThread::currentThreadId()));
+}
+
+QString FrameProfiler::saveChromeTrace() const {
+	Expects(!enabled());
+
+	auto sorted = std::vector<const Event*>();
+	sorted.reserve(_events.size());
+	for (const auto &event : _events) {
+		if (event.name != nullptr) {
+			sorted.push_back(&event);
+		}
+	}
+	if (sorted.empty()) {
+		return QString();
+	}
+	ranges::sort(sorted, ranges::less(), &Event::start);
+
+	auto list = QJsonArray();
+	for (const auto event : sorted) {
+		list.push_back(QJsonObject{
+			{ u"name"_q, QString::fromLatin1(event->name) },
+			{ u"ph"_q, u"X"_q },
+			{ u"ts"_q, double(event->start) / 1000. },
+			{ u"dur"_q, double(event->duration) / 1000. },
+			{ u"pid"_q, 0 },
+			{ u"tid"_q, double(event->thread) },
+		});
+	}
+	const auto path = cWorkingDir()
+		+ u"frame_trace_%1.json"_q.arg(
+			QDateTime::currentDateTime().toString(u"yyyyMMdd_hhmmss"_q));
+	auto file = QFile(path);
+	if (!file.open(QIODevice::WriteOnly)) {
+		return QString();
+	}
+	file.write(QJsonDocument(
+		QJsonObject{ { u"traceEvents"_q, list } }
+	).toJson(QJsonDocument::Compact));
+	return path;
+}
+
+} // namespace Core
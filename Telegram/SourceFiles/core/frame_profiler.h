@@ -0,0 +1,83 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace Core {
+
+// Lightweight scoped markers for the paint and frame-presenting hot
+// paths. Recording is off by default, so a disabled marker costs one
+// relaxed atomic load. When recording, each marker writes one fixed
+// size event into a preallocated ring buffer, cheap enough to keep
+// the instrumentation compiled into release builds.
+class FrameProfiler final {
+public:
+	struct Event {
+		const char *name = nullptr;
+		qint64 start = 0; // Nanoseconds, steady clock.
+		qint64 duration = 0;
+		quint64 thread = 0;
+	};
+
+	[[nodiscard]] static FrameProfiler &Instance();
+
+	[[nodiscard]] bool enabled() const {
+		return _enabled.load(std::memory_order_relaxed);
+	}
+	void start();
+	void stop();
+
+	void record(const char *name, qint64 start, qint64 duration);
+
+	// Writes the recorded events in the Chrome trace events format,
+	// loadable by chrome://tracing and by Perfetto. Returns the path
+	// of the written file or an empty string on failure.
+	[[nodiscard]] QString saveChromeTrace() const;
+
+private:
+	FrameProfiler() = default;
+
+	static constexpr auto kRingSize = 64 * 1024;
+
+	std::atomic<bool> _enabled = false;
+	std::atomic<quint32> _index = 0;
+	std::vector<Event> _events;
+
+};
+
+class FrameMarker final {
+public:
+	explicit FrameMarker(const char *name)
+	: _name(name)
+	, _start(FrameProfiler::Instance().enabled() ? Now() : 0) {
+	}
+	FrameMarker(const FrameMarker &other) = delete;
+	FrameMarker &operator=(const FrameMarker &other) = delete;
+	~FrameMarker() {
+		if (_start) {
+			FrameProfiler::Instance().record(
+				_name,
+				_start,
+				Now() - _start);
+		}
+	}
+
+private:
+	[[nodiscard]] static qint64 Now() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	const char *_name = nullptr;
+	qint64 _start = 0;
+
+};
+
+} // namespace Core
@@ -0,0 +1,42 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/memory_pressure.h"
+
+namespace Core {
+namespace {
+
+// Eviction frees things that will be re-created on use, so reacting
+// to every repeated system signal would just produce thrashing.
+constexpr auto kNotifyEach = 10 * crl::time(1000);
+
+rpl::event_stream<> &Stream() {
+	static auto result = rpl::event_stream<>();
+	return result;
+}
+
+crl::time LastNotified/* = 0*/;
+
+} // namespace
+
+void NotifyMemoryPressure() {
+	crl::on_main([] {
+		const auto now = crl::now();
+		if (LastNotified && (now - LastNotified < kNotifyEach)) {
+			return;
+		}
+		LastNotified = now;
+		LOG(("Memory pressure reported, dropping lazy caches."));
+		Stream().fire({});
+	});
+}
+
+rpl::producer<> MemoryPressure() {
+	return Stream().events();
+}
+
+} // namespace Core
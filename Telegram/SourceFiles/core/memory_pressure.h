@@ -0,0 +1,21 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Core {
+
+// Called by the platform integrations (from any thread) when the
+// system reports that memory is getting tight. Notifications are
+// rate-limited and delivered on the main thread.
+void NotifyMemoryPressure();
+
+// Subscribers drop whatever they can re-create lazily: heavy view
+// parts, frame caches, decoded media.
+[[nodiscard]] rpl::producer<> MemoryPressure();
+
+} // namespace Core
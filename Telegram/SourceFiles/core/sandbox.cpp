@@ -11,6 +11,15 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "platform/platform_specific.h"
 #include "mainwidget.h"
 #include "mainwindow.h"
+#include "main/main_account.h"
+#include "main/main_domain.h"
+#include "main/main_session.h"
+#include "data/data_folder.h"
+#include "data/data_peer.h"
+#include "data/data_session.h"
+#include "dialogs/dialogs_indexed_list.h"
+#include "dialogs/dialogs_main_list.h"
+#include "history/history.h"
 #include "storage/localstorage.h"
 #include "window/notifications_manager.h"
 #include "window/window_controller.h"
@@ -29,14 +38,27 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/ui_utility.h"
 #include "ui/effects/animations.h"
 
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QLockFile>
 #include <QtGui/QSessionManager>
 #include <QtGui/QScreen>
 #include <QtGui/qpa/qplatformscreen.h>
 
+#if defined Q_OS_LINUX && QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+#include <sys/socket.h>
+#include <unistd.h>
+#endif // Q_OS_LINUX && Qt >= 6.2.0
+
 namespace Core {
 namespace {
 
+// Idle tasks wait for this much quiet time after the last widget
+// paint and get this budget of main thread time per slice.
+constexpr auto kIdleTasksDelay = crl::time(5);
+constexpr auto kIdleTasksBudget = crl::time(4);
+
 QChar _toHex(ushort v) {
 	v = v & 0x000F;
 	return QChar::fromLatin1((v >= 10) ? ('a' + (v - 10)) : ('0' + v));
@@ -75,13 +97,86 @@ QString _escapeFrom7bit(const QString &str) {
 	return result;
 }
 
+// A consistent read-only snapshot for local tooling, composed
+// synchronously on the main thread between event loop iterations.
+[[nodiscard]] QByteArray ComposeStatsSnapshot(
+		not_null<Application*> application) {
+	auto accounts = QJsonArray();
+	for (const auto &[index, account] : application->domain().accounts()) {
+		if (!account->sessionExists()) {
+			continue;
+		}
+		const auto session = &account->session();
+		auto chats = QJsonArray();
+		const auto addRow = [&](not_null<Dialogs::Row*> row) {
+			const auto history = row->history();
+			if (!history) {
+				return;
+			}
+			const auto state = history->chatListUnreadState();
+			chats.append(QJsonObject{
+				{ u"peer"_q, QString::number(history->peer->id.value) },
+				{ u"name"_q, history->peer->name() },
+				{ u"unread_messages"_q, state.messages },
+				{ u"unread_marked"_q, (state.marks > 0) },
+			});
+		};
+		const auto addList = [&](not_null<Dialogs::IndexedList*> indexed) {
+			for (const auto &row : indexed->all()) {
+				addRow(row);
+			}
+		};
+		const auto list = session->data().chatsList();
+		addList(list->indexed());
+		const auto folderId = Data::Folder::kId;
+		if (const auto folder = session->data().folderLoaded(folderId)) {
+			addList(folder->chatsList()->indexed());
+		}
+		const auto unread = list->unreadState();
+		accounts.append(QJsonObject{
+			{ u"account"_q, index },
+			{ u"unread_messages"_q, unread.messages },
+			{ u"unread_chats"_q, unread.chats },
+			{ u"chats"_q, chats },
+		});
+	}
+	return QJsonDocument(
+		QJsonObject{ { u"accounts"_q, accounts } }
+	).toJson(QJsonDocument::Compact);
+}
+
+// On Linux the single instance server is an abstract namespace socket,
+// it has no filesystem permissions and its name can be enumerated by any
+// local user, so before replying with anything sensitive make sure the
+// peer socket belongs to the same user. Elsewhere the server is a named
+// pipe / filesystem socket already restricted to the owning user.
+[[nodiscard]] bool ClientIsSameUser(not_null<QLocalSocket*> socket) {
+#if defined Q_OS_LINUX && QT_VERSION >= QT_VERSION_CHECK(6, 2, 0)
+	auto credentials = ucred();
+	auto size = socklen_t(sizeof(credentials));
+	const auto descriptor = socket->socketDescriptor();
+	if (descriptor < 0 || getsockopt(
+			int(descriptor),
+			SOL_SOCKET,
+			SO_PEERCRED,
+			&credentials,
+			&size) != 0) {
+		return false;
+	}
+	return (credentials.uid == getuid());
+#else // Q_OS_LINUX && Qt >= 6.2.0
+	return true;
+#endif // !(Q_OS_LINUX && Qt >= 6.2.0)
+}
+
 } // namespace
 
 bool Sandbox::QuitOnStartRequested = false;
 
 Sandbox::Sandbox(int &argc, char **argv)
 : QApplication(argc, argv)
-, _mainThreadId(QThread::currentThreadId()) {
+, _mainThreadId(QThread::currentThreadId())
+, _idleTasksTimer([=] { runIdleTasks(); }) {
 }
 
 int Sandbox::start() {
@@ -463,6 +558,16 @@ void Sandbox::readClients() {
 						: 0;
 					const auto response = u"RES:%1_%2;"_q.arg(processId).arg(windowId).toLatin1();
 					i->first->write(response.data(), response.size());
+				} else if (cmd.startsWith(u"STATS:"_q)) {
+					// The reply is a single compact JSON line, so the
+					// client can frame it by the trailing newline. The
+					// snapshot contains private data, so unlike the
+					// commands above it goes only to the same user.
+					const auto response = ((_application
+						&& ClientIsSameUser(i->first))
+						? ComposeStatsSnapshot(_application.get())
+						: QByteArray("{}")) + '\n';
+					i->first->write(response.data(), response.size());
 				} else {
 					LOG(("Sandbox Error: unknown command %1 passed in local socket").arg(cmd.toString()));
 				}
@@ -596,6 +701,7 @@ bool Sandbox::notify(QObject *receiver, QEvent *e) {
 
 	const auto wrap = createEventNestingLevel();
 	if (e->type() == QEvent::UpdateRequest) {
+		_lastUpdateRequestTime = crl::now();
 		const auto weak = QPointer<QObject>(receiver);
 		_widgetUpdateRequests.fire({});
 		if (!weak) {
@@ -617,6 +723,49 @@ void Sandbox::processPostponedCalls(int level) {
 	}
 }
 
+void Sandbox::addIdleTask(IdleTask task) {
+	Expects(task != nullptr);
+
+	_idleTasks.push_back(std::move(task));
+	if (!_idleTasksTimer.isActive()) {
+		_idleTasksTimer.callOnce(kIdleTasksDelay);
+	}
+}
+
+void Sandbox::runIdleTasks() {
+	const auto now = crl::now();
+	const auto sincePaint = now - _lastUpdateRequestTime;
+	if (sincePaint < kIdleTasksDelay) {
+		// A widget was painted just now, the loop isn't idle yet,
+		// wait until the update requests settle down.
+		_idleTasksTimer.callOnce(kIdleTasksDelay - sincePaint);
+		return;
+	}
+	const auto finish = now + kIdleTasksBudget;
+
+	// A task may add new tasks from inside its callback, so the list
+	// is taken out and the survivors are put back afterwards.
+	auto tasks = base::take(_idleTasks);
+	auto left = std::vector<IdleTask>();
+	left.reserve(tasks.size());
+	for (auto &task : tasks) {
+		const auto budget = finish - crl::now();
+		if (budget <= 0) {
+			left.push_back(std::move(task));
+		} else if (customEnterFromEventLoop([&] { return task(budget); })) {
+			left.push_back(std::move(task));
+		}
+	}
+	left.insert(
+		end(left),
+		std::make_move_iterator(begin(_idleTasks)),
+		std::make_move_iterator(end(_idleTasks)));
+	_idleTasks = std::move(left);
+	if (!_idleTasks.empty()) {
+		_idleTasksTimer.callOnce(kIdleTasksDelay);
+	}
+}
+
 bool Sandbox::nativeEventFilter(
 		const QByteArray &eventType,
 		void *message,
@@ -639,6 +788,9 @@ void Sandbox::closeApplication() {
 	}
 	SetLaunchState(LaunchState::QuitProcessed);
 
+	_idleTasksTimer.cancel();
+	_idleTasks.clear();
+
 	_application = nullptr;
 
 	_localServer.close();
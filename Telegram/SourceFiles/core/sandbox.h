@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "mtproto/mtproto_proxy_data.h"
+#include "base/timer.h"
 
 #include <QtWidgets/QApplication>
 #include <QtNetwork/QLocalServer>
@@ -43,6 +44,15 @@ public:
 	void postponeCall(FnMut<void()> &&callable);
 	bool notify(QObject *receiver, QEvent *e) override;
 
+	// Runs the task in small slices while the event loop is idle: not
+	// right after a widget was painted and with a time budget per
+	// slice. The task receives the budget that is left for its slice
+	// and returns true while it still has work to do. The task is kept
+	// until it returns false, so it must guard the objects it uses,
+	// for example with base::make_weak of their owner.
+	using IdleTask = Fn<bool(crl::time budget)>;
+	void addIdleTask(IdleTask task);
+
 	template <typename Callable>
 	auto customEnterFromEventLoop(Callable &&callable) {
 		registerEnterFromEventLoop();
@@ -88,6 +98,7 @@ private:
 		void *message,
 		native_event_filter_result *result) override;
 	void processPostponedCalls(int level);
+	void runIdleTasks();
 	void singleInstanceChecked();
 	void launchApplication();
 	void setupScreenScale();
@@ -131,6 +142,10 @@ private:
 
 	rpl::event_stream<> _widgetUpdateRequests;
 
+	std::vector<IdleTask> _idleTasks;
+	base::Timer _idleTasksTimer;
+	crl::time _lastUpdateRequestTime = 0;
+
 	std::unique_ptr<QThread> _deadlockDetector;
 
 };
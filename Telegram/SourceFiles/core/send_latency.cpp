@@ -0,0 +1,117 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/send_latency.h"
+
+namespace Core {
+namespace {
+
+// Sends that failed or were deleted never reach the Shown stage, so
+// the pending map is bounded by evicting the oldest unfinished trace.
+constexpr auto kPendingLimit = 1024;
+
+// Finished samples are kept in a ring, old sends stop mattering.
+constexpr auto kSamplesLimit = 4096;
+
+} // namespace
+
+SendLatency &SendLatency::Instance() {
+	static auto result = SendLatency();
+	return result;
+}
+
+void SendLatency::Samples::add(crl::time value) {
+	if (int(values.size()) < kSamplesLimit) {
+		values.push_back(value);
+	} else {
+		values[position] = value;
+		position = (position + 1) % kSamplesLimit;
+	}
+	++total;
+}
+
+void SendLatency::mark(FullMsgId itemId, Stage stage, crl::time when) {
+	if (!when) {
+		when = crl::now();
+	}
+	if (stage == Stage::Queued) {
+		if (int(_pending.size()) >= kPendingLimit) {
+			auto oldest = begin(_pending);
+			for (auto i = oldest; i != end(_pending); ++i) {
+				if (i->second.queued < oldest->second.queued) {
+					oldest = i;
+				}
+			}
+			_pending.erase(oldest);
+		}
+		_pending[itemId] = Trace{ .queued = when };
+		return;
+	}
+	const auto i = _pending.find(itemId);
+	if (i == end(_pending)) {
+		return;
+	}
+	switch (stage) {
+	case Stage::UploadStarted: i->second.uploadStarted = when; break;
+	case Stage::UploadFinished: i->second.uploadFinished = when; break;
+	case Stage::Requested: i->second.requested = when; break;
+	case Stage::Shown:
+		finish(i->second, when);
+		_pending.erase(i);
+		break;
+	}
+}
+
+void SendLatency::discard(FullMsgId itemId) {
+	_pending.remove(itemId);
+}
+
+void SendLatency::finish(const Trace &trace, crl::time shown) {
+	if (!trace.queued || shown < trace.queued) {
+		return;
+	}
+	_total.add(shown - trace.queued);
+	if (trace.uploadStarted >= trace.queued) {
+		_prepare.add(trace.uploadStarted - trace.queued);
+		if (trace.uploadFinished >= trace.uploadStarted) {
+			_upload.add(trace.uploadFinished - trace.uploadStarted);
+		}
+	} else if (trace.requested >= trace.queued) {
+		_prepare.add(trace.requested - trace.queued);
+	}
+	if (trace.requested > 0 && shown >= trace.requested) {
+		_network.add(shown - trace.requested);
+	}
+}
+
+QString SendLatency::report() const {
+	auto result = QString();
+	const auto append = [&](const QString &name, const Samples &samples) {
+		if (samples.values.empty()) {
+			return;
+		}
+		auto sorted = samples.values;
+		ranges::sort(sorted);
+		const auto at = [&](int percent) {
+			return sorted[(int(sorted.size()) - 1) * percent / 100];
+		};
+		result += u"%1: p50 %2 ms, p95 %3 ms (%4 sends)\n"_q
+			.arg(name)
+			.arg(at(50))
+			.arg(at(95))
+			.arg(samples.total);
+	};
+	append(u"total"_q, _total);
+	append(u"prepare"_q, _prepare);
+	append(u"upload"_q, _upload);
+	append(u"network"_q, _network);
+	return result.isEmpty()
+		? u"No finished sends were traced yet."_q
+		: result.trimmed();
+}
+
+} // namespace Core
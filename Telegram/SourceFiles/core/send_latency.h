@@ -0,0 +1,65 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "data/data_msg_id.h"
+
+namespace Core {
+
+// Per-message timeline of one send, from the local message appearing
+// in the history to the moment the check mark replaces the clock.
+// Finished traces are folded into bounded per-stage samples, so the
+// 'sendlatency' settings code can show local percentiles instead of
+// anecdotes. All stages are marked on the main thread.
+class SendLatency final {
+public:
+	enum class Stage {
+		Queued, // Send initiated, the local message is in the history.
+		UploadStarted,
+		UploadFinished,
+		Requested, // The send request went to the MTProto session.
+		Shown, // Server id received, the check mark is shown.
+	};
+
+	[[nodiscard]] static SendLatency &Instance();
+
+	// Pass 'when' to backdate a stage, for sends that were initiated
+	// before their local message id existed (media prepare).
+	void mark(FullMsgId itemId, Stage stage, crl::time when = 0);
+	void discard(FullMsgId itemId);
+
+	[[nodiscard]] QString report() const;
+
+private:
+	struct Trace {
+		crl::time queued = 0;
+		crl::time uploadStarted = 0;
+		crl::time uploadFinished = 0;
+		crl::time requested = 0;
+	};
+	struct Samples {
+		std::vector<crl::time> values;
+		int position = 0;
+		int total = 0;
+
+		void add(crl::time value);
+	};
+
+	SendLatency() = default;
+
+	void finish(const Trace &trace, crl::time shown);
+
+	base::flat_map<FullMsgId, Trace> _pending;
+	Samples _total; // Queued -> check mark shown.
+	Samples _prepare; // Queued -> upload or request send.
+	Samples _upload; // Upload start -> upload finish.
+	Samples _network; // Request send -> check mark shown.
+
+};
+
+} // namespace Core
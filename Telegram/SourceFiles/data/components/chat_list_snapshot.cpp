@@ -0,0 +1,161 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/components/chat_list_snapshot.h"
+
+#include "data/data_chat_filters.h"
+#include "data/data_session.h"
+#include "dialogs/dialogs_indexed_list.h"
+#include "dialogs/dialogs_main_list.h"
+#include "history/history.h"
+#include "main/main_session.h"
+#include "storage/serialize_common.h"
+#include "storage/serialize_peer.h"
+
+namespace Data {
+namespace {
+
+constexpr auto kLimit = 64;
+
+} // namespace
+
+ChatListSnapshot::ChatListSnapshot(not_null<Main::Session*> session)
+: _session(session) {
+}
+
+ChatListSnapshot::~ChatListSnapshot() = default;
+
+QByteArray ChatListSnapshot::serialize() const {
+	const auto list = _session->data().chatsList()->indexed();
+	auto histories = std::vector<not_null<History*>>();
+	histories.reserve(std::min(list->size(), kLimit));
+	for (const auto &row : *list) {
+		if (const auto history = row->key().history()) {
+			histories.push_back(history);
+			if (int(histories.size()) == kLimit) {
+				break;
+			}
+		}
+	}
+	if (histories.empty()) {
+		return {};
+	}
+	auto &filters = _session->data().chatsFilters();
+	auto aggregates = std::vector<std::pair<FilterId, Dialogs::UnreadState>>();
+	for (const auto &filter : filters.list()) {
+		if (const auto id = filter.id()) {
+			aggregates.emplace_back(id, filters.chatsList(id)->unreadState());
+		}
+	}
+	auto size = 2 * sizeof(quint32); // AppVersion, count
+	for (const auto &history : histories) {
+		size += Serialize::peerSize(history->peer)
+			+ 2 * sizeof(qint32) // unreadCount, chatListTimeId
+			+ sizeof(quint8); // unreadMark
+	}
+	size += sizeof(quint32) // filters count
+		+ aggregates.size() * 10 * sizeof(qint32);
+	auto stream = Serialize::ByteArrayWriter(size);
+	stream
+		<< quint32(AppVersion)
+		<< quint32(histories.size());
+	for (const auto &history : histories) {
+		Serialize::writePeer(stream, history->peer);
+		stream
+			<< qint32(history->unreadCount())
+			<< qint32(history->chatListTimeId())
+			<< quint8(history->unreadMark() ? 1 : 0);
+	}
+	stream << quint32(aggregates.size());
+	for (const auto &[id, state] : aggregates) {
+		stream
+			<< qint32(id)
+			<< qint32(state.messages)
+			<< qint32(state.messagesMuted)
+			<< qint32(state.chats)
+			<< qint32(state.chatsMuted)
+			<< qint32(state.marks)
+			<< qint32(state.marksMuted)
+			<< qint32(state.mentions)
+			<< qint32(state.reactions)
+			<< qint32(state.reactionsMuted);
+	}
+	return std::move(stream).result();
+}
+
+void ChatListSnapshot::applyLocal(QByteArray serialized) {
+	if (serialized.isEmpty()) {
+		return;
+	}
+	auto stream = Serialize::ByteArrayReader(serialized);
+	auto streamAppVersion = quint32();
+	auto count = quint32();
+	stream >> streamAppVersion >> count;
+	if (!stream.ok()) {
+		DEBUG_LOG(("ChatList Snapshot: Bad local, not ok."));
+		return;
+	}
+	for (auto i = 0; i != int(count); ++i) {
+		const auto peer = Serialize::readPeer(
+			_session,
+			streamAppVersion,
+			stream);
+		auto unreadCount = qint32();
+		auto timeId = qint32();
+		auto unreadMark = quint8();
+		stream >> unreadCount >> timeId >> unreadMark;
+		if (!stream.ok() || !peer) {
+			DEBUG_LOG(("ChatList Snapshot: Failed reading %1 / %2."
+				).arg(i + 1
+				).arg(count));
+			return;
+		}
+		const auto history = _session->data().history(peer);
+		if (history->folderKnown()) {
+			continue;
+		}
+		history->clearFolder();
+		history->setChatListTimeId(timeId);
+		history->updateChatListExistence();
+		if (unreadCount > 0) {
+			history->setUnreadCount(unreadCount);
+		}
+		if (unreadMark) {
+			history->setUnreadMark(true);
+		}
+	}
+	auto aggregatesCount = quint32();
+	stream >> aggregatesCount;
+	if (!stream.ok()) {
+		return;
+	}
+	for (auto i = 0; i != int(aggregatesCount); ++i) {
+		auto id = qint32();
+		auto state = Dialogs::UnreadState();
+		stream
+			>> id
+			>> state.messages
+			>> state.messagesMuted
+			>> state.chats
+			>> state.chatsMuted
+			>> state.marks
+			>> state.marksMuted
+			>> state.mentions
+			>> state.reactions
+			>> state.reactionsMuted;
+		if (!stream.ok() || !id) {
+			DEBUG_LOG(("ChatList Snapshot: Failed reading aggregates."));
+			return;
+		}
+		state.known = true;
+		_session->data().chatsFilters().chatsList(
+			id
+		)->setCloudUnreadState(state);
+	}
+}
+
+} // namespace Data
@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "data/components/recent_peers.h"
 
+#include "base/unixtime.h"
 #include "main/main_session.h"
 #include "storage/serialize_common.h"
 #include "storage/serialize_peer.h"
@@ -17,6 +18,14 @@ namespace {
 
 constexpr auto kLimit = 48;
 
+// The weight of a single interaction halves after a week, so the order
+// mixes how often a peer is used with how recently it was used.
+constexpr auto kHalfLifeSeconds = TimeId(7 * 24 * 3600);
+
+[[nodiscard]] float64 DecayTo(TimeId from, TimeId to) {
+	return std::exp2(float64(from - to) / kHalfLifeSeconds);
+}
+
 } // namespace
 
 RecentPeers::RecentPeers(not_null<Main::Session*> session)
@@ -25,6 +34,15 @@ RecentPeers::RecentPeers(not_null<Main::Session*> session)
 
 RecentPeers::~RecentPeers() = default;
 
+float64 RecentPeers::ScoreKey(const Entry &entry) {
+	// A monotonic transform of the decayed score that doesn't depend
+	// on the current time: the ratio of two decayed scores is constant,
+	// so entries keep their relative order between interactions and
+	// only the bumped one has to move.
+	return std::log2(entry.frequency)
+		+ float64(entry.lastUsed) / kHalfLifeSeconds;
+}
+
 const std::vector<not_null<PeerData*>> &RecentPeers::list() const {
 	_session->local().readSearchSuggestions();
 
@@ -35,10 +53,19 @@ rpl::producer<> RecentPeers::updates() const {
 	return _updates.events();
 }
 
+void RecentPeers::refreshList() {
+	_list.clear();
+	_list.reserve(_entries.size());
+	for (const auto &entry : _entries) {
+		_list.push_back(entry.peer);
+	}
+}
+
 void RecentPeers::remove(not_null<PeerData*> peer) {
-	const auto i = ranges::find(_list, peer);
-	if (i != end(_list)) {
-		_list.erase(i);
+	const auto i = ranges::find(_entries, peer, &Entry::peer);
+	if (i != end(_entries)) {
+		_entries.erase(i);
+		refreshList();
 		_updates.fire({});
 	}
 	_session->local().writeSearchSuggestionsDelayed();
@@ -47,15 +74,26 @@ void RecentPeers::remove(not_null<PeerData*> peer) {
 void RecentPeers::bump(not_null<PeerData*> peer) {
 	_session->local().readSearchSuggestions();
 
-	if (!_list.empty() && _list.front() == peer) {
-		return;
-	}
-	auto i = ranges::find(_list, peer);
-	if (i == end(_list)) {
-		_list.push_back(peer);
-		i = end(_list) - 1;
+	const auto now = base::unixtime::now();
+	auto i = ranges::find(_entries, peer, &Entry::peer);
+	if (i == end(_entries)) {
+		_entries.push_back({ peer, 0., now });
+		i = end(_entries) - 1;
 	}
-	ranges::rotate(begin(_list), i, i + 1);
+	// Decay the accumulated frequency to this moment and count
+	// the interaction.
+	i->frequency = i->frequency * DecayTo(i->lastUsed, now) + 1.;
+	i->lastUsed = now;
+	const auto key = ScoreKey(*i);
+	const auto better = std::lower_bound(
+		begin(_entries),
+		i,
+		key,
+		[](const Entry &entry, float64 key) {
+			return ScoreKey(entry) > key;
+		});
+	ranges::rotate(better, i, i + 1);
+	refreshList();
 	_updates.fire({});
 
 	_session->local().writeSearchSuggestionsDelayed();
@@ -64,7 +102,8 @@ void RecentPeers::bump(not_null<PeerData*> peer) {
 void RecentPeers::clear() {
 	_session->local().readSearchSuggestions();
 
-	_list.clear();
+	_entries.clear();
+	refreshList();
 	_updates.fire({});
 
 	_session->local().writeSearchSuggestionsDelayed();
@@ -73,26 +112,33 @@ void RecentPeers::clear() {
 QByteArray RecentPeers::serialize() const {
 	_session->local().readSearchSuggestions();
 
-	if (_list.empty()) {
+	if (_entries.empty()) {
 		return {};
 	}
 	auto size = 2 * sizeof(quint32); // AppVersion, count
-	const auto count = std::min(int(_list.size()), kLimit);
-	auto &&list = _list | ranges::views::take(count);
-	for (const auto &peer : list) {
-		size += Serialize::peerSize(peer);
+	const auto count = std::min(int(_entries.size()), kLimit);
+	auto &&list = _entries | ranges::views::take(count);
+	for (const auto &entry : list) {
+		size += Serialize::peerSize(entry.peer);
+		size += sizeof(float64) + sizeof(qint32);
 	}
 	auto stream = Serialize::ByteArrayWriter(size);
 	stream
 		<< quint32(AppVersion)
-		<< quint32(_list.size());
-	for (const auto &peer : list) {
-		Serialize::writePeer(stream, peer);
+		<< quint32(count);
+	for (const auto &entry : list) {
+		Serialize::writePeer(stream, entry.peer);
+	}
+	// The scores follow the peer list, so older versions reading only
+	// the peers keep working with this data.
+	for (const auto &entry : list) {
+		stream << entry.frequency << qint32(entry.lastUsed);
 	}
 	return std::move(stream).result();
 }
 
 void RecentPeers::applyLocal(QByteArray serialized) {
+	_entries.clear();
 	_list.clear();
 	if (serialized.isEmpty()) {
 		DEBUG_LOG(("Suggestions: Bad RecentPeers local, empty."));
@@ -110,7 +156,7 @@ void RecentPeers::applyLocal(QByteArray serialized) {
 		"Start RecentPeers read, count: %1, version: %2."
 		).arg(count
 		).arg(streamAppVersion));
-	_list.reserve(count);
+	_entries.reserve(count);
 	for (auto i = 0; i != int(count); ++i) {
 		const auto streamPosition = stream.underlying().device()->pos();
 		const auto peer = Serialize::readPeer(
@@ -118,9 +164,9 @@ void RecentPeers::applyLocal(QByteArray serialized) {
 			streamAppVersion,
 			stream);
 		if (stream.ok() && peer) {
-			_list.push_back(peer);
+			_entries.push_back({ peer });
 		} else {
-			_list.clear();
+			_entries.clear();
 			DEBUG_LOG(("Suggestions: Failed RecentPeers reading %1 / %2."
 				).arg(i + 1
 				).arg(count));
@@ -129,6 +175,28 @@ void RecentPeers::applyLocal(QByteArray serialized) {
 			return;
 		}
 	}
+	auto scoresOk = !stream.atEnd();
+	if (scoresOk) {
+		for (auto &entry : _entries) {
+			auto frequency = float64();
+			auto lastUsed = qint32();
+			stream >> frequency >> lastUsed;
+			entry.frequency = std::max(frequency, 1.);
+			entry.lastUsed = lastUsed;
+		}
+		scoresOk = stream.ok();
+	}
+	if (!scoresOk) {
+		// A legacy pure-recency list, synthesize scores decreasing
+		// down the list so the stored order is preserved.
+		const auto now = base::unixtime::now();
+		auto index = 0;
+		for (auto &entry : _entries) {
+			entry.frequency = 1.;
+			entry.lastUsed = now - (index++) * 60;
+		}
+	}
+	refreshList();
 	DEBUG_LOG(
 		("Suggestions: RecentPeers read OK, count: %1").arg(_list.size()));
 }
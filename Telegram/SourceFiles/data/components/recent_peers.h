@@ -29,8 +29,19 @@ public:
 	void applyLocal(QByteArray serialized);
 
 private:
+	struct Entry {
+		not_null<PeerData*> peer;
+		float64 frequency = 0.;
+		TimeId lastUsed = 0;
+	};
+
+	[[nodiscard]] static float64 ScoreKey(const Entry &entry);
+
+	void refreshList();
+
 	const not_null<Main::Session*> _session;
 
+	std::vector<Entry> _entries;
 	std::vector<not_null<PeerData*>> _list;
 	rpl::event_stream<> _updates;
 
@@ -165,11 +165,19 @@ HistoryItem *ScheduledMessages::lookupItem(PeerId peer, MsgId msg) const {
 		return nullptr;
 	}
 
-	const auto &items = i->second.items;
-	const auto j = ranges::find_if(items, [&](auto &item) {
+	const auto &list = i->second;
+	if (IsScheduledMsgId(msg)) {
+		const auto j = list.itemById.find(LocalToRemoteMsgId(msg));
+		if (j != end(list.itemById)) {
+			return j->second;
+		}
+	}
+
+	// Still-sending items have local ids that aren't in itemById.
+	const auto j = ranges::find_if(list.items, [&](auto &item) {
 		return item->id == msg;
 	});
-	if (j == end(items)) {
+	if (j == end(list.items)) {
 		return nullptr;
 	}
 	return (*j).get();
@@ -10,6 +10,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_session.h"
 
 namespace Data {
+namespace {
+
+// About one frame at 60Hz, so an update storm during channel sync
+// produces a single delivery (and repaint) per frame, not one per batch.
+constexpr auto kSendNotificationsEach = crl::time(16);
+
+} // namespace
 
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::updated(
@@ -88,7 +95,9 @@ void Changes::Manager<DataType, UpdateType>::sendNotifications() {
 	}
 }
 
-Changes::Changes(not_null<Main::Session*> session) : _session(session) {
+Changes::Changes(not_null<Main::Session*> session)
+: _session(session)
+, _notifyTimer([=] { sendNotifications(); }) {
 }
 
 Main::Session &Changes::session() const {
@@ -305,8 +314,16 @@ rpl::producer<StoryUpdate> Changes::realtimeStoryUpdates(
 }
 
 void Changes::scheduleNotifications() {
-	if (!_notify) {
-		_notify = true;
+	if (_notify) {
+		return;
+	}
+	_notify = true;
+	const auto wait = _sentNotificationsAt
+		+ kSendNotificationsEach
+		- crl::now();
+	if (wait > 0) {
+		_notifyTimer.callOnce(wait);
+	} else {
 		crl::on_main(&session(), [=] {
 			sendNotifications();
 		});
@@ -318,6 +335,8 @@ void Changes::sendNotifications() {
 		return;
 	}
 	_notify = false;
+	_notifyTimer.cancel();
+	_sentNotificationsAt = crl::now();
 	_peerChanges.sendNotifications();
 	_historyChanges.sendNotifications();
 	_messageChanges.sendNotifications();
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #pragma once
 
 #include "base/flags.h"
+#include "base/timer.h"
 
 class History;
 class PeerData;
@@ -394,6 +395,8 @@ private:
 	Manager<Dialogs::Entry, EntryUpdate> _entryChanges;
 	Manager<Story, StoryUpdate> _storyChanges;
 
+	base::Timer _notifyTimer;
+	crl::time _sentNotificationsAt = 0;
 	bool _notify = false;
 
 };
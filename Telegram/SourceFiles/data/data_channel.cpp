@@ -171,6 +171,9 @@ void ChannelData::setFlags(ChannelDataFlags which) {
 		mgInfo->ensureForum(this);
 	}
 	_flags.set(which);
+	if (diff & Flag::Creator) {
+		refreshEffectiveAdminRights();
+	}
 	if (diff & (Flag::Left | Flag::Forbidden)) {
 		if (const auto chat = getMigrateFromChat()) {
 			session().changes().peerUpdated(chat, UpdateFlag::Migration);
@@ -234,8 +237,7 @@ void ChannelData::setInviteLink(const QString &newInviteLink) {
 }
 
 bool ChannelData::canHaveInviteLink() const {
-	return amCreator()
-		|| (adminRights() & AdminRight::InviteByLinkOrAdd);
+	return effectiveAdminRights() & AdminRight::InviteByLinkOrAdd;
 }
 
 void ChannelData::setLocation(const MTPChannelLocation &data) {
@@ -557,38 +559,31 @@ void ChannelData::setAvailableMinId(MsgId availableMinId) {
 }
 
 bool ChannelData::canBanMembers() const {
-	return amCreator()
-		|| (adminRights() & AdminRight::BanUsers);
+	return effectiveAdminRights() & AdminRight::BanUsers;
 }
 
 bool ChannelData::canPostMessages() const {
-	return amCreator()
-		|| (adminRights() & AdminRight::PostMessages);
+	return effectiveAdminRights() & AdminRight::PostMessages;
 }
 
 bool ChannelData::canEditMessages() const {
-	return amCreator()
-		|| (adminRights() & AdminRight::EditMessages);
+	return effectiveAdminRights() & AdminRight::EditMessages;
 }
 
 bool ChannelData::canDeleteMessages() const {
-	return amCreator()
-		|| (adminRights() & AdminRight::DeleteMessages);
+	return effectiveAdminRights() & AdminRight::DeleteMessages;
 }
 
 bool ChannelData::canPostStories() const {
-	return amCreator()
-		|| (adminRights() & AdminRight::PostStories);
+	return effectiveAdminRights() & AdminRight::PostStories;
 }
 
 bool ChannelData::canEditStories() const {
-	return amCreator()
-		|| (adminRights() & AdminRight::EditStories);
+	return effectiveAdminRights() & AdminRight::EditStories;
 }
 
 bool ChannelData::canDeleteStories() const {
-	return amCreator()
-		|| (adminRights() & AdminRight::DeleteStories);
+	return effectiveAdminRights() & AdminRight::DeleteStories;
 }
 
 bool ChannelData::canPostPaidMedia() const {
@@ -606,12 +601,11 @@ bool ChannelData::hiddenPreHistory() const {
 bool ChannelData::canAddMembers() const {
 	return isMegagroup()
 		? !amRestricted(ChatRestriction::AddParticipants)
-		: ((adminRights() & AdminRight::InviteByLinkOrAdd) || amCreator());
+		: !!(effectiveAdminRights() & AdminRight::InviteByLinkOrAdd);
 }
 
 bool ChannelData::canAddAdmins() const {
-	return amCreator()
-		|| (adminRights() & AdminRight::AddAdmins);
+	return effectiveAdminRights() & AdminRight::AddAdmins;
 }
 
 bool ChannelData::allowsForwarding() const {
@@ -651,7 +645,7 @@ bool ChannelData::canEditSignatures() const {
 
 bool ChannelData::canEditPreHistoryHidden() const {
 	return isMegagroup()
-		&& ((adminRights() & AdminRight::BanUsers) || amCreator())
+		&& (effectiveAdminRights() & AdminRight::BanUsers)
 		&& (!isPublic() || canEditUsername());
 }
 
@@ -665,7 +659,7 @@ bool ChannelData::canEditStickers() const {
 }
 
 bool ChannelData::canEditEmoji() const {
-	return amCreator() || (adminRights() & ChatAdminRight::ChangeInfo);
+	return effectiveAdminRights() & ChatAdminRight::ChangeInfo;
 }
 
 bool ChannelData::canDelete() const {
@@ -713,11 +707,18 @@ bool ChannelData::canRestrictParticipant(
 	return adminRights() & AdminRight::BanUsers;
 }
 
+void ChannelData::refreshEffectiveAdminRights() {
+	_effectiveAdminRights = amCreator()
+		? ChatAdminRights::from_raw(~0)
+		: adminRights();
+}
+
 void ChannelData::setAdminRights(ChatAdminRights rights) {
 	if (rights == adminRights()) {
 		return;
 	}
 	_adminRights.set(rights);
+	refreshEffectiveAdminRights();
 	if (!canHaveInviteLink()) {
 		setPendingRequestsCount(0, std::vector<UserId>{});
 	}
@@ -320,6 +320,13 @@ public:
 		return (adminRights() != 0);
 	}
 
+	// Admin rights with the creator resolved to the full set, kept up
+	// to date on rights and flags changes, so the availability checks
+	// that history views run per message cost a single mask test.
+	[[nodiscard]] ChatAdminRights effectiveAdminRights() const {
+		return _effectiveAdminRights;
+	}
+
 	[[nodiscard]] auto restrictions() const {
 		return _restrictions.current();
 	}
@@ -511,6 +518,7 @@ private:
 	auto unavailableReasons() const
 		-> const std::vector<Data::UnavailableReason> & override;
 	bool canEditLastAdmin(not_null<UserData*> user) const;
+	void refreshEffectiveAdminRights();
 
 	void setUnavailableReasonsList(
 		std::vector<Data::UnavailableReason> &&reasons) override;
@@ -532,6 +540,7 @@ private:
 
 	RestrictionFlags _defaultRestrictions;
 	AdminRightFlags _adminRights;
+	ChatAdminRights _effectiveAdminRights;
 	RestrictionFlags _restrictions;
 	TimeId _restrictedUntil;
 	TimeId _subscriptionUntilDate;
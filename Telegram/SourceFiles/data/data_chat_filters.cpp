@@ -294,6 +294,16 @@ const base::flat_set<not_null<History*>> &ChatFilter::never() const {
 bool ChatFilter::contains(
 		not_null<History*> history,
 		bool ignoreFakeUnread) const {
+	const auto state = (_flags & (Flag::NoMuted | Flag::NoRead))
+		? history->chatListBadgesState()
+		: Dialogs::BadgesState();
+	return contains(history, state, ignoreFakeUnread);
+}
+
+bool ChatFilter::contains(
+		not_null<History*> history,
+		const Dialogs::BadgesState &state,
+		bool ignoreFakeUnread) const {
 	const auto flag = [&] {
 		const auto peer = history->peer;
 		if (const auto user = peer->asUser()) {
@@ -317,9 +327,6 @@ bool ChatFilter::contains(
 	if (_never.contains(history)) {
 		return false;
 	}
-	const auto state = (_flags & (Flag::NoMuted | Flag::NoRead))
-		? history->chatListBadgesState()
-		: Dialogs::BadgesState();
 	return false
 		|| ((_flags & flag)
 			&& (!(_flags & Flag::NoMuted)
@@ -682,8 +689,9 @@ bool ChatFilters::applyChange(ChatFilter &filter, ChatFilter &&updated) {
 				: row->entry()->hasChatsFilterTags(0);
 		};
 		const auto feedHistory = [&](not_null<History*> history) {
-			const auto now = filter.contains(history);
-			const auto was = wasFilter.contains(history);
+			const auto badges = history->chatListBadgesState();
+			const auto now = filter.contains(history, badges);
+			const auto was = wasFilter.contains(history, badges);
 			if (now != was) {
 				if (now) {
 					history->addToChatList(id, filterList);
@@ -15,6 +15,7 @@ class History;
 namespace Dialogs {
 class MainList;
 class Key;
+struct BadgesState;
 } // namespace Dialogs
 
 namespace Ui {
@@ -86,6 +87,13 @@ public:
 		not_null<History*> history,
 		bool ignoreFakeUnread = false) const;
 
+	// Allows checking several filters against one history without
+	// recomputing its badges state for each of them.
+	[[nodiscard]] bool contains(
+		not_null<History*> history,
+		const Dialogs::BadgesState &state,
+		bool ignoreFakeUnread = false) const;
+
 private:
 	FilterId _id = 0;
 	QString _title;
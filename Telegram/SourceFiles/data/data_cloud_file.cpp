@@ -120,6 +120,14 @@ void CloudImage::load(not_null<Main::Session*> session, FileOrigin origin) {
 		done);
 }
 
+void CloudImage::cancel() {
+	if (!_file.loader) {
+		return;
+	}
+	_file.flags |= CloudFile::Flag::Cancelled;
+	_file.loader = nullptr;
+}
+
 const ImageLocation &CloudImage::location() const {
 	return _file.location;
 }
@@ -67,6 +67,11 @@ public:
 	[[nodiscard]] bool failed() const;
 	[[nodiscard]] bool loadedOnce() const;
 	void load(not_null<Main::Session*> session, FileOrigin origin);
+
+	// Stops an in-flight download without marking the image as failed,
+	// so a later load() call restarts it from the beginning.
+	void cancel();
+
 	[[nodiscard]] const ImageLocation &location() const;
 	[[nodiscard]] int byteSize() const;
 
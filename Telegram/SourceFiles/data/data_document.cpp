@@ -51,6 +51,11 @@ constexpr auto kMaxAllowedPreloadPrefix = 6 * 1024 * 1024;
 constexpr auto kDefaultWebmEmojiSize = 100;
 constexpr auto kDefaultWebmStickerLargerSize = kStickerSideSize;
 
+// In automatic mode playback starts from this quality for instant
+// start, the player then measures the download speed and requests a
+// switch to a higher quality mid-stream if the connection allows it.
+constexpr auto kAutoStartQualityHeight = 480;
+
 const auto kLottieStickerDimensions = QSize(
 	kStickerSideSize,
 	kStickerSideSize);
@@ -606,10 +611,12 @@ not_null<DocumentData*> DocumentData::chooseQuality(
 		HistoryItem *context,
 		Media::VideoQuality request) {
 	const auto &list = resolveQualities(context);
-	if (list.empty() || !request.height) {
+	if (list.empty() || (request.manual && !request.height)) {
 		return this;
 	}
-	const auto height = int(request.height);
+	const auto height = request.height
+		? int(request.height)
+		: kAutoStartQualityHeight;
 	auto closest = this;
 	auto closestAbs = std::abs(height - resolveVideoQuality());
 	auto closestSize = size;
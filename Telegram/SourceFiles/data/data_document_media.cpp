@@ -192,7 +192,7 @@ Image *DocumentMedia::thumbnailInline() const {
 	if (!_inlineThumbnail && !_owner->inlineThumbnailIsPath()) {
 		const auto bytes = _owner->inlineThumbnailBytes();
 		if (!bytes.isEmpty()) {
-			auto image = Images::FromInlineBytes(bytes);
+			auto image = _owner->owner().inlineThumbnail(bytes);
 			if (image.isNull()) {
 				_owner->clearInlineThumbnailBytes();
 			} else {
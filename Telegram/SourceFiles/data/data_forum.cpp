@@ -211,8 +211,8 @@ void Forum::reorderLastTopics() {
 		const auto bDate = bItem ? bItem->date() : TimeId(0);
 		return aDate > bDate;
 	};
-	_lastTopics.clear();
-	_lastTopics.reserve(kShowTopicNamesCount + 1);
+	auto lastTopics = std::vector<not_null<ForumTopic*>>();
+	lastTopics.reserve(kShowTopicNamesCount + 1);
 	auto &&topics = ranges::views::all(
 		*_topicsList.indexed()
 	) | ranges::views::transform([](not_null<Dialogs::Row*> row) {
@@ -221,21 +221,27 @@ void Forum::reorderLastTopics() {
 	auto nonPinnedChecked = 0;
 	for (const auto topic : topics) {
 		const auto i = ranges::upper_bound(
-			_lastTopics,
+			lastTopics,
 			not_null(topic),
 			pred);
-		if (size(_lastTopics) < kShowTopicNamesCount
-			|| i != end(_lastTopics)) {
-			_lastTopics.insert(i, topic);
+		if (size(lastTopics) < kShowTopicNamesCount
+			|| i != end(lastTopics)) {
+			lastTopics.insert(i, topic);
 		}
-		if (size(_lastTopics) > kShowTopicNamesCount) {
-			_lastTopics.pop_back();
+		if (size(lastTopics) > kShowTopicNamesCount) {
+			lastTopics.pop_back();
 		}
 		if (!topic->isPinnedDialog(FilterId())
 			&& ++nonPinnedChecked >= kShowTopicNamesCount) {
 			break;
 		}
 	}
+	if (_lastTopics == lastTopics) {
+		// The chats list lays the topic names ribbon out again on each
+		// version bump, don't invalidate it when the list didn't change.
+		return;
+	}
+	_lastTopics = std::move(lastTopics);
 	++_lastTopicsVersion;
 	_history->updateChatListEntry();
 }
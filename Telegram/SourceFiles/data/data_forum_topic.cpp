@@ -617,6 +617,7 @@ void ForumTopic::chatListPreloadData() {
 		[[maybe_unused]] const auto preload = _icon->ready();
 	}
 	allowChatListMessageResolve();
+	preloadLastItemDialogsView();
 }
 
 void ForumTopic::paintUserpic(
@@ -21,17 +21,22 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/random.h"
 #include "main/main_session.h"
 #include "window/notifications_manager.h"
+#include "window/window_session_controller.h"
 #include "history/history.h"
 #include "history/history_item.h"
 #include "history/history_item_helpers.h"
 #include "history/view/history_view_element.h"
 #include "core/application.h"
+#include "core/send_latency.h"
 #include "apiwrap.h"
 
 namespace Data {
 namespace {
 
 constexpr auto kReadRequestTimeout = 3 * crl::time(1000);
+constexpr auto kMaxReadRequestsInFlight = 8;
+constexpr auto kPreloadAroundUnreadCount = 50;
+constexpr auto kPreloadAtTheEndCount = 30;
 
 } // namespace
 
@@ -134,7 +139,14 @@ void Histories::unloadAll() {
 	}
 }
 
+void Histories::collectGarbage() {
+	for (const auto &[peerId, history] : _map) {
+		history->collectGarbage();
+	}
+}
+
 void Histories::clearAll() {
+	cancelPreload();
 	_map.clear();
 }
 
@@ -553,6 +565,116 @@ void Histories::requestGroupAround(not_null<HistoryItem*> item) {
 		ChatListGroupRequest{ .aroundId = id, .requestId = requestId });
 }
 
+void Histories::preload(not_null<History*> history) {
+	if (_preloadHistory == history) {
+		return;
+	}
+	cancelPreload();
+	const auto peer = history->peer;
+	if (peer->migrateFrom()) {
+		// Migrated histories are shown merged with the old group,
+		// leave them to the full HistoryWidget loading logic.
+		return;
+	}
+	for (const auto &window : session().windows()) {
+		if (window->activeChatCurrent().history() == history) {
+			// Shown already, the history widget manages its loading.
+			return;
+		}
+	}
+	if (const auto state = lookup(history)) {
+		for (const auto &[id, sent] : state->sent) {
+			if (sent.type == RequestType::History) {
+				return;
+			}
+		}
+		if (!state->postponed.empty()) {
+			return;
+		}
+	}
+	const auto around = history->loadAroundId();
+	const auto showAt = around ? ShowAtUnreadMsgId : ShowAtTheEndMsgId;
+	if (history->isReadyFor(showAt)) {
+		return;
+	}
+	const auto loadCount = around
+		? kPreloadAroundUnreadCount
+		: kPreloadAtTheEndCount;
+	const auto offset = around ? (-loadCount / 2) : 0;
+	_preloadHistory = history;
+	_preloadRequestId = sendRequest(history, RequestType::History, [=](
+			Fn<void()> finish) {
+		return session().api().request(MTPmessages_GetHistory(
+			peer->input,
+			MTP_int(around), // offset_id
+			MTP_int(0), // offset_date
+			MTP_int(offset),
+			MTP_int(loadCount),
+			MTP_int(0), // max_id
+			MTP_int(0), // min_id
+			MTP_long(0) // hash
+		)).done([=](const MTPmessages_Messages &result) {
+			_preloadHistory = nullptr;
+			_preloadRequestId = 0;
+			applyPreloadedSlice(history, result, around);
+			finish();
+		}).fail([=] {
+			_preloadHistory = nullptr;
+			_preloadRequestId = 0;
+			finish();
+		}).send();
+	});
+}
+
+void Histories::cancelPreload() {
+	_preloadHistory = nullptr;
+	if (const auto id = base::take(_preloadRequestId)) {
+		cancelRequest(id);
+	}
+}
+
+void Histories::applyPreloadedSlice(
+		not_null<History*> history,
+		const MTPmessages_Messages &result,
+		MsgId aroundId) {
+	const auto showAt = aroundId ? ShowAtUnreadMsgId : ShowAtTheEndMsgId;
+	if (history->isReadyFor(showAt)
+		|| (aroundId && history->loadAroundId() != aroundId)) {
+		// Loaded by a real request while we were in flight, or the
+		// unread position moved and the slice no longer covers it.
+		return;
+	}
+	const QVector<MTPMessage> *list = nullptr;
+	result.match([&](const MTPDmessages_messages &data) {
+		_owner->processUsers(data.vusers());
+		_owner->processChats(data.vchats());
+		list = &data.vmessages().v;
+	}, [&](const MTPDmessages_messagesSlice &data) {
+		_owner->processUsers(data.vusers());
+		_owner->processChats(data.vchats());
+		list = &data.vmessages().v;
+	}, [&](const MTPDmessages_channelMessages &data) {
+		if (const auto channel = history->peer->asChannel()) {
+			channel->ptsReceived(data.vpts().v);
+			channel->processTopics(data.vtopics());
+		} else {
+			LOG(("API Error: received messages.channelMessages when "
+				"no channel was passed! (Histories::applyPreloadedSlice)"));
+		}
+		_owner->processUsers(data.vusers());
+		_owner->processChats(data.vchats());
+		list = &data.vmessages().v;
+	}, [&](const MTPDmessages_messagesNotModified &) {
+		LOG(("API Error: received messages.messagesNotModified! "
+			"(Histories::applyPreloadedSlice)"));
+	});
+	if (!list) {
+		return;
+	}
+	history->getReadyFor(showAt);
+	history->addOlderSlice(*list);
+}
+
 void Histories::sendPendingReadInbox(not_null<History*> history) {
 	if (const auto state = lookup(history)) {
 		DEBUG_LOG(("Reading: send pending now with till %1 and when %2"
@@ -577,9 +699,16 @@ void Histories::sendReadRequests() {
 			DEBUG_LOG(("Reading: skipping zero till."));
 			continue;
 		} else if (state.willReadWhen <= now) {
-			DEBUG_LOG(("Reading: sending with till %1."
-				).arg(state.willReadTill.bare));
-			sendReadRequest(history, state);
+			if (_readRequestsSent < kMaxReadRequestsInFlight) {
+				DEBUG_LOG(("Reading: sending with till %1."
+					).arg(state.willReadTill.bare));
+				sendReadRequest(history, state);
+			} else {
+				// Pace the burst from mark-all-as-read: each finished
+				// request re-enters here and sends the next pending one.
+				DEBUG_LOG(("Reading: postponing, %1 in flight."
+					).arg(_readRequestsSent));
+			}
 		} else if (!next || *next > state.willReadWhen) {
 			DEBUG_LOG(("Reading: scheduling for later send."));
 			next = state.willReadWhen;
@@ -603,7 +732,9 @@ void Histories::sendReadRequest(not_null<History*> history, State &state) {
 	sendRequest(history, RequestType::ReadInbox, [=](Fn<void()> finish) {
 		DEBUG_LOG(("Reading: sending request invoked with till %1."
 			).arg(tillId.bare));
+		++_readRequestsSent;
 		const auto finished = [=] {
+			--_readRequestsSent;
 			const auto state = lookup(history);
 			Assert(state != nullptr);
 
@@ -895,6 +1026,13 @@ int Histories::sendRequest(
 		Fn<mtpRequestId(Fn<void()> finish)> generator) {
 	Expects(type != RequestType::None);
 
+	if (type == RequestType::History
+		&& history == _preloadHistory
+		&& _preloadRequestId) {
+		// A real request for this history supersedes the speculative
+		// preload, don't make it wait in the queue behind that one.
+		cancelPreload();
+	}
 	auto &state = _states[history];
 	const auto id = ++_requestAutoincrement;
 	_historyByRequest.emplace(id, history);
@@ -1012,6 +1150,11 @@ int Histories::sendPreparedMessage(
 		return sendRequest(history, type, [=](Fn<void()> finish) {
 			const auto session = &_owner->session();
 			const auto api = &session->api();
+			if (const auto itemId = _owner->messageIdByRandomId(randomId)) {
+				Core::SendLatency::Instance().mark(
+					itemId,
+					Core::SendLatency::Stage::Requested);
+			}
 			history->sendRequestId = api->request(
 				base::duplicate(request)
 			).done([=](
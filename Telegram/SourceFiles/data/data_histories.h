@@ -55,6 +55,7 @@ public:
 	void applyPeerDialogs(const MTPmessages_PeerDialogs &dialogs);
 
 	void unloadAll();
+	void collectGarbage();
 	void clearAll();
 
 	void readInbox(not_null<History*> history);
@@ -74,6 +75,13 @@ public:
 
 	void requestGroupAround(not_null<HistoryItem*> item);
 
+	// Speculatively loads the slice that opening the chat would show,
+	// so that the click-to-first-paint path skips the network wait.
+	// Only one preload is kept in flight, a newer one cancels it, and
+	// a real history request for the same chat supersedes it.
+	void preload(not_null<History*> history);
+	void cancelPreload();
+
 	void deleteMessages(
 		not_null<History*> history,
 		const QVector<MTPint> &ids,
@@ -186,6 +194,11 @@ private:
 		}
 	}
 
+	void applyPreloadedSlice(
+		not_null<History*> history,
+		const MTPmessages_Messages &result,
+		MsgId aroundId);
+
 	void readInboxTill(not_null<History*> history, MsgId tillId, bool force);
 	void sendReadRequests();
 	void sendReadRequest(not_null<History*> history, State &state);
@@ -215,6 +228,7 @@ private:
 	base::flat_map<int, not_null<History*>> _historyByRequest;
 	int _requestAutoincrement = 0;
 	base::Timer _readRequestsTimer;
+	int _readRequestsSent = 0;
 
 	base::flat_set<not_null<Data::Folder*>> _dialogFolderRequests;
 	base::flat_map<
@@ -226,6 +240,9 @@ private:
 
 	base::flat_set<not_null<History*>> _fakeChatListRequests;
 
+	History *_preloadHistory = nullptr;
+	int _preloadRequestId = 0;
+
 	base::flat_map<
 		GroupRequestKey,
 		ChatListGroupRequest> _chatListGroupRequests;
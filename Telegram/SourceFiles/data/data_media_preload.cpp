@@ -130,7 +130,7 @@ void VideoPreload::load() {
 	for (auto i = 0; i != parts; ++i) {
 		_parts.emplace(i * part, QByteArray());
 	}
-	addToQueue();
+	addToQueue(Storage::kPreloadDownloadPriority);
 }
 
 void VideoPreload::done(QByteArray result) {
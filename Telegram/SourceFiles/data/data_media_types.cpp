@@ -1930,7 +1930,8 @@ bool MediaGame::dropForwardedInfo() const {
 }
 
 bool MediaGame::consumeMessageText(const TextWithEntities &text) {
-	_consumedText = text;
+	_consumedText = parent()->history()->owner().internText(
+		TextWithEntities(text));
 	return true;
 }
 
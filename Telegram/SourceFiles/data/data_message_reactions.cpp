@@ -51,6 +51,8 @@ constexpr auto kMyTagsRequestTimeout = crl::time(1000);
 constexpr auto kTopRequestDelay = 60 * crl::time(1000);
 constexpr auto kTopReactionsLimit = 14;
 constexpr auto kPaidAccumulatePeriod = 5 * crl::time(1000) + 500;
+constexpr auto kUpdatesBatchDelay = crl::time(100);
+constexpr auto kMaxEffectAnimations = 12;
 
 [[nodiscard]] QString ReactionIdToLog(const ReactionId &id) {
 	if (const auto custom = id.custom()) {
@@ -307,6 +309,7 @@ Reactions::Reactions(not_null<Session*> owner)
 : _owner(owner)
 , _topRefreshTimer([=] { refreshTop(); })
 , _repaintTimer([=] { repaintCollected(); })
+, _queuedUpdatesTimer([=] { applyQueuedUpdates(); })
 , _sendPaidTimer([=] { sendPaid(); }) {
 	refreshDefault();
 
@@ -531,6 +534,77 @@ void Reactions::renameTag(const ReactionId &id, const QString &name) {
 	)).send();
 }
 
+void Reactions::reindexTagged(not_null<HistoryItem*> item) {
+	if (!item->reactionsAreTags() || !IsServerMsgId(item->id)) {
+		return;
+	}
+	const auto id = item->id;
+	auto now = item->chosenReactions();
+	auto &was = _messageTags[id];
+	for (const auto &tag : was) {
+		if (!ranges::contains(now, tag)) {
+			const auto i = _taggedMessages.find(tag);
+			if (i != end(_taggedMessages)) {
+				i->second.remove(id);
+				if (i->second.empty()) {
+					_taggedMessages.erase(i);
+				}
+			}
+		}
+	}
+	for (const auto &tag : now) {
+		if (!ranges::contains(was, tag)) {
+			_taggedMessages[tag].emplace(id);
+		}
+	}
+	if (now.empty()) {
+		_messageTags.remove(id);
+	} else {
+		was = std::move(now);
+	}
+}
+
+void Reactions::unindexTagged(not_null<HistoryItem*> item) {
+	const auto i = _messageTags.find(item->id);
+	if (i == end(_messageTags)) {
+		return;
+	}
+	for (const auto &tag : i->second) {
+		const auto j = _taggedMessages.find(tag);
+		if (j != end(_taggedMessages)) {
+			j->second.remove(item->id);
+			if (j->second.empty()) {
+				_taggedMessages.erase(j);
+			}
+		}
+	}
+	_messageTags.erase(i);
+}
+
+std::vector<MsgId> Reactions::tagged(
+		const std::vector<ReactionId> &tags) const {
+	if (tags.empty()) {
+		return {};
+	}
+	const auto first = _taggedMessages.find(tags.front());
+	if (first == end(_taggedMessages)) {
+		return {};
+	}
+	auto result = std::vector<MsgId>();
+	result.reserve(first->second.size());
+	for (const auto &id : first->second) {
+		const auto all = ranges::all_of(tags, [&](const ReactionId &tag) {
+			const auto i = _taggedMessages.find(tag);
+			return (i != end(_taggedMessages)) && i->second.contains(id);
+		});
+		if (all) {
+			result.push_back(id);
+		}
+	}
+	ranges::reverse(result);
+	return result;
+}
+
 void Reactions::scheduleMyTagsUpdate(SavedSublist *sublist) {
 	auto &my = _myTags[sublist];
 	my.updateScheduled = true;
@@ -588,6 +662,20 @@ DocumentData *Reactions::choosePaidReactionAnimation() const {
 	return randomLoadedFrom(_paidReactionAnimations);
 }
 
+bool Reactions::takeEffectAnimationSlot() {
+	if (_effectAnimationSlotsTaken >= kMaxEffectAnimations) {
+		return false;
+	}
+	++_effectAnimationSlotsTaken;
+	return true;
+}
+
+void Reactions::releaseEffectAnimationSlot() {
+	Expects(_effectAnimationSlotsTaken > 0);
+
+	--_effectAnimationSlotsTaken;
+}
+
 DocumentData *Reactions::randomLoadedFrom(
 		std::vector<not_null<DocumentData*>> list) const {
 	if (list.empty()) {
@@ -1492,6 +1580,37 @@ void Reactions::poll(not_null<HistoryItem*> item, crl::time now) {
 	}
 }
 
+void Reactions::queueUpdate(
+		not_null<HistoryItem*> item,
+		const MTPMessageReactions &reactions) {
+	// Each update carries the whole reactions state, so on a popular
+	// post it is enough to apply the latest one per batch window
+	// instead of relayouting the item hundreds of times per second.
+	const auto id = item->fullId();
+	if (_queuedUpdates.empty() && !_queuedUpdatesTimer.isActive()) {
+		item->updateReactions(&reactions);
+		_queuedUpdatesTimer.callOnce(kUpdatesBatchDelay);
+		return;
+	} else if (const auto i = _queuedUpdates.find(id)
+		; i != end(_queuedUpdates)) {
+		i->second = reactions;
+	} else {
+		_queuedUpdates.emplace(id, reactions);
+	}
+}
+
+void Reactions::applyQueuedUpdates() {
+	if (_queuedUpdates.empty()) {
+		return;
+	}
+	for (const auto &[id, reactions] : base::take(_queuedUpdates)) {
+		if (const auto item = _owner->message(id)) {
+			item->updateReactions(&reactions);
+		}
+	}
+	_queuedUpdatesTimer.callOnce(kUpdatesBatchDelay);
+}
+
 void Reactions::updateAllInHistory(not_null<PeerData*> peer, bool enabled) {
 	if (const auto history = _owner->historyLoaded(peer)) {
 		history->reactionsEnabledChanged(enabled);
@@ -1835,6 +1954,7 @@ MessageReactions::MessageReactions(not_null<HistoryItem*> item)
 }
 
 MessageReactions::~MessageReactions() {
+	_item->history()->owner().reactions().unindexTagged(_item);
 	cancelScheduledPaid();
 	if (const auto paid = _paid.get()) {
 		if (paid->sending > 0) {
@@ -1913,6 +2033,9 @@ void MessageReactions::add(const ReactionId &id, bool addToRecent) {
 	}
 	auto &owner = history->owner();
 	owner.reactions().send(_item, addToRecent);
+	if (tags) {
+		owner.reactions().reindexTagged(_item);
+	}
 	owner.notifyItemDataChange(_item);
 }
 
@@ -1956,6 +2079,9 @@ void MessageReactions::remove(const ReactionId &id) {
 	}
 	auto &owner = history->owner();
 	owner.reactions().send(_item, false);
+	if (tags) {
+		owner.reactions().reindexTagged(_item);
+	}
 	owner.notifyItemDataChange(_item);
 }
 
@@ -2167,6 +2293,9 @@ bool MessageReactions::change(
 			changed = true;
 		}
 	}
+	if (changed && _item->reactionsAreTags()) {
+		owner.reactions().reindexTagged(_item);
+	}
 	return changed;
 }
 
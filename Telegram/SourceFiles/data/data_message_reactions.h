@@ -111,10 +111,24 @@ public:
 	void incrementMyTag(const ReactionId &id, SavedSublist *sublist);
 	void decrementMyTag(const ReactionId &id, SavedSublist *sublist);
 	void renameTag(const ReactionId &id, const QString &name);
+
+	// Local index of loaded Saved Messages by tag, so a tag filter can
+	// show results instantly while the server search is on its way.
+	void reindexTagged(not_null<HistoryItem*> item);
+	void unindexTagged(not_null<HistoryItem*> item);
+	[[nodiscard]] std::vector<MsgId> tagged(
+		const std::vector<ReactionId> &tags) const;
 	[[nodiscard]] DocumentData *chooseGenericAnimation(
 		not_null<DocumentData*> custom) const;
 	[[nodiscard]] DocumentData *choosePaidReactionAnimation() const;
 
+	// Each around-reaction effect runs its own frame decoder, which
+	// melts paint times when dozens fly at once, so the in-flight ones
+	// share a fixed pool of slots: a fly animation that couldn't take
+	// a slot plays without the effect and the mini copies.
+	[[nodiscard]] bool takeEffectAnimationSlot();
+	void releaseEffectAnimationSlot();
+
 	[[nodiscard]] rpl::producer<> topUpdates() const;
 	[[nodiscard]] rpl::producer<> recentUpdates() const;
 	[[nodiscard]] rpl::producer<> defaultUpdates() const;
@@ -141,6 +155,12 @@ public:
 
 	void poll(not_null<HistoryItem*> item, crl::time now);
 
+	// Coalesces the full-state reaction updates from the server, popular
+	// posts get them much more often than it makes sense to relayout.
+	void queueUpdate(
+		not_null<HistoryItem*> item,
+		const MTPMessageReactions &reactions);
+
 	void updateAllInHistory(not_null<PeerData*> peer, bool enabled);
 
 	void clearTemporary();
@@ -254,6 +274,7 @@ private:
 
 	void repaintCollected();
 	void pollCollected();
+	void applyQueuedUpdates();
 
 	void sendPaid();
 	bool sendPaid(not_null<HistoryItem*> item);
@@ -280,6 +301,8 @@ private:
 	base::flat_map<
 		ReactionId,
 		base::flat_set<SavedSublist*>> _unresolvedMyTags;
+	base::flat_map<ReactionId, base::flat_set<MsgId>> _taggedMessages;
+	base::flat_map<MsgId, std::vector<ReactionId>> _messageTags;
 	std::vector<Reaction> _tags;
 	std::vector<ReactionId> _tagsIds;
 	base::flat_set<ReactionId> _unresolvedTags;
@@ -349,12 +372,17 @@ private:
 	base::flat_set<not_null<HistoryItem*>> _pollingItems;
 	mtpRequestId _pollRequestId = 0;
 
+	base::flat_map<FullMsgId, MTPMessageReactions> _queuedUpdates;
+	base::Timer _queuedUpdatesTimer;
+
 	base::flat_map<not_null<HistoryItem*>, crl::time> _sendPaidItems;
 	base::flat_map<not_null<HistoryItem*>, mtpRequestId> _sendingPaid;
 	base::Timer _sendPaidTimer;
 
 	mtpRequestId _saveFaveRequestId = 0;
 
+	int _effectAnimationSlotsTaken = 0;
+
 	rpl::lifetime _lifetime;
 
 };
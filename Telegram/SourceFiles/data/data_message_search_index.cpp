@@ -0,0 +1,152 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "data/data_message_search_index.h"
+
+#include "data/data_peer.h"
+#include "data/data_session.h"
+#include "history/history.h"
+#include "history/history_item.h"
+#include "ui/text/text_entity.h"
+
+namespace Data {
+namespace {
+
+constexpr auto kMaxWordsPerItem = 64;
+
+} // namespace
+
+MessageSearchIndex::MessageSearchIndex(not_null<Session*> owner)
+: _owner(owner) {
+}
+
+MessageSearchIndex::~MessageSearchIndex() = default;
+
+void MessageSearchIndex::add(not_null<HistoryItem*> item) {
+	if (item->isService()) {
+		return;
+	}
+	const auto &text = item->originalText().text;
+	if (text.isEmpty()) {
+		return;
+	}
+	const auto itemId = item->fullId();
+	auto &stored = _wordsByItem[itemId];
+	auto count = int(stored.size());
+	for (const auto &word : TextUtilities::PrepareSearchWords(text)) {
+		if (count >= kMaxWordsPerItem) {
+			break;
+		} else if (stored.emplace(word).second) {
+			_words.emplace(word, itemId);
+			++count;
+		}
+	}
+	if (stored.empty()) {
+		_wordsByItem.remove(itemId);
+	}
+}
+
+void MessageSearchIndex::remove(not_null<HistoryItem*> item) {
+	const auto itemId = item->fullId();
+	const auto i = _wordsByItem.find(itemId);
+	if (i == _wordsByItem.cend()) {
+		return;
+	}
+	removeWords(itemId, i->second);
+	_wordsByItem.erase(i);
+}
+
+void MessageSearchIndex::update(not_null<HistoryItem*> item) {
+	remove(item);
+	add(item);
+}
+
+void MessageSearchIndex::removeWords(
+		FullMsgId itemId,
+		const base::flat_set<QString> &words) {
+	for (const auto &word : words) {
+		const auto [from, till] = _words.equal_range(word);
+		for (auto i = from; i != till; ++i) {
+			if (i->second == itemId) {
+				_words.erase(i);
+				break;
+			}
+		}
+	}
+}
+
+std::vector<not_null<HistoryItem*>> MessageSearchIndex::query(
+		const QString &text,
+		PeerData *inPeer,
+		PeerData *fromPeer,
+		int limit) const {
+	auto result = std::vector<not_null<HistoryItem*>>();
+	const auto words = TextUtilities::PrepareSearchWords(text);
+	if (words.isEmpty()) {
+		return result;
+	}
+	// Take the query word with the fewest prefix matches in the index
+	// and check the remaining words only for those few candidates.
+	auto minimalFrom = _words.end();
+	auto minimalCount = -1;
+	for (const auto &word : words) {
+		const auto from = _words.lower_bound(word);
+		auto till = from;
+		auto count = 0;
+		while (till != _words.end()
+			&& till->first.startsWith(word)
+			&& (minimalCount < 0 || count < minimalCount)) {
+			++till;
+			++count;
+		}
+		if (till == _words.end() || !till->first.startsWith(word)) {
+			if (!count) {
+				return result;
+			} else if (minimalCount < 0 || count < minimalCount) {
+				minimalFrom = from;
+				minimalCount = count;
+			}
+		}
+	}
+	Assert(minimalCount >= 0);
+	for (auto i = minimalFrom; minimalCount != 0; ++i, --minimalCount) {
+		const auto item = _owner->message(i->second);
+		if (!item) {
+			continue;
+		} else if (inPeer && item->history()->peer != inPeer) {
+			continue;
+		} else if (fromPeer && item->from() != fromPeer) {
+			continue;
+		}
+		const auto j = _wordsByItem.find(i->second);
+		Assert(j != _wordsByItem.cend());
+		const auto &stored = j->second;
+		const auto found = [&](const QString &word) {
+			const auto k = stored.lower_bound(word);
+			return (k != stored.cend()) && k->startsWith(word);
+		};
+		const auto allFound = [&] {
+			for (const auto &word : words) {
+				if (!found(word)) {
+					return false;
+				}
+			}
+			return true;
+		}();
+		if (allFound) {
+			result.push_back(item);
+		}
+	}
+	ranges::sort(result, ranges::greater(), &HistoryItem::position);
+	result.erase(ranges::unique(result), end(result));
+	if (int(result.size()) > limit) {
+		result.resize(limit);
+	}
+	return result;
+}
+
+} // namespace Data
@@ -0,0 +1,45 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+class HistoryItem;
+class PeerData;
+
+namespace Data {
+
+class Session;
+
+// An in-memory inverted index over the text of loaded messages, so
+// that history search can show local matches instantly (and work
+// offline) while the server round-trip is in flight.
+class MessageSearchIndex final {
+public:
+	explicit MessageSearchIndex(not_null<Session*> owner);
+	~MessageSearchIndex();
+
+	void add(not_null<HistoryItem*> item);
+	void remove(not_null<HistoryItem*> item);
+	void update(not_null<HistoryItem*> item);
+
+	[[nodiscard]] std::vector<not_null<HistoryItem*>> query(
+		const QString &text,
+		PeerData *inPeer,
+		PeerData *fromPeer,
+		int limit) const;
+
+private:
+	void removeWords(FullMsgId itemId, const base::flat_set<QString> &words);
+
+	const not_null<Session*> _owner;
+
+	base::flat_multi_map<QString, FullMsgId> _words;
+	base::flat_map<FullMsgId, base::flat_set<QString>> _wordsByItem;
+
+};
+
+} // namespace Data
@@ -266,8 +266,9 @@ MessagesResult MessagesList::queryFromSlice(
 	auto haveEqualOrAfter = int(end(slice.messages) - position);
 	auto before = qMin(haveBefore, query.limitBefore);
 	auto equalOrAfter = qMin(haveEqualOrAfter, query.limitAfter + 1);
-	auto ids = std::vector<MessagePosition>(position - before, position + equalOrAfter);
-	result.messageIds.merge(ids.begin(), ids.end());
+	result.messageIds = base::flat_set<MessagePosition>(
+		position - before,
+		position + equalOrAfter);
 	if (slice.range.from == MinMessagePosition) {
 		result.skippedBefore = haveBefore - before;
 	}
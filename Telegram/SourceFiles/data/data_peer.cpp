@@ -398,12 +398,46 @@ void PeerData::paintUserpic(
 		bool forceCircle) const {
 	const auto cloud = userpicCloudImage(view);
 	const auto ratio = style::DevicePixelRatio();
+	const auto forum = !forceCircle && isForum();
+
+	// Rounded frames are shared between all views showing the same
+	// userpic at the same size, so several lists with the same peer
+	// draw one implicitly-shared image (and one backend texture)
+	// instead of rasterizing a copy per row.
+	struct FrameKey {
+		InMemoryKey key;
+		int size = 0;
+		int forum = 0;
+		int palette = 0;
+
+		friend inline constexpr auto operator<=>(
+			FrameKey,
+			FrameKey) noexcept = default;
+	};
+	static constexpr auto kFramesLimit = 2048;
+	static auto Frames = base::flat_map<FrameKey, QImage>();
+
+	const auto key = FrameKey{
+		.key = userpicUniqueKey(view),
+		.size = size * ratio,
+		.forum = forum ? 1 : 0,
+		.palette = style::PaletteVersion(),
+	};
+	const auto i = Frames.find(key);
+	if (i != Frames.cend()) {
+		p.drawImage(QRect(x, y, size, size), i->second);
+		return;
+	}
 	Ui::ValidateUserpicCache(
 		view,
 		cloud,
 		cloud ? nullptr : ensureEmptyUserpic().get(),
 		size * ratio,
-		!forceCircle && isForum());
+		forum);
+	if (Frames.size() >= kFramesLimit) {
+		Frames.clear();
+	}
+	Frames.emplace(key, view.cached);
 	p.drawImage(QRect(x, y, size, size), view.cached);
 }
 
@@ -411,6 +445,10 @@ void PeerData::loadUserpic() {
 	_userpic.load(&session(), userpicOrigin());
 }
 
+void PeerData::cancelUserpicLoad() {
+	_userpic.cancel();
+}
+
 bool PeerData::hasUserpic() const {
 	return !_userpic.empty();
 }
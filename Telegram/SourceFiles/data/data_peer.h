@@ -337,6 +337,7 @@ public:
 			forceCircle);
 	}
 	void loadUserpic();
+	void cancelUserpicLoad();
 	[[nodiscard]] bool hasUserpic() const;
 	[[nodiscard]] Ui::PeerUserpicView activeUserpicView();
 	[[nodiscard]] Ui::PeerUserpicView createUserpicView();
@@ -37,7 +37,7 @@ Image *PhotoMedia::thumbnailInline() const {
 	if (!_inlineThumbnail) {
 		const auto bytes = _owner->inlineThumbnailBytes();
 		if (!bytes.isEmpty()) {
-			auto image = Images::FromInlineBytes(bytes);
+			auto image = _owner->owner().inlineThumbnail(bytes);
 			if (image.isNull()) {
 				_owner->clearInlineThumbnailBytes();
 			} else {
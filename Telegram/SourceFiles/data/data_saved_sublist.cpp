@@ -220,6 +220,15 @@ void SavedSublist::paintUserpic(
 void SavedSublist::chatListPreloadData() {
 	peer()->loadUserpic();
 	allowChatListMessageResolve();
+	if (const auto item = chatListMessage()) {
+		if (!_lastItemDialogsView.prepared(item, nullptr)) {
+			_lastItemDialogsView.prepare(
+				item,
+				nullptr,
+				[=] { updateChatListEntry(); },
+				{});
+		}
+	}
 }
 
 void SavedSublist::allowChatListMessageResolve() {
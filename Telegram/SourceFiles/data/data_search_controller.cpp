@@ -26,6 +26,57 @@ constexpr auto kDefaultSearchTimeoutMs = crl::time(200);
 
 } // namespace
 
+MTPMessagesFilter PrepareSearchFilter(Storage::SharedMediaType type) {
+	using Type = Storage::SharedMediaType;
+	switch (type) {
+	case Type::Photo:
+		return MTP_inputMessagesFilterPhotos();
+	case Type::Video:
+		return MTP_inputMessagesFilterVideo();
+	case Type::PhotoVideo:
+		return MTP_inputMessagesFilterPhotoVideo();
+	case Type::MusicFile:
+		return MTP_inputMessagesFilterMusic();
+	case Type::File:
+		return MTP_inputMessagesFilterDocument();
+	case Type::VoiceFile:
+		return MTP_inputMessagesFilterVoice();
+	case Type::RoundVoiceFile:
+		return MTP_inputMessagesFilterRoundVoice();
+	case Type::RoundFile:
+		return MTP_inputMessagesFilterRoundVideo();
+	case Type::GIF:
+		return MTP_inputMessagesFilterGif();
+	case Type::Link:
+		return MTP_inputMessagesFilterUrl();
+	case Type::ChatPhoto:
+		return MTP_inputMessagesFilterChatPhotos();
+	case Type::Pinned:
+		return MTP_inputMessagesFilterPinned();
+	}
+	return MTP_inputMessagesFilterEmpty();
+}
+
+auto SharedMediaTypeFromFilter(const MTPMessagesFilter &filter)
+-> std::optional<Storage::SharedMediaType> {
+	using Type = Storage::SharedMediaType;
+	switch (filter.type()) {
+	case mtpc_inputMessagesFilterPhotos: return Type::Photo;
+	case mtpc_inputMessagesFilterVideo: return Type::Video;
+	case mtpc_inputMessagesFilterPhotoVideo: return Type::PhotoVideo;
+	case mtpc_inputMessagesFilterMusic: return Type::MusicFile;
+	case mtpc_inputMessagesFilterDocument: return Type::File;
+	case mtpc_inputMessagesFilterVoice: return Type::VoiceFile;
+	case mtpc_inputMessagesFilterRoundVoice: return Type::RoundVoiceFile;
+	case mtpc_inputMessagesFilterRoundVideo: return Type::RoundFile;
+	case mtpc_inputMessagesFilterGif: return Type::GIF;
+	case mtpc_inputMessagesFilterUrl: return Type::Link;
+	case mtpc_inputMessagesFilterChatPhotos: return Type::ChatPhoto;
+	case mtpc_inputMessagesFilterPinned: return Type::Pinned;
+	}
+	return std::nullopt;
+}
+
 std::optional<SearchRequest> PrepareSearchRequest(
 		not_null<PeerData*> peer,
 		MsgId topicRootId,
@@ -33,36 +84,7 @@ std::optional<SearchRequest> PrepareSearchRequest(
 		const QString &query,
 		MsgId messageId,
 		Data::LoadDirection direction) {
-	const auto filter = [&] {
-		using Type = Storage::SharedMediaType;
-		switch (type) {
-		case Type::Photo:
-			return MTP_inputMessagesFilterPhotos();
-		case Type::Video:
-			return MTP_inputMessagesFilterVideo();
-		case Type::PhotoVideo:
-			return MTP_inputMessagesFilterPhotoVideo();
-		case Type::MusicFile:
-			return MTP_inputMessagesFilterMusic();
-		case Type::File:
-			return MTP_inputMessagesFilterDocument();
-		case Type::VoiceFile:
-			return MTP_inputMessagesFilterVoice();
-		case Type::RoundVoiceFile:
-			return MTP_inputMessagesFilterRoundVoice();
-		case Type::RoundFile:
-			return MTP_inputMessagesFilterRoundVideo();
-		case Type::GIF:
-			return MTP_inputMessagesFilterGif();
-		case Type::Link:
-			return MTP_inputMessagesFilterUrl();
-		case Type::ChatPhoto:
-			return MTP_inputMessagesFilterChatPhotos();
-		case Type::Pinned:
-			return MTP_inputMessagesFilterPinned();
-		}
-		return MTP_inputMessagesFilterEmpty();
-	}();
+	const auto filter = PrepareSearchFilter(type);
 	if (query.isEmpty() && filter.type() == mtpc_inputMessagesFilterEmpty) {
 		return std::nullopt;
 	}
@@ -36,6 +36,11 @@ using HistoryResult = SearchResult;
 using HistoryRequest = MTPmessages_GetHistory;
 using HistoryRequestResult = MTPmessages_Messages;
 
+[[nodiscard]] MTPMessagesFilter PrepareSearchFilter(
+	Storage::SharedMediaType type);
+[[nodiscard]] auto SharedMediaTypeFromFilter(const MTPMessagesFilter &filter)
+-> std::optional<Storage::SharedMediaType>;
+
 [[nodiscard]] std::optional<SearchRequest> PrepareSearchRequest(
 	not_null<PeerData*> peer,
 	MsgId topicRootId,
@@ -17,7 +17,9 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "api/api_user_names.h"
 #include "core/application.h"
 #include "core/core_settings.h"
+#include "core/memory_pressure.h"
 #include "core/mime_type.h" // Core::IsMimeSticker
+#include "ui/image/image.h" // Images::FromInlineBytes
 #include "ui/image/image_location_factory.h" // Images::FromPhotoSize
 #include "ui/text/format_values.h" // Ui::FormatPhone
 #include "export/export_manager.h"
@@ -31,6 +33,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "inline_bots/inline_bot_layout_item.h"
 #include "storage/storage_account.h"
 #include "storage/storage_encrypted_file.h"
+#include "storage/storage_hot_blob_cache.h"
 #include "media/player/media_player_instance.h" // instance()->play()
 #include "media/audio/media_audio.h"
 #include "boxes/abstract_box.h"
@@ -69,6 +72,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_streaming.h"
 #include "data/data_media_rotation.h"
 #include "data/data_histories.h"
+#include "data/data_message_search_index.h"
 #include "data/data_peer_values.h"
 #include "data/data_premium_limits.h"
 #include "data/data_forum.h"
@@ -84,6 +88,11 @@ namespace {
 
 using ViewElement = HistoryView::Element;
 
+constexpr auto kCollectItemsGarbageEach = 5 * 60 * crl::time(1000);
+constexpr auto kInternTextMinLength = 32;
+constexpr auto kInternedTextsLimit = 8192;
+constexpr auto kInlineThumbnailsLimit = 1024;
+
 // s: box 100x100
 // m: box 320x320
 // x: box 800x800
@@ -217,6 +226,7 @@ Session::Session(not_null<Main::Session*> session)
 , _bigFileCache(Core::App().databases().get(
 	_session->local().cacheBigFilePath(),
 	_session->local().cacheBigFileSettings()))
+, _hotBlobCache(std::make_unique<Storage::HotBlobCache>())
 , _groupFreeTranscribeLevel(session->appConfig().value(
 ) | rpl::map([limits = Data::LevelLimits(session)] {
 	return limits.groupTranscribeLevelMin();
@@ -231,6 +241,7 @@ Session::Session(not_null<Main::Session*> session)
 , _selfDestructTimer([=] { checkSelfDestructItems(); })
 , _pollsClosingTimer([=] { checkPollsClosings(); })
 , _watchForOfflineTimer([=] { checkLocalUsersWentOffline(); })
+, _itemsGarbageTimer([=] { _histories->collectGarbage(); })
 , _groups(this)
 , _chatsFilters(std::make_unique<ChatFilters>(this))
 , _cloudThemes(std::make_unique<CloudThemes>(session))
@@ -238,6 +249,7 @@ Session::Session(not_null<Main::Session*> session)
 , _streaming(std::make_unique<Streaming>(this))
 , _mediaRotation(std::make_unique<MediaRotation>())
 , _histories(std::make_unique<Histories>(this))
+, _messageSearchIndex(std::make_unique<MessageSearchIndex>(this))
 , _stickers(std::make_unique<Stickers>(this))
 , _reactions(std::make_unique<Reactions>(this))
 , _emojiStatuses(std::make_unique<EmojiStatuses>(this))
@@ -270,6 +282,11 @@ Session::Session(not_null<Main::Session*> session)
 		notifyUnreadBadgeChanged();
 	}, _lifetime);
 
+	Core::MemoryPressure(
+	) | rpl::start_with_next([=] {
+		unloadAllHeavyViewParts();
+	}, _lifetime);
+
 	_chatsFilters->changed(
 	) | rpl::start_with_next([=] {
 		const auto enabled = _chatsFilters->has();
@@ -296,6 +313,8 @@ Session::Session(not_null<Main::Session*> session)
 
 	subscribeForTopicRepliesLists();
 
+	_itemsGarbageTimer.callEach(kCollectItemsGarbageEach);
+
 	crl::on_main(_session, [=] {
 		AmPremiumValue(
 			_session
@@ -1347,6 +1366,10 @@ Storage::Cache::Database &Session::cacheBigFile() {
 	return *_bigFileCache;
 }
 
+Storage::HotBlobCache &Session::hotBlobCache() {
+	return *_hotBlobCache;
+}
+
 void Session::suggestStartExport(TimeId availableAt) {
 	_exportAvailableAt = availableAt;
 	suggestStartExport();
@@ -1825,6 +1848,7 @@ rpl::producer<not_null<HistoryItem*>> Session::itemDataChanges() const {
 }
 
 void Session::requestItemTextRefresh(not_null<HistoryItem*> item) {
+	_messageSearchIndex->update(item);
 	const auto call = [&](not_null<HistoryItem*> item) {
 		enumerateItemViews(item, [&](not_null<ViewElement*> view) {
 			view->itemTextUpdated();
@@ -1884,6 +1908,45 @@ void Session::highlightProcessDone(uint64 processId) {
 	}
 }
 
+TextWithEntities Session::internText(TextWithEntities &&text) {
+	if (text.text.size() < kInternTextMinLength) {
+		return std::move(text);
+	}
+	const auto hash = qHash(text.text);
+	const auto i = _internedTexts.find(hash);
+	if (i != end(_internedTexts)) {
+		for (const auto &interned : i->second) {
+			if (interned == text) {
+				return interned;
+			}
+		}
+	}
+	if (_internedTextsCount >= kInternedTextsLimit) {
+		// Pooled copies only pin buffers that no live item shares any
+		// longer, so just start over when the pool grows too large.
+		_internedTexts.clear();
+		_internedTextsCount = 0;
+	}
+	_internedTexts[hash].push_back(text);
+	++_internedTextsCount;
+	return std::move(text);
+}
+
+QImage Session::inlineThumbnail(const QByteArray &bytes) {
+	const auto i = _inlineThumbnails.find(bytes);
+	if (i != end(_inlineThumbnails)) {
+		return i->second;
+	}
+	auto result = Images::FromInlineBytes(bytes);
+	if (!result.isNull()) {
+		if (_inlineThumbnails.size() >= kInlineThumbnailsLimit) {
+			_inlineThumbnails.clear();
+		}
+		_inlineThumbnails.emplace(bytes, result);
+	}
+	return result;
+}
+
 void Session::requestUnreadReactionsAnimation(not_null<HistoryItem*> item) {
 	enumerateItemViews(item, [&](not_null<ViewElement*> view) {
 		view->animateUnreadReactions();
@@ -1978,6 +2041,12 @@ void Session::unregisterHeavyViewPart(not_null<ViewElement*> view) {
 	_heavyViewParts.remove(view);
 }
 
+void Session::unloadAllHeavyViewParts() {
+	for (const auto &view : base::take(_heavyViewParts)) {
+		view->unloadHeavyPart();
+	}
+}
+
 void Session::unloadHeavyViewParts(
 		not_null<HistoryView::ElementDelegate*> delegate) {
 	if (_heavyViewParts.empty()) {
@@ -2388,6 +2457,7 @@ void Session::processMessages(
 		const QVector<MTPMessage> &data,
 		NewMessageType type) {
 	auto indices = base::flat_map<uint64, int>();
+	indices.reserve(data.size());
 	for (int i = 0, l = data.size(); i != l; ++i) {
 		const auto &message = data[i];
 		if (message.type() == mtpc_message) {
@@ -2460,6 +2530,18 @@ void Session::registerMessage(not_null<HistoryItem*> item) {
 	if (!peerIsChannel(peerId) && IsServerMsgId(itemId)) {
 		_nonChannelMessages.emplace(itemId, item);
 	}
+	_messageSearchIndex->add(item);
+
+	// Resolve the dependents waiting for this message by an index walk
+	// instead of a server request round-trip per dependent.
+	const auto awaited = _awaitedDependencies.find(FullMsgId(peerId, itemId));
+	if (awaited != end(_awaitedDependencies)) {
+		const auto dependents = base::take(awaited->second);
+		_awaitedDependencies.erase(awaited);
+		for (const auto &dependent : dependents) {
+			dependent->updateDependencyItem();
+		}
+	}
 }
 
 void Session::registerMessageTTL(TimeId when, not_null<HistoryItem*> item) {
@@ -2578,6 +2660,7 @@ void Session::removeDependencyMessage(not_null<HistoryItem*> item) {
 void Session::unregisterMessage(not_null<HistoryItem*> item) {
 	const auto peerId = item->history()->peer->id;
 	const auto itemId = item->id;
+	_messageSearchIndex->remove(item);
 	_itemRemoved.fire_copy(item);
 	if (item->hasPossibleRestrictions()) {
 		_possiblyRestricted.remove(item);
@@ -2682,6 +2765,36 @@ void Session::unregisterDependentMessage(
 	}
 }
 
+bool Session::itemHasViews(not_null<const HistoryItem*> item) const {
+	return _views.find(item) != end(_views);
+}
+
+bool Session::itemHasDependents(not_null<HistoryItem*> item) const {
+	return _dependentMessages.find(item) != end(_dependentMessages);
+}
+
+void Session::registerAwaitedDependency(
+		not_null<HistoryItem*> dependent,
+		PeerId peerId,
+		MsgId msgId) {
+	if (!IsServerMsgId(msgId)) {
+		return;
+	}
+	_awaitedDependencies[FullMsgId(peerId, msgId)].emplace(dependent);
+}
+
+void Session::unregisterAwaitedDependency(
+		not_null<HistoryItem*> dependent,
+		PeerId peerId,
+		MsgId msgId) {
+	const auto i = _awaitedDependencies.find(FullMsgId(peerId, msgId));
+	if (i != end(_awaitedDependencies)) {
+		if (i->second.remove(dependent) && i->second.empty()) {
+			_awaitedDependencies.erase(i);
+		}
+	}
+}
+
 void Session::registerMessageRandomId(uint64 randomId, FullMsgId itemId) {
 	_messageByRandomId.emplace(randomId, itemId);
 }
@@ -4479,14 +4592,20 @@ void Session::refreshChatListEntry(Dialogs::Key key) {
 	if (!history) {
 		return;
 	}
-	for (const auto &filter : _chatsFilters->list()) {
+	// Filters checking the mute or the unread state all test the same
+	// badges state, so compute it once and not in each contains().
+	const auto &filters = _chatsFilters->list();
+	const auto badges = (filters.size() > 1)
+		? history->chatListBadgesState()
+		: BadgesState();
+	for (const auto &filter : filters) {
 		const auto id = filter.id();
 		if (!id) {
 			continue;
 		}
 		const auto filterList = chatsFilters().chatsList(id);
 		auto event = ChatListEntryRefresh{ .key = key, .filterId = id };
-		if (filter.contains(history)) {
+		if (filter.contains(history, badges)) {
 			event.existenceChanged = !entry->inChatList(id);
 			if (event.existenceChanged) {
 				entry->addToChatList(id, filterList);
@@ -4843,6 +4962,7 @@ rpl::producer<SentFromScheduled> Session::sentFromScheduled() const {
 }
 
 void Session::clearLocalStorage() {
+	_hotBlobCache->clear();
 	_cache->close();
 	_cache->clear();
 	_bigFileCache->close();
@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "storage/storage_databases.h"
 #include "dialogs/dialogs_main_list.h"
 #include "data/data_groups.h"
+#include "data/data_sharded_map.h"
 #include "data/data_cloud_file.h"
 #include "history/history_location_manager.h"
 #include "base/timer.h"
@@ -43,6 +44,10 @@ namespace Iv {
 class Data;
 } // namespace Iv
 
+namespace Storage {
+class HotBlobCache;
+} // namespace Storage
+
 namespace Data {
 
 class Folder;
@@ -58,6 +63,7 @@ class CloudThemes;
 class Streaming;
 class MediaRotation;
 class Histories;
+class MessageSearchIndex;
 class DocumentMedia;
 class PhotoMedia;
 class Stickers;
@@ -144,6 +150,9 @@ public:
 	[[nodiscard]] Histories &histories() const {
 		return *_histories;
 	}
+	[[nodiscard]] MessageSearchIndex &messageSearchIndex() const {
+		return *_messageSearchIndex;
+	}
 	[[nodiscard]] Stickers &stickers() const {
 		return *_stickers;
 	}
@@ -197,6 +206,7 @@ public:
 
 	[[nodiscard]] Storage::Cache::Database &cache();
 	[[nodiscard]] Storage::Cache::Database &cacheBigFile();
+	[[nodiscard]] Storage::HotBlobCache &hotBlobCache();
 
 	[[nodiscard]] not_null<PeerData*> peer(PeerId id);
 	[[nodiscard]] not_null<PeerData*> peer(UserId id) = delete;
@@ -354,8 +364,18 @@ public:
 		uint64 processId,
 		not_null<HistoryItem*> item);
 
+	// Replaces equal text payloads with one shared copy, so a message
+	// forwarded to many chats holds a single text buffer.
+	[[nodiscard]] TextWithEntities internText(TextWithEntities &&text);
+
+	// Decodes an inline thumbnail placeholder, pooling the results so
+	// that loading a list full of copies of the same media doesn't
+	// decode the same placeholder bytes over and over.
+	[[nodiscard]] QImage inlineThumbnail(const QByteArray &bytes);
+
 	void registerHeavyViewPart(not_null<ViewElement*> view);
 	void unregisterHeavyViewPart(not_null<ViewElement*> view);
+	void unloadAllHeavyViewParts();
 	void unloadHeavyViewParts(
 		not_null<HistoryView::ElementDelegate*> delegate);
 	void unloadHeavyViewParts(
@@ -484,6 +504,17 @@ public:
 	void unregisterDependentMessage(
 		not_null<HistoryItem*> dependent,
 		not_null<HistoryItem*> dependency);
+	[[nodiscard]] bool itemHasViews(not_null<const HistoryItem*> item) const;
+	[[nodiscard]] bool itemHasDependents(
+		not_null<HistoryItem*> item) const;
+	void registerAwaitedDependency(
+		not_null<HistoryItem*> dependent,
+		PeerId peerId,
+		MsgId msgId);
+	void unregisterAwaitedDependency(
+		not_null<HistoryItem*> dependent,
+		PeerId peerId,
+		MsgId msgId);
 
 	void destroyAllCallItems();
 
@@ -947,6 +978,7 @@ private:
 
 	Storage::DatabasePointer _cache;
 	Storage::DatabasePointer _bigFileCache;
+	const std::unique_ptr<Storage::HotBlobCache> _hotBlobCache;
 
 	TimeId _exportAvailableAt = 0;
 	QPointer<Ui::BoxContent> _exportSuggestion;
@@ -991,14 +1023,17 @@ private:
 	Dialogs::IndexedList _contactsNoChatsList;
 
 	MsgId _localMessageIdCounter = StartClientMsgId;
-	std::unordered_map<PeerId, Messages> _messages;
+	ShardedMap<PeerId, Messages> _messages;
 	std::map<
 		not_null<HistoryItem*>,
 		base::flat_set<not_null<HistoryItem*>>> _dependentMessages;
+	base::flat_map<
+		FullMsgId,
+		base::flat_set<not_null<HistoryItem*>>> _awaitedDependencies;
 	std::map<TimeId, base::flat_set<not_null<HistoryItem*>>> _ttlMessages;
 	base::Timer _ttlCheckTimer;
 
-	std::unordered_map<MsgId, not_null<HistoryItem*>> _nonChannelMessages;
+	ShardedMap<MsgId, not_null<HistoryItem*>> _nonChannelMessages;
 
 	base::flat_map<uint64, FullMsgId> _messageByRandomId;
 	base::flat_map<uint64, SentData> _sentMessagesData;
@@ -1058,6 +1093,11 @@ private:
 	base::flat_map<uint64, not_null<HistoryItem*>> _highlightings;
 	base::flat_map<QString, not_null<DocumentData*>> _venueIcons;
 
+	base::flat_map<size_t, std::vector<TextWithEntities>> _internedTexts;
+	int _internedTextsCount = 0;
+
+	base::flat_map<QByteArray, QImage> _inlineThumbnails;
+
 	base::flat_set<not_null<WebPageData*>> _webpagesUpdated;
 	base::flat_set<not_null<GameData*>> _gamesUpdated;
 	base::flat_set<not_null<PollData*>> _pollsUpdated;
@@ -1097,7 +1137,7 @@ private:
 
 	History *_topPromoted = nullptr;
 
-	std::unordered_map<PeerId, std::unique_ptr<PeerData>> _peers;
+	ShardedMap<PeerId, std::unique_ptr<PeerData>> _peers;
 
 	MessageIdsList _mimeForwardIds;
 
@@ -1113,6 +1153,7 @@ private:
 
 	base::flat_map<not_null<UserData*>, TimeId> _watchingForOffline;
 	base::Timer _watchForOfflineTimer;
+	base::Timer _itemsGarbageTimer;
 
 	base::flat_map<not_null<PeerData*>, MTP::DcId> _peerStatsDcIds;
 
@@ -1130,6 +1171,7 @@ private:
 	const std::unique_ptr<Streaming> _streaming;
 	const std::unique_ptr<MediaRotation> _mediaRotation;
 	const std::unique_ptr<Histories> _histories;
+	const std::unique_ptr<MessageSearchIndex> _messageSearchIndex;
 	const std::unique_ptr<Stickers> _stickers;
 	const std::unique_ptr<Reactions> _reactions;
 	const std::unique_ptr<EmojiStatuses> _emojiStatuses;
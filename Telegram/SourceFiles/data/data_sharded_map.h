@@ -0,0 +1,195 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <unordered_map>
+
+namespace Data {
+
+// Owner maps in Data::Session may hold tens of thousands of entries for
+// large workspaces. A single flat hash map makes every lookup touch one
+// huge table and every rehash stall the main thread, so we shard by key
+// hash: each lookup works with a small cache-friendly table and rehashes
+// during bulk insertion stay local to one shard.
+template <
+	typename Key,
+	typename Value,
+	int kShardCount = 64,
+	typename Hash = std::hash<Key>>
+class ShardedMap final {
+	static_assert(kShardCount > 0 && !(kShardCount & (kShardCount - 1)));
+
+public:
+	using Shard = std::unordered_map<Key, Value, Hash>;
+	using ShardIterator = typename Shard::iterator;
+	using value_type = typename Shard::value_type;
+
+	class iterator {
+	public:
+		iterator() = default;
+		iterator(ShardedMap *that, int shard, ShardIterator inner)
+		: _that(that)
+		, _shard(shard)
+		, _inner(inner) {
+		}
+
+		[[nodiscard]] value_type &operator*() const {
+			return *_inner;
+		}
+		[[nodiscard]] value_type *operator->() const {
+			return &*_inner;
+		}
+		iterator &operator++() {
+			++_inner;
+			skipEmpty();
+			return *this;
+		}
+		[[nodiscard]] bool operator==(const iterator &other) const {
+			return (_shard == other._shard)
+				&& (_shard == kShardCount || _inner == other._inner);
+		}
+		[[nodiscard]] bool operator!=(const iterator &other) const {
+			return !(*this == other);
+		}
+
+	private:
+		void skipEmpty() {
+			while (_shard < kShardCount
+				&& _inner == _that->_shards[_shard].end()) {
+				if (++_shard < kShardCount) {
+					_inner = _that->_shards[_shard].begin();
+				}
+			}
+		}
+
+		ShardedMap *_that = nullptr;
+		int _shard = kShardCount;
+		ShardIterator _inner;
+
+		friend class ShardedMap;
+
+	};
+	using const_iterator = iterator;
+
+	[[nodiscard]] iterator begin() {
+		auto result = iterator(this, 0, _shards[0].begin());
+		result.skipEmpty();
+		return result;
+	}
+	[[nodiscard]] iterator end() {
+		return iterator(this, kShardCount, ShardIterator());
+	}
+	[[nodiscard]] iterator begin() const {
+		return const_cast<ShardedMap*>(this)->begin();
+	}
+	[[nodiscard]] iterator end() const {
+		return const_cast<ShardedMap*>(this)->end();
+	}
+	[[nodiscard]] iterator cend() const {
+		return end();
+	}
+
+	[[nodiscard]] iterator find(const Key &key) {
+		const auto shard = shardIndex(key);
+		const auto i = _shards[shard].find(key);
+		return (i == _shards[shard].end())
+			? end()
+			: iterator(this, shard, i);
+	}
+	[[nodiscard]] iterator find(const Key &key) const {
+		return const_cast<ShardedMap*>(this)->find(key);
+	}
+
+	template <typename ...Args>
+	std::pair<iterator, bool> emplace(const Key &key, Args &&...args) {
+		const auto shard = shardIndex(key);
+		const auto result = _shards[shard].emplace(
+			key,
+			std::forward<Args>(args)...);
+		return { iterator(this, shard, result.first), result.second };
+	}
+
+	[[nodiscard]] Value &operator[](const Key &key) {
+		return _shards[shardIndex(key)][key];
+	}
+
+	size_t erase(const Key &key) {
+		return _shards[shardIndex(key)].erase(key);
+	}
+
+	iterator erase(iterator i) {
+		Expects(i._shard < kShardCount);
+
+		auto result = iterator(
+			this,
+			i._shard,
+			_shards[i._shard].erase(i._inner));
+		result.skipEmpty();
+		return result;
+	}
+
+	void clear() {
+		for (auto &shard : _shards) {
+			shard.clear();
+		}
+	}
+
+	[[nodiscard]] bool empty() const {
+		for (const auto &shard : _shards) {
+			if (!shard.empty()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	[[nodiscard]] size_t size() const {
+		auto result = size_t(0);
+		for (const auto &shard : _shards) {
+			result += shard.size();
+		}
+		return result;
+	}
+
+private:
+	[[nodiscard]] static int shardIndex(const Key &key) {
+		// The inner tables use the same Hash and may take it modulo a
+		// power-of-two bucket count (MSVC does), consuming the low bits,
+		// so the shard is chosen by the high bits of a multiplicative
+		// remix of the hash - picking it from the low bits directly
+		// would leave most buckets of every shard permanently empty.
+		if constexpr (kShardCount == 1) {
+			return 0;
+		}
+		constexpr auto kShardBits = std::bit_width(
+			std::uint32_t(kShardCount)) - 1;
+		const auto remixed = std::uint64_t(Hash()(key))
+			* 0x9E3779B97F4A7C15ULL;
+		return int(remixed >> (64 - kShardBits));
+	}
+
+	std::array<Shard, kShardCount> _shards;
+
+};
+
+template <typename Key, typename Value, int kShardCount, typename Hash>
+[[nodiscard]] inline auto begin(
+		const ShardedMap<Key, Value, kShardCount, Hash> &map) {
+	return map.begin();
+}
+
+template <typename Key, typename Value, int kShardCount, typename Hash>
+[[nodiscard]] inline auto end(
+		const ShardedMap<Key, Value, kShardCount, Hash> &map) {
+	return map.end();
+}
+
+} // namespace Data
@@ -39,6 +39,11 @@ constexpr auto kSavedFirstPerPage = 30;
 constexpr auto kSavedPerPage = 100;
 constexpr auto kMaxPreloadSources = 10;
 constexpr auto kStillPreloadFromFirst = 3;
+
+// Viewer ids come ordered by distance from the shown story, this is
+// how many of the closest ones are kept buffered in parallel. Each one
+// costs at most the streaming preload prefix while in flight.
+constexpr auto kViewerPreloadRing = 4;
 constexpr auto kMaxSegmentsCount = 180;
 constexpr auto kPollingIntervalChat = 5 * TimeId(60);
 constexpr auto kPollingIntervalViewer = 1 * TimeId(60);
@@ -466,6 +471,7 @@ Story *Stories::parseAndApply(
 		}
 		if (mediaChanged) {
 			_preloaded.remove(fullId);
+			_preloadingViewer.remove(fullId);
 			if (_preloading && _preloading->id() == fullId) {
 				_preloading = nullptr;
 				rebuildPreloadSources(StorySourcesList::NotHidden);
@@ -822,6 +828,7 @@ void Stories::applyDeleted(not_null<PeerData*> peer, StoryId id) {
 					}
 				}
 			}
+			_preloadingViewer.remove(fullId);
 			if (_preloading && _preloading->id() == fullId) {
 				_preloading = nullptr;
 				preloadFinished(fullId);
@@ -1962,7 +1969,7 @@ void Stories::setPreloadingInViewer(std::vector<FullStoryId> ids) {
 	}), end(ids));
 	if (_toPreloadViewer != ids) {
 		_toPreloadViewer = std::move(ids);
-		continuePreloading();
+		updateViewerPreloads();
 	}
 }
 
@@ -2181,7 +2188,7 @@ void Stories::continuePreloading() {
 		_preloading = nullptr;
 	}
 	const auto id = nextPreloadId();
-	if (!id) {
+	if (!id || _preloadingViewer.contains(id)) {
 		return;
 	} else if (const auto maybeStory = lookup(id)) {
 		startPreloading(*maybeStory);
@@ -2190,7 +2197,6 @@ void Stories::continuePreloading() {
 
 bool Stories::shouldContinuePreload(FullStoryId id) const {
 	const auto first = ranges::views::concat(
-		_toPreloadViewer,
 		_toPreloadSources[static_cast<int>(StorySourcesList::Hidden)],
 		_toPreloadSources[static_cast<int>(StorySourcesList::NotHidden)]
 	) | ranges::views::take(kStillPreloadFromFirst);
@@ -2200,9 +2206,7 @@ bool Stories::shouldContinuePreload(FullStoryId id) const {
 FullStoryId Stories::nextPreloadId() const {
 	const auto hidden = static_cast<int>(StorySourcesList::Hidden);
 	const auto main = static_cast<int>(StorySourcesList::NotHidden);
-	const auto result = !_toPreloadViewer.empty()
-		? _toPreloadViewer.front()
-		: !_toPreloadSources[hidden].empty()
+	const auto result = !_toPreloadSources[hidden].empty()
 		? _toPreloadSources[hidden].front()
 		: !_toPreloadSources[main].empty()
 		? _toPreloadSources[main].front()
@@ -2212,6 +2216,44 @@ FullStoryId Stories::nextPreloadId() const {
 	return result;
 }
 
+void Stories::updateViewerPreloads() {
+	// _toPreloadViewer is ordered by distance from the shown story, so
+	// the buffered ring is just its first entries: in-flight preloads
+	// that fell out of that window are dropped and the freed slots go
+	// to the closest stories that aren't buffered yet.
+	const auto ring = std::vector<FullStoryId>(
+		begin(_toPreloadViewer),
+		begin(_toPreloadViewer) + std::min(
+			int(_toPreloadViewer.size()),
+			kViewerPreloadRing));
+	for (auto i = begin(_preloadingViewer); i != end(_preloadingViewer);) {
+		if (ranges::contains(ring, i->first)) {
+			++i;
+		} else {
+			i = _preloadingViewer.erase(i);
+		}
+	}
+	// A preload may finish synchronously and erase its id from
+	// _toPreloadViewer, that is why the ring ids are snapshotted above.
+	for (const auto &id : ring) {
+		if (_preloadingViewer.contains(id)
+			|| (_preloading && _preloading->id() == id)) {
+			continue;
+		}
+		const auto maybeStory = lookup(id);
+		if (!maybeStory) {
+			continue;
+		}
+		auto preloading = std::make_unique<StoryPreload>(*maybeStory, [=] {
+			_preloadingViewer.remove(id);
+			preloadFinished(id, true);
+		});
+		if (!_preloaded.contains(id)) {
+			_preloadingViewer.emplace(id, std::move(preloading));
+		}
+	}
+}
+
 void Stories::startPreloading(not_null<Story*> story) {
 	Expects(!_preloaded.contains(story->fullId()));
 
@@ -2237,6 +2279,7 @@ void Stories::preloadFinished(FullStoryId id, bool markAsPreloaded) {
 	}
 	crl::on_main(this, [=] {
 		continuePreloading();
+		updateViewerPreloads();
 	});
 }
 
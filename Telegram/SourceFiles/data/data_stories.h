@@ -312,6 +312,7 @@ private:
 	[[nodiscard]] FullStoryId nextPreloadId() const;
 	void startPreloading(not_null<Story*> story);
 	void preloadFinished(FullStoryId id, bool markAsPreloaded = false);
+	void updateViewerPreloads();
 	void preloadListsMore();
 
 	void notifySourcesChanged(StorySourcesList list);
@@ -401,6 +402,9 @@ private:
 	std::vector<FullStoryId> _toPreloadSources[kStorySourcesListCount];
 	std::vector<FullStoryId> _toPreloadViewer;
 	std::unique_ptr<StoryPreload> _preloading;
+	base::flat_map<
+		FullStoryId,
+		std::unique_ptr<StoryPreload>> _preloadingViewer;
 	int _preloadingHiddenSourcesCounter = 0;
 	int _preloadingMainSourcesCounter = 0;
 
@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history.h"
 #include "history/history_item.h"
 #include "history/history_unread_things.h"
+#include "history/view/history_view_item_preview.h"
 #include "main/main_session.h"
 
 namespace Data {
@@ -44,6 +45,24 @@ const PeerNotifySettings &Thread::notify() const {
 	return const_cast<Thread*>(this)->notify();
 }
 
+void Thread::preloadLastItemDialogsView() {
+	const auto item = chatListMessage();
+	if (!item) {
+		return;
+	}
+	// Shape the preview and name while the row is still outside the
+	// visible area, so scrolling to it doesn't lay out text in paint.
+	const auto forum = asHistory() ? peer()->forum() : nullptr;
+	if (!_lastItemDialogsView.prepared(item, forum)) {
+		_lastItemDialogsView.prepare(
+			item,
+			forum,
+			[=] { updateChatListEntry(); },
+			{});
+	}
+	[[maybe_unused]] const auto &name = chatListNameText();
+}
+
 void Thread::setUnreadThingsKnown() {
 	_flags |= Flag::UnreadThingsKnown;
 }
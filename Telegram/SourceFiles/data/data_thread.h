@@ -110,6 +110,7 @@ public:
 	[[nodiscard]] Dialogs::Ui::MessageView &lastItemDialogsView() {
 		return _lastItemDialogsView;
 	}
+	void preloadLastItemDialogsView();
 
 	[[nodiscard]] virtual auto sendActionPainter()
 		-> not_null<HistoryView::SendActionPainter*> = 0;
@@ -22,6 +22,8 @@ constexpr auto kAudioAlbumThumbCacheTag = 0x0000000000000300ULL;
 constexpr auto kWebDocumentCacheTag = 0x0000020000000000ULL;
 constexpr auto kUrlCacheTag = 0x0000030000000000ULL;
 constexpr auto kGeoPointCacheTag = 0x0000040000000000ULL;
+constexpr auto kWebPagePreviewCacheTag = 0x0000050000000000ULL;
+constexpr auto kDownloadPartialCacheTag = 0x0000060000000000ULL;
 
 } // namespace
 
@@ -74,6 +76,47 @@ Storage::Cache::Key UrlCacheKey(const QString &location) {
 	};
 }
 
+Storage::Cache::Key WebPagePreviewCacheKey(const QString &url) {
+	const auto bytes = url.toUtf8();
+	const auto hash = openssl::Sha256(bytes::make_span(bytes));
+	const auto span = bytes::make_span(hash);
+	const auto bytes1 = span.subspan(0, sizeof(uint32));
+	const auto bytes2 = span.subspan(sizeof(uint32), sizeof(uint64));
+	const auto bytes3 = span.subspan(
+		sizeof(uint32) + sizeof(uint64),
+		sizeof(uint16));
+	const auto part1 = *reinterpret_cast<const uint32*>(bytes1.data());
+	const auto part2 = *reinterpret_cast<const uint64*>(bytes2.data());
+	const auto part3 = *reinterpret_cast<const uint16*>(bytes3.data());
+	return Storage::Cache::Key{
+		Data::kWebPagePreviewCacheTag | (uint64(part3) << 32) | part1,
+		part2
+	};
+}
+
+Storage::Cache::Key DownloadPartialCacheKey(const Storage::Cache::Key &key) {
+	// Records of partially downloaded files live in their own namespace,
+	// derived from the full file key by hashing - the file key namespaces
+	// may use any bits of the key, so there is no place for an added tag.
+	auto salted = QByteArray("partial:");
+	salted.append(reinterpret_cast<const char*>(&key.high), sizeof(uint64));
+	salted.append(reinterpret_cast<const char*>(&key.low), sizeof(uint64));
+	const auto hash = openssl::Sha256(bytes::make_span(salted));
+	const auto span = bytes::make_span(hash);
+	const auto bytes1 = span.subspan(0, sizeof(uint32));
+	const auto bytes2 = span.subspan(sizeof(uint32), sizeof(uint64));
+	const auto bytes3 = span.subspan(
+		sizeof(uint32) + sizeof(uint64),
+		sizeof(uint16));
+	const auto part1 = *reinterpret_cast<const uint32*>(bytes1.data());
+	const auto part2 = *reinterpret_cast<const uint64*>(bytes2.data());
+	const auto part3 = *reinterpret_cast<const uint16*>(bytes3.data());
+	return Storage::Cache::Key{
+		Data::kDownloadPartialCacheTag | (uint64(part3) << 32) | part1,
+		part2
+	};
+}
+
 Storage::Cache::Key GeoPointCacheKey(const GeoPointLocation &location) {
 	const auto zoomscale = ((uint32(location.zoom) & 0x0FU) << 8)
 		| (uint32(location.scale) & 0x0FU);
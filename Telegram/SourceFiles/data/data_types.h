@@ -48,6 +48,8 @@ Storage::Cache::Key DocumentCacheKey(int32 dcId, uint64 id);
 Storage::Cache::Key DocumentThumbCacheKey(int32 dcId, uint64 id);
 Storage::Cache::Key WebDocumentCacheKey(const WebFileLocation &location);
 Storage::Cache::Key UrlCacheKey(const QString &location);
+Storage::Cache::Key WebPagePreviewCacheKey(const QString &url);
+Storage::Cache::Key DownloadPartialCacheKey(const Storage::Cache::Key &key);
 Storage::Cache::Key GeoPointCacheKey(const GeoPointLocation &location);
 Storage::Cache::Key AudioAlbumThumbCacheKey(
 	const AudioAlbumThumbLocation &location);
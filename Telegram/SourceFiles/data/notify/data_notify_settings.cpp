@@ -333,6 +333,7 @@ void NotifySettings::updateLocal(not_null<Thread*> thread) {
 }
 
 void NotifySettings::updateLocal(not_null<PeerData*> peer) {
+	_mutedCache.erase(peer);
 	const auto history = _owner->historyLoaded(peer->id);
 	auto changesIn = crl::time(0);
 	const auto muted = isMuted(peer, &changesIn);
@@ -397,6 +398,10 @@ void NotifySettings::cacheSound(const std::optional<NotifySound> &sound) {
 void NotifySettings::updateLocal(DefaultNotify type) {
 	defaultValue(type).updates.fire({});
 
+	// The defaults feed the cached decisions of all peers of this type,
+	// including the ones the enumeration below doesn't visit.
+	_mutedCache.clear();
+
 	const auto goodForUpdate = [&](
 			not_null<const PeerData*> peer,
 			const PeerNotifySettings &settings) {
@@ -513,6 +518,17 @@ bool NotifySettings::soundUnknown(not_null<const Thread*> thread) const {
 bool NotifySettings::isMuted(
 		not_null<const PeerData*> peer,
 		crl::time *changesIn) const {
+	if (!changesIn) {
+		const auto now = crl::now();
+		const auto i = _mutedCache.find(peer);
+		if (i != end(_mutedCache) && now < i->second.checkAfter) {
+			return i->second.muted;
+		}
+		auto changes = kMaxNotifyCheckDelay;
+		const auto muted = isMuted(peer, &changes);
+		_mutedCache[peer] = { muted, now + changes };
+		return muted;
+	}
 	if (const auto until = peer->notify().muteUntil()) {
 		return MutedFromUntil(*until, changesIn);
 	} else if (const auto until = defaultSettings(peer).muteUntil()) {
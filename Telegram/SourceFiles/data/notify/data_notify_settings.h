@@ -122,6 +122,10 @@ private:
 		PeerNotifySettings settings;
 		rpl::event_stream<> updates;
 	};
+	struct MutedCached {
+		bool muted = false;
+		crl::time checkAfter = 0;
+	};
 
 	void cacheSound(const std::optional<NotifySound> &sound);
 
@@ -152,6 +156,14 @@ private:
 	const not_null<Session*> _owner;
 
 	DefaultValue _defaultValues[3];
+
+	// Cached effective mute decisions, so that processing an updates
+	// burst looks the answer up instead of walking the peer settings
+	// and the defaults for each message.
+	mutable std::unordered_map<
+		not_null<const PeerData*>,
+		MutedCached> _mutedCache;
+
 	std::unordered_set<not_null<const PeerData*>> _mutedPeers;
 	std::unordered_map<not_null<ForumTopic*>, rpl::lifetime> _mutedTopics;
 	base::Timer _unmuteByFinishedTimer;
@@ -858,15 +858,11 @@ void CustomEmojiManager::repaintLater(
 		not_null<Ui::CustomEmoji::Instance*> instance,
 		Ui::CustomEmoji::RepaintRequest request) {
 	auto &bunch = _repaints[request.duration];
+	if (!bunch.queued.emplace(instance).second) {
+		// Still waiting for full bunch repaint, don't bump.
+		return;
+	}
 	if (bunch.when < request.when) {
-		if (bunch.when > 0) {
-			for (const auto &already : bunch.instances) {
-				if (already.get() == instance) {
-					// Still waiting for full bunch repaint, don't bump.
-					return;
-				}
-			}
-		}
 		bunch.when = request.when;
 #if 0 // inject-to-on_main
 		_repaintsLastAdded = request.when;
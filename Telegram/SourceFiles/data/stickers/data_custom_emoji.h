@@ -111,6 +111,11 @@ private:
 	struct RepaintBunch {
 		crl::time when = 0;
 		std::vector<base::weak_ptr<Ui::CustomEmoji::Instance>> instances;
+
+		// Membership index for the list above, so that a request from
+		// an already queued instance is recognized in O(log n) instead
+		// of a linear scan through all instances waiting for this tick.
+		base::flat_set<not_null<Ui::CustomEmoji::Instance*>> queued;
 	};
 	struct LoaderWithSetId {
 		std::unique_ptr<Ui::CustomEmoji::Loader> loader;
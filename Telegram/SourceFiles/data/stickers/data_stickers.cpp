@@ -148,9 +148,52 @@ Main::Session &Stickers::session() const {
 }
 
 void Stickers::notifyUpdated(StickersType type) {
+	if (_batchFeed) {
+		_batchFeed->updated.emplace(type);
+		return;
+	}
 	_updated.fire_copy(type);
 }
 
+void Stickers::startBatchFeed() {
+	if (!_batchFeed) {
+		_batchFeed = std::make_unique<BatchFeedState>();
+	}
+}
+
+void Stickers::finishBatchFeed() {
+	if (!_batchFeed) {
+		return;
+	}
+	const auto state = base::take(_batchFeed);
+	for (const auto type : state->installedWrites) {
+		if (type == StickersType::Emoji) {
+			session().local().writeInstalledCustomEmoji();
+		} else if (type == StickersType::Masks) {
+			session().local().writeInstalledMasks();
+		} else {
+			session().local().writeInstalledStickers();
+		}
+	}
+	for (const auto type : state->featuredWrites) {
+		if (type == StickersType::Emoji) {
+			session().local().writeFeaturedCustomEmoji();
+		} else if (type == StickersType::Stickers) {
+			session().local().writeFeaturedStickers();
+		}
+	}
+	for (const auto type : state->archivedWrites) {
+		if (type == StickersType::Masks) {
+			session().local().writeArchivedMasks();
+		} else if (type == StickersType::Stickers) {
+			session().local().writeArchivedStickers();
+		}
+	}
+	for (const auto type : state->updated) {
+		notifyUpdated(type);
+	}
+}
+
 rpl::producer<StickersType> Stickers::updated() const {
 	return _updated.events();
 }
@@ -282,7 +325,7 @@ void Stickers::incrementSticker(not_null<DocumentData*> document) {
 	}
 
 	if (writeOldRecent) {
-		session().saveSettings();
+		session().saveSettingsDelayed();
 	}
 
 	// Remove that sticker from custom stickers, now it is in cloud recent stickers.
@@ -304,7 +347,7 @@ void Stickers::incrementSticker(not_null<DocumentData*> document) {
 		session().local().writeInstalledStickers();
 	}
 	if (writeRecentStickers) {
-		session().local().writeRecentStickers();
+		session().local().writeRecentStickersDelayed();
 	}
 	notifyRecentUpdated(StickersType::Stickers);
 }
@@ -785,6 +828,36 @@ void Stickers::somethingReceived(
 	}
 
 	notifyUpdated(type);
+
+	if (type == StickersType::Stickers) {
+		prefetchSetThumbnails();
+	}
+}
+
+void Stickers::prefetchSetThumbnails() {
+	if (_setThumbnailsPrefetched) {
+		return;
+	}
+	_setThumbnailsPrefetched = true;
+
+	// Load the footer strip thumbnails of the installed sets into the
+	// local cache right away, so the first sticker panel open doesn't
+	// start with a screenful of download placeholders.
+	const auto &sets = this->sets();
+	for (const auto setId : setsOrder()) {
+		const auto i = sets.find(setId);
+		if (i == sets.cend()) {
+			continue;
+		}
+		const auto set = i->second.get();
+		if (set->hasThumbnail()) {
+			set->loadThumbnail();
+		} else if (const auto document = set->lookupThumbnailDocument()) {
+			if (document->hasThumbnail()) {
+				document->loadThumbnail(document->stickerSetOrigin());
+			}
+		}
+	}
 }
 
 void Stickers::setPackAndEmoji(
@@ -1723,7 +1796,9 @@ void Stickers::feedSetStickers(
 
 	const auto isArchived = !!(set->flags & SetFlag::Archived);
 	if ((set->flags & SetFlag::Installed) && !isArchived) {
-		if (isEmoji) {
+		if (_batchFeed) {
+			_batchFeed->installedWrites.emplace(set->type());
+		} else if (isEmoji) {
 			session().local().writeInstalledCustomEmoji();
 		} else if (isMasks) {
 			session().local().writeInstalledMasks();
@@ -1732,7 +1807,9 @@ void Stickers::feedSetStickers(
 		}
 	}
 	if (set->flags & SetFlag::Featured) {
-		if (isEmoji) {
+		if (_batchFeed) {
+			_batchFeed->featuredWrites.emplace(set->type());
+		} else if (isEmoji) {
 			session().local().writeFeaturedCustomEmoji();
 		} else if (isMasks) {
 		} else {
@@ -1740,7 +1817,9 @@ void Stickers::feedSetStickers(
 		}
 	}
 	if (wasArchived != isArchived) {
-		if (isEmoji) {
+		if (_batchFeed) {
+			_batchFeed->archivedWrites.emplace(set->type());
+		} else if (isEmoji) {
 		} else if (isMasks) {
 			session().local().writeArchivedMasks();
 		} else {
@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
+#include "base/flat_set.h"
 #include "mtproto/sender.h"
 #include "data/stickers/data_stickers_set.h"
 #include "settings.h"
@@ -68,6 +69,14 @@ public:
 	void notifyUpdated(StickersType type);
 	[[nodiscard]] rpl::producer<StickersType> updated() const;
 	[[nodiscard]] rpl::producer<> updated(StickersType type) const;
+
+	// Coalesces the disk writes and update notifications from a series
+	// of feedSetFull() calls, e.g. while syncing all the installed sets
+	// after a fresh login, into one write and one notification of each
+	// kind when the batch is finished.
+	void startBatchFeed();
+	void finishBatchFeed();
+
 	void notifyRecentUpdated(StickersType type);
 	[[nodiscard]] rpl::producer<StickersType> recentUpdated() const;
 	[[nodiscard]] rpl::producer<> recentUpdated(StickersType type) const;
@@ -261,6 +270,13 @@ public:
 	[[nodiscard]] RecentStickerPack &getRecentPack() const;
 
 private:
+	struct BatchFeedState {
+		base::flat_set<StickersType> updated;
+		base::flat_set<StickersType> installedWrites;
+		base::flat_set<StickersType> featuredWrites;
+		base::flat_set<StickersType> archivedWrites;
+	};
+
 	[[nodiscard]] bool updateNeeded(crl::time last, crl::time now) const {
 		constexpr auto kUpdateTimeout = crl::time(3600'000);
 		return (last == 0) || (now >= last + kUpdateTimeout);
@@ -292,6 +308,7 @@ private:
 		const QVector<MTPStickerSet> &list,
 		uint64 hash,
 		StickersType type);
+	void prefetchSetThumbnails();
 	void featuredReceived(
 		const MTPDmessages_featuredStickers &data,
 		StickersType type);
@@ -321,6 +338,8 @@ private:
 	StickersSetsOrder _archivedSetsOrder;
 	StickersSetsOrder _archivedMaskSetsOrder;
 	SavedGifs _savedGifs;
+	std::unique_ptr<BatchFeedState> _batchFeed;
+	bool _setThumbnailsPrefetched = false;
 
 };
 
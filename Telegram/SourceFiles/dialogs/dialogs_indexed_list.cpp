@@ -33,6 +33,7 @@ RowsByLetter IndexedList::addToEnd(Key key) {
 		}
 		result.letters.emplace(ch, j->second.addToEnd(key));
 	}
+	addNameWords(key);
 	return result;
 }
 
@@ -49,6 +50,7 @@ Row *IndexedList::addByName(Key key) {
 		}
 		j->second.addByName(key);
 	}
+	addNameWords(key);
 	return result;
 }
 
@@ -154,6 +156,7 @@ void IndexedList::adjustByName(
 			j->second.addByName(key);
 		}
 	}
+	updateNameWords(key);
 }
 
 void IndexedList::adjustNames(
@@ -192,6 +195,7 @@ void IndexedList::adjustNames(
 			history->addChatListEntryByLetter(filterId, ch, row);
 		}
 	}
+	updateNameWords(key);
 }
 
 void IndexedList::remove(Key key, Row *replacedBy) {
@@ -201,40 +205,108 @@ void IndexedList::remove(Key key, Row *replacedBy) {
 				it->second.remove(key, replacedBy);
 			}
 		}
+		removeNameWords(key);
 	}
 }
 
 void IndexedList::clear() {
 	_list.clear();
 	_index.clear();
+	_words.clear();
+	_wordsByKey.clear();
 }
 
-std::vector<not_null<Row*>> IndexedList::filtered(
-		const QStringList &words) const {
-	const auto minimal = [&]() -> const Dialogs::List* {
-		if (empty()) {
-			return nullptr;
+void IndexedList::addNameWords(Key key) {
+	auto &stored = _wordsByKey[key];
+	for (const auto &word : key.entry()->chatListNameWords()) {
+		if (stored.emplace(word).second) {
+			_words.emplace(word, key);
 		}
-		auto result = (const Dialogs::List*)nullptr;
-		for (const auto &word : words) {
-			if (word.isEmpty()) {
-				continue;
+	}
+}
+
+void IndexedList::removeNameWords(Key key) {
+	const auto i = _wordsByKey.find(key);
+	if (i == _wordsByKey.cend()) {
+		return;
+	}
+	for (const auto &word : i->second) {
+		const auto [from, till] = _words.equal_range(word);
+		for (auto j = from; j != till; ++j) {
+			if (j->second == key) {
+				_words.erase(j);
+				break;
 			}
-			const auto found = filtered(word[0]);
-			if (!found || found->empty()) {
-				return nullptr;
-			} else if (!result || result->size() > found->size()) {
-				result = found;
+		}
+	}
+	_wordsByKey.erase(i);
+}
+
+void IndexedList::updateNameWords(Key key) {
+	const auto &now = key.entry()->chatListNameWords();
+	auto &stored = _wordsByKey[key];
+	for (auto i = stored.begin(); i != stored.end();) {
+		if (now.contains(*i)) {
+			++i;
+			continue;
+		}
+		const auto [from, till] = _words.equal_range(*i);
+		for (auto j = from; j != till; ++j) {
+			if (j->second == key) {
+				_words.erase(j);
+				break;
 			}
 		}
-		return result;
-	}();
+		i = stored.erase(i);
+	}
+	for (const auto &word : now) {
+		if (stored.emplace(word).second) {
+			_words.emplace(word, key);
+		}
+	}
+}
+
+std::vector<not_null<Row*>> IndexedList::filtered(
+		const QStringList &words) const {
 	auto result = std::vector<not_null<Row*>>();
-	if (!minimal || minimal->empty()) {
+	if (empty()) {
 		return result;
 	}
-	result.reserve(minimal->size());
-	for (const auto &row : *minimal) {
+	// Take the query word with the fewest prefix matches in the index
+	// and check the remaining words only for those few candidates.
+	auto minimalFrom = _words.end();
+	auto minimalCount = -1;
+	for (const auto &word : words) {
+		if (word.isEmpty()) {
+			continue;
+		}
+		const auto from = _words.lower_bound(word);
+		auto till = from;
+		auto count = 0;
+		while (till != _words.end()
+			&& till->first.startsWith(word)
+			&& (minimalCount < 0 || count < minimalCount)) {
+			++till;
+			++count;
+		}
+		if (till == _words.end() || !till->first.startsWith(word)) {
+			if (!count) {
+				return result;
+			} else if (minimalCount < 0 || count < minimalCount) {
+				minimalFrom = from;
+				minimalCount = count;
+			}
+		}
+	}
+	if (minimalCount < 0) {
+		return result;
+	}
+	result.reserve(minimalCount);
+	for (auto i = minimalFrom; minimalCount != 0; ++i, --minimalCount) {
+		const auto row = _list.getRow(i->second);
+		if (!row) {
+			continue;
+		}
 		const auto &nameWords = row->entry()->chatListNameWords();
 		const auto found = [&](const QString &word) {
 			for (const auto &name : nameWords) {
@@ -256,6 +328,8 @@ std::vector<not_null<Row*>> IndexedList::filtered(
 			result.push_back(row);
 		}
 	}
+	ranges::sort(result, ranges::less(), &Row::index);
+	result.erase(ranges::unique(result), end(result));
 	return result;
 }
 
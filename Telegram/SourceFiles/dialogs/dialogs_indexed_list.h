@@ -93,11 +93,20 @@ private:
 		not_null<History*> history,
 		const base::flat_set<QChar> &oldChars);
 
+	void addNameWords(Key key);
+	void removeNameWords(Key key);
+	void updateNameWords(Key key);
+
 	SortMode _sortMode = SortMode();
 	FilterId _filterId = 0;
 	List _list, _empty;
 	base::flat_map<QChar, List> _index;
 
+	// Sorted index of all chat name words for prefix search,
+	// with a copy of the indexed words per key for updates.
+	base::flat_multi_map<QString, Key> _words;
+	base::flat_map<Key, base::flat_set<QString>> _wordsByKey;
+
 };
 
 } // namespace Dialogs
@@ -20,6 +20,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history.h"
 #include "history/history_item.h"
 #include "core/application.h"
+#include "core/frame_profiler.h"
 #include "core/click_handler_types.h"
 #include "core/shortcuts.h"
 #include "ui/widgets/buttons.h"
@@ -89,6 +90,8 @@ constexpr auto kHashtagResultsLimit = 5;
 constexpr auto kStartReorderThreshold = 30;
 constexpr auto kQueryPreviewLimit = 32;
 constexpr auto kPreviewPostsLimit = 3;
+constexpr auto kPreloadOnHoverDelay = crl::time(100);
+constexpr auto kAnimationsPauseAfterScroll = crl::time(200);
 
 [[nodiscard]] InnerWidget::ChatsFilterTagsKey SerializeFilterTagsKey(
 		FilterId filterId,
@@ -234,6 +237,8 @@ InnerWidget::InnerWidget(
 , _controller(controller)
 , _shownList(controller->session().data().chatsList()->indexed())
 , _st(&st::defaultDialogRow)
+, _preloadOnHoverTimer([=] { preloadSelectedHistory(); })
+, _resumeRowAnimationsTimer([=] { update(); })
 , _pinnedShiftAnimation([=](crl::time now) {
 	return pinnedShiftAnimationCallback(now);
 })
@@ -279,7 +284,9 @@ InnerWidget::InnerWidget(
 	}, lifetime());
 
 	session().data().sendActionManager().animationUpdated(
-	) | rpl::start_with_next([=](
+	) | rpl::filter([=] {
+		return !_controller->widget()->framesHidden();
+	}) | rpl::start_with_next([=](
 			const Data::SendActionManager::AnimationUpdate &update) {
 		const auto updateRect = Ui::RowPainter::SendActionAnimationRect(
 			_st,
@@ -295,7 +302,9 @@ InnerWidget::InnerWidget(
 	}, lifetime());
 
 	session().data().sendActionManager().speakingAnimationUpdated(
-	) | rpl::start_with_next([=](not_null<History*> history) {
+	) | rpl::filter([=] {
+		return !_controller->widget()->framesHidden();
+	}) | rpl::start_with_next([=](not_null<History*> history) {
 		repaintDialogRowCornerStatus(history);
 	}, lifetime());
 
@@ -757,6 +766,8 @@ void InnerWidget::showSavedSublists() {
 }
 
 void InnerWidget::paintEvent(QPaintEvent *e) {
+	const auto marker = Core::FrameMarker("DialogsInner::paint");
+
 	Painter p(this);
 
 	p.setInactive(
@@ -765,12 +776,19 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 		return;
 	}
 	const auto activeEntry = _controller->activeChatEntryCurrent();
-	const auto videoPaused = _controller->isGifPausedAtLeastFor(
-		Window::GifPauseReason::Any);
+	const auto ms = crl::now();
+
+	// While the list is being scrolled the rows repaint on every frame
+	// anyway, ticking animated userpics and emoji statuses on top of
+	// that only adds rasterization work. Show their static frames and
+	// resume the animations when the scroll settles.
+	const auto scrolling = (_lastScrollTime > 0)
+		&& (ms < _lastScrollTime + kAnimationsPauseAfterScroll);
+	const auto videoPaused = scrolling
+		|| _controller->isGifPausedAtLeastFor(Window::GifPauseReason::Any);
 	auto fullWidth = width();
 	const auto r = e->rect();
 	auto dialogsClip = r;
-	const auto ms = crl::now();
 	const auto childListShown = _childListShown.current();
 	auto context = Ui::PaintContext{
 		.st = _st,
@@ -879,7 +897,48 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 		context.topicJumpSelected = selected
 			&& _selectedTopicJump
 			&& (!_pressed || _pressedTopicJump);
-		Ui::RowPainter::Paint(p, row, validateVideoUserpic(row), context);
+
+		// Rows without frame-by-frame animated content are painted
+		// into a per-row cache and invalidated by damage events, so
+		// scrolling repaints blit the cached pixels instead of
+		// laying out userpic, name, preview and badges every frame.
+		const auto videoUserpic = validateVideoUserpic(row);
+		if (videoUserpic || expanding || row->hasRipple()) {
+			Ui::RowPainter::Paint(p, row, videoUserpic, context);
+			return;
+		}
+		const auto key = [&] {
+			auto result = uint64(0xcbf29ce484222325ULL);
+			const auto mix = [&](uint64 value) {
+				result = (result ^ value) * 0x100000001b3ULL;
+			};
+			mix(uint64(uint32(context.width)));
+			mix(uint64(uint32(_filterId)));
+			mix(uint64(uint32(style::PaletteVersion())));
+			mix(uint64(reinterpret_cast<uintptr_t>(context.st)));
+			mix(uint64(chatsFilterTags.size()));
+			mix((context.active ? 1 : 0)
+				| (context.selected ? 2 : 0)
+				| (context.topicJumpSelected ? 4 : 0)
+				| (context.narrow ? 8 : 0)
+				| (context.rightButton ? 16 : 0));
+			return result ? result : 1;
+		}();
+		const auto ratio = style::DevicePixelRatio();
+		const auto size = QSize(fullWidth, row->height()) * ratio;
+		auto &cache = row->paintCache();
+		if (row->paintCacheKey() != key || cache.size() != size) {
+			if (cache.size() != size) {
+				cache = QImage(size, QImage::Format_ARGB32_Premultiplied);
+				cache.setDevicePixelRatio(ratio);
+			}
+			cache.fill(Qt::transparent);
+			auto q = Painter(&cache);
+			q.setInactive(videoPaused);
+			Ui::RowPainter::Paint(q, row, videoUserpic, context);
+			row->setPaintCacheKey(key);
+		}
+		p.drawImage(0, 0, cache);
 	};
 	if (_state == WidgetState::Default) {
 		const auto collapsedSkip = collapsedRowsOffset();
@@ -1615,6 +1674,17 @@ void InnerWidget::clearIrrelevantState() {
 	}
 }
 
+void InnerWidget::preloadSelectedHistory() {
+	if (_state != WidgetState::Default || !_selected) {
+		return;
+	}
+	const auto history = _selected->history();
+	if (!history || history->peer->isForum()) {
+		return;
+	}
+	session().data().histories().preload(history);
+}
+
 bool InnerWidget::lookupIsInBotAppButton(
 		Row *row,
 		QPoint localPosition) {
@@ -1685,6 +1755,14 @@ void InnerWidget::selectByMouse(QPoint globalPosition) {
 			|| _selectedTopicJump != selectedTopicJump
 			|| _selectedBotApp != selectedBotApp) {
 			updateSelectedRow();
+			if (_selected != selected) {
+				session().data().histories().cancelPreload();
+				if (selected && selected->history()) {
+					_preloadOnHoverTimer.callOnce(kPreloadOnHoverDelay);
+				} else {
+					_preloadOnHoverTimer.cancel();
+				}
+			}
 			_selected = selected;
 			_selectedTopicJump = selectedTopicJump;
 			_selectedBotApp = selectedBotApp;
@@ -2529,6 +2607,7 @@ int InnerWidget::defaultRowTop(not_null<Row*> row) const {
 void InnerWidget::repaintDialogRow(
 		FilterId filterId,
 		not_null<Row*> row) {
+	row->invalidatePaintCache();
 	if (_state == WidgetState::Default) {
 		if (_filterId == filterId) {
 			if (const auto folder = row->folder()) {
@@ -2541,6 +2620,7 @@ void InnerWidget::repaintDialogRow(
 			for (auto i = 0, l = int(_filterResults.size()); i != l; ++i) {
 				const auto &result = _filterResults[i];
 				if (result.key() == row->key()) {
+					result.row->invalidatePaintCache();
 					update(
 						0,
 						filteredOffset() + result.top,
@@ -2615,6 +2695,7 @@ void InnerWidget::updateDialogRow(
 				repaintCollapsedFolderRow(folder);
 			}
 			if (const auto dialog = _shownList->getRow(row.key)) {
+				dialog->invalidatePaintCache();
 				const auto position = dialog->index();
 				auto top = dialogsOffset();
 				if (base::in_range(position, 0, _pinnedRows.size())) {
@@ -2628,6 +2709,7 @@ void InnerWidget::updateDialogRow(
 			&& !_filterResults.empty()) {
 			for (const auto &result : _filterResults) {
 				if (result.key() == row.key) {
+					result.row->invalidatePaintCache();
 					updateRow(
 						filteredOffset() + result.top,
 						result.row->height());
@@ -2772,6 +2854,7 @@ void InnerWidget::clearSelection() {
 	_mouseSelection = false;
 	_lastMousePosition = std::nullopt;
 	_lastRowLocalMouseX = -1;
+	_preloadOnHoverTimer.cancel();
 	if (isSelected()) {
 		updateSelectedRow();
 		_collapsedSelected = -1;
@@ -3390,6 +3473,10 @@ rpl::producer<> InnerWidget::refreshHashtagsRequests() const {
 void InnerWidget::visibleTopBottomUpdated(
 		int visibleTop,
 		int visibleBottom) {
+	if (_visibleTop != visibleTop) {
+		_lastScrollTime = crl::now();
+		_resumeRowAnimationsTimer.callOnce(kAnimationsPauseAfterScroll);
+	}
 	_visibleTop = visibleTop;
 	_visibleBottom = visibleBottom;
 	preloadRowsData();
@@ -285,6 +285,7 @@ private:
 	void processGlobalForceClick(QPoint globalPosition);
 	void clearIrrelevantState();
 	void selectByMouse(QPoint globalPosition);
+	void preloadSelectedHistory();
 	void preloadRowsData();
 	void scrollToItem(int top, int height);
 	void scrollToDefaultSelected();
@@ -492,6 +493,9 @@ private:
 	bool _skipTopDialog = false;
 	Row *_selected = nullptr;
 	Row *_pressed = nullptr;
+	base::Timer _preloadOnHoverTimer;
+	base::Timer _resumeRowAnimationsTimer;
+	crl::time _lastScrollTime = 0;
 	MsgId _pressedTopicJumpRootId;
 	bool _selectedTopicJump = false;
 	bool _pressedTopicJump = false;
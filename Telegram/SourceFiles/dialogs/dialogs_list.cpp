@@ -34,6 +34,7 @@ not_null<Row*> List::addToEnd(Key key) {
 	).first->second.get();
 	result->recountHeight(_narrowRatio, _filterId);
 	_rows.emplace_back(result);
+	_sortKeys.push_back(result->sortKey(_filterId));
 	if (_sortMode == SortMode::Date) {
 		adjustByDate(result);
 	}
@@ -86,19 +87,21 @@ void List::adjustByDate(not_null<Row*> row) {
 
 	const auto key = row->sortKey(_filterId);
 	const auto index = row->index();
-	const auto i = _rows.begin() + index;
-	const auto before = std::find_if(i + 1, _rows.end(), [&](Row *row) {
-		return (row->sortKey(_filterId) <= key);
+	_sortKeys[index] = key;
+	const auto i = _sortKeys.begin() + index;
+	const auto before = std::find_if(i + 1, _sortKeys.end(), [&](uint64 k) {
+		return (k <= key);
 	});
+	const auto rows = _rows.begin() + index;
 	if (before != i + 1) {
-		rotate(i, i + 1, before);
+		rotate(rows, rows + 1, rows + (before - i));
 	} else {
 		const auto from = std::make_reverse_iterator(i);
-		const auto after = std::find_if(from, _rows.rend(), [&](Row *row) {
-			return (row->sortKey(_filterId) >= key);
+		const auto after = std::find_if(from, _sortKeys.rend(), [&](uint64 k) {
+			return (k >= key);
 		}).base();
 		if (after != i) {
-			rotate(after, i, i + 1);
+			rotate(rows - (i - after), rows, rows + 1);
 		}
 	}
 }
@@ -153,6 +156,13 @@ void List::rotate(
 	auto top = (*first)->top();
 	std::rotate(first, middle, last);
 
+	const auto keys = _sortKeys.begin();
+	const auto base = _rows.begin();
+	std::rotate(
+		keys + (first - base),
+		keys + (middle - base),
+		keys + (last - base));
+
 	auto count = (last - first);
 	auto index = (first - _rows.begin());
 	while (count--) {
@@ -175,6 +185,7 @@ bool List::remove(Key key, Row *replacedBy) {
 	auto top = row->top();
 	const auto index = row->index();
 	_rows.erase(_rows.begin() + index);
+	_sortKeys.erase(_sortKeys.begin() + index);
 	for (auto i = index, count = int(_rows.size()); i != count; ++i) {
 		const auto row = _rows[i];
 		row->_index = i;
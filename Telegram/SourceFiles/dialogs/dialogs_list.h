@@ -25,6 +25,7 @@ public:
 
 	void clear() {
 		_rows.clear();
+		_sortKeys.clear();
 		_rowByKey.clear();
 	}
 	[[nodiscard]] int size() const {
@@ -83,6 +84,12 @@ private:
 	FilterId _filterId = 0;
 	float64 _narrowRatio = 0.;
 	std::vector<not_null<Row*>> _rows;
+
+	// Plain copies of _rows sort keys, kept in sync with _rows, so that
+	// adjustByDate scans contiguous memory instead of dereferencing each
+	// Row and its Entry on every comparison.
+	std::vector<uint64> _sortKeys;
+
 	std::map<Key, std::unique_ptr<Row>> _rowByKey;
 
 };
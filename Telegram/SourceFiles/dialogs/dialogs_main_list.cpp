@@ -167,6 +167,15 @@ void MainList::updateCloudUnread(const MTPDdialogFolder &data) {
 	_cloudUnreadState.known = true;
 }
 
+void MainList::setCloudUnreadState(const UnreadState &state) {
+	const auto notifier = unreadStateChangeNotifier(!loaded());
+
+	// Unlike updateCloudUnread() this gets a fully known state, so no
+	// finalizeCloudUnread() adjustments are needed.
+	_cloudUnreadState = state;
+	_cloudUnreadState.known = true;
+}
+
 bool MainList::cloudUnreadKnown() const {
 	return _cloudUnreadState.known;
 }
@@ -42,6 +42,7 @@ public:
 		const UnreadState &nowState);
 	void unreadEntryChanged(const UnreadState &state, bool added);
 	void updateCloudUnread(const MTPDdialogFolder &data);
+	void setCloudUnreadState(const UnreadState &state);
 	[[nodiscard]] bool cloudUnreadKnown() const;
 	[[nodiscard]] UnreadState unreadState() const;
 	[[nodiscard]] rpl::producer<UnreadState> unreadStateChanges() const;
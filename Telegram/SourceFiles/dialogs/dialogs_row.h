@@ -72,6 +72,9 @@ public:
 	[[nodiscard]] Ui::PeerUserpicView &userpicView() const {
 		return _userpic;
 	}
+	[[nodiscard]] bool hasRipple() const {
+		return _ripple != nullptr;
+	}
 
 private:
 	mutable Ui::PeerUserpicView _userpic;
@@ -145,6 +148,21 @@ public:
 	}
 	[[nodiscard]] uint64 sortKey(FilterId filterId) const;
 
+	// Cached rasterization of the painted row, see the damage-tracked
+	// paint path in InnerWidget::paintEvent. A zero key means invalid.
+	[[nodiscard]] QImage &paintCache() const {
+		return _paintCache;
+	}
+	[[nodiscard]] uint64 paintCacheKey() const {
+		return _paintCacheKey;
+	}
+	void setPaintCacheKey(uint64 key) const {
+		_paintCacheKey = key;
+	}
+	void invalidatePaintCache() const {
+		_paintCacheKey = 0;
+	}
+
 	// for any attached data, for example View in contacts list
 	void *attached = nullptr;
 
@@ -200,6 +218,8 @@ private:
 
 	Key _id;
 	mutable std::unique_ptr<CornerBadgeUserpic> _cornerBadgeUserpic;
+	mutable QImage _paintCache;
+	mutable uint64 _paintCacheKey = 0;
 	int _top = 0;
 	int _height = 0;
 	uint32 _index : 30 = 0;
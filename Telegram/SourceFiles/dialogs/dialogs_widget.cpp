@@ -68,6 +68,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_forum.h"
 #include "data/data_forum_topic.h"
 #include "data/data_histories.h"
+#include "data/data_message_search_index.h"
 #include "data/data_changes.h"
 #include "data/data_download_manager.h"
 #include "data/data_chat_filters.h"
@@ -2242,6 +2243,22 @@ bool Widget::search(bool inCache, SearchRequestDelay delay) {
 		process->full = false;
 		_migratedProcess.full = false;
 		cancelSearchRequest();
+		if (_searchQueryTags.empty() && !_searchQuery.isEmpty()) {
+			// Show instant results from the local message index, the
+			// server response will replace them when (if) it arrives.
+			auto local = session().data().messageSearchIndex().query(
+				_searchQuery,
+				inPeer,
+				_searchQueryFrom,
+				kSearchPerPage);
+			if (const auto count = int(local.size())) {
+				_inner->searchReceived(
+					std::move(local),
+					nullptr,
+					fromStartType,
+					count);
+			}
+		}
 		if (inPeer) {
 			const auto topic = searchInTopic();
 			auto &histories = session().data().histories();
@@ -2231,6 +2231,10 @@ void ApiWrap::filePartDone(int64 offset, const MTPupload_File &result) {
 		}
 	}
 
+	if (const auto result = _fileProcess->file.flush(); !result) {
+		ioError(result);
+		return;
+	}
 	auto process = base::take(_fileProcess);
 	const auto relativePath = process->relativePath;
 	_fileCache->save(process->location, relativePath);
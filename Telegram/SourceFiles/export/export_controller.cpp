@@ -20,6 +20,8 @@ namespace {
 
 const auto kNullStateCallback = [](ProcessingState&) {};
 
+constexpr auto kProcessingStateEach = crl::time(100);
+
 Settings NormalizeSettings(const Settings &settings) {
 	if (!settings.onlySinglePeer()) {
 		return base::duplicate(settings);
@@ -122,6 +124,7 @@ private:
 	// rpl::variable<State> fails to compile in MSVC :(
 	State _state;
 	rpl::event_stream<State> _stateChanges;
+	crl::time _lastProcessingFired = 0;
 
 	Output::Stats _stats;
 
@@ -184,6 +187,21 @@ void ControllerObject::setState(State &&state) {
 	if (stopped()) {
 		return;
 	}
+	// Progress arrives for every downloaded file part and every written
+	// messages batch, don't marshal each one to the main thread - within
+	// a step 10 Hz is enough for the UI, step changes pass right away.
+	const auto now = std::get_if<ProcessingState>(&state);
+	const auto was = std::get_if<ProcessingState>(&_state);
+	if (now && was && now->step == was->step) {
+		const auto time = crl::now();
+		if (time - _lastProcessingFired < kProcessingStateEach) {
+			_state = std::move(state);
+			return;
+		}
+		_lastProcessingFired = time;
+	} else if (now) {
+		_lastProcessingFired = crl::now();
+	}
 	_state = std::move(state);
 	_stateChanges.fire_copy(_state);
 }
@@ -18,16 +18,25 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace Export {
 namespace Output {
+namespace {
+
+constexpr auto kWriteBufferSize = 512 * 1024;
+
+} // namespace
 
 File::File(const QString &path, Stats *stats) : _path(path), _stats(stats) {
 }
 
+File::~File() {
+	(void)flush();
+}
+
 int64 File::size() const {
-	return _offset;
+	return _offset + _buffer.size();
 }
 
 bool File::empty() const {
-	return !_offset;
+	return !_offset && _buffer.isEmpty();
 }
 
 Result File::writeBlock(const QByteArray &block) {
@@ -43,18 +52,39 @@ Result File::writeBlockAttempt(const QByteArray &block) {
 		_inStats = true;
 		_stats->incrementFiles();
 	}
+	const auto size = block.size();
+	if (size) {
+		_buffer.append(block);
+		if (_stats) {
+			_stats->incrementBytes(size);
+		}
+	}
+	// An empty block is a request to create the file, so flush right away.
+	if (!size || _buffer.size() >= kWriteBufferSize) {
+		return flush();
+	}
+	return Result::Success();
+}
+
+Result File::flush() {
+	const auto result = flushAttempt();
+	if (!result) {
+		_file.reset();
+	}
+	return result;
+}
+
+Result File::flushAttempt() {
 	if (const auto result = reopen(); !result) {
 		return result;
 	}
-	const auto size = block.size();
+	const auto size = _buffer.size();
 	if (!size) {
 		return Result::Success();
 	}
-	if (_file->write(block) == size && _file->flush()) {
+	if (_file->write(_buffer) == size && _file->flush()) {
 		_offset += size;
-		if (_stats) {
-			_stats->incrementBytes(size);
-		}
+		_buffer.clear();
 		return Result::Success();
 	}
 	return error();
@@ -133,7 +163,11 @@ Result File::Copy(
 	if (bytes.size() != f.size()) {
 		return Result(Result::Type::FatalError, source);
 	}
-	return File(path, stats).writeBlock(bytes);
+	auto file = File(path, stats);
+	if (const auto result = file.writeBlock(bytes); !result) {
+		return result;
+	}
+	return file.flush();
 }
 
 } // namespace Output
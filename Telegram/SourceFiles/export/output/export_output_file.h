@@ -22,11 +22,13 @@ class Stats;
 class File {
 public:
 	File(const QString &path, Stats *stats);
+	~File();
 
 	[[nodiscard]] int64 size() const;
 	[[nodiscard]] bool empty() const;
 
 	[[nodiscard]] Result writeBlock(const QByteArray &block);
+	[[nodiscard]] Result flush();
 
 	[[nodiscard]] static QString PrepareRelativePath(
 		const QString &folder,
@@ -40,12 +42,14 @@ public:
 private:
 	[[nodiscard]] Result reopen();
 	[[nodiscard]] Result writeBlockAttempt(const QByteArray &block);
+	[[nodiscard]] Result flushAttempt();
 
 	[[nodiscard]] Result error() const;
 	[[nodiscard]] Result fatalError() const;
 
 	QString _path;
 	int64 _offset = 0;
+	QByteArray _buffer;
 	std::optional<QFile> _file;
 
 	Stats *_stats = nullptr;
@@ -23,16 +23,39 @@ namespace {
 
 using Context = details::JsonContext;
 
+[[nodiscard]] constexpr bool SerializeStringCheck(char ch) {
+	// 0xE2 starts the line / paragraph separators that need escaping.
+	return (ch == '"')
+		|| (ch == '\\')
+		|| (ch == char(0xE2))
+		|| (ch >= 0 && ch < 32);
+}
+
 QByteArray SerializeString(const QByteArray &value) {
 	const auto size = value.size();
 	const auto begin = value.data();
 	const auto end = begin + size;
 
 	auto result = QByteArray();
-	result.reserve(2 + size * 4);
+	result.reserve(2 + size + (size / 8));
 	result.append('"');
+
+	// Almost all of the text doesn't need escaping, so instead of
+	// appending char-by-char the clean runs between escapes are copied
+	// whole, letting memcpy do the bulk of the work.
+	auto from = begin;
+	const auto flush = [&](const char *till) {
+		if (till > from) {
+			result.append(from, till - from);
+		}
+	};
 	for (auto p = begin; p != end; ++p) {
 		const auto ch = *p;
+		if (!SerializeStringCheck(ch)) {
+			continue;
+		}
+		flush(p);
+		from = p + 1;
 		if (ch == '\n') {
 			result.append("\\n", 2);
 		} else if (ch == '\r') {
@@ -51,20 +74,23 @@ QByteArray SerializeString(const QByteArray &value) {
 			} else {
 				result.append('0' + left);
 			}
-		} else if (ch == char(0xE2)
-			&& (p + 2 < end)
-			&& *(p + 1) == char(0x80)) {
+		} else if ((p + 2 < end) && *(p + 1) == char(0x80)) {
 			if (*(p + 2) == char(0xA8)) { // Line separator.
 				result.append("\\u2028", 6);
+				p += 2;
+				from = p + 1;
 			} else if (*(p + 2) == char(0xA9)) { // Paragraph separator.
 				result.append("\\u2029", 6);
+				p += 2;
+				from = p + 1;
 			} else {
-				result.append(ch);
+				from = p; // A plain 0xE2 byte, keep it in the run.
 			}
 		} else {
-			result.append(ch);
+			from = p;
 		}
 	}
+	flush(end);
 	result.append('"');
 	return result;
 }
@@ -1571,11 +1597,14 @@ Result JsonWriter::finish() {
 
 	if (_settings.onlySinglePeer()) {
 		Assert(_context.nesting.empty());
-		return Result::Success();
+		return _output->flush();
 	}
 	auto block = popNesting();
 	Assert(_context.nesting.empty());
-	return _output->writeBlock(block);
+	if (const auto result = _output->writeBlock(block); !result) {
+		return result;
+	}
+	return _output->flush();
 }
 
 QString JsonWriter::mainFilePath() {
@@ -33,6 +33,9 @@ extern "C" {
 #define DA_FFMPEG_HAVE_DURATION (LIBAVUTIL_VERSION_INT >= \
 	AV_VERSION_INT(58, 02, 100))
 
+#define DA_FFMPEG_HAVE_INDEX_ENTRIES (LIBAVFORMAT_VERSION_INT >= \
+	AV_VERSION_INT(58, 79, 100))
+
 class QImage;
 
 namespace FFmpeg {
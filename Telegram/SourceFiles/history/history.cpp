@@ -658,10 +658,12 @@ not_null<HistoryItem*> History::addNewItem(
 	}
 
 	if (!loadedAtBottom() || peer->migrateTo()) {
+		const auto previous = _lastMessage.value_or(nullptr);
 		setLastMessage(item);
 		if (unread) {
 			newItemAdded(item);
 		}
+		destroyStaleLastMessage(previous);
 	} else {
 		addNewToBack(item, unread);
 		checkForLoadedAtTop(item);
@@ -2328,6 +2330,7 @@ const base::flat_set<QChar> &History::chatListFirstLetters() const {
 void History::chatListPreloadData() {
 	peer->loadUserpic();
 	allowChatListMessageResolve();
+	preloadLastItemDialogsView();
 }
 
 void History::paintUserpic(
@@ -2487,6 +2490,24 @@ void History::setLastMessage(HistoryItem *item) {
 	}
 }
 
+void History::destroyStaleLastMessage(HistoryItem *previous) {
+	// Update-fed messages of a muted broadcast that isn't loaded at the
+	// bottom only ever flash by as the replaced last message, they are
+	// never displayed. Without this check they accumulate one full
+	// HistoryItem per post in every background channel till restart.
+	if (!previous
+		|| (_lastMessage && *_lastMessage == previous)
+		|| (_chatListMessage && *_chatListMessage == previous)
+		|| previous->mainView()
+		|| !previous->isRegular()
+		|| previous->isPinned()) {
+		return;
+	} else if (!peer->isBroadcast() || !muted()) {
+		return;
+	}
+	previous->destroy();
+}
+
 void History::refreshChatListMessage() {
 	const auto known = chatListMessageKnown();
 	setChatListMessageFromLast();
@@ -3059,9 +3080,82 @@ void History::resizeToWidth(int newWidth) {
 	int y = 0;
 	for (const auto &block : blocks) {
 		block->setY(y);
+		block->setPendingResize(false);
 		y += block->resizeGetHeight(newWidth, request);
 	}
 	_height = y;
+	_hasPendingResizeSlices = _pendingResizeSlicesReinit = false;
+}
+
+void History::resizeToWidthIncremental(
+		int newWidth,
+		int visibleTop,
+		int visibleBottom) {
+	using Request = HistoryBlock::ResizeRequest;
+	const auto request = (_flags & Flag::PendingAllItemsResize)
+		? Request::ReinitAll
+		: (_width != newWidth)
+		? Request::ResizeAll
+		: Request::ResizePending;
+	if (request == Request::ResizePending) {
+		// Touches only the items flagged for resize, cheap enough
+		// to perform synchronously.
+		resizeToWidth(newWidth);
+		return;
+	}
+	_flags &= ~(Flag::HasPendingResizedItems | Flag::PendingAllItemsResize);
+
+	_width = newWidth;
+	_pendingResizeSlicesReinit = _pendingResizeSlicesReinit
+		|| (request == Request::ReinitAll);
+	int y = 0;
+	for (const auto &block : blocks) {
+		const auto wasY = block->y();
+		const auto wasHeight = block->height();
+		block->setY(y);
+		if ((wasY < visibleBottom) && (wasY + wasHeight > visibleTop)) {
+			block->setPendingResize(false);
+			y += block->resizeGetHeight(newWidth, request);
+		} else {
+			// Keep the old height as an estimate, the block is
+			// reflowed later in resizeSlice().
+			block->setPendingResize(true);
+			_hasPendingResizeSlices = true;
+			y += wasHeight;
+		}
+	}
+	_height = y;
+}
+
+bool History::hasPendingResizeSlices() const {
+	return _hasPendingResizeSlices;
+}
+
+bool History::resizeSlice(crl::time deadline) {
+	using Request = HistoryBlock::ResizeRequest;
+	if (!_hasPendingResizeSlices) {
+		return false;
+	}
+	const auto request = _pendingResizeSlicesReinit
+		? Request::ReinitAll
+		: Request::ResizeAll;
+	int y = 0;
+	auto more = false;
+	for (const auto &block : blocks) {
+		block->setY(y);
+		if (block->pendingResize() && crl::now() < deadline) {
+			block->setPendingResize(false);
+			y += block->resizeGetHeight(_width, request);
+		} else {
+			more = more || block->pendingResize();
+			y += block->height();
+		}
+	}
+	_height = y;
+	if (!more) {
+		_hasPendingResizeSlices = _pendingResizeSlicesReinit = false;
+	}
+	return more;
 }
 
 void History::forceFullResize() {
@@ -3517,6 +3611,56 @@ void History::clearUpTill(MsgId availableMinId) {
 	requestChatListMessage();
 }
 
+void History::collectGarbage() {
+	// Items were kept alive till an explicit history clear, so the set
+	// grew without bound from updates, search and media results in chats
+	// that may never have been opened. Destroy detached items nothing
+	// references, in two passes, so each one survives at least one full
+	// sweep interval and can be re-requested from the server on access.
+	const auto chatsListItem = chatListMessage();
+	const auto last = lastMessage();
+	auto candidates = base::flat_set<MsgId>();
+	auto remove = std::vector<not_null<HistoryItem*>>();
+	for (const auto &item : _items) {
+		if (!item->isRegular()
+			|| (item.get() == last)
+			|| (item.get() == chatsListItem)
+			|| item->mainView()
+			|| item->isPinned()
+			|| item->isUnreadMention()
+			|| item->hasUnreadReaction()
+			|| owner().itemHasViews(item.get())
+			|| owner().itemHasDependents(item.get())) {
+			continue;
+		} else if (const auto topic = item->topic()) {
+			if (item.get() == topic->lastMessage()
+				|| item.get() == topic->chatListMessage()) {
+				continue;
+			}
+		}
+		if (const auto group = owner().groups().find(item.get())) {
+			// An album is displayed by the view of its leading item, so
+			// any shown part protects all the parts of the group.
+			const auto shown = ranges::any_of(group->items, [&](
+					not_null<HistoryItem*> part) {
+				return part->mainView() || owner().itemHasViews(part);
+			});
+			if (shown) {
+				continue;
+			}
+		}
+		if (_garbageCandidates.contains(item->id)) {
+			remove.push_back(item.get());
+		} else {
+			candidates.emplace(item->id);
+		}
+	}
+	_garbageCandidates = std::move(candidates);
+	for (const auto item : remove) {
+		item->destroy();
+	}
+}
+
 void History::applyGroupAdminChanges(const base::flat_set<UserId> &changes) {
 	for (const auto &block : blocks) {
 		for (const auto &message : block->messages) {
@@ -126,6 +126,7 @@ public:
 	};
 	void clear(ClearType type);
 	void clearUpTill(MsgId availableMinId);
+	void collectGarbage();
 
 	void applyGroupAdminChanges(const base::flat_set<UserId> &changes);
 
@@ -281,6 +282,18 @@ public:
 	HistoryItem *lastEditableMessage() const;
 
 	void resizeToWidth(int newWidth);
+
+	// Incremental relayout: resize only the blocks intersecting the
+	// visible range right away, mark the rest dirty and reflow them
+	// later in resizeSlice() calls with a time budget.
+	void resizeToWidthIncremental(
+		int newWidth,
+		int visibleTop,
+		int visibleBottom);
+	[[nodiscard]] bool hasPendingResizeSlices() const;
+	// Returns true while dirty blocks remain after the deadline.
+	bool resizeSlice(crl::time deadline);
+
 	void forceFullResize();
 	int height() const;
 
@@ -534,6 +547,7 @@ private:
 	// After adding a new history slice check lastMessage / loadedAtBottom.
 	void checkLastMessage();
 	void setLastMessage(HistoryItem *item);
+	void destroyStaleLastMessage(HistoryItem *previous);
 	void setLastServerMessage(HistoryItem *item);
 
 	void refreshChatListMessage();
@@ -589,6 +603,8 @@ private:
 	HistoryItem *_joinedMessage = nullptr;
 	bool _loadedAtTop = false;
 	bool _loadedAtBottom = true;
+	bool _hasPendingResizeSlices = false;
+	bool _pendingResizeSlicesReinit = false;
 
 	std::optional<Data::Folder*> _folder;
 
@@ -599,6 +615,7 @@ private:
 	std::optional<HistoryItem*> _lastServerMessage;
 	base::flat_set<not_null<HistoryItem*>> _clientSideMessages;
 	std::unordered_set<std::unique_ptr<HistoryItem>> _items;
+	base::flat_set<MsgId> _garbageCandidates;
 
 	std::unique_ptr<Data::HistoryMessages> _messages;
 
@@ -662,6 +679,12 @@ public:
 	int height() const {
 		return _height;
 	}
+	bool pendingResize() const {
+		return _pendingResize;
+	}
+	void setPendingResize(bool pending) {
+		_pendingResize = pending;
+	}
 	not_null<History*> history() const {
 		return _history;
 	}
@@ -697,5 +720,6 @@ protected:
 	int _y = 0;
 	int _height = 0;
 	int _indexInHistory = -1;
+	bool _pendingResize = false;
 
 };
@@ -72,6 +72,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "menu/menu_item_download_files.h"
 #include "menu/menu_sponsored.h"
 #include "core/application.h"
+#include "core/frame_profiler.h"
 #include "apiwrap.h"
 #include "api/api_attached_stickers.h"
 #include "api/api_toggling_media.h"
@@ -102,6 +103,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace {
 
 constexpr auto kScrollDateHideTimeout = 1000;
+constexpr auto kIdleResizeSliceBudget = crl::time(4);
+constexpr auto kIdleResizeSliceInterval = crl::time(16);
 constexpr auto kUnloadHeavyPartsPages = 2;
 constexpr auto kClearUserpicsAfter = 50;
 
@@ -321,7 +324,8 @@ HistoryInner::HistoryInner(
 , _touchSelectTimer([=] { onTouchSelect(); })
 , _touchScrollTimer([=] { onTouchScrollTimer(); })
 , _scrollDateCheck([this] { scrollDateCheck(); })
-, _scrollDateHideTimer([this] { scrollDateHideByTimer(); }) {
+, _scrollDateHideTimer([this] { scrollDateHideByTimer(); })
+, _idleResizeTimer([this] { performIdleResizeSlice(); }) {
 	_history->delegateMixin()->setCurrent(this);
 	if (_migrated) {
 		_migrated->delegateMixin()->setCurrent(this);
@@ -949,6 +953,7 @@ void HistoryInner::startEffectOnRead(not_null<HistoryItem*> item) {
 }
 
 void HistoryInner::paintEvent(QPaintEvent *e) {
+	const auto marker = Core::FrameMarker("HistoryInner::paint");
 	if (_controller->contentOverlapped(this, e)
 		|| hasPendingResizedItems()) {
 		return;
@@ -3266,9 +3271,30 @@ void HistoryInner::recountHistoryGeometry() {
 
 	updateBotInfo(false);
 
-	_history->resizeToWidth(_contentWidth);
-	if (_migrated) {
-		_migrated->resizeToWidth(_contentWidth);
+	if (_visibleAreaBottom > _visibleAreaTop) {
+		// Relayout the visible blocks synchronously, the rest is
+		// reflowed in idle-time slices to keep resize under a frame.
+		const auto htop = historyTop();
+		_history->resizeToWidthIncremental(
+			_contentWidth,
+			_visibleAreaTop - htop,
+			_visibleAreaBottom - htop);
+		if (_migrated) {
+			const auto mtop = migratedTop();
+			_migrated->resizeToWidthIncremental(
+				_contentWidth,
+				_visibleAreaTop - mtop,
+				_visibleAreaBottom - mtop);
+		}
+		if (_history->hasPendingResizeSlices()
+			|| (_migrated && _migrated->hasPendingResizeSlices())) {
+			_idleResizeTimer.callOnce(kIdleResizeSliceInterval);
+		}
+	} else {
+		_history->resizeToWidth(_contentWidth);
+		if (_migrated) {
+			_migrated->resizeToWidth(_contentWidth);
+		}
 	}
 
 	// With migrated history we perhaps do not need to display
@@ -3466,6 +3492,18 @@ void HistoryInner::changeItemsRevealHeight(int revealHeight) {
 	updateSize();
 }
 
+void HistoryInner::performIdleResizeSlice() {
+	const auto deadline = crl::now() + kIdleResizeSliceBudget;
+	auto more = _history->resizeSlice(deadline);
+	if (_migrated) {
+		more = _migrated->resizeSlice(deadline) || more;
+	}
+	updateSize();
+	if (more) {
+		_idleResizeTimer.callOnce(kIdleResizeSliceInterval);
+	}
+}
+
 void HistoryInner::updateSize() {
 	const auto visibleHeight = _scroll->height();
 	const auto itemsHeight = historyHeight() - _revealHeight;
@@ -3561,29 +3599,16 @@ void HistoryInner::adjustCurrent(int32 y, History *history) const {
 	Expects(!history->isEmpty());
 
 	_curHistory = history;
-	if (_curBlock >= history->blocks.size()) {
-		_curBlock = history->blocks.size() - 1;
-		_curItem = 0;
-	}
-	while (history->blocks[_curBlock]->y() > y && _curBlock > 0) {
-		--_curBlock;
-		_curItem = 0;
-	}
-	while (history->blocks[_curBlock]->y() + history->blocks[_curBlock]->height() <= y && _curBlock + 1 < history->blocks.size()) {
-		++_curBlock;
-		_curItem = 0;
-	}
-	auto block = history->blocks[_curBlock].get();
-	if (_curItem >= block->messages.size()) {
-		_curItem = block->messages.size() - 1;
-	}
-	auto by = block->y();
-	while (block->messages[_curItem]->y() + by > y && _curItem > 0) {
-		--_curItem;
-	}
-	while (block->messages[_curItem]->y() + block->messages[_curItem]->height() + by <= y && _curItem + 1 < block->messages.size()) {
-		++_curItem;
-	}
+
+	// Blocks and messages store their top offsets, kept in sync by
+	// the resize handling, so instead of walking linearly from the
+	// previous position we can binary search right away. This keeps
+	// hit testing fast during selection drags in long histories.
+	_curBlock = BinarySearchBlocksOrItems<true>(history->blocks, y);
+	const auto block = history->blocks[_curBlock].get();
+	_curItem = BinarySearchBlocksOrItems<true>(
+		block->messages,
+		y - block->y());
 }
 
 auto HistoryInner::prevItem(Element *view) -> Element* {
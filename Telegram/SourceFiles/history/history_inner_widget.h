@@ -309,6 +309,7 @@ private:
 	void enumerateDates(Method method);
 
 	void scrollDateCheck();
+	void performIdleResizeSlice();
 	void scrollDateHideByTimer();
 	bool canHaveFromUserpics() const;
 	void mouseActionStart(const QPoint &screenPos, Qt::MouseButton button);
@@ -548,6 +549,7 @@ private:
 	Ui::Animations::Simple _scrollDateOpacity;
 	SingleQueuedInvokation _scrollDateCheck;
 	base::Timer _scrollDateHideTimer;
+	base::Timer _idleResizeTimer;
 	Element *_scrollDateLastItem = nullptr;
 	int _scrollDateLastItemTop = 0;
 	ClickHandlerPtr _scrollDateLink;
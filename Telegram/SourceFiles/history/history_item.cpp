@@ -35,6 +35,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "apiwrap.h"
 #include "media/audio/media_audio.h"
 #include "core/application.h"
+#include "core/send_latency.h"
 #include "window/window_controller.h"
 #include "window/window_session_controller.h"
 #include "core/click_handler_types.h"
@@ -881,11 +882,27 @@ void HistoryItem::updateServiceDependent(bool force) {
 	}
 
 	// Record resolve state for upcoming on-demand resolving.
+	const auto wasPending = dependent->pendingResolve;
+	const auto dependencyPeerId = dependent->peerId
+		? dependent->peerId
+		: _history->peer->id;
 	if (dependent->msg || !dependent->msgId || force) {
 		dependent->pendingResolve = false;
+		if (wasPending) {
+			_history->owner().unregisterAwaitedDependency(
+				this,
+				dependencyPeerId,
+				dependent->msgId);
+		}
 	} else {
 		dependent->pendingResolve = true;
 		dependent->requestedResolve = false;
+		if (!wasPending) {
+			_history->owner().registerAwaitedDependency(
+				this,
+				dependencyPeerId,
+				dependent->msgId);
+		}
 	}
 
 	// updateDependentServiceText may call UpdateComponents!
@@ -2203,6 +2220,9 @@ void HistoryItem::setRealId(MsgId newId) {
 	Expects(IsClientMsgId(id));
 
 	const auto oldId = std::exchange(id, newId);
+	Core::SendLatency::Instance().mark(
+		FullMsgId(_history->peer->id, oldId),
+		Core::SendLatency::Stage::Shown);
 	_flags &= ~(MessageFlag::BeingSent | MessageFlag::Local);
 	if (isBusinessShortcut()) {
 		_date = 0;
@@ -3361,7 +3381,7 @@ void HistoryItem::setTextValue(TextWithEntities text, bool force) {
 		history()->owner().registerHighlightProcess(processId, this);
 	}
 	const auto had = !_text.empty();
-	_text = std::move(text);
+	_text = history()->owner().internText(std::move(text));
 	RemoveComponents(HistoryMessageTranslation::Bit());
 	if (had || force) {
 		history()->owner().requestItemTextRefresh(this);
@@ -6065,6 +6085,13 @@ void HistoryItem::setupTTLChange() {
 
 void HistoryItem::clearDependencyMessage() {
 	if (const auto dependent = GetServiceDependentData()) {
+		if (dependent->pendingResolve && dependent->msgId) {
+			_history->owner().unregisterAwaitedDependency(
+				this,
+				dependent->peerId ? dependent->peerId : _history->peer->id,
+				dependent->msgId);
+			dependent->pendingResolve = false;
+		}
 		if (dependent->msg) {
 			_history->owner().unregisterDependentMessage(
 				this,
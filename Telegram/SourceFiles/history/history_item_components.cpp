@@ -419,15 +419,25 @@ void HistoryMessageReply::updateData(
 		not_null<HistoryItem*> holder,
 		bool force) {
 	const auto guard = gsl::finally([&] { refreshReplyToMedia(); });
+	const auto peerId = _fields.externalPeerId
+		? _fields.externalPeerId
+		: holder->history()->peer->id;
+	const auto wasPending = (_pendingResolve == 1);
+	const auto stopPending = [&] {
+		_pendingResolve = 0;
+		if (wasPending) {
+			holder->history()->owner().unregisterAwaitedDependency(
+				holder,
+				peerId,
+				_fields.messageId);
+		}
+	};
 	if (!force) {
 		if (resolvedMessage || resolvedStory || _unavailable) {
-			_pendingResolve = 0;
+			stopPending();
 			return;
 		}
 	}
-	const auto peerId = _fields.externalPeerId
-		? _fields.externalPeerId
-		: holder->history()->peer->id;
 	if (!resolvedMessage && _fields.messageId) {
 		resolvedMessage = holder->history()->owner().message(
 			peerId,
@@ -485,10 +495,16 @@ void HistoryMessageReply::updateData(
 		|| resolvedStory
 		|| (!_fields.messageId && !_fields.storyId && external())
 		|| _unavailable) {
-		_pendingResolve = 0;
+		stopPending();
 	} else if (!force) {
 		_pendingResolve = 1;
 		_requestedResolve = 0;
+		if (!wasPending) {
+			holder->history()->owner().registerAwaitedDependency(
+				holder,
+				peerId,
+				_fields.messageId);
+		}
 	}
 }
 
@@ -526,6 +542,15 @@ void HistoryMessageReply::setTopMessageId(MsgId topMessageId) {
 }
 
 void HistoryMessageReply::clearData(not_null<HistoryItem*> holder) {
+	if (_pendingResolve) {
+		holder->history()->owner().unregisterAwaitedDependency(
+			holder,
+			(_fields.externalPeerId
+				? _fields.externalPeerId
+				: holder->history()->peer->id),
+			_fields.messageId);
+		_pendingResolve = 0;
+	}
 	if (resolvedMessage) {
 		holder->history()->owner().unregisterDependentMessage(
 			holder,
@@ -13,6 +13,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace {
 
+constexpr auto kCacheLimit = 1024;
+
 using UpdateFlag = Data::HistoryUpdate::Flag;
 
 } // namespace
@@ -49,3 +51,35 @@ void HistoryTranslation::translateTo(LanguageId id) {
 LanguageId HistoryTranslation::translatedTo() const {
 	return _translatedTo;
 }
+
+void HistoryTranslation::cacheResult(
+		FullMsgId itemId,
+		LanguageId to,
+		TextWithEntities text) {
+	if (text.empty()) {
+		return;
+	}
+	if (_cache.size() >= kCacheLimit && !_cache.contains(itemId)) {
+		const auto oldest = ranges::min_element(
+			_cache,
+			ranges::less(),
+			[](const auto &pair) { return pair.second.lastUsed; });
+		_cache.erase(oldest);
+	}
+	_cache[itemId] = CachedResult{
+		.text = std::move(text),
+		.to = to,
+		.lastUsed = ++_cacheUseStamp,
+	};
+}
+
+std::optional<TextWithEntities> HistoryTranslation::cachedResult(
+		FullMsgId itemId,
+		LanguageId to) {
+	const auto i = _cache.find(itemId);
+	if (i == end(_cache) || i->second.to != to) {
+		return std::nullopt;
+	}
+	i->second.lastUsed = ++_cacheUseStamp;
+	return i->second.text;
+}
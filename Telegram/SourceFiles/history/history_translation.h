@@ -23,10 +23,27 @@ public:
 	void translateTo(LanguageId id);
 	[[nodiscard]] LanguageId translatedTo() const;
 
+	// Items are destroyed when their blocks unload, so without a cache
+	// scrolling back through an already translated channel re-requests
+	// the same texts and re-layouts the items when they arrive.
+	void cacheResult(FullMsgId itemId, LanguageId to, TextWithEntities text);
+	[[nodiscard]] std::optional<TextWithEntities> cachedResult(
+		FullMsgId itemId,
+		LanguageId to);
+
 private:
+	struct CachedResult {
+		TextWithEntities text;
+		LanguageId to;
+		uint64 lastUsed = 0;
+	};
+
 	const not_null<History*> _history;
 
 	LanguageId _offerFrom;
 	LanguageId _translatedTo;
 
-};
\ No newline at end of file
+	base::flat_map<FullMsgId, CachedResult> _cache;
+	uint64 _cacheUseStamp = 0;
+
+};
@@ -1729,21 +1729,32 @@ Ui::ChatTheme *HistoryWidget::customChatTheme() const {
 }
 
 void HistoryWidget::fieldChanged() {
-	const auto updateTyping = (_textUpdateEvents
-		& TextUpdateEvent::SendTyping);
-
+	// Rechecking the characters count, the send text and the
+	// autocomplete query rereads the whole document, which gets costly
+	// in huge drafts. Let the edit itself paint first and handle all
+	// the change notifications of this event loop cycle in one pass.
+	_fieldChangedQueuedEvents |= _textUpdateEvents;
+	if (_fieldChangedQueued) {
+		return;
+	}
+	_fieldChangedQueued = true;
 	InvokeQueued(this, [=] {
-		updateInlineBotQuery();
-		if (_history
-			&& !_inlineBot
-			&& !_editMsgId
-			&& (!_autocomplete || !_autocomplete->stickersEmoji())
-			&& updateTyping) {
-			session().sendProgressManager().update(
-				_history,
-				Api::SendProgressType::Typing);
-		}
+		_fieldChangedQueued = false;
+		fieldChangedQueued(base::take(_fieldChangedQueuedEvents));
 	});
+}
+
+void HistoryWidget::fieldChangedQueued(TextUpdateEvents events) {
+	updateInlineBotQuery();
+	if (_history
+		&& !_inlineBot
+		&& !_editMsgId
+		&& (!_autocomplete || !_autocomplete->stickersEmoji())
+		&& (events & TextUpdateEvent::SendTyping)) {
+		session().sendProgressManager().update(
+			_history,
+			Api::SendProgressType::Typing);
+	}
 
 	checkCharsCount();
 
@@ -1762,7 +1773,7 @@ void HistoryWidget::fieldChanged() {
 	}
 
 	_saveCloudDraftTimer.cancel();
-	if (!_peer || !(_textUpdateEvents & TextUpdateEvent::SaveDraft)) {
+	if (!_peer || !(events & TextUpdateEvent::SaveDraft)) {
 		return;
 	}
 
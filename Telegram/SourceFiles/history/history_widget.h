@@ -376,6 +376,7 @@ private:
 	void setTabbedPanel(std::unique_ptr<TabbedPanel> panel);
 	void updateField();
 	void fieldChanged();
+	void fieldChangedQueued(TextUpdateEvents events);
 	void fieldTabbed();
 	void fieldFocused();
 	void fieldResized();
@@ -834,6 +835,8 @@ private:
 	bool _nonEmptySelection = false;
 
 	TextUpdateEvents _textUpdateEvents = (TextUpdateEvents() | TextUpdateEvent::SaveDraft | TextUpdateEvent::SendTyping);
+	TextUpdateEvents _fieldChangedQueuedEvents = 0;
+	bool _fieldChangedQueued = false;
 
 	QString _confirmSource;
 
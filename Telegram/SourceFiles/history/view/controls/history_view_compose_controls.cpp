@@ -1752,26 +1752,40 @@ void ComposeControls::updateSilentBroadcast() {
 }
 
 void ComposeControls::fieldChanged() {
+	// Reacting to every change notification rereads the document for
+	// the send text, the limits and the autocomplete query, too costly
+	// in huge drafts. Coalesce the notifications of one event loop
+	// cycle into a single pass queued after the edit is painted.
+	_fieldChangedQueuedEvents |= _textUpdateEvents;
+	if (_fieldChangedQueued) {
+		return;
+	}
+	_fieldChangedQueued = true;
+	InvokeQueued(_field.get(), [=] {
+		_fieldChangedQueued = false;
+		fieldChangedQueued(base::take(_fieldChangedQueuedEvents));
+	});
+}
+
+void ComposeControls::fieldChangedQueued(TextUpdateEvents events) {
 	const auto typing = (!_inlineBot
 		&& !_header->isEditingMessage()
-		&& (_textUpdateEvents & TextUpdateEvent::SendTyping));
+		&& (events & TextUpdateEvent::SendTyping));
 	updateSendButtonType();
 	_hasSendText = HasSendText(_field);
 	if (updateBotCommandShown() || updateLikeShown()) {
 		updateControlsVisibility();
 		updateControlsGeometry(_wrap->size());
 	}
-	InvokeQueued(_field.get(), [=] {
-		updateInlineBotQuery();
-		if ((!_autocomplete || !_autocomplete->stickersEmoji()) && typing) {
-			_sendActionUpdates.fire({ Api::SendProgressType::Typing });
-		}
-	});
+	updateInlineBotQuery();
+	if ((!_autocomplete || !_autocomplete->stickersEmoji()) && typing) {
+		_sendActionUpdates.fire({ Api::SendProgressType::Typing });
+	}
 
 	checkCharsLimitation();
 
 	_saveCloudDraftTimer.cancel();
-	if (!(_textUpdateEvents & TextUpdateEvent::SaveDraft)) {
+	if (!(events & TextUpdateEvent::SaveDraft)) {
 		return;
 	}
 	_saveDraftText = true;
@@ -306,6 +306,7 @@ private:
 
 	void escape();
 	void fieldChanged();
+	void fieldChangedQueued(TextUpdateEvents events);
 	void toggleTabbedSelectorMode();
 	void createTabbedPanel();
 	void setTabbedPanel(std::unique_ptr<ChatHelpers::TabbedPanel> panel);
@@ -428,6 +429,8 @@ private:
 	TextUpdateEvents _textUpdateEvents = TextUpdateEvents()
 		| TextUpdateEvent::SaveDraft
 		| TextUpdateEvent::SendTyping;
+	TextUpdateEvents _fieldChangedQueuedEvents = 0;
+	bool _fieldChangedQueued = false;
 	Dialogs::EntryState _currentDialogsEntryState;
 
 	crl::time _saveDraftStart = 0;
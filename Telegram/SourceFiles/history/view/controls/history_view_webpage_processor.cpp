@@ -8,15 +8,75 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/view/controls/history_view_webpage_processor.h"
 
 #include "base/unixtime.h"
+#include "core/version.h"
 #include "data/data_chat_participant_status.h"
+#include "data/data_document.h"
+#include "data/data_document_media.h"
 #include "data/data_file_origin.h"
+#include "data/data_photo.h"
+#include "data/data_photo_media.h"
 #include "data/data_session.h"
 #include "data/data_web_page.h"
 #include "history/history.h"
 #include "lang/lang_keys.h"
 #include "main/main_session.h"
+#include "storage/cache/storage_cache_database.h"
+#include "ui/image/image.h"
+#include "ui/ui_utility.h"
+#include "styles/style_chat.h"
 
 namespace HistoryView::Controls {
+namespace {
+
+// messages.getWebPagePreview provides no TTL of its own, pending pages
+// carry the retry date and are not persisted, resolved ones keep their
+// local copy for a day.
+constexpr auto kCachedPreviewTtl = TimeId(24 * 60 * 60);
+
+[[nodiscard]] QByteArray SerializeCachedPreview(const MTPWebPage &page) {
+	auto buffer = mtpBuffer();
+	page.write(buffer);
+	const auto tl = QByteArray(
+		reinterpret_cast<const char*>(buffer.constData()),
+		buffer.size() * sizeof(mtpPrime));
+	auto result = QByteArray();
+	auto stream = QDataStream(&result, QIODevice::WriteOnly);
+	stream << qint32(AppVersion) // The TL scheme may change with it.
+		<< qint32(base::unixtime::now() + kCachedPreviewTtl)
+		<< tl;
+	return result;
+}
+
+[[nodiscard]] WebPageData *ParseCachedPreview(
+		not_null<Main::Session*> session,
+		const QByteArray &value) {
+	if (value.isEmpty()) {
+		return nullptr;
+	}
+	auto stream = QDataStream(value);
+	auto version = qint32();
+	auto expires = qint32();
+	auto tl = QByteArray();
+	stream >> version >> expires >> tl;
+	if (stream.status() != QDataStream::Ok
+		|| version != AppVersion
+		|| expires <= base::unixtime::now()
+		|| tl.isEmpty()) {
+		return nullptr;
+	}
+	auto buffer = mtpBuffer();
+	buffer.resize(tl.size() / sizeof(mtpPrime));
+	memcpy(buffer.data(), tl.constData(), buffer.size() * sizeof(mtpPrime));
+	auto from = buffer.constData();
+	auto page = MTPWebPage();
+	if (!page.read(from, from + buffer.size())) {
+		return nullptr;
+	}
+	const auto result = session->data().processWebpage(page);
+	return (result->pendingTill > 0) ? nullptr : result.get();
+}
+
+} // namespace
 
 WebPageText TitleAndDescriptionFromWebPage(not_null<WebPageData*> d) {
 	QString resultTitle, resultDescription;
@@ -138,6 +198,31 @@ void WebpageResolver::request(const QString &link, bool force) {
 	if (_requestLink == link && !force) {
 		return;
 	}
+	_requestLink = link;
+
+	// Previews resolved in a past run are persisted in the local cache,
+	// so reopening chats full of links paints them without round-trips.
+	const auto generation = ++_generation;
+	const auto weak = base::make_weak(this);
+	_session->data().cache().get(
+		Data::WebPagePreviewCacheKey(link),
+		[=](QByteArray value) {
+		crl::on_main(weak, [=] {
+			if (_generation != generation) {
+				return;
+			} else if (const auto page = ParseCachedPreview(
+					_session,
+					value)) {
+				_cache.emplace(link, page->failed ? nullptr : page);
+				_resolved.fire_copy(link);
+			} else {
+				requestFromNetwork(link);
+			}
+		});
+	});
+}
+
+void WebpageResolver::requestFromNetwork(const QString &link) {
 	const auto done = [=](const MTPDmessageMediaWebPage &data) {
 		const auto page = _session->data().processWebpage(data.vwebpage());
 		if (page->pendingTill > 0
@@ -145,6 +230,13 @@ void WebpageResolver::request(const QString &link, bool force) {
 			page->pendingTill = 0;
 			page->failed = true;
 		}
+		if (!page->failed && !page->pendingTill) {
+			_session->data().cache().put(
+				Data::WebPagePreviewCacheKey(link),
+				Storage::Cache::Database::TaggedValue(
+					SerializeCachedPreview(data.vwebpage()),
+					0));
+		}
 		_cache.emplace(link, page->failed ? nullptr : page.get());
 		_resolved.fire_copy(link);
 	};
@@ -152,7 +244,6 @@ void WebpageResolver::request(const QString &link, bool force) {
 		_cache.emplace(link, nullptr);
 		_resolved.fire_copy(link);
 	};
-	_requestLink = link;
 	_requestId = _api.request(
 		MTPmessages_GetWebPagePreview(
 			MTP_flags(0),
@@ -177,6 +268,7 @@ void WebpageResolver::request(const QString &link, bool force) {
 
 void WebpageResolver::cancel(const QString &link) {
 	if (_requestLink == link) {
+		++_generation;
 		_api.request(base::take(_requestId)).cancel();
 	}
 }
@@ -197,6 +289,7 @@ WebpageProcessor::WebpageProcessor(
 	) | rpl::filter([=] {
 		return _data && (_data->document || _data->photo);
 	}) | rpl::start_with_next([=] {
+		generatePreviewBlit();
 		_repaintRequests.fire({});
 	}, _lifetime);
 
@@ -295,6 +388,7 @@ void WebpageProcessor::apply(Data::WebPageDraft draft, bool reparse) {
 
 void WebpageProcessor::updateFromData() {
 	_timer.cancel();
+	restartPreviewGeneration();
 	auto parsed = WebpageParsed();
 	if (ShowWebPagePreview(_data)) {
 		if (const auto till = _data->pendingTill) {
@@ -309,12 +403,23 @@ void WebpageProcessor::updateFromData() {
 				std::max(timeout, 0) * crl::time(1000));
 		} else {
 			const auto webpage = _data;
-			const auto context = _history->peer;
+			const auto blit = _previewBlit;
 			const auto preview = ProcessWebPageData(_data);
 			parsed.title = preview.title;
 			parsed.description = preview.description;
 			parsed.drawPreview = [=](QPainter &p, QRect to) {
-				return DrawWebPageDataPreview(p, webpage, context, to);
+				const auto photo = webpage->photo;
+				const auto document = webpage->document;
+				if ((!photo || photo->isNull())
+					&& (!document
+						|| !document->hasThumbnail()
+						|| document->isPatternWallPaper())) {
+					return false;
+				}
+				if (blit && !blit->isNull()) {
+					p.drawPixmap(to.x(), to.y(), *blit);
+				}
+				return true;
 			};
 		}
 	}
@@ -322,6 +427,123 @@ void WebpageProcessor::updateFromData() {
 	_repaintRequests.fire({});
 }
 
+void WebpageProcessor::restartPreviewGeneration() {
+	_previewGeneration = base::binary_guard();
+	_previewPhotoMedia = nullptr;
+	_previewDocumentMedia = nullptr;
+	_previewBlit = nullptr;
+	_previewGood = false;
+	_previewGenerating = false;
+	if (!ShowWebPagePreview(_data) || _data->pendingTill) {
+		return;
+	}
+	const auto photo = _data->photo;
+	const auto document = _data->document;
+	if ((!photo || photo->isNull())
+		&& (!document
+			|| !document->hasThumbnail()
+			|| document->isPatternWallPaper())) {
+		return;
+	}
+	_previewBlit = std::make_shared<QPixmap>();
+	generatePreviewBlit();
+}
+
+void WebpageProcessor::generatePreviewBlit() {
+	if (!_previewBlit || _previewGood || _previewGenerating) {
+		return;
+	}
+	const auto photo = _data->photo;
+	const auto document = _data->document;
+	auto source = (Image*)nullptr;
+	auto options = Images::Options();
+	auto good = false;
+	if (photo && !photo->isNull()) {
+		if (!_previewPhotoMedia) {
+			_previewPhotoMedia = photo->createMediaView();
+			const auto load = photo->inlineThumbnailBytes().isEmpty()
+				|| _previewPhotoMedia->autoLoadThumbnailAllowed(
+					_history->peer);
+			if (load) {
+				_previewPhotoMedia->wanted(
+					Data::PhotoSize::Small,
+					Data::FileOrigin());
+			}
+		}
+		using Size = Data::PhotoSize;
+		if (const auto small = _previewPhotoMedia->image(Size::Small)) {
+			source = small;
+			good = true;
+		} else if (const auto large = _previewPhotoMedia->image(Size::Large)) {
+			source = large;
+			good = true;
+		} else if (const auto blurred = _previewPhotoMedia->thumbnailInline()) {
+			source = blurred;
+			options = Images::Option::Blur;
+		}
+	} else if (document
+		&& document->hasThumbnail()
+		&& !document->isPatternWallPaper()) {
+		if (!_previewDocumentMedia) {
+			_previewDocumentMedia = document->createMediaView();
+			_previewDocumentMedia->thumbnailWanted(Data::FileOrigin());
+		}
+		const auto round = document->isVideoMessage()
+			? Images::Option::RoundCircle
+			: Images::Option();
+		if (const auto thumbnail = _previewDocumentMedia->thumbnail()) {
+			source = thumbnail;
+			options = round;
+			good = true;
+		} else if (const auto blurred
+				= _previewDocumentMedia->thumbnailInline()) {
+			source = blurred;
+			options = round | Images::Option::Blur;
+		}
+	}
+	if (!source || source->isNull()) {
+		return;
+	}
+	// Scale and crop the thumbnail on a worker thread, so that when a
+	// link preview resolves mid-typing the compose field paint is just
+	// a pixmap blit. The blurred version is replaced by the good one
+	// when the real thumbnail arrives from the downloader.
+	_previewGenerating = true;
+	const auto ratio = style::DevicePixelRatio();
+	const auto outer = st::historyReplyPreview;
+	crl::async([
+		=,
+		guard = _previewGeneration.make_guard(),
+		blit = _previewBlit,
+		original = source->original()
+	]() mutable {
+		const auto w = std::max(original.width(), 1);
+		const auto h = std::max(original.height(), 1);
+		const auto thumbSize = ((w > h)
+			? QSize(w * outer / h, outer)
+			: QSize(outer, h * outer / w)) * ratio;
+		auto prepared = Images::Prepare(std::move(original), thumbSize, {
+			.options = options | Images::Option::TransparentBackground,
+			.outer = { outer, outer },
+		});
+		crl::on_main(std::move(guard), [
+			=,
+			prepared = std::move(prepared)
+		]() mutable {
+			*blit = Ui::PixmapFromImage(std::move(prepared));
+			_previewGenerating = false;
+			_previewGood = good;
+			if (good) {
+				_previewPhotoMedia = nullptr;
+				_previewDocumentMedia = nullptr;
+			} else {
+				generatePreviewBlit();
+			}
+			_repaintRequests.fire({});
+		});
+	});
+}
+
 void WebpageProcessor::setDisabled(bool disabled) {
 	_parser.setDisabled(disabled);
 	if (disabled) {
@@ -7,12 +7,19 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
+#include "base/binary_guard.h"
+#include "base/weak_ptr.h"
 #include "data/data_drafts.h"
 #include "chat_helpers/message_field.h"
 #include "mtproto/sender.h"
 
 class History;
 
+namespace Data {
+class PhotoMedia;
+class DocumentMedia;
+} // namespace Data
+
 namespace Main {
 class Session;
 } // namespace Main
@@ -50,7 +57,7 @@ struct WebpageParsed {
 	}
 };
 
-class WebpageResolver final {
+class WebpageResolver final : public base::has_weak_ptr {
 public:
 	explicit WebpageResolver(not_null<Main::Session*> session);
 
@@ -66,6 +73,8 @@ public:
 	void cancel(const QString &link);
 
 private:
+	void requestFromNetwork(const QString &link);
+
 	const not_null<Main::Session*> _session;
 	MTP::Sender _api;
 	base::flat_map<QString, WebPageData*> _cache;
@@ -73,6 +82,7 @@ private:
 
 	QString _requestLink;
 	mtpRequestId _requestId = 0;
+	int _generation = 0;
 
 };
 
@@ -106,6 +116,8 @@ public:
 private:
 	void updateFromData();
 	void checkPreview();
+	void restartPreviewGeneration();
+	void generatePreviewBlit();
 
 	const not_null<History*> _history;
 	const std::shared_ptr<WebpageResolver> _resolver;
@@ -117,6 +129,13 @@ private:
 	WebPageData *_data = nullptr;
 	Data::WebPageDraft _draft;
 
+	std::shared_ptr<QPixmap> _previewBlit;
+	std::shared_ptr<Data::PhotoMedia> _previewPhotoMedia;
+	std::shared_ptr<Data::DocumentMedia> _previewDocumentMedia;
+	base::binary_guard _previewGeneration;
+	bool _previewGood = false;
+	bool _previewGenerating = false;
+
 	rpl::event_stream<> _repaintRequests;
 	rpl::variable<WebpageParsed> _parsed;
 
@@ -508,11 +508,14 @@ void Item::setupHistory() {
 
 	_inner->resizeToWidth(_scroll->width(), _scroll->height());
 
-	_inner->refreshViewer();
-
 	_inner->setAttribute(Qt::WA_TransparentForMouseEvents);
 
 	crl::on_main(this, [=] {
+		// Building the list content for a heavy channel is the expensive
+		// part of opening a preview. Show the menu with the background
+		// and the top bar right away and fill the history a frame later,
+		// so the right-click doesn't hitch the dialogs list.
+		_inner->refreshViewer();
 		_inner->setFocus();
 	});
 }
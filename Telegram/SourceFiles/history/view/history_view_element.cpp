@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "history/view/history_view_element.h"
 
+#include "history/view/history_view_element_arena.h"
 #include "history/view/history_view_service_message.h"
 #include "history/view/history_view_message.h"
 #include "history/view/media/history_view_media_grouped.h"
@@ -476,6 +477,14 @@ void FakeBotAboutTop::init() {
 	height = st::msgNameStyle.font->height + st::botDescSkip;
 }
 
+void *Element::operator new(std::size_t size) {
+	return ElementArena::Instance().allocate(size);
+}
+
+void Element::operator delete(void *pointer, std::size_t size) {
+	ElementArena::Instance().free(pointer, size);
+}
+
 Element::Element(
 	not_null<ElementDelegate*> delegate,
 	not_null<HistoryItem*> data,
@@ -727,8 +736,7 @@ void Element::overrideMedia(std::unique_ptr<Media> media) {
 	Expects(!history()->owner().groups().find(data()));
 
 	_text = Ui::Text::String(st::msgMinWidth);
-	_textWidth = -1;
-	_textHeight = 0;
+	_textHeights = {};
 
 	_media = std::move(media);
 	if (!pendingResize()) {
@@ -860,11 +868,16 @@ OnlyEmojiAndSpaces Element::isOnlyEmojiAndSpaces() const {
 
 int Element::textHeightFor(int textWidth) {
 	validateText();
-	if (_textWidth != textWidth) {
-		_textWidth = textWidth;
-		_textHeight = _text.countHeight(textWidth);
+	const auto b = begin(_textHeights);
+	for (auto i = b, e = end(_textHeights); i != e; ++i) {
+		if (i->width == textWidth) {
+			std::rotate(b, i, i + 1);
+			return b->height;
+		}
 	}
-	return _textHeight;
+	std::rotate(b, end(_textHeights) - 1, end(_textHeights));
+	*b = { textWidth, _text.countHeight(textWidth) };
+	return b->height;
 }
 
 auto Element::contextDependentServiceText() -> TextWithLinks {
@@ -1086,20 +1099,17 @@ void Element::setTextWithLinks(
 		}
 	}
 	InitElementTextPart(this, _text);
-	_textWidth = -1;
-	_textHeight = 0;
+	_textHeights = {};
 }
 
 void Element::validateTextSkipBlock(bool has, int width, int height) {
 	validateText();
 	if (!has) {
 		if (_text.removeSkipBlock()) {
-			_textWidth = -1;
-			_textHeight = 0;
+			_textHeights = {};
 		}
 	} else if (_text.updateSkipBlock(width, height)) {
-		_textWidth = -1;
-		_textHeight = 0;
+		_textHeights = {};
 	}
 }
 
@@ -1517,16 +1527,14 @@ void Element::itemTextUpdated() {
 	}
 	clearSpecialOnlyEmoji();
 	_text = Ui::Text::String(st::msgMinWidth);
-	_textWidth = -1;
-	_textHeight = 0;
+	_textHeights = {};
 	if (_media && !data()->media()) {
 		refreshMedia(nullptr);
 	}
 }
 
 void Element::blockquoteExpandChanged() {
-	_textWidth = -1;
-	_textHeight = 0;
+	_textHeights = {};
 	history()->owner().requestViewResize(this);
 }
 
@@ -338,6 +338,11 @@ public:
 		Element *replacing,
 		Flag serviceFlag);
 
+	// View objects are allocated from ElementArena slabs, see
+	// history_view_element_arena.h.
+	[[nodiscard]] void *operator new(std::size_t size);
+	void operator delete(void *pointer, std::size_t size);
+
 	[[nodiscard]] not_null<ElementDelegate*> delegate() const;
 	[[nodiscard]] not_null<HistoryItem*> data() const;
 	[[nodiscard]] not_null<History*> history() const;
@@ -648,6 +653,16 @@ private:
 	};
 	[[nodiscard]] TextWithLinks contextDependentServiceText();
 
+	// Text height is cached for the last few widths, so that toggling
+	// side panels or snapping the window between two sizes doesn't
+	// re-run text layout for each item again and again.
+	static constexpr auto kTextHeightsCount = 4;
+
+	struct TextHeight {
+		int width = -1;
+		int height = 0;
+	};
+
 	const not_null<ElementDelegate*> _delegate;
 	const not_null<HistoryItem*> _data;
 	HistoryBlock *_block = nullptr;
@@ -657,8 +672,7 @@ private:
 
 	HistoryItem *_textItem = nullptr;
 	mutable Ui::Text::String _text;
-	mutable int _textWidth = -1;
-	mutable int _textHeight = 0;
+	mutable std::array<TextHeight, kTextHeightsCount> _textHeights;
 
 	int _y = 0;
 	int _indexInBlock = -1;
@@ -0,0 +1,123 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "history/view/history_view_element_arena.h"
+
+#include <new>
+
+namespace HistoryView {
+
+struct ElementArena::Slab {
+	Slab *next = nullptr;
+	Slab *prev = nullptr;
+	FreeBlock *freeList = nullptr;
+	char *bump = nullptr;
+	char *end = nullptr;
+	int classIndex = 0;
+	int used = 0;
+};
+
+ElementArena &ElementArena::Instance() {
+	static auto result = ElementArena();
+	return result;
+}
+
+void *ElementArena::allocate(std::size_t size) {
+	if (size > kMaxBlockSize) {
+		return ::operator new(size);
+	}
+	const auto index = int((size + kGranularity - 1) / kGranularity) - 1;
+	auto &list = _classes[index];
+	auto slab = list.partial;
+	if (!slab) {
+		slab = createSlab(index);
+	}
+	++slab->used;
+	auto result = (void*)nullptr;
+	if (const auto block = slab->freeList) {
+		slab->freeList = block->next;
+		result = block;
+	} else {
+		result = slab->bump;
+		slab->bump += (index + 1) * kGranularity;
+	}
+	if (!slab->freeList
+		&& slab->bump + (index + 1) * kGranularity > slab->end) {
+		detachSlab(slab);
+	}
+	return result;
+}
+
+void ElementArena::free(void *pointer, std::size_t size) {
+	if (size > kMaxBlockSize) {
+		::operator delete(pointer);
+		return;
+	}
+	const auto slab = SlabFor(pointer);
+	const auto wasFull = !slab->freeList
+		&& (slab->bump + (slab->classIndex + 1) * kGranularity > slab->end);
+	const auto block = static_cast<FreeBlock*>(pointer);
+	block->next = slab->freeList;
+	slab->freeList = block;
+	if (!--slab->used) {
+		if (!wasFull) {
+			detachSlab(slab);
+		}
+		::operator delete(
+			static_cast<void*>(slab),
+			std::align_val_t(kSlabSize));
+	} else if (wasFull) {
+		auto &list = _classes[slab->classIndex];
+		slab->prev = nullptr;
+		slab->next = list.partial;
+		if (slab->next) {
+			slab->next->prev = slab;
+		}
+		list.partial = slab;
+	}
+}
+
+ElementArena::Slab *ElementArena::createSlab(int index) {
+	const auto memory = ::operator new(
+		kSlabSize,
+		std::align_val_t(kSlabSize));
+	const auto result = new (memory) Slab();
+	const auto header = (sizeof(Slab) + kGranularity - 1)
+		/ kGranularity
+		* kGranularity;
+	result->bump = static_cast<char*>(memory) + header;
+	result->end = static_cast<char*>(memory) + kSlabSize;
+	result->classIndex = index;
+
+	auto &list = _classes[index];
+	result->next = list.partial;
+	if (result->next) {
+		result->next->prev = result;
+	}
+	list.partial = result;
+	return result;
+}
+
+void ElementArena::detachSlab(Slab *slab) {
+	auto &list = _classes[slab->classIndex];
+	if (slab->prev) {
+		slab->prev->next = slab->next;
+	} else {
+		list.partial = slab->next;
+	}
+	if (slab->next) {
+		slab->next->prev = slab->prev;
+	}
+	slab->prev = slab->next = nullptr;
+}
+
+ElementArena::Slab *ElementArena::SlabFor(void *pointer) {
+	return reinterpret_cast<Slab*>(
+		reinterpret_cast<std::uintptr_t>(pointer) & ~(kSlabSize - 1));
+}
+
+} // namespace HistoryView
@@ -0,0 +1,51 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace HistoryView {
+
+// Opening a chat constructs thousands of short-lived view objects
+// (Element / Media trees). Carving them from large size-class slabs
+// instead of individual heap allocations keeps construction cache
+// friendly and returns whole slabs to the system when a chat closes
+// and its views are destroyed together.
+//
+// The arena is used from the main thread only, where all view objects
+// are created and destroyed.
+class ElementArena final {
+public:
+	[[nodiscard]] static ElementArena &Instance();
+
+	[[nodiscard]] void *allocate(std::size_t size);
+	void free(void *pointer, std::size_t size);
+
+private:
+	static constexpr auto kSlabSize = std::size_t(64 << 10);
+	static constexpr auto kGranularity = std::size_t(16);
+	static constexpr auto kMaxBlockSize = std::size_t(1024);
+	static constexpr auto kClassesCount = kMaxBlockSize / kGranularity;
+
+	struct Slab;
+	struct FreeBlock {
+		FreeBlock *next = nullptr;
+	};
+	struct SizeClass {
+		Slab *partial = nullptr;
+	};
+
+	ElementArena() = default;
+
+	[[nodiscard]] Slab *createSlab(int index);
+	void detachSlab(Slab *slab);
+	[[nodiscard]] static Slab *SlabFor(void *pointer);
+
+	SizeClass _classes[kClassesCount];
+
+};
+
+} // namespace HistoryView
@@ -44,6 +44,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "window/window_session_controller.h"
 #include "window/window_peer_menu.h"
 #include "main/main_session.h"
+#include "main/main_session_settings.h"
 #include "ui/widgets/popup_menu.h"
 #include "ui/widgets/scroll_area.h"
 #include "ui/toast/toast.h"
@@ -62,9 +63,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/crash_reports.h"
 #include "data/components/sponsored_messages.h"
 #include "data/data_session.h"
+#include "data/data_auto_download.h"
 #include "data/data_changes.h"
+#include "data/data_file_origin.h"
 #include "data/data_folder.h"
+#include "data/data_media_preload.h"
 #include "data/data_media_types.h"
+#include "data/data_photo.h"
 #include "data/data_document.h"
 #include "data/data_peer.h"
 #include "data/data_user.h"
@@ -85,6 +90,8 @@ constexpr auto kPreloadedScreensCount = 4;
 constexpr auto kPreloadIfLessThanScreens = 2;
 constexpr auto kPreloadedScreensCountFull
 	= kPreloadedScreensCount + 1 + kPreloadedScreensCount;
+constexpr auto kPreloadMediaScreens = 2;
+constexpr auto kPreloadMediaCount = 4;
 constexpr auto kClearUserpicsAfter = 50;
 
 [[nodiscard]] std::unique_ptr<TranslateTracker> MaybeTranslateTracker(
@@ -1088,6 +1095,9 @@ void ListWidget::visibleTopBottomUpdated(
 
 	const auto initializing = !(_visibleTop < _visibleBottom);
 	const auto scrolledUp = (visibleTop < _visibleTop);
+	if (!initializing && visibleTop != _visibleTop) {
+		_scrollDownwards = !scrolledUp;
+	}
 	_visibleTop = visibleTop;
 	_visibleBottom = visibleBottom;
 
@@ -1114,6 +1124,7 @@ void ListWidget::visibleTopBottomUpdated(
 
 void ListWidget::applyUpdatedScrollState() {
 	checkMoveToOtherViewer();
+	preloadMediaInScrollDirection();
 }
 
 void ListWidget::updateVisibleTopItem() {
@@ -1755,6 +1766,75 @@ void ListWidget::checkMoveToOtherViewer() {
 	}
 }
 
+void ListWidget::preloadMediaInScrollDirection() {
+	const auto visibleHeight = (_visibleBottom - _visibleTop);
+	if (_items.empty() || visibleHeight <= 0) {
+		_mediaPreloads.clear();
+		return;
+	}
+	// Prefetch photos and streamable video prefixes for the messages
+	// that the current scroll direction is about to reveal. Entries
+	// that leave the predicted window are destroyed, which cancels
+	// their downloads, so a direction change drops obsolete requests.
+	const auto limitTop = _visibleTop - kPreloadMediaScreens * visibleHeight;
+	const auto limitBottom = _visibleBottom
+		+ kPreloadMediaScreens * visibleHeight;
+	const auto count = int(_items.size());
+	const auto fromIndex = findItemIndexByY(
+		_scrollDownwards ? _visibleBottom : _visibleTop);
+	const auto delta = _scrollDownwards ? 1 : -1;
+	auto preloads = base::flat_map<
+		not_null<const HistoryItem*>,
+		std::unique_ptr<Data::MediaPreload>>();
+	for (auto i = fromIndex
+		; i >= 0 && i < count && preloads.size() < kPreloadMediaCount
+		; i += delta) {
+		const auto view = _items[i];
+		const auto top = itemTop(view);
+		if (_scrollDownwards
+			? (top > limitBottom)
+			: (top + view->height() < limitTop)) {
+			break;
+		}
+		const auto item = view->data();
+		const auto media = item->media();
+		if (!media) {
+			continue;
+		}
+		const auto peer = item->history()->peer;
+		const auto photo = media->photo();
+		const auto document = media->document();
+		const auto usePhoto = photo
+			&& Data::PhotoPreload::Should(photo, peer);
+		const auto useVideo = !usePhoto
+			&& document
+			&& Data::VideoPreload::Can(document)
+			&& Data::AutoDownload::Should(
+				session().settings().autoDownload(),
+				peer,
+				document);
+		if (!usePhoto && !useVideo) {
+			continue;
+		}
+		if (const auto taken = _mediaPreloads.find(item)
+			; taken != end(_mediaPreloads)) {
+			preloads.emplace(item, std::move(taken->second));
+			continue;
+		}
+		// The done callback may fire from the constructor, so it only
+		// schedules the removal, when the entry is already stored.
+		const auto done = [=] {
+			crl::on_main(this, [=] { _mediaPreloads.remove(item); });
+		};
+		const auto origin = Data::FileOrigin(item->fullId());
+		preloads.emplace(item, usePhoto
+			? std::unique_ptr<Data::MediaPreload>(
+				std::make_unique<Data::PhotoPreload>(photo, origin, done))
+			: std::make_unique<Data::VideoPreload>(document, origin, done));
+	}
+	_mediaPreloads = std::move(preloads);
+}
+
 QString ListWidget::tooltipText() const {
 	const auto item = (_overElement && _mouseAction == MouseAction::None)
 		? _overElement->data().get()
@@ -4119,6 +4199,7 @@ void ListWidget::itemRemoved(not_null<const HistoryItem*> item) {
 	if (_pressItemExact == item) {
 		_pressItemExact = nullptr;
 	}
+	_mediaPreloads.remove(item);
 	const auto i = _views.find(item);
 	if (i == end(_views)) {
 		return;
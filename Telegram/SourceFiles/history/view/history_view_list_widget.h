@@ -44,6 +44,7 @@ struct Group;
 struct Reaction;
 struct AllowedReactions;
 struct ReactionId;
+class MediaPreload;
 } // namespace Data
 
 namespace HistoryView::Reactions {
@@ -592,6 +593,7 @@ private:
 	[[nodiscard]] HistoryItemsList collectVisibleItems() const;
 
 	void checkMoveToOtherViewer();
+	void preloadMediaInScrollDirection();
 	void updateVisibleTopItem();
 	void updateItemsGeometry();
 	void updateSize();
@@ -792,6 +794,10 @@ private:
 	Fn<bool()> _overrideInitialScroll;
 
 	bool _scrollInited = false;
+	bool _scrollDownwards = true;
+	base::flat_map<
+		not_null<const HistoryItem*>,
+		std::unique_ptr<Data::MediaPreload>> _mediaPreloads;
 	bool _scrollDateShown = false;
 	Ui::Animations::Simple _scrollDateOpacity;
 	SingleQueuedInvokation _scrollDateCheck;
@@ -934,7 +934,7 @@ QSize Message::performCountOptimalSize() {
 				if (withVisibleText) {
 					if (maxWidth < textualWidth) {
 						minHeight -= text().minHeight();
-						minHeight += text().countHeight(innerWidth);
+						minHeight += textHeightFor(innerWidth);
 					}
 				}
 				if (reactionsInBubble) {
@@ -1932,12 +1932,7 @@ void Message::paintTopicButton(
 	const auto skip = padding.right() + st::topicButtonArrowSkip;
 	auto color = stm->msgServiceFg->c;
 	color.setAlpha(color.alpha() / 8);
-	p.setPen(Qt::NoPen);
-	p.setBrush(color);
-	{
-		auto hq = PainterHighQualityEnabler(p);
-		p.drawRoundedRect(rect, height / 2, height / 2);
-	}
+	Ui::FillRoundRect(p, rect, color, height / 2);
 	if (button->ripple) {
 		button->ripple->paint(
 			p,
@@ -3984,10 +3979,7 @@ void Message::drawRightAction(
 		}
 	}
 
-	p.setPen(Qt::NoPen);
-	p.setBrush(st->msgServiceBg());
 	{
-		PainterHighQualityEnabler hq(p);
 		const auto rect = style::rtlrect(
 			left,
 			top,
@@ -3996,9 +3988,12 @@ void Message::drawRightAction(
 			outerWidth);
 		const auto usual = st::historyFastShareSize;
 		if (size->width() == size->height() && size->width() == usual) {
+			PainterHighQualityEnabler hq(p);
+			p.setPen(Qt::NoPen);
+			p.setBrush(st->msgServiceBg());
 			p.drawEllipse(rect);
 		} else {
-			p.drawRoundedRect(rect, usual / 2, usual / 2);
+			Ui::FillRoundRect(p, rect, st->msgServiceBg()->c, usual / 2);
 		}
 	}
 	if (displayRightActionComments()) {
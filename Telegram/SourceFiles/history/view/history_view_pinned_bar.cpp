@@ -24,6 +24,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace HistoryView {
 namespace {
 
+constexpr auto kMaxCachedBarContents = 100;
+
 [[nodiscard]] Ui::MessageBarContent ContentWithoutPreview(
 		not_null<HistoryItem*> item,
 		Fn<void()> repaint) {
@@ -166,15 +168,41 @@ rpl::producer<Ui::MessageBarContent> PinnedBarContent(
 		not_null<Main::Session*> session,
 		rpl::producer<PinnedId> id,
 		Fn<void()> repaint) {
+	// The last built content is cached per pinned message, so switching
+	// back to an already shown pin fills the bar instantly instead of
+	// resolving the message and rebuilding the preview again.
+	struct State {
+		base::flat_map<FullMsgId, Ui::MessageBarContent> cache;
+	};
+	const auto state = std::make_shared<State>();
 	return std::move(
 		id
 	) | rpl::distinct_until_changed(
 	) | rpl::map([=](PinnedId id) {
-		return ContentByItemId(
+		auto live = ContentByItemId(
 			session,
 			id.message,
 			repaint
-		) | rpl::map(WithPinnedTitle(session, id));
+		) | rpl::map([=](Ui::MessageBarContent &&content) {
+			if (id.message && !content.text.empty()) {
+				if (state->cache.size() >= kMaxCachedBarContents
+					&& !state->cache.contains(id.message)) {
+					state->cache.clear();
+				}
+				state->cache[id.message] = content;
+			}
+			return std::move(content);
+		});
+		auto full = [&]() -> rpl::producer<Ui::MessageBarContent> {
+			const auto i = state->cache.find(id.message);
+			if (i == end(state->cache)) {
+				return std::move(live);
+			}
+			return rpl::single(
+				Ui::MessageBarContent(i->second)
+			) | rpl::then(std::move(live));
+		}();
+		return std::move(full) | rpl::map(WithPinnedTitle(session, id));
 	}) | rpl::flatten_latest();
 }
 
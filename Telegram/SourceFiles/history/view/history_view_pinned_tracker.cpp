@@ -101,6 +101,7 @@ void PinnedTracker::refreshViewer() {
 		for (auto i = 0; i != count; ++i) {
 			_slice.ids.push_back(result[i]);
 		}
+		rememberSlice();
 		refreshCurrentFromSlice();
 		if (_slice.fullCount == 0) {
 			_thread->setHasPinnedMessages(false);
@@ -112,6 +113,64 @@ void PinnedTracker::refreshViewer() {
 	}, _dataLifetime);
 }
 
+MsgId PinnedTracker::universalId(FullMsgId id) const {
+	return (_migratedPeer && !peerIsChannel(id.peer))
+		? (id.msg - ServerMaxMsgId)
+		: id.msg;
+}
+
+void PinnedTracker::rememberSlice() {
+	// Accumulate every slice the viewer reported into a sorted index,
+	// so jumping back to an already seen pin doesn't have to wait for
+	// a fresh slice to load around it.
+	const auto count = std::max(
+		_slice.fullCount.value_or(1),
+		int(_slice.ids.size()));
+	if (_indexed.count != count) {
+		// Pins were added or removed, the remembered indices shifted.
+		_indexed.ids.clear();
+		_indexed.indices.clear();
+		_indexed.count = count;
+	}
+	if (!_slice.skippedBefore.has_value()) {
+		return;
+	}
+	const auto proj = [&](FullMsgId id) { return universalId(id); };
+	auto index = *_slice.skippedBefore;
+	for (const auto &id : _slice.ids) {
+		const auto i = ranges::lower_bound(
+			_indexed.ids,
+			universalId(id),
+			ranges::less(),
+			proj);
+		if (i == end(_indexed.ids) || *i != id) {
+			_indexed.ids.insert(i, id);
+		}
+		_indexed.indices[id] = index++;
+	}
+}
+
+bool PinnedTracker::applyIndexed() {
+	if (_indexed.ids.empty()) {
+		return false;
+	}
+	const auto proj = [&](FullMsgId id) { return universalId(id); };
+	const auto i = ranges::lower_bound(
+		_indexed.ids,
+		_aroundId,
+		ranges::less(),
+		proj);
+	const auto id = (i != begin(_indexed.ids))
+		? *(i - 1)
+		: _indexed.ids.front();
+	const auto j = _indexed.indices.find(id);
+	if (j == end(_indexed.indices)) {
+		return false;
+	}
+	_current = PinnedId{ id, j->second, _indexed.count };
+	return true;
+}
+
 void PinnedTracker::refreshCurrentFromSlice() {
 	const auto proj1 = [](FullMsgId id) {
 		return peerIsChannel(id.peer) ? id.msg : (id.msg - ServerMaxMsgId);
@@ -145,6 +204,11 @@ void PinnedTracker::refreshCurrentFromSlice() {
 		} else {
 			_current = PinnedId();
 		}
+	} else {
+		// The slice doesn't cover the new position yet, look the pin up
+		// in the accumulated index so the bar switches right away; the
+		// viewer refresh below corrects it if the pins changed.
+		applyIndexed();
 	}
 	if (nearEnd) {
 		refreshViewer();
@@ -155,6 +219,7 @@ void PinnedTracker::clear() {
 	_dataLifetime.destroy();
 	_viewerAroundId = 0;
 	_current = PinnedId();
+	_indexed = Indexed();
 }
 
 void PinnedTracker::trackAround(UniversalMsgId messageId) {
@@ -41,9 +41,17 @@ private:
 		std::optional<int> skippedBefore;
 		std::optional<int> skippedAfter;
 	};
+	struct Indexed {
+		std::vector<FullMsgId> ids;
+		base::flat_map<FullMsgId, int> indices;
+		int count = 0;
+	};
 	void clear();
 	void refreshViewer();
 	void refreshCurrentFromSlice();
+	void rememberSlice();
+	bool applyIndexed();
+	[[nodiscard]] MsgId universalId(FullMsgId id) const;
 
 	const not_null<Data::Thread*> _thread;
 	PeerData *_migratedPeer = nullptr;
@@ -54,6 +62,7 @@ private:
 	UniversalMsgId _aroundId = 0;
 	UniversalMsgId _viewerAroundId = 0;
 	Slice _slice;
+	Indexed _indexed;
 
 	rpl::lifetime _lifetime;
 
@@ -218,6 +218,7 @@ void Reply::update(
 		|| (externalMedia && externalMedia->hasReplyPreview());
 	_hasPreview = hasPreview ? 1 : 0;
 	_displaying = data->displaying() ? 1 : 0;
+	const auto wasMultiline = (_multiline != 0);
 	_multiline = data->multiline() ? 1 : 0;
 	_replyToStory = (fields.storyId != 0);
 	const auto hasQuoteIcon = _displaying
@@ -244,15 +245,24 @@ void Reply::update(
 		}).text
 		: TextWithEntities();
 	const auto repaint = [=] { item->customEmojiRepaint(); };
-	const auto context = Core::MarkedTextContext{
-		.session = &view->history()->session(),
-		.customEmojiRepaint = repaint,
-	};
-	_text.setMarkedText(
-		st::defaultTextStyle,
-		text,
-		_multiline ? Ui::ItemTextDefaultOptions() : Ui::DialogTextOptions(),
-		context);
+	// The views are rebuilt on all kinds of changes around the message,
+	// while the quote text rarely changes, so don't relayout it in vain.
+	const auto unchanged = (wasMultiline == (_multiline != 0))
+		&& !_text.isEmpty()
+		&& (_text.toTextWithEntities() == text);
+	if (!unchanged) {
+		const auto context = Core::MarkedTextContext{
+			.session = &view->history()->session(),
+			.customEmojiRepaint = repaint,
+		};
+		_text.setMarkedText(
+			st::defaultTextStyle,
+			text,
+			_multiline
+				? Ui::ItemTextDefaultOptions()
+				: Ui::DialogTextOptions(),
+			context);
+	}
 
 	updateName(view, data);
 
@@ -463,16 +473,18 @@ void Reply::updateName(
 	if (!viaBotUsername.isEmpty()) {
 		nameFull.append(u" @"_q).append(viaBotUsername);
 	}
-	const auto context = Core::MarkedTextContext{
-		.session = &history->session(),
-		.customEmojiRepaint = [] {},
-		.customEmojiLoopLimit = 1,
-	};
-	_name.setMarkedText(
-		st::fwdTextStyle,
-		nameFull,
-		Ui::NameTextOptions(),
-		context);
+	if (_name.isEmpty() || _name.toTextWithEntities() != nameFull) {
+		const auto context = Core::MarkedTextContext{
+			.session = &history->session(),
+			.customEmojiRepaint = [] {},
+			.customEmojiLoopLimit = 1,
+		};
+		_name.setMarkedText(
+			st::fwdTextStyle,
+			nameFull,
+			Ui::NameTextOptions(),
+			context);
+	}
 	if (sender) {
 		_nameVersion = sender->nameVersion();
 	}
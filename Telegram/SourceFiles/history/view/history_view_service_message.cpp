@@ -300,7 +300,32 @@ void ServiceMessagePainter::PaintComplexBubble(
 		int width,
 		const Ui::Text::String &text,
 		const QRect &textRect) {
-	const auto lineWidths = CountLineWidths(text, textRect);
+	PaintComplexBubble(p, st, left, width, CountLineWidths(text, textRect));
+}
+
+void ServiceMessagePainter::PaintComplexBubble(
+		Painter &p,
+		not_null<const Ui::ChatStyle*> st,
+		int left,
+		int width,
+		const std::vector<int> &lineWidths) {
+	if (lineWidths.size() == 1) {
+		// Most service messages (dates, joins, pins, calls) fit in one
+		// line, so the bubble is a plain rounded rect from the corners
+		// cache and the multi-line shape computation is skipped.
+		const auto richWidth = lineWidths.front()
+			+ st::msgServicePadding.left()
+			+ st::msgServicePadding.right();
+		const auto richHeight = st::msgServiceFont->height
+			+ st::msgServicePadding.top()
+			+ st::msgServicePadding.bottom();
+		PaintBubble(p, st, QRect(
+			left + ((width - richWidth) / 2),
+			st::msgServiceMargin.top(),
+			richWidth,
+			richHeight));
+		return;
+	}
 
 	int y = st::msgServiceMargin.top(), previousRichWidth = 0;
 	bool previousShrink = false, forceShrink = false;
@@ -470,6 +495,7 @@ QSize Service::performCountCurrentSize(int newWidth) {
 
 QSize Service::performCountOptimalSize() {
 	validateText();
+	_bubbleLineWidthsFor = -1;
 
 	if (const auto media = this->media()) {
 		media->initDimensions();
@@ -549,13 +575,18 @@ void Service::draw(Painter &p, const PaintContext &context) const {
 		const auto trect = QRect(g.left(), margin.top(), g.width(), height)
 			- st::msgServicePadding;
 
+		if (_bubbleLineWidthsFor != trect.width()) {
+			_bubbleLineWidthsFor = trect.width();
+			_bubbleLineWidths = ServiceMessagePainter::CountLineWidths(
+				text(),
+				trect);
+		}
 		ServiceMessagePainter::PaintComplexBubble(
 			p,
 			context.st,
 			g.left(),
 			g.width(),
-			text(),
-			trect);
+			_bubbleLineWidths);
 
 		p.setBrush(Qt::NoBrush);
 		p.setPen(st->msgServiceFg());
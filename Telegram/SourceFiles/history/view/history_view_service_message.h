@@ -60,6 +60,11 @@ private:
 	QSize performCountOptimalSize() override;
 	QSize performCountCurrentSize(int newWidth) override;
 
+	// Cached bubble shape for the current text and width, so that the
+	// line widths are not recounted on every paint.
+	mutable std::vector<int> _bubbleLineWidths;
+	mutable int _bubbleLineWidthsFor = -1;
+
 };
 
 int WideChatWidth();
@@ -116,8 +121,12 @@ public:
 		int width,
 		const Ui::Text::String &text,
 		const QRect &textRect);
-
-private:
+	static void PaintComplexBubble(
+		Painter &p,
+		not_null<const Ui::ChatStyle*> st,
+		int left,
+		int width,
+		const std::vector<int> &lineWidths);
 	static std::vector<int> CountLineWidths(
 		const Ui::Text::String &text,
 		const QRect &textRect);
@@ -178,7 +178,8 @@ TopBarWidget::TopBarWidget(
 		using AnimationUpdate = Data::SendActionManager::AnimationUpdate;
 		session().data().sendActionManager().animationUpdated(
 		) | rpl::filter([=](const AnimationUpdate &update) {
-			return (update.thread == _activeChat.key.thread());
+			return (update.thread == _activeChat.key.thread())
+				&& !_controller->widget()->framesHidden();
 		}) | rpl::start_with_next([=] {
 			update();
 		}, lifetime());
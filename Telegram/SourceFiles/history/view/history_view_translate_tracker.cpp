@@ -16,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_session.h"
 #include "history/history.h"
 #include "history/history_item.h"
+#include "history/history_translation.h"
 #include "history/history_item_components.h"
 #include "history/view/history_view_element.h"
 #include "main/main_session.h"
@@ -148,11 +149,18 @@ bool TranslateTracker::add(
 void TranslateTracker::switchTranslation(
 		not_null<HistoryItem*> item,
 		LanguageId id) {
-	if (item->translationShowRequiresRequest(id)) {
-		_itemsToRequest.emplace(
-			item->fullId(),
-			ItemToRequest{ int(item->originalText().text.size()) });
+	if (!item->translationShowRequiresRequest(id)) {
+		return;
 	}
+	if (const auto translation = _history->translation()) {
+		if (auto cached = translation->cachedResult(item->fullId(), id)) {
+			item->translationDone(id, std::move(*cached));
+			return;
+		}
+	}
+	_itemsToRequest.emplace(
+		item->fullId(),
+		ItemToRequest{ int(item->originalText().text.size()) });
 }
 
 void TranslateTracker::finishBunch() {
@@ -287,15 +295,21 @@ void TranslateTracker::requestDone(
 	auto index = 0;
 	const auto session = &_history->session();
 	const auto owner = &session->data();
+	const auto translation = _history->translation();
 	for (const auto &id : base::take(_requested)) {
+		const auto data = (index >= list.size())
+			? nullptr
+			: &list[index].data();
+		auto text = data ? TextWithEntities{
+			qs(data->vtext()),
+			Api::EntitiesFromMTP(session, data->ventities().v)
+		} : TextWithEntities();
+		if (translation) {
+			// Cache even if the item was unloaded while the request
+			// was in flight, it will be recreated on scroll-back.
+			translation->cacheResult(id, to, text);
+		}
 		if (const auto item = owner->message(id)) {
-			const auto data = (index >= list.size())
-				? nullptr
-				: &list[index].data();
-			auto text = data ? TextWithEntities{
-				qs(data->vtext()),
-				Api::EntitiesFromMTP(session, data->ventities().v)
-			} : TextWithEntities();
 			item->translationDone(to, std::move(text));
 		}
 		++index;
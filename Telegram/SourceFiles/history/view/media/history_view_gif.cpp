@@ -57,6 +57,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "styles/style_chat.h"
 
 #include <QSvgRenderer>
+#include <QtCore/QThread>
 
 namespace HistoryView {
 namespace {
@@ -65,6 +66,21 @@ constexpr auto kMaxGifForwardedBarLines = 4;
 constexpr auto kUseNonBlurredThreshold = 240;
 constexpr auto kMaxInlineArea = 1920 * 1080;
 
+// Every inline autoplay runs a decoder of its own, so admission is
+// capped by core count - a screenful of GIFs otherwise starves the
+// rest of the application on small CPUs. Players waiting for a slot
+// are repainted when one frees and re-apply while they stay visible.
+[[nodiscard]] int SimultaneousPlaysLimit() {
+	static const auto result = std::clamp(
+		QThread::idealThreadCount() / 2,
+		2,
+		6);
+	return result;
+}
+
+base::flat_set<not_null<Gif*>> PlayingGifs;
+base::flat_set<not_null<Gif*>> WaitingGifs;
+
 [[nodiscard]] int GifMaxStatusWidth(not_null<DocumentData*> document) {
 	auto result = st::normalFont->width(
 		Ui::FormatDownloadText(document->size, document->size));
@@ -208,6 +224,7 @@ Gif::Gif(
 }
 
 Gif::~Gif() {
+	WaitingGifs.remove(this);
 	if (_streamed || _dataMedia) {
 		if (_streamed) {
 			_data->owner().streaming().keepAlive(_data);
@@ -470,7 +487,7 @@ void Gif::draw(Painter &p, const PaintContext &context) const {
 		&& !activeRoundPlaying
 		&& !fullHiddenBySpoiler;
 	if (startPlay) {
-		const_cast<Gif*>(this)->playAnimation(true);
+		const_cast<Gif*>(this)->startAutoplayWithinBudget();
 	} else {
 		checkStreamedIsStarted();
 	}
@@ -1304,7 +1321,7 @@ void Gif::drawGrouped(
 		&& CanPlayInline(_data);
 	const auto startPlay = autoplay && !_streamed;
 	if (startPlay) {
-		const_cast<Gif*>(this)->playAnimation(true);
+		const_cast<Gif*>(this)->startAutoplayWithinBudget();
 	} else {
 		checkStreamedIsStarted();
 	}
@@ -1772,6 +1789,7 @@ bool Gif::hasHeavyPart() const {
 }
 
 void Gif::unloadHeavyPart() {
+	WaitingGifs.remove(this);
 	stopAnimation();
 	_dataMedia = nullptr;
 	if (_spoiler) {
@@ -1898,6 +1916,15 @@ void Gif::createStreamedPlayer() {
 	checkStreamedIsStarted();
 }
 
+void Gif::startAutoplayWithinBudget() {
+	if (int(PlayingGifs.size()) < SimultaneousPlaysLimit()) {
+		WaitingGifs.remove(this);
+		playAnimation(true);
+	} else {
+		WaitingGifs.emplace(this);
+	}
+}
+
 void Gif::startStreamedPlayer() const {
 	Expects(_streamed != nullptr);
 
@@ -1927,9 +1954,20 @@ void Gif::setStreamed(std::unique_ptr<Streamed> value) {
 	const auto set = (!_streamed && value);
 	_streamed = std::move(value);
 	if (set) {
+		PlayingGifs.emplace(this);
+		WaitingGifs.remove(this);
 		history()->owner().registerHeavyViewPart(_parent);
 		togglePollingStory(true);
 	} else if (removed) {
+		PlayingGifs.remove(this);
+		if (!WaitingGifs.empty()
+			&& int(PlayingGifs.size()) < SimultaneousPlaysLimit()) {
+			// Waiters that are still visible re-apply from paint,
+			// the rest just stay out of both lists.
+			for (const auto &gif : base::take(WaitingGifs)) {
+				gif->repaint();
+			}
+		}
 		_parent->checkHeavyPart();
 	}
 }
@@ -148,6 +148,7 @@ private:
 	::Media::View::PlaybackProgress *videoPlayback() const;
 
 	void createStreamedPlayer();
+	void startAutoplayWithinBudget();
 	void checkStreamedIsStarted() const;
 	void startStreamedPlayer() const;
 	void setStreamed(std::unique_ptr<Streamed> value);
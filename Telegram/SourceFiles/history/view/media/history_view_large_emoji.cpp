@@ -100,16 +100,27 @@ void LargeEmoji::draw(
 	if (!selected) {
 		_selectedFrame = QImage();
 	}
-	for (const auto &media : _images) {
+	const auto ratio = style::DevicePixelRatio();
+	for (auto i = 0; i != int(_images.size()); ++i) {
+		const auto &media = _images[i];
 		if (const auto image = std::get_if<ImagePtr>(&media)) {
 			if (const auto &prepared = (*image)->image) {
-				const auto colored = selected
-					? &context.st->msgStickerOverlay()
-					: nullptr;
-				p.drawPixmap(
-					x,
-					y,
-					prepared->pix(size, { .colored = colored }));
+				if (selected) {
+					const auto colored = &context.st->msgStickerOverlay();
+					p.drawPixmap(
+						x,
+						y,
+						prepared->pix(size, { .colored = colored }));
+				} else {
+					auto &pixmap = _pixmaps[i];
+					if (pixmap.size() != size * ratio) {
+						// A shallow copy of the prepared pixmap, so the
+						// usual paint is a direct blit without the pixmap
+						// cache key lookup on every frame.
+						pixmap = prepared->pix(size);
+					}
+					p.drawPixmap(x, y, pixmap);
+				}
 			} else if ((*image)->load) {
 				(*image)->load();
 			}
@@ -58,6 +58,7 @@ private:
 
 	const not_null<Element*> _parent;
 	const std::array<LargeEmojiMedia, Ui::Text::kIsolatedEmojiLimit> _images;
+	std::array<QPixmap, Ui::Text::kIsolatedEmojiLimit> _pixmaps;
 	QImage _selectedFrame;
 	QSize _size;
 	bool _hasHeavyPart = false;
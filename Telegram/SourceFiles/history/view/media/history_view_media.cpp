@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history.h"
 #include "history/history_item.h"
 #include "history/view/history_view_element.h"
+#include "history/view/history_view_element_arena.h"
 #include "history/view/history_view_cursor_state.h"
 #include "history/view/history_view_text_helper.h"
 #include "history/view/media/history_view_media_common.h"
@@ -191,6 +192,14 @@ TextWithEntities AddTimestampLinks(
 	return text;
 }
 
+void *Media::operator new(std::size_t size) {
+	return ElementArena::Instance().allocate(size);
+}
+
+void Media::operator delete(void *pointer, std::size_t size) {
+	ElementArena::Instance().free(pointer, size);
+}
+
 Storage::SharedMediaTypesMask Media::sharedMediaTypes() const {
 	return {};
 }
@@ -83,6 +83,11 @@ public:
 	explicit Media(not_null<Element*> parent) : _parent(parent) {
 	}
 
+	// Media views share the Element slab arena, see
+	// history_view_element_arena.h.
+	[[nodiscard]] void *operator new(std::size_t size);
+	void operator delete(void *pointer, std::size_t size);
+
 	[[nodiscard]] not_null<Element*> parent() const;
 	[[nodiscard]] not_null<History*> history() const;
 
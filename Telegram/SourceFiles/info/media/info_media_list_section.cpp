@@ -31,6 +31,10 @@ bool ListSection::empty() const {
 	return _items.empty();
 }
 
+bool ListSection::hasSameItems(const ListSection &other) const {
+	return (_type == other._type) && (_items == other._items);
+}
+
 UniversalMsgId ListSection::minId() const {
 	Expects(!empty());
 
@@ -325,6 +329,10 @@ void ListSection::resizeToWidth(int newWidth) {
 	auto minWidth = st::infoMediaMinGridSize + st::infoMediaSkip * 2;
 	if (newWidth < minWidth) {
 		return;
+	} else if (newWidth == _widthLaidOut) {
+		// The items and the width didn't change since the last layout,
+		// only the section top offset may move.
+		return;
 	}
 
 	auto resizeOneColumn = [&](int itemsLeft, int itemWidth) {
@@ -370,6 +378,7 @@ void ListSection::resizeToWidth(int newWidth) {
 		resizeOneColumn(itemsLeft, itemWidth);
 	} break;
 	}
+	_widthLaidOut = newWidth;
 
 	refreshHeight();
 }
@@ -22,6 +22,10 @@ public:
 
 	[[nodiscard]] bool empty() const;
 
+	// True when the other section holds exactly the same layouts, so
+	// its computed geometry can be reused instead of a fresh layout.
+	[[nodiscard]] bool hasSameItems(const ListSection &other) const;
+
 	[[nodiscard]] UniversalMsgId minId() const;
 
 	void setTop(int top);
@@ -87,6 +91,7 @@ private:
 	mutable int _rowsCount = 0;
 	int _top = 0;
 	int _height = 0;
+	int _widthLaidOut = 0;
 
 	Mosaic::Layout::MosaicLayout<BaseLayout> _mosaic;
 
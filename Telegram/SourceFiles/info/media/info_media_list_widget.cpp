@@ -541,8 +541,28 @@ void ListWidget::trackSession(not_null<Main::Session*> session) {
 void ListWidget::refreshRows() {
 	saveScrollState();
 
-	_sections.clear();
-	_sections = _provider->fillSections(this);
+	auto fresh = _provider->fillSections(this);
+
+	// A new message only changes its own month bucket. Take over the
+	// geometry of buckets whose item lists didn't change, so they skip
+	// the per-item layout pass and recountHeight() just shifts their
+	// top offsets.
+	auto was = _sections.begin();
+	for (auto &section : fresh) {
+		if (section.empty()) {
+			continue;
+		}
+		while (was != _sections.end()
+			&& !was->empty()
+			&& was->minId() > section.minId()) {
+			++was;
+		}
+		if (was != _sections.end() && was->hasSameItems(section)) {
+			section = std::move(*was);
+			++was;
+		}
+	}
+	_sections = std::move(fresh);
 
 	if (_controller->isDownloads() && !_sections.empty()) {
 		for (const auto &item : _sections.back().items()) {
@@ -53,6 +53,7 @@ class ItemBase;
 using Results = std::vector<std::unique_ptr<Result>>;
 
 struct CacheEntry {
+	crl::time lastUsed = 0;
 	QString nextOffset;
 	QString switchPmText;
 	QString switchPmStartToken;
@@ -25,6 +25,7 @@ namespace Layout {
 namespace {
 
 constexpr auto kInlineBotRequestDelay = 400;
+constexpr auto kInlineCacheLimit = 32;
 
 } // namespace
 
@@ -414,6 +415,7 @@ void Widget::inlineResultsDone(const MTPmessages_BotResults &result) {
 		if (!added) {
 			entry->nextOffset = QString();
 		}
+		pruneInlineCache();
 	} else if (adding) {
 		it->second->nextOffset = QString();
 	}
@@ -427,6 +429,7 @@ void Widget::inlineResultsDone(const MTPmessages_BotResults &result) {
 void Widget::queryInlineBot(UserData *bot, PeerData *peer, QString query) {
 	bool force = false;
 	_inlineQueryPeer = peer;
+	query = query.trimmed();
 	if (bot != _inlineBot) {
 		inlineBotChanged();
 		_inlineBot = bot;
@@ -445,11 +448,49 @@ void Widget::queryInlineBot(UserData *bot, PeerData *peer, QString query) {
 			showInlineRows(true);
 		} else {
 			_inlineNextQuery = query;
+			seedFromCachedPrefix();
 			_inlineRequestTimer.callOnce(kInlineBotRequestDelay);
 		}
 	}
 }
 
+void Widget::seedFromCachedPrefix() {
+	// While the refined request is on its way show the results of the
+	// longest cached prefix of the new query, they mostly survive the
+	// refinement for media-search bots.
+	auto best = _inlineCache.cend();
+	for (auto i = _inlineCache.cbegin(); i != _inlineCache.cend(); ++i) {
+		if (_inlineNextQuery.startsWith(i->first)
+			&& !i->second->results.empty()
+			&& (best == _inlineCache.cend()
+				|| i->first.size() > best->first.size())) {
+			best = i;
+		}
+	}
+	if (best != _inlineCache.cend() && _inlineQuery != best->first) {
+		_inlineQuery = best->first;
+		showInlineRows(true);
+	}
+}
+
+void Widget::pruneInlineCache() {
+	while (_inlineCache.size() > kInlineCacheLimit) {
+		auto oldest = _inlineCache.end();
+		for (auto i = _inlineCache.begin(); i != _inlineCache.end(); ++i) {
+			if (i->first == _inlineQuery || i->first == _inlineNextQuery) {
+				continue;
+			} else if (oldest == _inlineCache.end()
+				|| i->second->lastUsed < oldest->second->lastUsed) {
+				oldest = i;
+			}
+		}
+		if (oldest == _inlineCache.end()) {
+			break;
+		}
+		_inlineCache.erase(oldest);
+	}
+}
+
 void Widget::onInlineRequest() {
 	if (_inlineRequestId || !_inlineBot || !_inlineQueryPeer) return;
 	_inlineQuery = _inlineNextQuery;
@@ -483,6 +524,7 @@ bool Widget::refreshInlineRows(int *added) {
 	auto it = _inlineCache.find(_inlineQuery);
 	const CacheEntry *entry = nullptr;
 	if (it != _inlineCache.cend()) {
+		it->second->lastUsed = crl::now();
 		if (!it->second->results.empty() || !it->second->switchPmText.isEmpty()) {
 			entry = it->second.get();
 		}
@@ -122,6 +122,8 @@ private:
 	void recountContentMaxHeight();
 	bool refreshInlineRows(int *added = nullptr);
 	void inlineResultsDone(const MTPmessages_BotResults &result);
+	void seedFromCachedPrefix();
+	void pruneInlineCache();
 
 	const not_null<Window::SessionController*> _controller;
 	MTP::Sender _api;
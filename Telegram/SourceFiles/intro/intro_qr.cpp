@@ -20,6 +20,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/text/text_utilities.h"
 #include "ui/image/image_prepare.h"
 #include "ui/painter.h"
+#include "ui/render_async.h"
 #include "main/main_account.h"
 #include "ui/boxes/confirm_box.h"
 #include "core/application.h"
@@ -89,8 +90,13 @@ namespace {
 		std::move(qrs),
 		rpl::duplicate(palettes)
 	) | rpl::map([](const Qr::Data &code, const auto &) {
-		return TelegramQr(code, st::introQrPixel, st::introQrMaxSize);
-	}) | rpl::start_with_next([=](QImage &&image) {
+		// Rasterized on a background thread, the codes are regenerated
+		// every refresh period and this must not block the intro.
+		return Ui::RenderAsync([=] {
+			return TelegramQr(code, st::introQrPixel, st::introQrMaxSize);
+		});
+	}) | rpl::flatten_latest(
+	) | rpl::start_with_next([=](QImage &&image) {
 		state->previous = std::move(state->qr);
 		state->qr = std::move(image);
 		state->waiting.stop();
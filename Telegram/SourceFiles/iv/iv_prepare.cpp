@@ -509,14 +509,15 @@ QByteArray Parser::block(
 	const auto paddingTop = collage
 		? Percent(dimension) + "%"
 		: "calc(min(480px, " + Percent(dimension) + "%))";
-	const auto style = "background-image:url('" + src + "');"
-		"padding-top: " + paddingTop + ";";
+	// The full photo is loaded lazily from the scroll position in page.js,
+	// till then only the blurred minithumbnail below is shown.
+	const auto style = "padding-top: " + paddingTop + ";";
 	auto inner = tag("div", {
 		{ "class", "photo" },
-		{ "style", style } });
+		{ "style", style },
+		{ "data-src", src } });
 	const auto minithumb = Images::ExpandInlineBytes(photo.minithumbnail);
 	if (!minithumb.isEmpty()) {
-		const auto image = Images::Read({ .content = minithumb });
 		inner = tag("div", {
 			{ "class", "photo-bg" },
 			{ "style", "background-image:url('data:image/jpeg;base64,"
@@ -567,7 +568,6 @@ QByteArray Parser::block(
 	});
 	const auto minithumb = Images::ExpandInlineBytes(video.minithumbnail);
 	if (!minithumb.isEmpty()) {
-		const auto image = Images::Read({ .content = minithumb });
 		inner = tag("div", {
 			{ "class", "video-bg" },
 			{ "style", "background-image:url('data:image/jpeg;base64,"
@@ -658,6 +658,7 @@ QByteArray Parser::block(const MTPDpageBlockEmbed &data) {
 	if (!data.is_allow_scrolling()) {
 		attributes.push_back({ "scrolling", "no" });
 	}
+	attributes.push_back({ "loading", "lazy" });
 	attributes.push_back({ "frameborder", "0" });
 	attributes.push_back({ "allowtransparency", "true" });
 	attributes.push_back({ "allowfullscreen", "true" });
@@ -848,6 +849,7 @@ QByteArray Parser::block(const MTPDpageBlockMap &data) {
 	const auto height = std::min(450, (data.vh().v * width / data.vw().v));
 	return tag("figure", tag("img", {
 		{ "src", mapUrl(geo, width, height, data.vzoom().v) },
+		{ "loading", "lazy" },
 	}) + caption(data.vcaption()));
 }
 
@@ -1039,6 +1041,7 @@ QByteArray Parser::rich(const MTPRichText &text) {
 		auto attributes = Attributes{
 			{ "class", "pic" },
 			{ "src", documentFullUrl(image) },
+			{ "loading", "lazy" },
 		};
 		if (const auto width = data.vw().v) {
 			attributes.push_back({ "width", Number(width) });
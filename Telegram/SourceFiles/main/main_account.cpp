@@ -55,6 +55,9 @@ Account::~Account() {
 	if (const auto session = maybeSession()) {
 		session->saveSettingsNowIfNeeded();
 		_local->writeSearchSuggestionsIfNeeded();
+		_local->writeRecentStickersIfNeeded();
+		_local->writeLocationsIfNeeded();
+		_local->writeChatListSnapshot();
 	}
 	destroySession(DestroyReason::Quitting);
 }
@@ -192,6 +195,9 @@ void Account::createSession(
 	if (!serialized.isEmpty()) {
 		local().readSelf(_session.get(), serialized, streamVersion);
 	}
+	// Before _sessionValue fires, so that the window setup triggered by
+	// it can resolve the last opened chat peer from the snapshot.
+	local().readChatListSnapshot();
 	_sessionValue = _session.get();
 
 	Ensures(_session != nullptr);
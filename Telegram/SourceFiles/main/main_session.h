@@ -31,6 +31,7 @@ class Templates;
 namespace Data {
 class Session;
 class Changes;
+class ChatListSnapshot;
 class RecentPeers;
 class ScheduledMessages;
 class SponsoredMessages;
@@ -118,6 +119,9 @@ public:
 	[[nodiscard]] Data::RecentPeers &recentPeers() const {
 		return *_recentPeers;
 	}
+	[[nodiscard]] Data::ChatListSnapshot &chatListSnapshot() const {
+		return *_chatListSnapshot;
+	}
 	[[nodiscard]] Data::SponsoredMessages &sponsoredMessages() const {
 		return *_sponsoredMessages;
 	}
@@ -263,6 +267,7 @@ private:
 	const std::unique_ptr<SendAsPeers> _sendAsPeers;
 	const std::unique_ptr<InlineBots::AttachWebView> _attachWebView;
 	const std::unique_ptr<Data::RecentPeers> _recentPeers;
+	const std::unique_ptr<Data::ChatListSnapshot> _chatListSnapshot;
 	const std::unique_ptr<Data::ScheduledMessages> _scheduledMessages;
 	const std::unique_ptr<Data::SponsoredMessages> _sponsoredMessages;
 	const std::unique_ptr<Data::TopPeers> _topPeers;
@@ -47,7 +47,9 @@ QByteArray SessionSettings::serialize() const {
 		+ _hiddenPinnedMessages.size() * (sizeof(quint64) * 3)
 		+ sizeof(qint32)
 		+ _groupEmojiSectionHidden.size() * sizeof(quint64)
-		+ sizeof(qint32) * 2;
+		+ sizeof(qint32) * 2
+		+ sizeof(quint64)
+		+ sizeof(qint64);
 
 	auto result = QByteArray();
 	result.reserve(size);
@@ -102,6 +104,9 @@ QByteArray SessionSettings::serialize() const {
 		stream
 			<< qint32(_lastNonPremiumLimitDownload)
 			<< qint32(_lastNonPremiumLimitUpload);
+		stream
+			<< SerializePeerId(_lastOpenedPeerId)
+			<< qint64(_lastOpenedMsgId.bare);
 	}
 
 	Ensures(result.size() == size);
@@ -169,6 +174,8 @@ void SessionSettings::addFromSerialized(const QByteArray &serialized) {
 	qint32 legacySkipPremiumStickersSet = 0;
 	qint32 lastNonPremiumLimitDownload = 0;
 	qint32 lastNonPremiumLimitUpload = 0;
+	quint64 lastOpenedPeerId = 0;
+	qint64 lastOpenedMsgId = 0;
 
 	stream >> versionTag;
 	if (versionTag == kVersionTag) {
@@ -447,6 +454,11 @@ void SessionSettings::addFromSerialized(const QByteArray &serialized) {
 			>> lastNonPremiumLimitDownload
 			>> lastNonPremiumLimitUpload;
 	}
+	if (!stream.atEnd()) {
+		stream
+			>> lastOpenedPeerId
+			>> lastOpenedMsgId;
+	}
 	if (stream.status() != QDataStream::Ok) {
 		LOG(("App Error: "
 			"Bad data for SessionSettings::addFromSerialized()"));
@@ -494,6 +506,8 @@ void SessionSettings::addFromSerialized(const QByteArray &serialized) {
 	_mutePeriods = std::move(mutePeriods);
 	_lastNonPremiumLimitDownload = lastNonPremiumLimitDownload;
 	_lastNonPremiumLimitUpload = lastNonPremiumLimitUpload;
+	_lastOpenedPeerId = DeserializePeerId(lastOpenedPeerId);
+	_lastOpenedMsgId = lastOpenedMsgId;
 
 	if (version < 2) {
 		app.setLastSeenWarningSeen(appLastSeenWarningSeen == 1);
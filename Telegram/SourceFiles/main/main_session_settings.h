@@ -145,6 +145,19 @@ public:
 		_lastNonPremiumLimitUpload = when;
 	}
 
+	// The chat opened in the primary window, restored on startup
+	// together with the chat list snapshot before any network replies.
+	[[nodiscard]] PeerId lastOpenedPeerId() const {
+		return _lastOpenedPeerId;
+	}
+	[[nodiscard]] MsgId lastOpenedMsgId() const {
+		return _lastOpenedMsgId;
+	}
+	void setLastOpenedChat(PeerId peerId, MsgId msgId) {
+		_lastOpenedPeerId = peerId;
+		_lastOpenedMsgId = msgId;
+	}
+
 private:
 	static constexpr auto kDefaultSupportChatsLimitSlice = 7 * 24 * 60 * 60;
 	static constexpr auto kPhotoEditorHintMaxShowsCount = 5;
@@ -173,6 +186,8 @@ private:
 	std::vector<TimeId> _mutePeriods;
 	TimeId _lastNonPremiumLimitDownload = 0;
 	TimeId _lastNonPremiumLimitUpload = 0;
+	PeerId _lastOpenedPeerId = 0;
+	MsgId _lastOpenedMsgId = 0;
 
 	Support::SwitchSettings _supportSwitch;
 	bool _supportFixChatsOrder = true;
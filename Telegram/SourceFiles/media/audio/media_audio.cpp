@@ -27,6 +27,11 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include <numeric>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define TD_WAVEFORM_SSE2
+#include <emmintrin.h>
+#endif // defined(__x86_64__) || defined(_M_X64)
+
 Q_DECLARE_METATYPE(AudioMsgId);
 Q_DECLARE_METATYPE(VoiceWaveform);
 
@@ -338,8 +343,18 @@ void Mixer::Track::detach() {
 	destroyStream();
 }
 
+// Stops the source and unqueues the buffers, but keeps the generated
+// OpenAL objects alive for the next playback, so that starting a voice
+// message doesn't delete and regenerate them under AudioMutex each
+// time. The objects are really destroyed on detach(), when the device
+// itself is being closed.
+void Mixer::Track::recycle() {
+	getNotQueuedBufferIndex();
+	resetStream();
+}
+
 void Mixer::Track::clear() {
-	detach();
+	recycle();
 
 	state = TrackState();
 	file = Core::FileLocation();
@@ -1532,6 +1547,42 @@ Ui::PreparedFileInformation PrepareForSending(
 
 } // namespace Player
 
+namespace {
+
+[[nodiscard]] uint16 SamplesPeak(const uchar *data, int count) {
+	auto result = uint16(0);
+	for (auto i = 0; i != count; ++i) {
+		accumulate_max(result, Audio::ReadOneSample(data[i]));
+	}
+	return result;
+}
+
+[[nodiscard]] uint16 SamplesPeak(const int16 *data, int count) {
+	auto result = uint16(0);
+#ifdef TD_WAVEFORM_SSE2
+	// SSE2 is baseline on x86_64, take |sample| of eight samples at once
+	// (with saturation, so -32768 becomes 32767 instead of overflowing).
+	auto peaks = _mm_setzero_si128();
+	for (; count >= 8; count -= 8, data += 8) {
+		const auto loaded = _mm_loadu_si128(
+			reinterpret_cast<const __m128i*>(data));
+		peaks = _mm_max_epi16(peaks, _mm_max_epi16(
+			loaded,
+			_mm_subs_epi16(_mm_setzero_si128(), loaded)));
+	}
+	peaks = _mm_max_epi16(peaks, _mm_srli_si128(peaks, 8));
+	peaks = _mm_max_epi16(peaks, _mm_srli_si128(peaks, 4));
+	peaks = _mm_max_epi16(peaks, _mm_srli_si128(peaks, 2));
+	result = uint16(_mm_cvtsi128_si32(peaks) & 0xFFFF);
+#endif // TD_WAVEFORM_SSE2
+	for (; count > 0; --count, ++data) {
+		accumulate_max(result, Audio::ReadOneSample(*data));
+	}
+	return result;
+}
+
+} // namespace
+
 class FFMpegWaveformCounter : public FFMpegLoader {
 public:
 	FFMpegWaveformCounter(const Core::FileLocation &file, const QByteArray &data) : FFMpegLoader(file, data, bytes::vector()) {
@@ -1557,13 +1608,25 @@ public:
 
 		auto fmt = format();
 		auto peak = uint16(0);
-		auto callback = [&](uint16 sample) {
-			accumulate_max(peak, sample);
-			sumbytes += Media::Player::kWaveformSamplesCount;
-			if (sumbytes >= countbytes) {
-				sumbytes -= countbytes;
-				peaks.push_back(peak);
-				peak = 0;
+		// Instead of branching on the bucket boundary per sample, compute
+		// how many samples are left in the current bucket and find their
+		// peak in one (vectorized) pass.
+		const auto process = [&](const auto *samples, int64 count) {
+			const auto perSample = int64(
+				Media::Player::kWaveformSamplesCount);
+			while (count > 0) {
+				const auto till = (countbytes - sumbytes + perSample - 1)
+					/ perSample;
+				const auto take = std::min(count, till);
+				accumulate_max(peak, SamplesPeak(samples, int(take)));
+				samples += take;
+				count -= take;
+				sumbytes += take * perSample;
+				if (sumbytes >= countbytes) {
+					sumbytes -= countbytes;
+					peaks.push_back(peak);
+					peak = 0;
+				}
 			}
 		};
 		while (processed < countbytes) {
@@ -1579,9 +1642,13 @@ public:
 			const auto sampleBytes = v::get<bytes::const_span>(result);
 			Assert(!sampleBytes.empty());
 			if (fmt == AL_FORMAT_MONO8 || fmt == AL_FORMAT_STEREO8) {
-				Media::Audio::IterateSamples<uchar>(sampleBytes, callback);
+				process(
+					reinterpret_cast<const uchar*>(sampleBytes.data()),
+					sampleBytes.size());
 			} else if (fmt == AL_FORMAT_MONO16 || fmt == AL_FORMAT_STEREO16) {
-				Media::Audio::IterateSamples<int16>(sampleBytes, callback);
+				process(
+					reinterpret_cast<const int16*>(sampleBytes.data()),
+					sampleBytes.size() / 2);
 			}
 			processed += sampleBytes.size();
 		}
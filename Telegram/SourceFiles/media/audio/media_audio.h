@@ -214,6 +214,7 @@ private:
 
 		// Thread: Main. Must be locked: AudioMutex.
 		void detach();
+		void recycle();
 		void clear();
 
 		void started();
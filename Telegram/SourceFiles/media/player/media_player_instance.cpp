@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "media/player/media_player_instance.h"
 
 #include "data/data_document.h"
+#include "data/data_document_media.h"
 #include "data/data_session.h"
 #include "data/data_changes.h"
 #include "data/data_streaming.h"
@@ -333,9 +334,38 @@ void Instance::playlistUpdated(not_null<Data*> data) {
 		data->playlistIndex = std::nullopt;
 		data->shuffleData = nullptr;
 	}
+	preloadNextTrack(data);
 	data->playlistChanges.fire({});
 }
 
+void Instance::preloadNextTrack(not_null<Data*> data) {
+	// Pull the next track's bytes into the cache while the current one
+	// plays, so the automatic switch doesn't have to wait for network.
+	// With shuffle the next track isn't known in advance, skip it.
+	if (!data->playlistIndex || order(data) == OrderMode::Shuffle) {
+		data->nextPreload = nullptr;
+		return;
+	}
+	const auto delta = (order(data) == OrderMode::Reverse) ? -1 : 1;
+	const auto item = itemByIndex(data, *data->playlistIndex + delta);
+	const auto media = item ? item->media() : nullptr;
+	const auto document = (media && !media->ttlSeconds())
+		? media->document()
+		: nullptr;
+	if (!document
+		|| !(document->isAudioFile()
+			|| document->isVoiceMessage()
+			|| document->isVideoMessage())) {
+		data->nextPreload = nullptr;
+		return;
+	} else if (data->nextPreload
+		&& data->nextPreload->owner() == document) {
+		return;
+	}
+	data->nextPreload = document->createMediaView();
+	data->nextPreload->automaticLoad(item->fullId(), item);
+}
+
 bool Instance::validPlaylist(not_null<const Data*> data) const {
 	if (const auto key = playlistKey(data)) {
 		if (!data->playlistSlice) {
@@ -14,6 +14,10 @@ class AudioMsgId;
 class DocumentData;
 class History;
 
+namespace Data {
+class DocumentMedia;
+} // namespace Data
+
 namespace Media {
 enum class RepeatMode;
 enum class OrderMode;
@@ -200,6 +204,7 @@ private:
 		bool resumeOnCallEnd = false;
 		std::unique_ptr<Streamed> streamed;
 		std::unique_ptr<ShuffleData> shuffleData;
+		std::shared_ptr<Data::DocumentMedia> nextPreload;
 		std::unique_ptr<base::PowerSaveBlocker> powerSaveBlocker;
 		std::unique_ptr<base::PowerSaveBlocker> powerSaveBlockerVideo;
 	};
@@ -240,6 +245,7 @@ private:
 	bool validOtherPlaylist(not_null<const Data*> data) const;
 	void validateOtherPlaylist(not_null<Data*> data);
 	void playlistUpdated(not_null<Data*> data);
+	void preloadNextTrack(not_null<Data*> data);
 	bool moveInPlaylist(not_null<Data*> data, int delta, bool autonext);
 	void updatePowerSaveBlocker(
 		not_null<Data*> data,
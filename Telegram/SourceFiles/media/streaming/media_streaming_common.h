@@ -47,6 +47,7 @@ struct PlaybackOptions {
 	bool waitForMarkAsShown = false;
 	bool hwAllowed = false;
 	bool seekable = true;
+	bool priorityDecode = false; // Wins over autoplay tracks under load.
 	bool loop = false;
 };
 
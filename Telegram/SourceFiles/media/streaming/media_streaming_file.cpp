@@ -36,9 +36,11 @@ constexpr auto kMaxQueuedPackets = 1024;
 
 File::Context::Context(
 	not_null<FileDelegate*> delegate,
-	not_null<Reader*> reader)
+	not_null<Reader*> reader,
+	not_null<SeekIndex*> seekIndex)
 : _delegate(delegate)
 , _reader(reader)
+, _seekIndex(seekIndex)
 , _size(reader->size()) {
 }
 
@@ -256,6 +258,59 @@ void File::Context::seekToPosition(
 	return logFatal(qstr("av_seek_frame"), error);
 }
 
+void File::Context::restoreSeekIndex(
+		not_null<AVFormatContext*> format) const {
+#if DA_FFMPEG_HAVE_INDEX_ENTRIES
+	for (const auto &[index, entries] : _seekIndex->byStream) {
+		if (index >= int(format->nb_streams)) {
+			continue;
+		}
+		const auto stream = format->streams[index];
+		if (avformat_index_get_entries_count(stream)
+			>= int(entries.size())) {
+			continue;
+		}
+		for (const auto &entry : entries) {
+			av_add_index_entry(
+				stream,
+				entry.pos,
+				entry.timestamp,
+				entry.size,
+				entry.distance,
+				entry.keyframe ? AVINDEX_KEYFRAME : 0);
+		}
+	}
+#endif // DA_FFMPEG_HAVE_INDEX_ENTRIES
+}
+
+void File::Context::saveSeekIndex() {
+#if DA_FFMPEG_HAVE_INDEX_ENTRIES
+	if (!_format) {
+		return;
+	}
+	for (auto i = 0; i != int(_format->nb_streams); ++i) {
+		const auto stream = _format->streams[i];
+		const auto count = avformat_index_get_entries_count(stream);
+		auto &saved = _seekIndex->byStream[i];
+		if (count <= int(saved.size())) {
+			continue;
+		}
+		saved.clear();
+		saved.reserve(count);
+		for (auto j = 0; j != count; ++j) {
+			const auto entry = avformat_index_get_entry(stream, j);
+			saved.push_back({
+				.pos = entry->pos,
+				.timestamp = entry->timestamp,
+				.size = int(entry->size),
+				.distance = int(entry->min_distance),
+				.keyframe = ((entry->flags & AVINDEX_KEYFRAME) != 0),
+			});
+		}
+	}
+#endif // DA_FFMPEG_HAVE_INDEX_ENTRIES
+}
+
 std::variant<FFmpeg::Packet, FFmpeg::AvErrorWrap> File::Context::readPacket() {
 	auto error = FFmpeg::AvErrorWrap();
 
@@ -316,6 +371,7 @@ void File::Context::start(StartOptions options) {
 		sendFullInCache(true);
 	}
 	if (options.seekable && (video.codec || audio.codec)) {
+		restoreSeekIndex(format.get());
 		seekToPosition(
 			format.get(),
 			video.codec ? video : audio,
@@ -453,7 +509,7 @@ void File::start(not_null<FileDelegate*> delegate, StartOptions options) {
 	stop(true);
 
 	_reader->startStreaming();
-	_context.emplace(delegate, _reader.get());
+	_context.emplace(delegate, _reader.get(), &_seekIndex);
 
 	_thread = std::thread([=, context = &*_context] {
 		crl::toggle_fp_exceptions(true);
@@ -477,6 +533,7 @@ void File::stop(bool stillActive) {
 	if (_thread.joinable()) {
 		_context->interrupt();
 		_thread.join();
+		_context->saveSeekIndex();
 	}
 	_reader->stopStreaming(stillActive);
 	_context.reset();
@@ -48,13 +48,30 @@ public:
 	~File();
 
 private:
+	// Seek index entries collected while demuxing, they survive the
+	// per-seek context restarts, so scrubbing doesn't rebuild the index.
+	struct SeekIndex {
+		struct Entry {
+			int64 pos = 0;
+			int64 timestamp = 0;
+			int size = 0;
+			int distance = 0;
+			bool keyframe = false;
+		};
+		base::flat_map<int, std::vector<Entry>> byStream;
+	};
+
 	class Context final : public base::has_weak_ptr {
 	public:
-		Context(not_null<FileDelegate*> delegate, not_null<Reader*> reader);
+		Context(
+			not_null<FileDelegate*> delegate,
+			not_null<Reader*> reader,
+			not_null<SeekIndex*> seekIndex);
 		~Context();
 
 		void start(StartOptions options);
 		void readNextPacket();
+		void saveSeekIndex();
 
 		void interrupt();
 		void wake();
@@ -91,6 +108,7 @@ private:
 			not_null<AVFormatContext *> format,
 			const Stream &stream,
 			crl::time position);
+		void restoreSeekIndex(not_null<AVFormatContext*> format) const;
 
 		// TODO base::expected.
 		[[nodiscard]] auto readPacket()
@@ -102,6 +120,7 @@ private:
 
 		const not_null<FileDelegate*> _delegate;
 		const not_null<Reader*> _reader;
+		const not_null<SeekIndex*> _seekIndex;
 
 		base::flat_map<int, std::vector<FFmpeg::Packet>> _queuedPackets;
 		int64 _offset = 0;
@@ -118,6 +137,7 @@ private:
 
 	std::optional<Context> _context;
 	std::shared_ptr<Reader> _reader;
+	SeekIndex _seekIndex;
 	std::thread _thread;
 
 };
@@ -25,6 +25,9 @@ constexpr auto kSlicesInMemory = 2;
 
 // 1 MB of parts are requested from cloud ahead of reading demand.
 constexpr auto kPreloadPartsAhead = 8;
+constexpr auto kPreloadPartsAheadMax = 32;
+constexpr auto kReadaheadDuration = 2 * crl::time(1000);
+constexpr auto kReadaheadRateWindow = crl::time(500);
 constexpr auto kDownloaderRequestsLimit = 4;
 
 using PartsMap = base::flat_map<uint32, QByteArray>;
@@ -270,13 +273,14 @@ void Reader::Slice::addPart(uint32 offset, QByteArray bytes) {
 
 auto Reader::Slice::prepareFill(
 		uint32 from,
-		uint32 till) -> PrepareFillResult {
+		uint32 till,
+		int preloadParts) -> PrepareFillResult {
 	auto result = PrepareFillResult();
 
 	result.ready = false;
 	const auto fromOffset = (from / kPartSize) * kPartSize;
 	const auto tillPart = (till + kPartSize - 1) / kPartSize;
-	const auto preloadTillOffset = (tillPart + kPreloadPartsAhead)
+	const auto preloadTillOffset = (tillPart + preloadParts)
 		* kPartSize;
 
 	const auto after = ranges::upper_bound(
@@ -548,7 +552,11 @@ void Reader::Slices::processPart(
 	checkSliceFullLoaded(index + 1);
 }
 
-auto Reader::Slices::fill(uint32 offset, bytes::span buffer) -> FillResult {
+auto Reader::Slices::fill(
+	uint32 offset,
+	bytes::span buffer,
+	int preloadParts)
+-> FillResult {
 	Expects(!buffer.empty());
 	Expects(offset < _size);
 	Expects(offset + buffer.size() <= _size);
@@ -562,7 +570,7 @@ auto Reader::Slices::fill(uint32 offset, bytes::span buffer) -> FillResult {
 		Assert(waitingForHeaderCache());
 		return {};
 	} else if (isFullInHeader()) {
-		return fillFromHeader(offset, buffer);
+		return fillFromHeader(offset, buffer, preloadParts);
 	}
 
 	auto result = FillResult();
@@ -605,9 +613,15 @@ auto Reader::Slices::fill(uint32 offset, bytes::span buffer) -> FillResult {
 	const auto secondTill = (till > (fromSlice + 1) * kInSlice)
 		? (till - (fromSlice + 1) * kInSlice)
 		: 0;
-	const auto first = _data[fromSlice].prepareFill(firstFrom, firstTill);
+	const auto first = _data[fromSlice].prepareFill(
+		firstFrom,
+		firstTill,
+		preloadParts);
 	const auto second = (fromSlice + 1 < tillSlice)
-		? _data[fromSlice + 1].prepareFill(secondFrom, secondTill)
+		? _data[fromSlice + 1].prepareFill(
+			secondFrom,
+			secondTill,
+			preloadParts)
 		: Slice::PrepareFillResult();
 	handlePrepareResult(fromSlice, first);
 	if (fromSlice + 1 < tillSlice) {
@@ -639,13 +653,16 @@ auto Reader::Slices::fill(uint32 offset, bytes::span buffer) -> FillResult {
 	return result;
 }
 
-auto Reader::Slices::fillFromHeader(uint32 offset, bytes::span buffer)
+auto Reader::Slices::fillFromHeader(
+	uint32 offset,
+	bytes::span buffer,
+	int preloadParts)
 -> FillResult {
 	auto result = FillResult();
 	const auto from = offset;
 	const auto till = uint32(offset + buffer.size());
 
-	const auto prepared = _header.prepareFill(from, till);
+	const auto prepared = _header.prepareFill(from, till, preloadParts);
 	for (const auto full : prepared.offsetsFromLoader.values()) {
 		if (full < _size) {
 			result.offsetsFromLoader.add(full);
@@ -1238,6 +1255,7 @@ Reader::FillState Reader::fill(
 	};
 	const auto done = [&] {
 		clearWaiting();
+		accountFilledBytes(uint32(buffer.size()));
 		return FillState::Success;
 	};
 	const auto failed = [&] {
@@ -1266,7 +1284,7 @@ Reader::FillState Reader::fill(
 Reader::FillState Reader::fillFromSlices(uint32 offset, bytes::span buffer) {
 	using namespace rpl::mappers;
 
-	auto result = _slices.fill(offset, buffer);
+	auto result = _slices.fill(offset, buffer, readaheadParts());
 	if (result.state != FillState::Success && _slices.headerWontBeFilled()) {
 		_streamingError = Error::NotStreamable;
 		return FillState::Failed;
@@ -1296,6 +1314,35 @@ Reader::FillState Reader::fillFromSlices(uint32 offset, bytes::span buffer) {
 	return result.state;
 }
 
+void Reader::accountFilledBytes(uint32 count) {
+	const auto now = crl::now();
+	if (!_fillRateStart) {
+		_fillRateStart = now;
+	}
+	_fillRateBytes += count;
+	const auto elapsed = now - _fillRateStart;
+	if (elapsed >= kReadaheadRateWindow) {
+		const auto rate = _fillRateBytes / float64(elapsed);
+		_fillBytesPerMs = _fillBytesPerMs
+			? (0.7 * _fillBytesPerMs + 0.3 * rate)
+			: rate;
+		_fillRateStart = now;
+		_fillRateBytes = 0;
+	}
+}
+
+int Reader::readaheadParts() const {
+	if (_fillBytesPerMs <= 0.) {
+		return kPreloadPartsAhead;
+	}
+	// Keep kReadaheadDuration of playback buffered ahead.
+	const auto desired = _fillBytesPerMs * kReadaheadDuration;
+	return std::clamp(
+		int(desired / kPartSize) + 1,
+		kPreloadPartsAhead,
+		kPreloadPartsAheadMax);
+}
+
 void Reader::cancelLoadInRange(uint32 from, uint32 till) {
 	Expects(from < till);
 
@@ -134,7 +134,10 @@ private:
 
 		void processCacheData(PartsMap &&data);
 		void addPart(uint32 offset, QByteArray bytes);
-		PrepareFillResult prepareFill(uint32 from, uint32 till);
+		PrepareFillResult prepareFill(
+			uint32 from,
+			uint32 till,
+			int preloadParts);
 
 		// Get up to kLoadFromRemoteMax not loaded parts in from-till range.
 		StackIntVector<kLoadFromRemoteMax> offsetsFromLoader(
@@ -165,7 +168,10 @@ private:
 		void processCachedSizes(const std::vector<int> &sizes);
 		void processPart(uint32 offset, QByteArray &&bytes);
 
-		[[nodiscard]] FillResult fill(uint32 offset, bytes::span buffer);
+		[[nodiscard]] FillResult fill(
+			uint32 offset,
+			bytes::span buffer,
+			int preloadParts);
 		[[nodiscard]] SerializedSlice unloadToCache();
 
 		[[nodiscard]] QByteArray partForDownloader(uint32 offset) const;
@@ -192,7 +198,8 @@ private:
 		[[nodiscard]] bool computeIsGoodHeader() const;
 		[[nodiscard]] FillResult fillFromHeader(
 			uint32 offset,
-			bytes::span buffer);
+			bytes::span buffer,
+			int preloadParts);
 		void unloadSlice(Slice &slice) const;
 		void checkSliceFullLoaded(int sliceNumber);
 		[[nodiscard]] bool checkFullInCache() const;
@@ -221,6 +228,8 @@ private:
 	bool checkForSomethingMoreReceived();
 
 	FillState fillFromSlices(uint32 offset, bytes::span buffer);
+	void accountFilledBytes(uint32 count);
+	[[nodiscard]] int readaheadParts() const;
 
 	void finalizeCache();
 
@@ -265,6 +274,11 @@ private:
 	int _realPriority = 1;
 	bool _streamingActive = false;
 
+	// Streaming thread. Consumption rate for the readahead window.
+	crl::time _fillRateStart = 0;
+	uint32 _fillRateBytes = 0;
+	float64 _fillBytesPerMs = 0.;
+
 	// Streaming thread.
 	std::deque<uint32> _offsetsForDownloader;
 	base::flat_set<uint32> _downloaderOffsetsRequested;
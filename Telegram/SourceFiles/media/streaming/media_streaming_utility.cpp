@@ -12,6 +12,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/painter.h"
 #include "ffmpeg/ffmpeg_utility.h"
 
+extern "C" {
+#include <libavutil/hwcontext.h>
+} // extern "C"
+
 namespace Media {
 namespace Streaming {
 namespace {
@@ -121,6 +125,23 @@ bool TransferFrame(
 		not_null<AVFrame*> transferredFrame) {
 	Expects(decodedFrame->hw_frames_ctx != nullptr);
 
+	// Ask for a format the GL renderers take as raw planes (NV12 or
+	// YUV420P), any other transfer format goes through sws_scale after.
+	auto formats = (enum AVPixelFormat*)nullptr;
+	const auto gotFormats = av_hwframe_transfer_get_formats(
+		decodedFrame->hw_frames_ctx,
+		AV_HWFRAME_TRANSFER_DIRECTION_FROM,
+		&formats,
+		0);
+	if (gotFormats >= 0) {
+		const auto guard = gsl::finally([&] { av_freep(&formats); });
+		for (auto i = formats; *i != AV_PIX_FMT_NONE; ++i) {
+			if (*i == AV_PIX_FMT_NV12 || *i == AV_PIX_FMT_YUV420P) {
+				transferredFrame->format = *i;
+				break;
+			}
+		}
+	}
 	const auto error = FFmpeg::AvErrorWrap(
 		av_hwframe_transfer_data(transferredFrame, decodedFrame, 0));
 	if (error) {
@@ -294,16 +315,34 @@ QImage PrepareBlurredBackground(QSize outer, QImage frame) {
 	const auto copyh = std::min(
 		bsize.height(),
 		std::max(outer.height() * bsize.width() / outer.width(), 1));
-	auto copy = (bsize == QSize(copyw, copyh))
-		? std::move(frame)
-		: frame.copy(
-			(bsize.width() - copyw) / 2,
-			(bsize.height() - copyh) / 2,
-			copyw,
-			copyh);
-	auto scaled = (copy.width() <= 100 && copy.height() <= 100)
-		? std::move(copy)
-		: copy.scaled(40, 40, Qt::KeepAspectRatio, Qt::FastTransformation);
+	if (copyw <= 100 && copyh <= 100) {
+		auto copy = (bsize == QSize(copyw, copyh))
+			? std::move(frame)
+			: frame.copy(
+				(bsize.width() - copyw) / 2,
+				(bsize.height() - copyh) / 2,
+				copyw,
+				copyh);
+		return Images::Blur(std::move(copy), true);
+	}
+	// Scale the center crop in a single pass, allocating and copying
+	// the full-resolution cropped region is too expensive to do for
+	// every video frame.
+	const auto scaledSize = QSize(copyw, copyh)
+		.scaled(40, 40, Qt::KeepAspectRatio)
+		.expandedTo({ 1, 1 });
+	auto scaled = QImage(scaledSize, QImage::Format_ARGB32_Premultiplied);
+	{
+		auto p = QPainter(&scaled);
+		p.drawImage(
+			QRect(QPoint(), scaledSize),
+			frame,
+			QRect(
+				(bsize.width() - copyw) / 2,
+				(bsize.height() - copyh) / 2,
+				copyw,
+				copyh));
+	}
 	return Images::Blur(std::move(scaled), true);
 }
 
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "media/audio/media_audio.h"
 #include "base/concurrent_timer.h"
 #include "core/crash_reports.h"
+#include "core/frame_profiler.h"
 #include "base/debug_log.h"
 
 namespace Media {
@@ -20,8 +21,13 @@ namespace {
 constexpr auto kMaxFrameArea = 3840 * 2160; // usual 4K
 constexpr auto kDisplaySkipped = crl::time(-1);
 constexpr auto kFinishedPosition = std::numeric_limits<crl::time>::max();
+constexpr auto kBackgroundDecodeYield = crl::time(5);
 static_assert(kDisplaySkipped != kTimeUnknown);
 
+// All tracks decode on serial queues over the shared crl thread pool,
+// this counter lets autoplay tracks yield to the focused playback there.
+std::atomic<int> PriorityDecodersCount/* = 0*/;
+
 [[nodiscard]] QImage ConvertToARGB32(
 		FrameFormat format,
 		const FrameYUV &data) {
@@ -89,6 +95,7 @@ public:
 		const AudioMsgId &audioId,
 		FnMut<void(const Information &)> ready,
 		Fn<void(Error)> error);
+	~VideoTrackObject();
 
 	void process(std::vector<FFmpeg::Packet> &&packets);
 
@@ -194,6 +201,16 @@ VideoTrackObject::VideoTrackObject(
 	Expects(_stream.duration > 1);
 	Expects(_ready != nullptr);
 	Expects(_error != nullptr);
+
+	if (_options.priorityDecode) {
+		PriorityDecodersCount.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+VideoTrackObject::~VideoTrackObject() {
+	if (_options.priorityDecode) {
+		PriorityDecodersCount.fetch_sub(1, std::memory_order_relaxed);
+	}
 }
 
 rpl::producer<> VideoTrackObject::checkNextFrame() const {
@@ -265,6 +282,11 @@ int VideoTrackObject::durationByPacket(const FFmpeg::Packet &packet) {
 }
 
 void VideoTrackObject::queueReadFrames(crl::time delay) {
+	if (!delay
+		&& !_options.priorityDecode
+		&& PriorityDecodersCount.load(std::memory_order_relaxed) > 0) {
+		delay = kBackgroundDecodeYield;
+	}
 	if (delay > 0) {
 		_readFramesTimer.callOnce(delay);
 	} else if (!_queued) {
@@ -512,6 +534,7 @@ void VideoTrackObject::presentFrameIfNeeded() {
 	if (_pausedTime != kTimeUnknown || _resumedTime == kTimeUnknown) {
 		return;
 	}
+	const auto marker = Core::FrameMarker("VideoTrack::present");
 	const auto dropStaleFrames = !_options.waitForMarkAsShown;
 	const auto time = trackTime();
 	const auto presented = _shared->presentFrame(
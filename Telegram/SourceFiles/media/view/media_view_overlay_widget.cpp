@@ -3453,6 +3453,27 @@ void OverlayWidget::activate() {
 	setFocus();
 }
 
+void OverlayWidget::prewarmRenderer() {
+	if (!_opengl) {
+		return;
+	}
+	InvokeQueued(_widget, [=] {
+		if (!isHidden()) {
+			return;
+		}
+		if (const auto gl = qobject_cast<QOpenGLWidget*>(_widget.get())) {
+			// An offscreen grab initializes the context and runs
+			// RendererGL::init() with all the shader compilation.
+			_prewarming = true;
+			const auto guard = gsl::finally([&] {
+				_prewarming = false;
+			});
+			_window->createWinId();
+			gl->grabFramebuffer();
+		}
+	});
+}
+
 void OverlayWidget::show(OpenRequest request) {
 	const auto story = request.story();
 	const auto document = story ? story->document() : request.document();
@@ -4370,6 +4391,7 @@ void OverlayWidget::restartAtSeekPosition(crl::time position) {
 			: crl::time(0)),
 		.hwAllowed = Core::App().settings().hardwareAcceleratedVideo(),
 		.seekable = !_stories,
+		.priorityDecode = true,
 	};
 	if (!_streamed->withSound) {
 		options.mode = Streaming::Mode::Video;
@@ -4841,6 +4863,10 @@ Ui::GL::ChosenRenderer OverlayWidget::chooseRenderer(
 
 void OverlayWidget::paint(not_null<Renderer*> renderer) {
 	renderer->paintBackground();
+	if (_prewarming) {
+		// Only warming up the GL programs, nothing to show yet.
+		return;
+	}
 	if (contentShown()) {
 		if (videoShown()) {
 			renderer->paintTransformedVideoFrame(contentGeometry());
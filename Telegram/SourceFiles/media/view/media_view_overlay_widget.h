@@ -106,6 +106,10 @@ public:
 	[[nodiscard]] bool takeFocusFrom(not_null<QWidget*> window) const;
 	void activate();
 
+	// Creates the GL context and compiles the shaders while the window
+	// is still hidden, so the first media open doesn't stall on them.
+	void prewarmRenderer();
+
 	void show(OpenRequest request);
 
 	//void leaveToChildEvent(QEvent *e, QWidget *child) override {
@@ -537,6 +541,7 @@ private:
 	Window::SessionController *findWindow(bool switchTo = true) const;
 
 	bool _opengl = false;
+	bool _prewarming = false;
 	const std::unique_ptr<Ui::GL::Window> _wrap;
 	const not_null<Ui::RpWindow*> _window;
 	const std::unique_ptr<Platform::OverlayWidgetHelper> _helper;
@@ -1728,6 +1728,7 @@ void Pip::restartAtSeekPosition(crl::time position) {
 	options.hwAllowed = Core::App().settings().hardwareAcceleratedVideo();
 	options.audioId = _instance->player().prepareLegacyState().id;
 	options.speed = _delegate->pipPlaybackSpeed();
+	options.priorityDecode = true;
 
 	_instance->play(options);
 	if (_startPaused) {
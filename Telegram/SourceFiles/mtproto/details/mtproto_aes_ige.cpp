@@ -0,0 +1,209 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "mtproto/details/mtproto_aes_ige.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TD_AES_IGE_X86_64
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TD_AES_IGE_TARGET
+#else // _MSC_VER
+#include <cpuid.h>
+#define TD_AES_IGE_TARGET __attribute__((target("aes,sse2")))
+#endif // !_MSC_VER
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+#endif // defined(__x86_64__) || defined(_M_X64)
+
+namespace MTP::details {
+namespace {
+
+#ifdef TD_AES_IGE_X86_64
+
+constexpr auto kBlockSize = uint32(16);
+constexpr auto kScheduleSize = 15; // AES-256, 14 rounds.
+
+[[nodiscard]] bool DetectAesSupport() {
+#if defined(_MSC_VER)
+	int info[4] = { 0 };
+	__cpuid(info, 1);
+	return (info[2] & (1 << 25)) != 0;
+#else // _MSC_VER
+	auto eax = 0U, ebx = 0U, ecx = 0U, edx = 0U;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		return false;
+	}
+	return (ecx & (1U << 25)) != 0;
+#endif // !_MSC_VER
+}
+
+// One odd/even round pair of the AES-256 key schedule. The aeskeygenassist
+// round constant must be an immediate, hence a macro and not a helper.
+#define TD_AES_IGE_EXPAND(index, rcon) \
+	temp = _mm_aeskeygenassist_si128(schedule[(index) - 1], rcon); \
+	temp = _mm_shuffle_epi32(temp, 0xff); \
+	accum = schedule[(index) - 2]; \
+	accum = _mm_xor_si128(accum, _mm_slli_si128(accum, 4)); \
+	accum = _mm_xor_si128(accum, _mm_slli_si128(accum, 4)); \
+	accum = _mm_xor_si128(accum, _mm_slli_si128(accum, 4)); \
+	schedule[index] = _mm_xor_si128(accum, temp); \
+	temp = _mm_aeskeygenassist_si128(schedule[index], 0); \
+	temp = _mm_shuffle_epi32(temp, 0xaa); \
+	accum = schedule[(index) - 1]; \
+	accum = _mm_xor_si128(accum, _mm_slli_si128(accum, 4)); \
+	accum = _mm_xor_si128(accum, _mm_slli_si128(accum, 4)); \
+	accum = _mm_xor_si128(accum, _mm_slli_si128(accum, 4)); \
+	schedule[(index) + 1] = _mm_xor_si128(accum, temp);
+
+TD_AES_IGE_TARGET void ExpandKey256(const void *key, __m128i *schedule) {
+	auto temp = __m128i();
+	auto accum = __m128i();
+	const auto bytes = static_cast<const __m128i*>(key);
+	schedule[0] = _mm_loadu_si128(bytes);
+	schedule[1] = _mm_loadu_si128(bytes + 1);
+	TD_AES_IGE_EXPAND(2, 0x01);
+	TD_AES_IGE_EXPAND(4, 0x02);
+	TD_AES_IGE_EXPAND(6, 0x04);
+	TD_AES_IGE_EXPAND(8, 0x08);
+	TD_AES_IGE_EXPAND(10, 0x10);
+	TD_AES_IGE_EXPAND(12, 0x20);
+
+	temp = _mm_aeskeygenassist_si128(schedule[13], 0x40);
+	temp = _mm_shuffle_epi32(temp, 0xff);
+	accum = schedule[12];
+	accum = _mm_xor_si128(accum, _mm_slli_si128(accum, 4));
+	accum = _mm_xor_si128(accum, _mm_slli_si128(accum, 4));
+	accum = _mm_xor_si128(accum, _mm_slli_si128(accum, 4));
+	schedule[14] = _mm_xor_si128(accum, temp);
+}
+
+#undef TD_AES_IGE_EXPAND
+
+TD_AES_IGE_TARGET void InvertKey256(
+		const __m128i *schedule,
+		__m128i *inverted) {
+	inverted[0] = schedule[kScheduleSize - 1];
+	for (auto i = 1; i != kScheduleSize - 1; ++i) {
+		inverted[i] = _mm_aesimc_si128(schedule[kScheduleSize - 1 - i]);
+	}
+	inverted[kScheduleSize - 1] = schedule[0];
+}
+
+TD_AES_IGE_TARGET void EncryptIge(
+		const void *src,
+		void *dst,
+		uint32 len,
+		const __m128i *schedule,
+		const void *iv) {
+	const auto from = static_cast<const __m128i*>(src);
+	const auto till = from + (len / kBlockSize);
+	auto to = static_cast<__m128i*>(dst);
+	auto chainOut = _mm_loadu_si128(static_cast<const __m128i*>(iv));
+	auto chainIn = _mm_loadu_si128(static_cast<const __m128i*>(iv) + 1);
+	for (auto i = from; i != till; ++i, ++to) {
+		const auto in = _mm_loadu_si128(i);
+		auto block = _mm_xor_si128(in, chainOut);
+		block = _mm_xor_si128(block, schedule[0]);
+		for (auto round = 1; round != kScheduleSize - 1; ++round) {
+			block = _mm_aesenc_si128(block, schedule[round]);
+		}
+		block = _mm_aesenclast_si128(block, schedule[kScheduleSize - 1]);
+		const auto out = _mm_xor_si128(block, chainIn);
+		_mm_storeu_si128(to, out);
+		chainOut = out;
+		chainIn = in;
+	}
+}
+
+TD_AES_IGE_TARGET void DecryptIge(
+		const void *src,
+		void *dst,
+		uint32 len,
+		const __m128i *schedule,
+		const void *iv) {
+	const auto from = static_cast<const __m128i*>(src);
+	const auto till = from + (len / kBlockSize);
+	auto to = static_cast<__m128i*>(dst);
+	auto chainOut = _mm_loadu_si128(static_cast<const __m128i*>(iv));
+	auto chainIn = _mm_loadu_si128(static_cast<const __m128i*>(iv) + 1);
+	for (auto i = from; i != till; ++i, ++to) {
+		const auto in = _mm_loadu_si128(i);
+		auto block = _mm_xor_si128(in, chainIn);
+		block = _mm_xor_si128(block, schedule[0]);
+		for (auto round = 1; round != kScheduleSize - 1; ++round) {
+			block = _mm_aesdec_si128(block, schedule[round]);
+		}
+		block = _mm_aesdeclast_si128(block, schedule[kScheduleSize - 1]);
+		const auto out = _mm_xor_si128(block, chainOut);
+		_mm_storeu_si128(to, out);
+		chainOut = in;
+		chainIn = out;
+	}
+}
+
+#endif // TD_AES_IGE_X86_64
+
+} // namespace
+
+bool AesIgeHardwareAvailable() {
+#ifdef TD_AES_IGE_X86_64
+	static const auto result = DetectAesSupport();
+	return result;
+#else // TD_AES_IGE_X86_64
+	return false;
+#endif // !TD_AES_IGE_X86_64
+}
+
+bool AesIgeEncryptHardware(
+		const void *src,
+		void *dst,
+		uint32 len,
+		const void *key,
+		const void *iv) {
+#ifdef TD_AES_IGE_X86_64
+	Expects((len & (kBlockSize - 1)) == 0);
+
+	if (!AesIgeHardwareAvailable()) {
+		return false;
+	}
+	__m128i schedule[kScheduleSize];
+	ExpandKey256(key, schedule);
+	EncryptIge(src, dst, len, schedule, iv);
+	return true;
+#else // TD_AES_IGE_X86_64
+	return false;
+#endif // !TD_AES_IGE_X86_64
+}
+
+bool AesIgeDecryptHardware(
+		const void *src,
+		void *dst,
+		uint32 len,
+		const void *key,
+		const void *iv) {
+#ifdef TD_AES_IGE_X86_64
+	Expects((len & (kBlockSize - 1)) == 0);
+
+	if (!AesIgeHardwareAvailable()) {
+		return false;
+	}
+	__m128i schedule[kScheduleSize];
+	__m128i inverted[kScheduleSize];
+	ExpandKey256(key, schedule);
+	InvertKey256(schedule, inverted);
+	DecryptIge(src, dst, len, inverted, iv);
+	return true;
+#else // TD_AES_IGE_X86_64
+	return false;
+#endif // !TD_AES_IGE_X86_64
+}
+
+} // namespace MTP::details
@@ -0,0 +1,35 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace MTP::details {
+
+// Hardware AES-256-IGE using AES-NI, dispatched at runtime. The generic
+// OpenSSL AES_ige_encrypt() chains blocks through the table-based
+// AES_encrypt() and never reaches the accelerated EVP paths, so on every
+// packet it costs several times more than the instruction-set version.
+
+[[nodiscard]] bool AesIgeHardwareAvailable();
+
+// Both expect len to be a multiple of the AES block size and support
+// src == dst for in-place operation. Return false when the hardware
+// path is unavailable and the caller should use the OpenSSL fallback.
+bool AesIgeEncryptHardware(
+	const void *src,
+	void *dst,
+	uint32 len,
+	const void *key,
+	const void *iv);
+bool AesIgeDecryptHardware(
+	const void *src,
+	void *dst,
+	uint32 len,
+	const void *key,
+	const void *iv);
+
+} // namespace MTP::details
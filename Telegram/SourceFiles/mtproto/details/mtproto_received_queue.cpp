@@ -0,0 +1,72 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "mtproto/details/mtproto_received_queue.h"
+
+namespace MTP::details {
+
+ReceivedQueue::~ReceivedQueue() {
+	while (_drained) {
+		delete std::exchange(_drained, _drained->next);
+	}
+	auto node = _pushed.exchange(nullptr, std::memory_order_acquire);
+	while (node) {
+		delete std::exchange(node, node->next);
+	}
+}
+
+void ReceivedQueue::push(Response &&response) {
+	const auto node = new Node(std::move(response));
+	node->next = _pushed.load(std::memory_order_relaxed);
+	while (!_pushed.compare_exchange_weak(
+		node->next,
+		node,
+		std::memory_order_release,
+		std::memory_order_relaxed)) {
+	}
+}
+
+bool ReceivedQueue::scheduleWakeup() {
+	return !_wakeupScheduled.exchange(true, std::memory_order_acq_rel);
+}
+
+void ReceivedQueue::wakeupHandled() {
+	_wakeupScheduled.store(false, std::memory_order_release);
+}
+
+std::vector<Response> ReceivedQueue::take(int limit) {
+	auto result = std::vector<Response>();
+	while (int(result.size()) < limit) {
+		if (!_drained) {
+			auto node = _pushed.exchange(
+				nullptr,
+				std::memory_order_acquire);
+			if (!node) {
+				break;
+			}
+			// Reverse the grabbed LIFO into FIFO order.
+			while (node) {
+				const auto next = node->next;
+				node->next = _drained;
+				_drained = node;
+				node = next;
+			}
+		}
+		while (_drained && int(result.size()) < limit) {
+			result.push_back(std::move(_drained->response));
+			delete std::exchange(_drained, _drained->next);
+		}
+	}
+	return result;
+}
+
+bool ReceivedQueue::hasPending() const {
+	return (_drained != nullptr)
+		|| (_pushed.load(std::memory_order_acquire) != nullptr);
+}
+
+} // namespace MTP::details
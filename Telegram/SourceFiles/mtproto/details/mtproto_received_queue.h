@@ -0,0 +1,58 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "mtproto/mtproto_response.h"
+
+#include <atomic>
+
+namespace MTP::details {
+
+// Lock-free MPSC handoff of parsed responses / updates from the
+// session thread to the main thread. During channel catch-up tens of
+// thousands of messages go through this queue, so producers push to an
+// atomic stack without taking any lock and the consumer drains them in
+// bounded batches, one main-thread wakeup per burst.
+class ReceivedQueue final {
+public:
+	ReceivedQueue() = default;
+	ReceivedQueue(const ReceivedQueue &) = delete;
+	ReceivedQueue &operator=(const ReceivedQueue &) = delete;
+	~ReceivedQueue();
+
+	// Any thread.
+	void push(Response &&response);
+
+	// Returns true if the caller should wake the consumer up,
+	// false if a wakeup is already scheduled and not yet handled.
+	[[nodiscard]] bool scheduleWakeup();
+
+	// Consumer thread only.
+	void wakeupHandled();
+	[[nodiscard]] std::vector<Response> take(int limit);
+	[[nodiscard]] bool hasPending() const;
+
+private:
+	struct Node {
+		explicit Node(Response &&response)
+		: response(std::move(response)) {
+		}
+
+		Response response;
+		Node *next = nullptr;
+	};
+
+	// Producers push to an atomic LIFO, the consumer grabs the whole
+	// stack at once, reverses it and keeps the FIFO remainder local.
+	std::atomic<Node*> _pushed = nullptr;
+	Node *_drained = nullptr;
+	std::atomic<bool> _wakeupScheduled = false;
+
+};
+
+} // namespace MTP::details
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/details/mtproto_rsa_public_key.h"
 #include "mtproto/special_config_request.h"
 #include "mtproto/session.h"
+#include "mtproto/session_private.h"
 #include "mtproto/mtproto_config.h"
 #include "mtproto/mtproto_dc_options.h"
 #include "mtproto/config_loader.h"
@@ -32,11 +33,22 @@ namespace {
 
 constexpr auto kConfigBecomesOldIn = 2 * 60 * crl::time(1000);
 constexpr auto kConfigBecomesOldForBlockedIn = 8 * crl::time(1000);
+constexpr auto kFloodPacingStartInterval = crl::time(500);
+constexpr auto kFloodPacingMaxInterval = 20 * crl::time(1000);
+constexpr auto kFloodPacingForgetTimeout = 5 * 60 * crl::time(1000);
 
 using namespace details;
 
 std::atomic<int> GlobalAtomicRequestId = 0;
 
+[[nodiscard]] mtpTypeId RequestMethodId(const SerializedRequest &request) {
+	if (!request
+		|| request->size() <= SerializedRequest::kMessageBodyPosition) {
+		return 0;
+	}
+	return mtpTypeId((*request)[SerializedRequest::kMessageBodyPosition]);
+}
+
 } // namespace
 
 namespace details {
@@ -111,6 +123,7 @@ public:
 	void killSession(ShiftedDcId shiftedDcId);
 	void stopSession(ShiftedDcId shiftedDcId);
 	void reInitConnection(DcId dcId);
+	void importAuthIfNeeded(DcId dcId);
 	void logout(Fn<void()> done);
 
 	not_null<Dcenter*> getDcById(ShiftedDcId shiftedDcId);
@@ -216,6 +229,15 @@ private:
 		mtpRequestId requestId, DcId newdc);
 
 	void checkDelayedRequests();
+	void delayRequest(mtpRequestId requestId, crl::time sendAt);
+
+	[[nodiscard]] crl::time floodPacingDelay(
+		DcId dcId,
+		const SerializedRequest &request);
+	void learnFloodLimit(
+		DcId dcId,
+		const SerializedRequest &request,
+		crl::time waitFor);
 
 	const not_null<Instance*> _instance;
 	const Instance::Mode _mode = Instance::Mode::Normal;
@@ -276,9 +298,21 @@ private:
 
 	std::map<mtpRequestId, int> _requestsDelays;
 
+	// Rate ceilings learned from FLOOD_WAIT errors, keyed by bare dc id
+	// and method constructor id, so bulk operations pace themselves
+	// instead of slamming every following request into the same limit.
+	struct FloodPacingEntry {
+		crl::time blockedUntil = 0;
+		crl::time interval = 0;
+		crl::time nextPlanned = 0;
+		crl::time lastFlood = 0;
+	};
+	base::flat_map<std::pair<DcId, mtpTypeId>, FloodPacingEntry> _floodPacing;
+
 	std::set<mtpRequestId> _badGuestDcRequests;
 
 	std::map<DcId, std::vector<mtpRequestId>> _authWaiters;
+	std::set<DcId> _authImportRequested;
 
 	Fn<void(const Response&)> _updatesHandler;
 	Fn<void(const Error&, const Response&)> _globalFailHandler;
@@ -325,6 +359,9 @@ Instance::Private::Private(
 
 	_networkReachability->availableChanges(
 	) | rpl::start_with_next([=](bool available) {
+		// The endpoints that won connection races on the old network
+		// may be the worst choice on the new one.
+		details::ClearLastGoodEndpoints();
 		restart();
 	}, _lifetime);
 
@@ -382,7 +419,19 @@ void Instance::Private::start() {
 	_checkDelayedTimer.setCallback([this] { checkDelayedRequests(); });
 
 	Assert(!hasMainDcId() == isKeysDestroyer());
-	requestConfig();
+
+	const auto left = _config->values().expiresAt - base::unixtime::now();
+	if (!isKeysDestroyer()
+		&& (left > 0)
+		&& !_config->values().blockedMode) {
+		// The sessions already run on the persisted config, so while
+		// it hasn't expired just schedule the revalidation for when it
+		// does instead of spending a round trip on every cold start.
+		_configExpiresAt = crl::now() + left * crl::time(1000);
+		requestConfigIfExpired();
+	} else {
+		requestConfig();
+	}
 }
 
 void Instance::Private::resolveProxyDomain(const QString &host) {
@@ -1002,6 +1051,76 @@ void Instance::Private::checkDelayedRequests() {
 	}
 }
 
+void Instance::Private::delayRequest(
+		mtpRequestId requestId,
+		crl::time sendAt) {
+	auto it = _delayedRequests.begin(), e = _delayedRequests.end();
+	for (; it != e; ++it) {
+		if (it->first == requestId) {
+			return;
+		} else if (it->second > sendAt) {
+			break;
+		}
+	}
+	_delayedRequests.insert(it, std::make_pair(requestId, sendAt));
+
+	checkDelayedRequests();
+}
+
+crl::time Instance::Private::floodPacingDelay(
+		DcId dcId,
+		const SerializedRequest &request) {
+	const auto method = RequestMethodId(request);
+	if (!method) {
+		return 0;
+	}
+	const auto i = _floodPacing.find(std::pair(dcId, method));
+	if (i == end(_floodPacing)) {
+		return 0;
+	}
+	auto &entry = i->second;
+	const auto now = crl::now();
+	if (now - entry.lastFlood >= kFloodPacingForgetTimeout) {
+		// The ceiling is short-lived server state, don't keep throttling
+		// the method when it hasn't flooded in a while.
+		_floodPacing.erase(i);
+		return 0;
+	}
+	const auto planned = std::max({
+		now,
+		entry.blockedUntil,
+		entry.nextPlanned + entry.interval });
+	entry.nextPlanned = planned;
+	return planned - now;
+}
+
+void Instance::Private::learnFloodLimit(
+		DcId dcId,
+		const SerializedRequest &request,
+		crl::time waitFor) {
+	const auto method = RequestMethodId(request);
+	if (!method) {
+		return;
+	}
+	const auto now = crl::now();
+	auto &entry = _floodPacing[std::pair(dcId, method)];
+
+	// A repeated flood means the current spacing is still too tight.
+	entry.interval = std::min(
+		entry.interval ? (entry.interval * 2) : kFloodPacingStartInterval,
+		kFloodPacingMaxInterval);
+	entry.blockedUntil = now + waitFor;
+	entry.nextPlanned = std::max(entry.nextPlanned, entry.blockedUntil);
+	entry.lastFlood = now;
+
+	DEBUG_LOG(("MTP Info: flood pacing for method %1 on dc %2, "
+		"interval %3, blocked for %4"
+		).arg(method, 0, 16
+		).arg(dcId
+		).arg(entry.interval
+		).arg(waitFor));
+}
+
 void Instance::Private::sendRequest(
 		mtpRequestId requestId,
 		SerializedRequest &&request,
@@ -1039,6 +1158,15 @@ void Instance::Private::sendRequest(
 		}
 	}
 
+	if (const auto delay = floodPacingDelay(
+			BareDcId(realShiftedDcId),
+			request)) {
+		DEBUG_LOG(("MTP Info: pacing request %1 by %2ms after floods"
+			).arg(requestId
+			).arg(delay));
+		delayRequest(requestId, crl::now() + delay);
+		return;
+	}
 	session->sendPrepared(request, msCanWait);
 }
 
@@ -1369,6 +1497,37 @@ bool Instance::Private::exportFail(
 	return true;
 }
 
+void Instance::Private::importAuthIfNeeded(DcId dcId) {
+	Expects(dcId != 0);
+
+	if (!hasMainDcId() || dcId == mainDcId()) {
+		return;
+	} else if (!_authImportRequested.emplace(dcId).second) {
+		return;
+	} else if (getDcById(dcId)->getPersistentKey()) {
+		// A key that was used before is already authorized, requests
+		// to this dc won't hit 401, so there is nothing to pre-import.
+		return;
+	}
+
+	DEBUG_LOG(("MTP Info: exporting auth to dc %1 ahead of requests"
+		).arg(dcId));
+	auto exportRequestId = _instance->send(MTPauth_ExportAuthorization(
+		MTP_int(dcId)
+	), [this](const Response &response) {
+		auto result = MTPauth_ExportedAuthorization();
+		auto from = response.reply.constData();
+		if (!result.read(from, from + response.reply.size())) {
+			return false;
+		}
+		exportDone(result, response);
+		return true;
+	}, [this](const Error &error, const Response &response) {
+		return exportFail(error, response);
+	});
+	_authExportRequests.emplace(exportRequestId, dcId);
+}
+
 bool Instance::Private::onErrorDefault(
 		const Error &error,
 		const Response &response) {
@@ -1504,24 +1663,19 @@ bool Instance::Private::onErrorDefault(
 		} else if (m1.hasMatch()) {
 			secs = m1.captured(1).toInt();
 //			if (secs >= 60) return false;
+			if (const auto shiftedDcId = queryRequestByDc(requestId)) {
+				learnFloodLimit(
+					BareDcId(qAbs(*shiftedDcId)),
+					getRequest(requestId),
+					secs * crl::time(1000));
+			}
 		} else if (m2.hasMatch()) {
 			secs = m2.captured(1).toInt();
 			nonPremiumDelay = true;
 		} else if (m3.hasMatch()) {
 			secs = m3.captured(1).toInt();
 		}
-		auto sendAt = crl::now() + secs * 1000 + 10;
-		auto it = _delayedRequests.begin(), e = _delayedRequests.end();
-		for (; it != e; ++it) {
-			if (it->first == requestId) {
-				return true;
-			} else if (it->second > sendAt) {
-				break;
-			}
-		}
-		_delayedRequests.insert(it, std::make_pair(requestId, sendAt));
-
-		checkDelayedRequests();
+		delayRequest(requestId, crl::now() + secs * 1000 + 10);
 
 		if (nonPremiumDelay) {
 			_nonPremiumDelayedRequests.fire_copy(requestId);
@@ -1547,7 +1701,11 @@ bool Instance::Private::onErrorDefault(
 		DEBUG_LOG(("MTP Info: importing auth to dcWithShift %1"
 			).arg(dcWithShift));
 		auto &waiters(_authWaiters[newdc]);
-		if (!waiters.size()) {
+		const auto alreadyExporting = ranges::contains(
+			_authExportRequests,
+			newdc,
+			[](const auto &pair) { return BareDcId(pair.second); });
+		if (!waiters.size() && !alreadyExporting) {
 			auto exportRequestId = _instance->send(MTPauth_ExportAuthorization(
 				MTP_int(newdc)
 			), [this](const Response &response) {
@@ -1968,6 +2126,10 @@ void Instance::reInitConnection(DcId dcId) {
 	_private->reInitConnection(dcId);
 }
 
+void Instance::importAuthIfNeeded(DcId dcId) {
+	_private->importAuthIfNeeded(dcId);
+}
+
 void Instance::logout(Fn<void()> done) {
 	_private->logout(std::move(done));
 }
@@ -101,6 +101,11 @@ public:
 	void killSession(ShiftedDcId shiftedDcId);
 	void stopSession(ShiftedDcId shiftedDcId);
 	void reInitConnection(DcId dcId);
+
+	// Export the authorization to a dc without an auth key right away,
+	// so the first requests there won't pay for a 401 roundtrip.
+	void importAuthIfNeeded(DcId dcId);
+
 	void logout(Fn<void()> done);
 
 	void setUpdatesHandler(Fn<void(const Response&)> handler);
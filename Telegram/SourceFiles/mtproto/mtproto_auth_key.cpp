@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "mtproto/mtproto_auth_key.h"
 
+#include "mtproto/details/mtproto_aes_ige.h"
 #include "base/openssl_help.h"
 
 #include <QtCore/QDataStream>
@@ -149,6 +150,9 @@ void AuthKey::countKeyId() {
 }
 
 void aesIgeEncryptRaw(const void *src, void *dst, uint32 len, const void *key, const void *iv) {
+	if (details::AesIgeEncryptHardware(src, dst, len, key, iv)) {
+		return;
+	}
 	uchar aes_key[32], aes_iv[32];
 	memcpy(aes_key, key, 32);
 	memcpy(aes_iv, iv, 32);
@@ -159,6 +163,9 @@ void aesIgeEncryptRaw(const void *src, void *dst, uint32 len, const void *key, c
 }
 
 void aesIgeDecryptRaw(const void *src, void *dst, uint32 len, const void *key, const void *iv) {
+	if (details::AesIgeDecryptHardware(src, dst, len, key, iv)) {
+		return;
+	}
 	uchar aes_key[32], aes_iv[32];
 	memcpy(aes_key, key, 32);
 	memcpy(aes_iv, iv, 32);
@@ -169,17 +176,21 @@ void aesIgeDecryptRaw(const void *src, void *dst, uint32 len, const void *key, c
 }
 
 void aesCtrEncrypt(bytes::span data, const void *key, CTRState *state) {
-	AES_KEY aes;
-	AES_set_encrypt_key(static_cast<const uchar*>(key), 256, &aes);
-
+	static_assert(CTRState::ExpandedKeySize >= sizeof(AES_KEY), "Wrong size of ctr expanded key!");
 	static_assert(CTRState::IvecSize == AES_BLOCK_SIZE, "Wrong size of ctr ivec!");
 	static_assert(CTRState::EcountSize == AES_BLOCK_SIZE, "Wrong size of ctr ecount!");
 
+	const auto aes = reinterpret_cast<AES_KEY*>(state->expandedKey);
+	if (!state->keyExpanded) {
+		AES_set_encrypt_key(static_cast<const uchar*>(key), 256, aes);
+		state->keyExpanded = true;
+	}
+
 	CRYPTO_ctr128_encrypt(
 		reinterpret_cast<const uchar*>(data.data()),
 		reinterpret_cast<uchar*>(data.data()),
 		data.size(),
-		&aes,
+		aes,
 		state->ivec,
 		state->ecount,
 		&state->num,
@@ -115,10 +115,17 @@ struct CTRState {
 	static constexpr int KeySize = 32;
 	static constexpr int IvecSize = 16;
 	static constexpr int EcountSize = 16;
+	static constexpr int ExpandedKeySize = 256; // >= sizeof(AES_KEY).
 
 	uchar ivec[IvecSize] = { 0 };
 	uint32 num = 0;
 	uchar ecount[EcountSize] = { 0 };
+
+	// The obfuscated transport uses one constant key per direction for
+	// the whole connection, so the round keys are expanded on the first
+	// aesCtrEncrypt() call and reused for all the following chunks.
+	alignas(8) uchar expandedKey[ExpandedKeySize] = { 0 };
+	bool keyExpanded = false;
 };
 void aesCtrEncrypt(bytes::span data, const void *key, CTRState *state);
 
@@ -60,7 +60,8 @@ QByteArray Config::serialize() const {
 		+ sizeof(quint64)
 		+ sizeof(qint32)
 		+ Serialize::stringSize(_fields.gifSearchUsername)
-		+ Serialize::stringSize(_fields.venueSearchUsername);
+		+ Serialize::stringSize(_fields.venueSearchUsername)
+		+ sizeof(qint32);
 
 	auto result = QByteArray();
 	result.reserve(size);
@@ -107,7 +108,8 @@ QByteArray Config::serialize() const {
 			<< quint64(_fields.reactionDefaultCustom)
 			<< qint32(_fields.ratingDecay)
 			<< _fields.gifSearchUsername
-			<< _fields.venueSearchUsername;
+			<< _fields.venueSearchUsername
+			<< qint32(_fields.expiresAt);
 	}
 	return result;
 }
@@ -210,6 +212,9 @@ std::unique_ptr<Config> Config::FromSerialized(const QByteArray &serialized) {
 		read(raw->_fields.gifSearchUsername);
 		read(raw->_fields.venueSearchUsername);
 	}
+	if (!stream.atEnd()) {
+		read(raw->_fields.expiresAt);
+	}
 
 	if (stream.status() != QDataStream::Ok
 		|| !raw->_dcOptions.constructFromSerialized(dcOptionsSerialized)) {
@@ -284,6 +289,7 @@ void Config::apply(const MTPDconfig &data) {
 	}
 	_fields.gifSearchUsername = qs(data.vgif_search_username().value_or_empty());
 	_fields.venueSearchUsername = qs(data.vvenue_search_username().value_or_empty());
+	_fields.expiresAt = data.vexpires().v;
 
 	if (data.vdc_options().v.empty()) {
 		LOG(("MTP Error: config with empty dc_options received!"));
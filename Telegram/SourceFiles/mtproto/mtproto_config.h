@@ -43,6 +43,7 @@ struct ConfigFields {
 	QString reactionDefaultEmoji;
 	uint64 reactionDefaultCustom = 0;
 	QString autologinToken;
+	TimeId expiresAt = 0; // Server unixtime to revalidate the config at.
 
 	QString gifSearchUsername;
 	QString venueSearchUsername;
@@ -0,0 +1,203 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/expected.h"
+#include "mtproto/sender.h"
+
+#include <coroutine>
+
+namespace MTP {
+
+// A fire-and-forget coroutine over Sender requests. The coroutine starts
+// running right away and continues on the main thread inside the request
+// handlers themselves, so a chain of requests costs no additional
+// main-thread hops compared to nested callbacks. Destroying (or cancelling)
+// the Task destroys the coroutine frame and cancels the request it waits on.
+class Task {
+public:
+	class Promise;
+	using promise_type = Promise;
+
+	Task() = default;
+	Task(const Task &other) = delete;
+	Task &operator=(const Task &other) = delete;
+	Task(Task &&other) noexcept;
+	Task &operator=(Task &&other) noexcept;
+	~Task();
+
+	[[nodiscard]] bool running() const;
+	void cancel();
+
+private:
+	explicit Task(not_null<Promise*> promise);
+
+	Promise *_promise = nullptr;
+
+	friend class Promise;
+
+};
+
+class Task::Promise {
+public:
+	~Promise();
+
+	[[nodiscard]] Task get_return_object();
+	[[nodiscard]] std::suspend_never initial_suspend() noexcept {
+		return {};
+	}
+	[[nodiscard]] std::suspend_never final_suspend() noexcept {
+		return {};
+	}
+	void return_void() noexcept {
+	}
+	[[noreturn]] void unhandled_exception() {
+		Unexpected("Exception in MTP::Task coroutine.");
+	}
+
+private:
+	Task *_task = nullptr;
+
+	friend class Task;
+
+};
+
+inline Task::Task(not_null<Promise*> promise) : _promise(promise) {
+	_promise->_task = this;
+}
+
+inline Task::Task(Task &&other) noexcept
+: _promise(base::take(other._promise)) {
+	if (_promise) {
+		_promise->_task = this;
+	}
+}
+
+inline Task &Task::operator=(Task &&other) noexcept {
+	if (this != &other) {
+		cancel();
+		_promise = base::take(other._promise);
+		if (_promise) {
+			_promise->_task = this;
+		}
+	}
+	return *this;
+}
+
+inline Task::~Task() {
+	cancel();
+}
+
+inline bool Task::running() const {
+	return (_promise != nullptr);
+}
+
+inline void Task::cancel() {
+	if (const auto promise = base::take(_promise)) {
+		promise->_task = nullptr;
+		std::coroutine_handle<Promise>::from_promise(*promise).destroy();
+	}
+}
+
+inline Task::Promise::~Promise() {
+	if (_task) {
+		_task->_promise = nullptr;
+	}
+}
+
+inline Task Task::Promise::get_return_object() {
+	return Task(this);
+}
+
+// Keeps a set of running tasks alive, dropping the finished ones. Holding
+// the list in the object whose methods the coroutines use ties their
+// lifetime to it, the way rpl::lifetime does for subscriptions.
+class TaskList {
+public:
+	void add(Task &&task) {
+		_list.erase(
+			std::remove_if(begin(_list), end(_list), [](const Task &task) {
+				return !task.running();
+			}),
+			end(_list));
+		if (task.running()) {
+			_list.push_back(std::move(task));
+		}
+	}
+	void clear() {
+		_list.clear();
+	}
+	[[nodiscard]] bool empty() const {
+		return _list.empty();
+	}
+
+private:
+	std::vector<Task> _list;
+
+};
+
+template <typename Request>
+class RequestAwaiter {
+public:
+	using Result = typename Request::ResponseType;
+	using ResultOrError = base::expected<Result, Error>;
+
+	RequestAwaiter(
+		not_null<Sender*> sender,
+		Sender::SpecificRequestBuilder<Request> &&builder)
+	: _sender(sender)
+	, _builder(std::move(builder)) {
+	}
+	RequestAwaiter(const RequestAwaiter &other) = delete;
+	RequestAwaiter &operator=(const RequestAwaiter &other) = delete;
+	RequestAwaiter(RequestAwaiter &&other) = default;
+	~RequestAwaiter() {
+		if (_requestId) {
+			_sender->request(_requestId).cancel();
+		}
+	}
+
+	[[nodiscard]] bool await_ready() const noexcept {
+		return false;
+	}
+	void await_suspend(std::coroutine_handle<> handle) {
+		_requestId = _builder->done([=, this](const Result &result) {
+			_requestId = 0;
+			_result = result;
+			handle.resume();
+		}).fail([=, this](const Error &error) {
+			_requestId = 0;
+			_result = base::make_unexpected(error);
+			handle.resume();
+		}).handleAllErrors().send();
+	}
+	[[nodiscard]] ResultOrError await_resume() noexcept {
+		return std::move(*_result);
+	}
+
+private:
+	const not_null<Sender*> _sender;
+	std::optional<Sender::SpecificRequestBuilder<Request>> _builder;
+	std::optional<ResultOrError> _result;
+	mtpRequestId _requestId = 0;
+
+};
+
+template <
+	typename Request,
+	typename = std::enable_if_t<!std::is_reference_v<Request>>,
+	typename = typename Request::Unboxed>
+[[nodiscard]] RequestAwaiter<Request> Send(
+		not_null<Sender*> sender,
+		Request &&request) {
+	return RequestAwaiter<Request>(
+		sender,
+		sender->request(std::move(request)));
+}
+
+} // namespace MTP
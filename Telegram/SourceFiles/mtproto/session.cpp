@@ -16,6 +16,15 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace MTP {
 namespace details {
+namespace {
+
+// Responses / updates processed per one main thread wakeup.
+constexpr auto kMaxMessagesPerWakeup = 1024;
+
+// Window for packing bursts of requests into one container.
+constexpr auto kRequestCoalesceWindow = crl::time(5);
+
+} // namespace
 
 SessionOptions::SessionOptions(
 	const QString &systemLangCode,
@@ -69,6 +78,25 @@ void SessionData::queueTryToReceive() {
 	});
 }
 
+void SessionData::pushReceived(Response &&response) {
+	_receivedQueue.push(std::move(response));
+	if (_receivedQueue.scheduleWakeup()) {
+		queueTryToReceive();
+	}
+}
+
+std::vector<Response> SessionData::takeReceived(int limit) {
+	return _receivedQueue.take(limit);
+}
+
+bool SessionData::hasReceivedPending() const {
+	return _receivedQueue.hasPending();
+}
+
+void SessionData::receiveWakeupHandled() {
+	_receivedQueue.wakeupHandled();
+}
+
 void SessionData::queueNeedToResumeAndSend() {
 	withSession([](not_null<Session*> session) {
 		session->needToResumeAndSend();
@@ -433,8 +461,15 @@ void Session::sendPrepared(
 
 	DEBUG_LOG(("MTP Info: added, requestId %1").arg(request->requestId));
 	if (msCanWait >= 0) {
+		// Give immediate requests a tiny coalescing window, so bursts
+		// of small requests (peer / message resolving on folder open)
+		// are packed into one msg_container instead of paying the
+		// transport and ack overhead per request.
+		const auto wait = msCanWait
+			? msCanWait
+			: kRequestCoalesceWindow;
 		InvokeQueued(this, [=] {
-			sendAnything(msCanWait);
+			sendAnything(wait);
 		});
 	}
 }
@@ -548,31 +583,26 @@ void Session::tryToReceive() {
 		_needToReceive = true;
 		return;
 	}
-	while (true) {
-		auto lock = QWriteLocker(_data->haveReceivedMutex());
-		const auto messages = base::take(_data->haveReceivedMessages());
-		lock.unlock();
-		if (messages.empty()) {
-			break;
+	_data->receiveWakeupHandled();
+	const auto guard = QPointer<Session>(this);
+	const auto instance = QPointer<Instance>(_instance);
+	const auto main = (_shiftedDcId == BareDcId(_shiftedDcId));
+	const auto messages = _data->takeReceived(kMaxMessagesPerWakeup);
+	for (const auto &message : messages) {
+		if (message.requestId) {
+			instance->processCallback(message);
+		} else if (main) {
+			// Process updates only in main session.
+			instance->processUpdate(message);
 		}
-		const auto guard = QPointer<Session>(this);
-		const auto instance = QPointer<Instance>(_instance);
-		const auto main = (_shiftedDcId == BareDcId(_shiftedDcId));
-		for (const auto &message : messages) {
-			if (message.requestId) {
-				instance->processCallback(message);
-			} else if (main) {
-				// Process updates only in main session.
-				instance->processUpdate(message);
-			}
-			if (!instance) {
-				return;
-			}
-		}
-		if (!guard) {
-			break;
+		if (!instance) {
+			return;
 		}
 	}
+	if (guard && _data->hasReceivedPending()) {
+		// Let the event loop breathe between large drained batches.
+		InvokeQueued(this, [=] { tryToReceive(); });
+	}
 }
 
 void Session::killConnection() {
@@ -10,6 +10,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/timer.h"
 #include "mtproto/mtproto_response.h"
 #include "mtproto/mtproto_proxy_data.h"
+#include "mtproto/details/mtproto_received_queue.h"
 #include "mtproto/details/mtproto_serialized_request.h"
 
 #include <QtCore/QTimer>
@@ -74,19 +75,20 @@ public:
 	not_null<QReadWriteLock*> haveSentMutex() {
 		return &_haveSentLock;
 	}
-	not_null<QReadWriteLock*> haveReceivedMutex() {
-		return &_haveReceivedLock;
-	}
-
 	base::flat_map<mtpRequestId, SerializedRequest> &toSendMap() {
 		return _toSend;
 	}
 	base::flat_map<mtpMsgId, SerializedRequest> &haveSentMap() {
 		return _haveSent;
 	}
-	std::vector<Response> &haveReceivedMessages() {
-		return _receivedMessages;
-	}
+
+	// Lock-free, any thread. Schedules a main thread wakeup if needed.
+	void pushReceived(Response &&response);
+
+	// Main thread.
+	[[nodiscard]] std::vector<Response> takeReceived(int limit);
+	[[nodiscard]] bool hasReceivedPending() const;
+	void receiveWakeupHandled();
 
 	// SessionPrivate -> Session interface.
 	void queueTryToReceive();
@@ -125,8 +127,7 @@ private:
 	base::flat_map<mtpMsgId, SerializedRequest> _haveSent; // map of msg_id -> request, that was sent
 	QReadWriteLock _haveSentLock;
 
-	std::vector<Response> _receivedMessages; // list of responses / updates that should be processed in the main thread
-	QReadWriteLock _haveReceivedLock;
+	ReceivedQueue _receivedQueue; // responses / updates for the main thread
 
 };
 
@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/details/mtproto_dump_to_text.h"
 #include "mtproto/details/mtproto_rsa_public_key.h"
 #include "mtproto/session.h"
+#include "mtproto/session_statistics.h"
 #include "mtproto/mtproto_response.h"
 #include "mtproto/mtproto_dc_options.h"
 #include "mtproto/connection_abstract.h"
@@ -38,6 +39,7 @@ constexpr auto kMarkConnectionOldTimeout = crl::time(192000);
 constexpr auto kPingDelayDisconnect = 60;
 constexpr auto kPingSendAfter = 30 * crl::time(1000);
 constexpr auto kPingSendAfterForce = 45 * crl::time(1000);
+constexpr auto kKeepWarmAfterTraffic = 5 * 60 * crl::time(1000);
 constexpr auto kTemporaryExpiresIn = TimeId(86400);
 constexpr auto kBindKeyAdditionalExpiresTimeout = TimeId(30);
 constexpr auto kKeyOldEnoughForDestroy = 60 * crl::time(1000);
@@ -64,6 +66,20 @@ constexpr auto kCutContainerOnSize = 16 * 1024;
 
 auto SyncTimeRequestDuration = kFastRequestDuration;
 
+// The endpoint that won the race on this network gets a priority boost
+// above any static preference, so reconnects settle on it right away
+// instead of waiting out the full race again.
+constexpr auto kLastGoodPriorityBoost = 4;
+
+struct LastGoodEndpoint {
+	QString ip;
+	int port = 0;
+	int protocol = 0;
+};
+
+QMutex LastGoodEndpointsMutex;
+base::flat_map<DcId, LastGoodEndpoint> LastGoodEndpoints;
+
 using namespace details;
 
 [[nodiscard]] QString LogIdsVector(const QVector<MTPlong> &ids) {
@@ -161,6 +177,7 @@ SessionPrivate::SessionPrivate(
 , _pingSender(thread, [=] { sendPingByTimer(); })
 , _checkSentRequestsTimer(thread, [=] { checkSentRequests(); })
 , _clearOldContainersTimer(thread, [=] { clearOldContainers(); })
+, _statistics(StatisticsForDc(shiftedDcId))
 , _sessionData(std::move(data)) {
 	Expects(_shiftedDcId != 0);
 
@@ -187,9 +204,19 @@ void SessionPrivate::appendTestConnection(
 		const bytes::vector &protocolSecret) {
 	QWriteLocker lock(&_stateMutex);
 
-	const auto priority = (qthelp::is_ipv6(ip) ? 0 : 1)
+	auto priority = (qthelp::is_ipv6(ip) ? 0 : 1)
 		+ (protocol == DcOptions::Variants::Tcp ? 1 : 0)
 		+ (protocolSecret.empty() ? 0 : 1);
+	{
+		QMutexLocker lock(&LastGoodEndpointsMutex);
+		const auto i = LastGoodEndpoints.find(BareDcId(_shiftedDcId));
+		if (i != end(LastGoodEndpoints)
+			&& i->second.ip == ip
+			&& i->second.port == port
+			&& i->second.protocol == int(protocol)) {
+			priority += kLastGoodPriorityBoost;
+		}
+	}
 	_testConnections.push_back({
 		AbstractConnection::Create(
 			_instance,
@@ -197,7 +224,10 @@ void SessionPrivate::appendTestConnection(
 			thread(),
 			protocolSecret,
 			_options->proxy),
-		priority
+		priority,
+		ip,
+		port,
+		int(protocol)
 	});
 	const auto weak = _testConnections.back().data.get();
 	connect(weak, &AbstractConnection::error, [=](int errorCode) {
@@ -575,10 +605,18 @@ void SessionPrivate::tryToSend() {
 	const auto sendOnlyFirstPing = (state != ConnectedState);
 	const auto sendAll = !sendOnlyFirstPing && !_keyCreator;
 	const auto isMainSession = (GetDcIdShift(_shiftedDcId) == 0);
+
+	// A non-main session that carried real traffic recently is kept
+	// warm with the same ping loop as the main session, so the next
+	// burst of requests doesn't pay a full reconnect after the server
+	// drops the idle connection.
+	const auto keepWarm = !isMainSession
+		&& (_keepWarmUntil > 0)
+		&& (crl::now() < _keepWarmUntil);
 	if (sendOnlyFirstPing && !_pingIdToSend) {
 		DEBUG_LOG(("MTP Info: dc %1 not sending, waiting for Connected state, state: %2").arg(_shiftedDcId).arg(state));
 		return; // just do nothing, if is not connected yet
-	} else if (isMainSession
+	} else if ((isMainSession || keepWarm)
 		&& !sendOnlyFirstPing
 		&& !_pingIdToSend
 		&& !_pingId
@@ -597,7 +635,7 @@ void SessionPrivate::tryToSend() {
 	auto httpWaitRequest = SerializedRequest();
 	auto bindDcKeyRequest = SerializedRequest();
 	if (_pingIdToSend) {
-		if (sendOnlyFirstPing || !isMainSession) {
+		if (sendOnlyFirstPing || (!isMainSession && !keepWarm)) {
 			DEBUG_LOG(("MTP Info: sending ping, ping_id: %1"
 				).arg(_pingIdToSend));
 			pingRequest = SerializedRequest::Serialize(MTPPing(
@@ -733,6 +771,12 @@ void SessionPrivate::tryToSend() {
 		}
 		auto sendingRange = ranges::make_subrange(sendingFrom, sendingTill);
 		const auto sendingCount = totalSending;
+		if (sendingCount > 0 && !isMainSession) {
+			_keepWarmUntil = crl::now() + kKeepWarmAfterTraffic;
+			if (!_pingSender.isActive()) {
+				_pingSender.callOnce(kPingSendAfter);
+			}
+		}
 		if (pingRequest) ++totalSending;
 		if (ackRequest) ++totalSending;
 		if (resendRequest) ++totalSending;
@@ -1273,6 +1317,7 @@ void SessionPrivate::handleReceived() {
 		constexpr auto kMinimalIntsCount = kExternalHeaderIntsCount + kMinimalEncryptedIntsCount;
 		auto intsCount = uint32(intsBuffer.size());
 		auto ints = intsBuffer.constData();
+		_statistics->addBytesReceived(int64(intsCount) * kIntSize);
 		if ((intsCount < kMinimalIntsCount) || (intsCount > kMaxMessageLength / kIntSize)) {
 			LOG(("TCP Error: bad message received, len %1").arg(intsCount * kIntSize));
 			return restart();
@@ -1288,12 +1333,19 @@ void SessionPrivate::handleReceived() {
 		auto encryptedInts = ints + kExternalHeaderIntsCount;
 		auto encryptedIntsCount = (intsCount - kExternalHeaderIntsCount) & ~0x03U;
 		auto encryptedBytesCount = encryptedIntsCount * kIntSize;
-		auto decryptedBuffer = QByteArray(encryptedBytesCount, Qt::Uninitialized);
 		auto msgKey = *(MTPint128*)(ints + 2);
 
-		aesIgeDecrypt(encryptedInts, decryptedBuffer.data(), encryptedBytesCount, _encryptionKey, msgKey);
+		// Decrypt in place: we own the buffer and the ciphertext is
+		// not needed after the msg_key check, so this saves a buffer
+		// allocation and a full copy for every received packet.
+		aesIgeDecrypt(
+			encryptedInts,
+			intsBuffer.data() + kExternalHeaderIntsCount,
+			encryptedBytesCount,
+			_encryptionKey,
+			msgKey);
 
-		auto decryptedInts = reinterpret_cast<const mtpPrime*>(decryptedBuffer.constData());
+		auto decryptedInts = encryptedInts;
 		auto serverSalt = *(uint64*)&decryptedInts[0];
 		auto session = *(uint64*)&decryptedInts[2];
 		auto msgId = *(uint64*)&decryptedInts[4];
@@ -1404,14 +1456,8 @@ void SessionPrivate::handleReceived() {
 			_sessionData->queueSendAnything(kAckSendWaiting);
 		}
 
-		auto lock = QReadLocker(_sessionData->haveReceivedMutex());
-		const auto tryToReceive = !_sessionData->haveReceivedMessages().empty();
-		lock.unlock();
-
-		if (tryToReceive) {
-			DEBUG_LOG(("MTP Info: queueTryToReceive() - need to parse in another thread, %1 messages.").arg(_sessionData->haveReceivedMessages().size()));
-			_sessionData->queueTryToReceive();
-		}
+		// The main thread wakeup is scheduled by pushReceived(), at
+		// most one queued invocation per burst of received messages.
 
 		if (res != HandleResult::Success && res != HandleResult::Ignored) {
 			if (res == HandleResult::DestroyTemporaryKey) {
@@ -1631,8 +1677,7 @@ SessionPrivate::HandleResult SessionPrivate::handleOneReceived(
 				)).write(reply);
 
 				// Save rpc_error for processing in the main thread.
-				QWriteLocker locker(_sessionData->haveReceivedMutex());
-				_sessionData->haveReceivedMessages().push_back({
+				_sessionData->pushReceived({
 					.reply = std::move(reply),
 					.outerMsgId = info.outerMsgId,
 					.requestId = requestId,
@@ -1839,8 +1884,9 @@ SessionPrivate::HandleResult SessionPrivate::handleOneReceived(
 			}
 			typeId = response[0];
 		} else {
-			response.resize(end - from);
-			memcpy(response.data(), from, (end - from) * sizeof(mtpPrime));
+			// Range-construct instead of resize + memcpy, so the large
+			// catch-up responses aren't zero-filled before being copied.
+			response = mtpBuffer(from, end);
 		}
 		if (typeId == mtpc_rpc_error) {
 			if (IsDestroyedTemporaryKeyError(response)) {
@@ -1861,8 +1907,7 @@ SessionPrivate::HandleResult SessionPrivate::handleOneReceived(
 		const auto requestId = wasSent(requestMsgId);
 		if (requestId && requestId != mtpRequestId(0xFFFFFFFF)) {
 			// Save rpc_result for processing in the main thread.
-			QWriteLocker locker(_sessionData->haveReceivedMutex());
-			_sessionData->haveReceivedMessages().push_back({
+			_sessionData->pushReceived({
 				.reply = std::move(response),
 				.outerMsgId = info.outerMsgId,
 				.requestId = requestId,
@@ -1910,12 +1955,10 @@ SessionPrivate::HandleResult SessionPrivate::handleOneReceived(
 			resend(msgId, 10);
 		}
 
-		mtpBuffer update(from - start);
-		if (from > start) memcpy(update.data(), start, (from - start) * sizeof(mtpPrime));
+		auto update = mtpBuffer(start, from);
 
 		// Notify main process about new session - need to get difference.
-		QWriteLocker locker(_sessionData->haveReceivedMutex());
-		_sessionData->haveReceivedMessages().push_back({
+		_sessionData->pushReceived({
 			.reply = update,
 			.outerMsgId = info.outerMsgId,
 		});
@@ -1958,14 +2001,10 @@ SessionPrivate::HandleResult SessionPrivate::handleOneReceived(
 	}
 
 	if (_currentDcType == DcType::Regular) {
-		mtpBuffer update(end - from);
-		if (end > from) {
-			memcpy(update.data(), from, (end - from) * sizeof(mtpPrime));
-		}
+		auto update = mtpBuffer(from, end);
 
 		// Notify main process about the new updates.
-		QWriteLocker locker(_sessionData->haveReceivedMutex());
-		_sessionData->haveReceivedMessages().push_back({
+		_sessionData->pushReceived({
 			.reply = update,
 			.outerMsgId = info.outerMsgId,
 		});
@@ -2018,6 +2057,21 @@ mtpBuffer SessionPrivate::ungzip(const mtpPrime *from, const mtpPrime *end) cons
 	}
 	uint32 packedLen = packed.v.size(), unpackedChunk = packedLen;
 
+	// The gzip trailer keeps the unpacked size (mod 2^32) in the last
+	// four bytes, use it to allocate the result in one go instead of
+	// growing-and-copying the buffer chunk by chunk on large responses.
+	if (packedLen > 8) {
+		const auto trailer = reinterpret_cast<const uchar*>(
+			packed.v.constData() + packedLen - 4);
+		const auto unpackedSize = uint32(trailer[0])
+			| (uint32(trailer[1]) << 8)
+			| (uint32(trailer[2]) << 16)
+			| (uint32(trailer[3]) << 24);
+		if (unpackedSize > 0 && unpackedSize <= kMaxMessageLength) {
+			unpackedChunk = (unpackedSize >> 2) + 1;
+		}
+	}
+
 	z_stream stream;
 	stream.zalloc = 0;
 	stream.zfree = 0;
@@ -2109,6 +2163,7 @@ void SessionPrivate::requestsAcked(const QVector<MTPlong> &ids, bool byResponse)
 	{
 		QWriteLocker locker2(_sessionData->haveSentMutex());
 		auto &haveSent = _sessionData->haveSentMap();
+		_statistics->sampleInFlight(int(haveSent.size()));
 
 		for (const auto &wrappedMsgId : ids) {
 			const auto msgId = wrappedMsgId.v;
@@ -2133,6 +2188,10 @@ void SessionPrivate::requestsAcked(const QVector<MTPlong> &ids, bool byResponse)
 					DEBUG_LOG(("Message Info: ignoring ACK for msgId %1 because request %2 requires a response").arg(msgId).arg(requestId));
 					continue;
 				}
+				if (byResponse) {
+					_statistics->addResponse(
+						crl::now() - i->second->lastSentTime);
+				}
 				haveSent.erase(i);
 
 				_ackedIds.emplace(msgId, requestId);
@@ -2323,6 +2382,7 @@ void SessionPrivate::onConnected(
 	} else {
 		DEBUG_LOG(("MTP Info: connection through IPv4 succeed."));
 		_waitForBetterTimer.cancel();
+		rememberGoodEndpoint(*i);
 		_connection = std::move(i->data);
 		_testConnections.clear();
 		checkAuthKey();
@@ -2359,12 +2419,26 @@ void SessionPrivate::confirmBestConnection() {
 	DEBUG_LOG(("MTP Info: can't connect through better, using %1."
 		).arg(i->data->tag()));
 
+	rememberGoodEndpoint(*i);
 	_connection = std::move(i->data);
 	_testConnections.clear();
 
 	checkAuthKey();
 }
 
+void SessionPrivate::rememberGoodEndpoint(const TestConnection &test) {
+	if (test.ip.isEmpty()) {
+		// Mtproto proxy, the endpoint comes from the proxy settings.
+		return;
+	}
+	QMutexLocker lock(&LastGoodEndpointsMutex);
+	LastGoodEndpoints[BareDcId(_shiftedDcId)] = {
+		test.ip,
+		test.port,
+		test.protocol,
+	};
+}
+
 void SessionPrivate::removeTestConnection(
 		not_null<AbstractConnection*> connection) {
 	_testConnections.erase(
@@ -2683,6 +2757,8 @@ bool SessionPrivate::sendSecureRequest(
 	_connection->setSentEncryptedWithKeyId(_keyId);
 	_connection->sendData(std::move(packet));
 
+	_statistics->addRequestSent((prefix + fullSize) * sizeof(mtpPrime));
+
 	if (needAnyResponse) {
 		onSentSome((prefix + fullSize) * sizeof(mtpPrime));
 	}
@@ -2731,5 +2807,10 @@ void SessionPrivate::releaseKeyCreationOnFail() {
 	_sessionData->releaseKeyCreationOnFail();
 }
 
+void ClearLastGoodEndpoints() {
+	QMutexLocker lock(&LastGoodEndpointsMutex);
+	LastGoodEndpoints.clear();
+}
+
 } // namespace details
 } // namespace MTP
@@ -26,6 +26,7 @@ namespace details {
 
 class AbstractConnection;
 class SessionData;
+class SessionStatistics;
 class RSAPublicKey;
 struct SessionOptions;
 
@@ -56,6 +57,9 @@ private:
 	struct TestConnection {
 		ConnectionPointer data;
 		int priority = 0;
+		QString ip;
+		int port = 0;
+		int protocol = 0;
 	};
 	struct SentContainer {
 		crl::time sent = 0;
@@ -144,6 +148,7 @@ private:
 		const QString &ip,
 		int port,
 		const bytes::vector &protocolSecret);
+	void rememberGoodEndpoint(const TestConnection &test);
 
 	// if badTime received - search for ids in sessionData->haveSent and sessionData->wereAcked and sync time/salt, return true if found
 	bool requestsFixTimeSalt(const QVector<MTPlong> &ids, const OuterInfo &info);
@@ -211,11 +216,13 @@ private:
 	mtpPingId _pingId = 0;
 	mtpPingId _pingIdToSend = 0;
 	crl::time _pingSendAt = 0;
+	crl::time _keepWarmUntil = 0;
 	mtpMsgId _pingMsgId = 0;
 	base::Timer _pingSender;
 	base::Timer _checkSentRequestsTimer;
 	base::Timer _clearOldContainersTimer;
 
+	const not_null<SessionStatistics*> _statistics;
 	std::shared_ptr<SessionData> _sessionData;
 	std::unique_ptr<SessionOptions> _options;
 	AuthKeyPtr _encryptionKey;
@@ -240,5 +247,9 @@ private:
 
 };
 
+// Forgets which endpoints won the connection races, called when the
+// network changes and the cached winners are no longer meaningful.
+void ClearLastGoodEndpoints();
+
 } // namespace details
 } // namespace MTP
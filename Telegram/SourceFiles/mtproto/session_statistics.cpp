@@ -0,0 +1,122 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "mtproto/session_statistics.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+namespace MTP::details {
+namespace {
+
+QMutex RegistryMutex;
+base::flat_map<ShiftedDcId, SessionStatistics*> Registry;
+
+} // namespace
+
+void SessionStatistics::addRequestSent(int64 bytes) {
+	_requestsSent.fetch_add(1, std::memory_order_relaxed);
+	_bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void SessionStatistics::sampleInFlight(int count) {
+	auto max = _maxInFlight.load(std::memory_order_relaxed);
+	while (count > max
+		&& !_maxInFlight.compare_exchange_weak(
+			max,
+			count,
+			std::memory_order_relaxed)) {
+	}
+}
+
+void SessionStatistics::addBytesReceived(int64 bytes) {
+	_bytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void SessionStatistics::addResponse(crl::time duration) {
+	_responsesReceived.fetch_add(1, std::memory_order_relaxed);
+	auto index = 0;
+	while (index != kBucketsCount - 1
+		&& duration > kBucketBounds[index]) {
+		++index;
+	}
+	_buckets[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+int64 SessionStatistics::requestsSent() const {
+	return _requestsSent.load(std::memory_order_relaxed);
+}
+
+int64 SessionStatistics::responsesReceived() const {
+	return _responsesReceived.load(std::memory_order_relaxed);
+}
+
+int64 SessionStatistics::bytesSent() const {
+	return _bytesSent.load(std::memory_order_relaxed);
+}
+
+int64 SessionStatistics::bytesReceived() const {
+	return _bytesReceived.load(std::memory_order_relaxed);
+}
+
+int SessionStatistics::maxInFlight() const {
+	return _maxInFlight.load(std::memory_order_relaxed);
+}
+
+int64 SessionStatistics::bucketValue(int index) const {
+	Expects(index >= 0 && index < kBucketsCount);
+
+	return _buckets[index].load(std::memory_order_relaxed);
+}
+
+not_null<SessionStatistics*> StatisticsForDc(ShiftedDcId shiftedDcId) {
+	QMutexLocker lock(&RegistryMutex);
+	const auto i = Registry.find(shiftedDcId);
+	if (i != end(Registry)) {
+		return i->second;
+	}
+	const auto result = new SessionStatistics();
+	Registry.emplace(shiftedDcId, result);
+	return result;
+}
+
+QByteArray DumpSessionStatistics() {
+	auto entries = base::flat_map<ShiftedDcId, SessionStatistics*>();
+	{
+		QMutexLocker lock(&RegistryMutex);
+		entries = Registry;
+	}
+	auto list = QJsonArray();
+	for (const auto &[shiftedDcId, statistics] : entries) {
+		auto histogram = QJsonObject();
+		for (auto i = 0; i != SessionStatistics::kBucketsCount; ++i) {
+			const auto label = (i != SessionStatistics::kBucketsCount - 1)
+				? QString("<=%1ms").arg(
+					SessionStatistics::kBucketBounds[i])
+				: QString(">%1ms").arg(
+					SessionStatistics::kBucketBounds[i - 1]);
+			histogram.insert(label, double(statistics->bucketValue(i)));
+		}
+		list.append(QJsonObject{
+			{ "dc", BareDcId(shiftedDcId) },
+			{ "shifted_dc", shiftedDcId },
+			{ "requests_sent", double(statistics->requestsSent()) },
+			{ "responses_received",
+				double(statistics->responsesReceived()) },
+			{ "bytes_sent", double(statistics->bytesSent()) },
+			{ "bytes_received", double(statistics->bytesReceived()) },
+			{ "max_in_flight", statistics->maxInFlight() },
+			{ "response_time_histogram", histogram },
+		});
+	}
+	return QJsonDocument(
+		QJsonObject{ { "sessions", list } }
+	).toJson(QJsonDocument::Indented);
+}
+
+} // namespace MTP::details
@@ -0,0 +1,58 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "mtproto/core_types.h"
+
+#include <crl/crl_time.h>
+#include <atomic>
+
+namespace MTP::details {
+
+// Always-on counters for a single shifted dc id, updated from the
+// session thread and read from the main thread when a dump is
+// requested, so every field is a relaxed atomic and each update is
+// a couple of stores on the hot path.
+class SessionStatistics final {
+public:
+	// Response time buckets, milliseconds: the last one is open-ended.
+	static constexpr crl::time kBucketBounds[] = {
+		50, 100, 200, 400, 800, 1600, 3200, 6400, 12800 };
+	static constexpr auto kBucketsCount
+		= int(std::size(kBucketBounds)) + 1;
+
+	void addRequestSent(int64 bytes);
+	void addBytesReceived(int64 bytes);
+	void addResponse(crl::time duration);
+	void sampleInFlight(int count);
+
+	[[nodiscard]] int64 requestsSent() const;
+	[[nodiscard]] int64 responsesReceived() const;
+	[[nodiscard]] int64 bytesSent() const;
+	[[nodiscard]] int64 bytesReceived() const;
+	[[nodiscard]] int maxInFlight() const;
+	[[nodiscard]] int64 bucketValue(int index) const;
+
+private:
+	std::atomic<int64> _requestsSent = 0;
+	std::atomic<int64> _responsesReceived = 0;
+	std::atomic<int64> _bytesSent = 0;
+	std::atomic<int64> _bytesReceived = 0;
+	std::atomic<int> _maxInFlight = 0;
+	std::atomic<int64> _buckets[kBucketsCount] = {};
+
+};
+
+// The per-dc entries live for the lifetime of the process, so the
+// session thread can keep a raw pointer without synchronization.
+[[nodiscard]] not_null<SessionStatistics*> StatisticsForDc(
+	ShiftedDcId shiftedDcId);
+
+[[nodiscard]] QByteArray DumpSessionStatistics();
+
+} // namespace MTP::details
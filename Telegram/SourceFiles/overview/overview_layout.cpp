@@ -375,9 +375,18 @@ void Photo::paint(Painter &p, const QRect &clip, TextSelection selection, const
 			_goodLoaded = good;
 			_pix = QPixmap();
 			if (_goodLoaded) {
-				setPixFrom(_dataMedia->image(Data::PhotoSize::Large)
-					? _dataMedia->image(Data::PhotoSize::Large)
-					: _dataMedia->image(Data::PhotoSize::Thumbnail));
+				// Prefer the thumbnail size when it covers the grid
+				// cell: painting from the large image means decoding
+				// the whole cached photo just for a small square.
+				const auto ratio = style::DevicePixelRatio();
+				const auto thumbnail = _dataMedia->image(
+					Data::PhotoSize::Thumbnail);
+				const auto large = _dataMedia->image(
+					Data::PhotoSize::Large);
+				const auto enough = thumbnail
+					&& (thumbnail->width() >= _width * ratio
+						|| thumbnail->height() >= _height * ratio);
+				setPixFrom((enough || !large) ? thumbnail : large);
 			} else if (const auto small = _spoiler
 				? nullptr
 				: _dataMedia->image(Data::PhotoSize::Small)) {
@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "window/notifications_manager.h"
 #include "core/sandbox.h"
 #include "core/application.h"
+#include "core/memory_pressure.h"
 #include "core/core_settings.h"
 #include "base/random.h"
 
@@ -187,9 +188,11 @@ private:
 	}
 
 	void initInhibit();
+	void initMemoryMonitor();
 
 	const gi::ref_ptr<Application> _application;
 	XdpInhibit::InhibitProxy _inhibitProxy;
+	Gio::MemoryMonitor _memoryMonitor;
 	rpl::variable<std::optional<bool>> _darkMode;
 	base::Platform::XDP::SettingWatcher _darkModeWatcher;
 	rpl::lifetime _lifetime;
@@ -238,6 +241,8 @@ void LinuxIntegration::init() {
 			initInhibit();
 		}));
 
+	initMemoryMonitor();
+
 	_darkMode.value()
 #if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
 	| rpl::filter([] {
@@ -263,6 +268,24 @@ void LinuxIntegration::init() {
 #endif // Qt >= 6.5.0
 }
 
+void LinuxIntegration::initMemoryMonitor() {
+	_memoryMonitor = Gio::MemoryMonitor::dup_default();
+	if (!_memoryMonitor) {
+		return;
+	}
+	_memoryMonitor.signal_low_memory_warning().connect([](
+			Gio::MemoryMonitor,
+			Gio::MemoryMonitorWarningLevel level) {
+		// LOW fires all the time on some systems, so only the levels
+		// where the system actually wants memory back are forwarded.
+		if (level != Gio::MemoryMonitorWarningLevel::LOW_) {
+			Core::Sandbox::Instance().customEnterFromEventLoop([] {
+				Core::NotifyMemoryPressure();
+			});
+		}
+	});
+}
+
 void LinuxIntegration::initInhibit() {
 	if (!_inhibitProxy) {
 		return;
@@ -0,0 +1,75 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "platform/linux/overlay_widget_linux.h"
+
+#include "base/platform/base_platform_info.h"
+#include "ui/widgets/rp_window.h"
+
+#ifndef DESKTOP_APP_DISABLE_X11_INTEGRATION
+#include "base/platform/linux/base_linux_xcb_utilities.h"
+#endif // !DESKTOP_APP_DISABLE_X11_INTEGRATION
+
+namespace Platform {
+namespace {
+
+#ifndef DESKTOP_APP_DISABLE_X11_INTEGRATION
+// Fullscreen video pays an extra composition blit and loses vsync on
+// X11 while the viewer window is redirected, so ask the compositor to
+// unredirect it and scan the window out directly in fullscreen.
+void XCBSetBypassCompositor(QWindow *window, bool bypass) {
+	const base::Platform::XCB::Connection connection;
+	if (!connection || xcb_connection_has_error(connection)) {
+		return;
+	}
+
+	const auto bypassAtom = base::Platform::XCB::GetAtom(
+		connection,
+		"_NET_WM_BYPASS_COMPOSITOR");
+
+	if (!bypassAtom) {
+		return;
+	}
+
+	const auto value = uint32(bypass ? 1 : 0);
+
+	free(
+		xcb_request_check(
+			connection,
+			xcb_change_property_checked(
+				connection,
+				XCB_PROP_MODE_REPLACE,
+				window->winId(),
+				bypassAtom,
+				XCB_ATOM_CARDINAL,
+				32,
+				1,
+				&value)));
+}
+#endif // !DESKTOP_APP_DISABLE_X11_INTEGRATION
+
+} // namespace
+
+LinuxOverlayWidgetHelper::LinuxOverlayWidgetHelper(
+	not_null<Ui::RpWindow*> window,
+	Fn<void(bool)> maximize)
+: DefaultOverlayWidgetHelper(window, std::move(maximize))
+, _window(window) {
+}
+
+void LinuxOverlayWidgetHelper::afterShow(bool fullscreen) {
+#ifndef DESKTOP_APP_DISABLE_X11_INTEGRATION
+	if (IsX11()) {
+		if (const auto handle = _window->windowHandle()) {
+			XCBSetBypassCompositor(handle, fullscreen);
+		}
+	}
+#endif // !DESKTOP_APP_DISABLE_X11_INTEGRATION
+	DefaultOverlayWidgetHelper::afterShow(fullscreen);
+}
+
+} // namespace Platform
@@ -7,12 +7,27 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
+#include "platform/platform_overlay_widget.h"
+
 namespace Platform {
 
+class LinuxOverlayWidgetHelper final : public DefaultOverlayWidgetHelper {
+public:
+	LinuxOverlayWidgetHelper(
+		not_null<Ui::RpWindow*> window,
+		Fn<void(bool)> maximize);
+
+	void afterShow(bool fullscreen) override;
+
+private:
+	const not_null<Ui::RpWindow*> _window;
+
+};
+
 inline std::unique_ptr<OverlayWidgetHelper> CreateOverlayWidgetHelper(
 		not_null<Ui::RpWindow*> window,
 		Fn<void(bool)> maximize) {
-	return std::make_unique<DefaultOverlayWidgetHelper>(
+	return std::make_unique<LinuxOverlayWidgetHelper>(
 		window,
 		std::move(maximize));
 }
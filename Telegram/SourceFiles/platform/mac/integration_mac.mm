@@ -8,13 +8,43 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "platform/mac/integration_mac.h"
 
 #include "platform/platform_integration.h"
+#include "core/memory_pressure.h"
+
+#include <dispatch/dispatch.h>
 
 namespace Platform {
 namespace {
 
 class MacIntegration final : public Integration {
+public:
+	void init() override;
+	~MacIntegration();
+
+private:
+	dispatch_source_t _memoryPressureSource = nullptr;
 };
 
+void MacIntegration::init() {
+	_memoryPressureSource = dispatch_source_create(
+		DISPATCH_SOURCE_TYPE_MEMORYPRESSURE,
+		0,
+		DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+		dispatch_get_main_queue());
+	if (_memoryPressureSource) {
+		dispatch_source_set_event_handler(_memoryPressureSource, ^{
+			Core::NotifyMemoryPressure();
+		});
+		dispatch_resume(_memoryPressureSource);
+	}
+}
+
+MacIntegration::~MacIntegration() {
+	if (_memoryPressureSource) {
+		dispatch_source_cancel(_memoryPressureSource);
+		_memoryPressureSource = nullptr;
+	}
+}
+
 } // namespace
 
 std::unique_ptr<Integration> CreateIntegration() {
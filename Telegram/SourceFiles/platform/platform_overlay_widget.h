@@ -67,7 +67,7 @@ public:
 	not_null<Ui::RpWindow*> window,
 	Fn<void(bool)> maximize);
 
-class DefaultOverlayWidgetHelper final : public OverlayWidgetHelper {
+class DefaultOverlayWidgetHelper : public OverlayWidgetHelper {
 public:
 	DefaultOverlayWidgetHelper(
 		not_null<Ui::RpWindow*> window,
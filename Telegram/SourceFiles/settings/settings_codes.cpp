@@ -21,7 +21,12 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "mtproto/mtp_instance.h"
 #include "mtproto/mtproto_dc_options.h"
+#include "mtproto/session_statistics.h"
+#include "core/alloc_profiler.h"
 #include "core/file_utilities.h"
+#include "core/frame_profiler.h"
+#include "core/memory_pressure.h"
+#include "core/send_latency.h"
 #include "core/update_checker.h"
 #include "window/themes/window_theme.h"
 #include "window/themes/window_theme_editor.h"
@@ -84,6 +89,52 @@ auto GenerateCodes() {
 	codes.emplace(u"viewlogs"_q, [](SessionController *window) {
 		File::ShowInFolder(cWorkingDir() + "log.txt");
 	});
+	codes.emplace(u"netstats"_q, [](SessionController *window) {
+		const auto path = cWorkingDir() + u"netstats.json"_q;
+		auto file = QFile(path);
+		if (file.open(QIODevice::WriteOnly)) {
+			file.write(MTP::details::DumpSessionStatistics());
+			file.close();
+			File::ShowInFolder(path);
+		} else {
+			Ui::Toast::Show("Could not write netstats.json :(");
+		}
+	});
+	codes.emplace(u"frametrace"_q, [](SessionController *window) {
+		auto &profiler = Core::FrameProfiler::Instance();
+		if (!profiler.enabled()) {
+			profiler.start();
+			Ui::Toast::Show("Frame trace recording started.");
+		} else {
+			profiler.stop();
+			const auto path = profiler.saveChromeTrace();
+			if (path.isEmpty()) {
+				Ui::Toast::Show("Could not save the frame trace :(");
+			} else {
+				File::ShowInFolder(path);
+			}
+		}
+	});
+	codes.emplace(u"sendlatency"_q, [](SessionController *window) {
+		Ui::Toast::Show(Core::SendLatency::Instance().report());
+	});
+	codes.emplace(u"alloctrack"_q, [](SessionController *window) {
+		if (!Core::AllocationTrackingAvailable()) {
+			Ui::Toast::Show(
+				"This build was made without allocation tracking.");
+		} else if (!Core::AllocationTrackingEnabled()) {
+			Core::StartAllocationTracking();
+			Ui::Toast::Show("Allocation tracking started.");
+		} else {
+			Core::StopAllocationTracking();
+			const auto path = Core::SaveAllocationReport();
+			if (path.isEmpty()) {
+				Ui::Toast::Show("No allocations were sampled.");
+			} else {
+				File::ShowInFolder(path);
+			}
+		}
+	});
 	if (!Core::UpdaterDisabled()) {
 		codes.emplace(u"testupdate"_q, [](SessionController *window) {
 			Core::UpdateChecker().test();
@@ -95,6 +146,10 @@ auto GenerateCodes() {
 	codes.emplace(u"crashplease"_q, [](SessionController *window) {
 		Unexpected("Crashed in Settings!");
 	});
+	codes.emplace(u"memorypressure"_q, [](SessionController *window) {
+		Core::NotifyMemoryPressure();
+		Ui::Toast::Show("Memory pressure simulated.");
+	});
 	codes.emplace(u"moderate"_q, [](SessionController *window) {
 		auto text = Core::App().settings().moderateModeEnabled() ? u"Disable moderate mode?"_q : u"Enable moderate mode?"_q;
 		Ui::show(Ui::MakeConfirmBox({ text, [=] {
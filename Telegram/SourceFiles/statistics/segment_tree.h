@@ -11,6 +11,10 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace Statistic {
 
+// Answers range min / max queries over an immutable series in O(1)
+// from per-level tables, where level k holds the aggregate of each
+// window of 2 ^ k values. The levels are plain contiguous arrays and
+// each one is built in a single linear pass over the previous one.
 class SegmentTree final {
 public:
 	SegmentTree() = default;
@@ -27,44 +31,12 @@ public:
 	[[nodiscard]] ChartValue rMinQ(int from, int to);
 
 private:
-	struct Node final {
-		ChartValue sum = 0;
-		ChartValue max = 0;
-		ChartValue min = 0;
-
-		struct PendingVal {
-			[[nodiscard]] explicit operator bool() const {
-				return available;
-			}
-			ChartValue value = 0;
-			bool available = false;
-		};
-		PendingVal pendingVal;
-
-		int from = 0;
-		int to = 0;
-
-		[[nodiscard]] int size() {
-			return to - from + 1;
-		}
-	};
-
-	void build(ChartValue v, int from, int size);
-	void propagate(ChartValue v);
-	void change(Node &n, ChartValue value);
-
-	[[nodiscard]] ChartValue rMaxQ(ChartValue v, int from, int to);
-	[[nodiscard]] ChartValue rMinQ(ChartValue v, int from, int to);
-
-	[[nodiscard]] bool contains(int from1, int to1, int from2, int to2) const;
-	[[nodiscard]] bool intersects(
-		int from1,
-		int to1,
-		int from2,
-		int to2) const;
+	void build();
 
 	std::vector<ChartValue> _array;
-	std::vector<Node> _heap;
+	std::vector<std::vector<ChartValue>> _max;
+	std::vector<std::vector<ChartValue>> _min;
+	std::vector<int> _levelForSize;
 
 };
 
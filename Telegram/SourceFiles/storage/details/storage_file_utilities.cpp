@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/openssl_help.h"
 #include "base/random.h"
 
+#include <crl/crl_async.h>
 #include <crl/crl_object_on_thread.h>
 #include <QtCore/QtEndian>
 #include <QtCore/QSaveFile>
@@ -29,7 +30,7 @@ struct WriteEntry {
 	QString basePath;
 	QString base;
 	QByteArray data;
-	QByteArray md5;
+	bool backup = false;
 };
 
 class WriteManager final {
@@ -50,7 +51,7 @@ private:
 	[[nodiscard]] bool open(File &file, const WriteEntry &entry, char postfix);
 
 	[[nodiscard]] QString path(const WriteEntry &entry, char postfix) const;
-	[[nodiscard]] bool writeHeader(
+	[[nodiscard]] bool openForWrite(
 		const QString &basePath,
 		QFileDevice &file);
 
@@ -103,7 +104,6 @@ void WriteManager::writeNow(WriteEntry &&entry) {
 	};
 	const auto write = [&](auto &file) {
 		file.write(entry.data);
-		file.write(entry.md5);
 	};
 	const auto safe = path('s');
 	const auto simple = path('0');
@@ -111,9 +111,19 @@ void WriteManager::writeNow(WriteEntry &&entry) {
 	QSaveFile save;
 	if (open(save, 's')) {
 		write(save);
+		if (entry.backup && QFile::exists(safe)) {
+			// Keep the previous good version, so that the data survives
+			// a power loss that cuts the renamed content short before it
+			// reaches the disk. The signature check on read rejects the
+			// broken file and falls back to this copy.
+			QFile::remove(backup);
+			QFile::copy(safe, backup);
+		}
 		if (save.commit()) {
 			QFile::remove(simple);
-			QFile::remove(backup);
+			if (!entry.backup) {
+				QFile::remove(backup);
+			}
 			return;
 		}
 		LOG(("Storage Error: Could not commit '%1'.").arg(safe));
@@ -124,7 +134,9 @@ void WriteManager::writeNow(WriteEntry &&entry) {
 		base::Platform::FlushFileData(plain);
 		plain.close();
 
-		QFile::remove(backup);
+		if (!entry.backup) {
+			QFile::remove(backup);
+		}
 		if (base::Platform::RenameWithOverwrite(simple, safe)) {
 			return;
 		}
@@ -152,7 +164,7 @@ bool WriteManager::writeOneScheduledNow() {
 	return true;
 }
 
-bool WriteManager::writeHeader(const QString &basePath, QFileDevice &file) {
+bool WriteManager::openForWrite(const QString &basePath, QFileDevice &file) {
 	if (!file.open(QIODevice::WriteOnly)) {
 		const auto dir = QDir(basePath);
 		if (dir.exists()) {
@@ -163,9 +175,6 @@ bool WriteManager::writeHeader(const QString &basePath, QFileDevice &file) {
 			return false;
 		}
 	}
-	file.write(TdfMagic, TdfMagicLen);
-	const auto version = qint32(AppVersion);
-	file.write((const char*)&version, sizeof(version));
 	return true;
 }
 
@@ -177,7 +186,7 @@ template <typename File>
 bool WriteManager::open(File &file, const WriteEntry &entry, char postfix) {
 	const auto name = path(entry, postfix);
 	file.setFileName(name);
-	if (!writeHeader(entry.basePath, file)) {
+	if (!openForWrite(entry.basePath, file)) {
 		LOG(("Storage Error: Could not open '%1' for writing.").arg(name));
 		return false;
 	}
@@ -386,9 +395,11 @@ FileWriteDescriptor::FileWriteDescriptor(
 FileWriteDescriptor::FileWriteDescriptor(
 	const QString &name,
 	const QString &basePath,
-	bool sync)
+	bool sync,
+	bool backup)
 : _basePath(basePath)
-, _sync(sync) {
+, _sync(sync)
+, _backup(backup) {
 	init(name);
 }
 
@@ -402,6 +413,12 @@ void FileWriteDescriptor::init(const QString &name) {
 	const auto opened = _buffer.open(QIODevice::WriteOnly);
 	Assert(opened);
 	_stream.setDevice(&_buffer);
+
+	// The magic and version are staged right into the arena, so that
+	// the whole file is flushed with a single contiguous write.
+	_stream.writeRawData(TdfMagic, TdfMagicLen);
+	const auto version = qint32(AppVersion);
+	_stream.writeRawData((const char*)&version, sizeof(version));
 }
 
 void FileWriteDescriptor::writeData(const QByteArray &data) {
@@ -429,19 +446,20 @@ void FileWriteDescriptor::finish() {
 		return;
 	}
 
-	_stream.setDevice(nullptr);
 	_md5.feed(&_fullSize, sizeof(_fullSize));
 	qint32 version = AppVersion;
 	_md5.feed(&version, sizeof(version));
 	_md5.feed(TdfMagic, TdfMagicLen);
+	_stream.writeRawData((const char*)_md5.result(), 0x10);
 
+	_stream.setDevice(nullptr);
 	_buffer.close();
 
 	auto entry = WriteEntry{
 		.basePath = _basePath,
 		.base = _base,
 		.data = _safeData,
-		.md5 = QByteArray((const char*)_md5.result(), 0x10)
+		.backup = _backup,
 	};
 	if (_sync) {
 		Manager.writeSync(std::move(entry));
@@ -480,8 +498,15 @@ bool ReadFile(
 	// detect order of read attempts
 	QString toTry[2];
 	const auto modern = base + 's';
-	if (QFileInfo::exists(modern)) {
+	const auto modernExists = QFileInfo::exists(modern);
+	if (modernExists) {
 		toTry[0] = modern;
+		const auto backup = base + '1';
+		if (QFileInfo::exists(backup)) {
+			// The previous good version, in case the latest write was
+			// cut short by a crash or a power loss.
+			toTry[1] = backup;
+		}
 	} else {
 		// Legacy way.
 		toTry[0] = base + '0';
@@ -573,8 +598,10 @@ bool ReadFile(
 		result.stream.setDevice(&result.buffer);
 		result.stream.setVersion(QDataStream::Qt_5_1);
 
-		if ((i == 0 && !toTry[1].isEmpty()) || i == 1) {
-			QFile::remove(toTry[1 - i]);
+		if (i == 1) {
+			QFile::remove(toTry[0]);
+		} else if (!modernExists && !toTry[1].isEmpty()) {
+			QFile::remove(toTry[1]);
 		}
 
 		return true;
@@ -582,6 +609,24 @@ bool ReadFile(
 	return false;
 }
 
+void PrefetchFile(const QString &name, const QString &basePath) {
+	crl::async([base = basePath + name] {
+		const auto warm = [](const QString &path) {
+			QFile f(path);
+			if (f.open(QIODevice::ReadOnly)) {
+				[[maybe_unused]] const auto bytes = f.readAll();
+			}
+		};
+		const auto modern = base + 's';
+		if (QFileInfo::exists(modern)) {
+			warm(modern);
+		} else {
+			warm(base + '0');
+			warm(base + '1');
+		}
+	});
+}
+
 bool DecryptLocal(
 		EncryptedDescriptor &result,
 		const QByteArray &encrypted,
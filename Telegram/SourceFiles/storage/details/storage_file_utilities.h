@@ -61,7 +61,8 @@ public:
 	FileWriteDescriptor(
 		const QString &name,
 		const QString &basePath,
-		bool sync = false);
+		bool sync = false,
+		bool backup = false);
 	~FileWriteDescriptor();
 
 	void writeData(const QByteArray &data);
@@ -81,6 +82,7 @@ private:
 	HashMd5 _md5;
 	int _fullSize = 0;
 	bool _sync = false;
+	bool _backup = false;
 
 };
 
@@ -89,6 +91,10 @@ bool ReadFile(
 	const QString &name,
 	const QString &basePath);
 
+// Warms the OS file cache for the file on a background thread, so that
+// a following synchronous ReadFile() doesn't wait for a cold disk.
+void PrefetchFile(const QString &name, const QString &basePath);
+
 bool DecryptLocal(
 	EncryptedDescriptor &result,
 	const QByteArray &encrypted,
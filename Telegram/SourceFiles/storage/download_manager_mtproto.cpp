@@ -16,6 +16,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "apiwrap.h"
 #include "base/openssl_help.h"
 
+#include <crl/crl_async.h>
+
 namespace Storage {
 namespace {
 
@@ -82,7 +84,7 @@ bool DownloadManagerMtproto::Queue::empty() const {
 	return _tasks.empty();
 }
 
-auto DownloadManagerMtproto::Queue::nextTask(bool onlyHighestPriority) const
+auto DownloadManagerMtproto::Queue::nextTask(bool onlyHighestPriority)
 -> Task* {
 	if (_tasks.empty()) {
 		return nullptr;
@@ -100,7 +102,25 @@ auto DownloadManagerMtproto::Queue::nextTask(bool onlyHighestPriority) const
 	const auto first = ranges::find_if(
 		ranges::make_subrange(begin(_tasks), till),
 		readyToRequest);
-	return (first != till) ? first->task.get() : nullptr;
+	if (first == till) {
+		return nullptr;
+	}
+	const auto result = first->task.get();
+
+	// Round-robin between tasks of equal priority, so that a bunch of
+	// small files (sticker pack install, emoji set sync) interleave
+	// their parts over the sessions instead of being requested one
+	// after another, each waiting for the head of the queue to finish.
+	const auto priority = first->priority;
+	const auto samePriorityEnd = std::find_if(
+		first + 1,
+		end(_tasks),
+		[&](const Enqueued &enqueued) {
+			return (enqueued.priority != priority);
+		});
+	std::rotate(first, first + 1, samePriorityEnd);
+
+	return result;
 }
 
 void DownloadManagerMtproto::Queue::removeSession(int index) {
@@ -137,6 +157,11 @@ DownloadManagerMtproto::~DownloadManagerMtproto() {
 
 void DownloadManagerMtproto::enqueue(not_null<Task*> task, int priority) {
 	const auto dcId = task->dcId();
+	if (!_queues.contains(dcId)) {
+		// Overlap the auth export / import with the connection and key
+		// setup for the first download from this dc.
+		api().instance().importAuthIfNeeded(dcId);
+	}
 	auto &queue = _queues[dcId];
 	queue.enqueue(task, priority);
 	if (!_resetGenerationTimer.isActive()) {
@@ -682,42 +707,60 @@ void DownloadMtprotoTask::cdnPartLoaded(const MTPupload_CdnFile &result, mtpRequ
 			owner->checkSendNextAfterSuccess(dcId);
 		});
 
-		auto key = bytes::make_span(_cdnEncryptionKey);
-		auto iv = bytes::make_span(_cdnEncryptionIV);
-		Expects(key.size() == MTP::CTRState::KeySize);
-		Expects(iv.size() == MTP::CTRState::IvecSize);
-
-		auto state = MTP::CTRState();
-		auto ivec = bytes::make_span(state.ivec);
-		std::copy(iv.begin(), iv.end(), ivec.begin());
-
-		auto counterOffset = static_cast<uint32>(requestData.offset >> 4);
-		state.ivec[15] = static_cast<uchar>(counterOffset & 0xFF);
-		state.ivec[14] = static_cast<uchar>((counterOffset >> 8) & 0xFF);
-		state.ivec[13] = static_cast<uchar>((counterOffset >> 16) & 0xFF);
-		state.ivec[12] = static_cast<uchar>((counterOffset >> 24) & 0xFF);
-
-		auto decryptInPlace = data.vbytes().v;
-		auto buffer = bytes::make_detached_span(decryptInPlace);
-		MTP::aesCtrEncrypt(buffer, key.data(), &state);
-
-		switch (checkCdnFileHash(requestData.offset, buffer)) {
-		case CheckCdnHashResult::NoHash: {
-			_cdnUncheckedParts.emplace(requestData, decryptInPlace);
-			requestMoreCdnFileHashes();
-		} return;
-
-		case CheckCdnHashResult::Invalid: {
-			LOG(("API Error: Wrong cdnFileHash for offset %1."
-				).arg(requestData.offset));
-			cancelOnFail();
-		} return;
-
-		case CheckCdnHashResult::Good: {
-			partLoaded(requestData.offset, decryptInPlace);
-		} return;
-		}
-		Unexpected("Result of checkCdnFileHash()");
+		Expects(_cdnEncryptionKey.size() == MTP::CTRState::KeySize);
+		Expects(_cdnEncryptionIV.size() == MTP::CTRState::IvecSize);
+
+		// Decrypting and hashing on the response handler thread adds up
+		// over a multi-gigabyte download. Do both on a background thread
+		// overlapped with the network requests, hopping back only with
+		// the verdict. The SHA-256 itself goes through OpenSSL, which
+		// dispatches to the SIMD / SHA extension kernels at runtime.
+		const auto hashIt = _cdnFileHashes.find(requestData.offset);
+		const auto hash = (hashIt != _cdnFileHashes.cend())
+			? std::make_optional(hashIt->second.hash)
+			: std::nullopt;
+		const auto key = _cdnEncryptionKey;
+		const auto iv = _cdnEncryptionIV;
+		const auto weak = base::make_weak(this);
+		crl::async([=, decryptInPlace = data.vbytes().v]() mutable {
+			auto state = MTP::CTRState();
+			const auto ivSpan = bytes::make_span(iv);
+			auto ivec = bytes::make_span(state.ivec);
+			std::copy(ivSpan.begin(), ivSpan.end(), ivec.begin());
+
+			auto counterOffset = static_cast<uint32>(requestData.offset >> 4);
+			state.ivec[15] = static_cast<uchar>(counterOffset & 0xFF);
+			state.ivec[14] = static_cast<uchar>((counterOffset >> 8) & 0xFF);
+			state.ivec[13] = static_cast<uchar>((counterOffset >> 16) & 0xFF);
+			state.ivec[12] = static_cast<uchar>((counterOffset >> 24) & 0xFF);
+
+			auto buffer = bytes::make_detached_span(decryptInPlace);
+			MTP::aesCtrEncrypt(
+				buffer,
+				bytes::make_span(key).data(),
+				&state);
+
+			const auto good = hash
+				? std::make_optional(!bytes::compare(
+					openssl::Sha256(buffer),
+					bytes::make_span(*hash)))
+				: std::nullopt;
+			crl::on_main(weak, [=] {
+				const auto strong = weak.get();
+				if (!good) {
+					strong->_cdnUncheckedParts.emplace(
+						requestData,
+						decryptInPlace);
+					strong->requestMoreCdnFileHashes();
+				} else if (*good) {
+					strong->partLoaded(requestData.offset, decryptInPlace);
+				} else {
+					LOG(("API Error: Wrong cdnFileHash for offset %1."
+						).arg(requestData.offset));
+					strong->cancelOnFail();
+				}
+			});
+		});
 	});
 }
 
@@ -25,6 +25,12 @@ namespace Storage {
 // fixed part size download for hash checking.
 constexpr auto kDownloadPartSize = 128 * 1024;
 
+// Priority classes for the per-DC download queues. While anything of a
+// higher class still wants parts, lower classes don't get new slots.
+constexpr auto kBackgroundDownloadPriority = 0;
+constexpr auto kPreloadDownloadPriority = 1;
+constexpr auto kInteractiveDownloadPriority = 2;
+
 class DownloadMtprotoTask;
 
 class DownloadManagerMtproto final : public base::has_weak_ptr {
@@ -42,7 +48,18 @@ public:
 	void remove(not_null<Task*> task);
 
 	void notifyTaskFinished() {
-		_taskFinished.fire({});
+		// Views subscribe to this to repaint whatever they show, so a
+		// burst of finishing thumbnails in a media grid used to run
+		// every subscriber once per file. Coalesce the notifications
+		// and fire once per main loop iteration instead.
+		if (_taskFinishedNotifyScheduled) {
+			return;
+		}
+		_taskFinishedNotifyScheduled = true;
+		crl::on_main(this, [=] {
+			_taskFinishedNotifyScheduled = false;
+			_taskFinished.fire({});
+		});
 	}
 	[[nodiscard]] rpl::producer<> taskFinished() const {
 		return _taskFinished.events();
@@ -71,7 +88,7 @@ private:
 		void remove(not_null<Task*> task);
 		void resetGeneration();
 		[[nodiscard]] bool empty() const;
-		[[nodiscard]] Task *nextTask(bool onlyHighestPriority) const;
+		[[nodiscard]] Task *nextTask(bool onlyHighestPriority);
 		void removeSession(int index);
 
 	private:
@@ -116,6 +133,7 @@ private:
 	const not_null<ApiWrap*> _api;
 
 	rpl::event_stream<> _taskFinished;
+	bool _taskFinishedNotifyScheduled = false;
 	rpl::event_stream<DocumentId> _nonPremiumDelays;
 
 	base::flat_map<MTP::DcId, DcBalanceData> _balanceData;
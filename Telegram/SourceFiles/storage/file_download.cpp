@@ -15,9 +15,12 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/file_location.h"
 #include "storage/storage_account.h"
+#include "storage/storage_hot_blob_cache.h"
 #include "storage/file_download_mtproto.h"
 #include "storage/file_download_web.h"
 #include "platform/platform_file_utilities.h"
+#include "main/main_account.h"
+#include "main/main_domain.h"
 #include "main/main_session.h"
 #include "apiwrap.h"
 #include "core/crash_reports.h"
@@ -25,6 +28,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace {
 
+// Combine received parts into sequential disk writes of at least this size,
+// so spinning and network disks see few big writes instead of a seek per part.
+constexpr auto kCombinedWriteMinSize = int64(1024 * 1024);
+
+// Never hold more than this much not yet written parts in memory.
+constexpr auto kStagedPartsLimit = int64(8 * 1024 * 1024);
+
 class FromMemoryLoader final : public FileLoader {
 public:
 	FromMemoryLoader(
@@ -125,6 +135,8 @@ Main::Session &FileLoader::session() const {
 void FileLoader::finishWithBytes(const QByteArray &data) {
 	_data = data;
 	_localStatus = LocalStatus::Loaded;
+	_stagedParts.clear();
+	_stagedBytes = 0;
 	if (!_filename.isEmpty() && _toCache == LoadToCacheAsWell) {
 		if (!_fileIsOpen) _fileIsOpen = _file.open(QIODevice::WriteOnly);
 		if (!_fileIsOpen) {
@@ -145,6 +157,43 @@ void FileLoader::finishWithBytes(const QByteArray &data) {
 		Platform::File::PostprocessDownloaded(
 			QFileInfo(_file).absoluteFilePath());
 	}
+	notifyFinished();
+}
+
+void FileLoader::notifyFinished() {
+	// Decode a just-downloaded image off the main thread before firing
+	// the done notification, so that the consumers find imageData()
+	// ready instead of decoding a full-size photo right in the update
+	// cycle. The local cache load path already decodes this way.
+	if ((_locationType == UnknownFileLocation)
+		&& (_toCache == LoadToCacheAsWell)
+		&& _imageData.isNull()
+		&& !_data.isEmpty()) {
+		crl::async([
+			=,
+			guard = _asyncImageReading.make_guard(),
+			data = _data
+		]() mutable {
+			auto read = Images::Read({ .content = data });
+			crl::on_main(std::move(guard), [
+				=,
+				image = std::move(read.image),
+				format = std::move(read.format)
+			]() mutable {
+				if (_cancelled) {
+					return;
+				}
+				if (!image.isNull()) {
+					_imageData = std::move(image);
+					_imageFormat = std::move(format);
+				}
+				const auto session = _session;
+				_updates.fire_done();
+				session->notifyDownloaderTaskFinished();
+			});
+		});
+		return;
+	}
 	const auto session = _session;
 	_updates.fire_done();
 	session->notifyDownloaderTaskFinished();
@@ -199,6 +248,11 @@ void FileLoader::increaseLoadSize(int64 size, bool autoLoading) {
 
 	_loadSize = size;
 	_autoLoading = autoLoading;
+	if (!_finished && !_cancelled) {
+		// A background preload may have turned into a user-initiated
+		// download (or vice versa), reflect that in the queue priority.
+		startLoading();
+	}
 }
 
 void FileLoader::notifyAboutProgress() {
@@ -208,16 +262,15 @@ void FileLoader::notifyAboutProgress() {
 void FileLoader::localLoaded(
 		const StorageImageSaved &result,
 		const QByteArray &imageFormat,
-		const QImage &imageData) {
+		const QImage &imageData,
+		bool partial) {
 	_localLoading = nullptr;
 	if (result.data.isEmpty()) {
 		_localStatus = LocalStatus::NotFound;
 		start();
 		return;
 	}
-	const auto partial = result.data.startsWith("partial:");
-	constexpr auto kPrefix = 8;
-	if (partial	&& result.data.size() < _loadSize + kPrefix) {
+	if (partial && result.data.size() < _loadSize) {
 		_localStatus = LocalStatus::NotFound;
 		if (checkForOpen()) {
 			startLoadingWithPartial(result.data);
@@ -228,11 +281,7 @@ void FileLoader::localLoaded(
 		_imageFormat = imageFormat;
 		_imageData = imageData;
 	}
-	finishWithBytes(partial
-		? QByteArray::fromRawData(
-			result.data.data() + kPrefix,
-			result.data.size() - kPrefix)
-		: result.data);
+	finishWithBytes(result.data);
 }
 
 void FileLoader::start() {
@@ -267,22 +316,28 @@ void FileLoader::loadLocal(const Storage::Cache::Key &key) {
 	auto done = [=, guard = _localLoading.make_guard()](
 			QByteArray &&value,
 			QImage &&image,
-			QByteArray &&format) mutable {
+			QByteArray &&format,
+			bool partial) mutable {
 		crl::on_main(std::move(guard), [
 			=,
 			value = std::move(value),
 			image = std::move(image),
 			format = std::move(format)
 		]() mutable {
+			if (!partial && !value.isEmpty()) {
+				_session->data().hotBlobCache().put(key, value);
+			}
 			localLoaded(
 				StorageImageSaved(std::move(value)),
 				format,
-				std::move(image));
+				std::move(image),
+				partial);
 		});
 	};
-	_session->data().cache().get(key, [=, callback = std::move(done)](
-			QByteArray &&value) mutable {
-		if (readImage && !value.startsWith("partial:")) {
+	auto process = [=, callback = std::move(done)](
+			QByteArray &&value,
+			bool partial) mutable {
+		if (readImage && !partial) {
 			crl::async([
 				value = std::move(value),
 				done = std::move(callback)
@@ -292,15 +347,92 @@ void FileLoader::loadLocal(const Storage::Cache::Key &key) {
 					done(
 						std::move(value),
 						std::move(read.image),
-						std::move(read.format));
+						std::move(read.format),
+						false);
 				} else {
-					done(std::move(value), {}, {});
+					done(std::move(value), {}, {}, false);
 				}
 			});
 		} else {
-			callback(std::move(value), {}, {});
+			callback(std::move(value), {}, {}, partial);
 		}
-	});
+	};
+	if (auto cached = _session->data().hotBlobCache().get(key)) {
+		process(std::move(*cached), false);
+		return;
+	}
+
+	// The cache key is derived from the document, not from the account,
+	// so the same media downloaded in another logged in account sits in
+	// that account's cache under the same key. On a local miss check the
+	// other accounts before going to network, writing a hit through to
+	// our own cache so the next lookup is local again.
+	//
+	// The cache databases die with their sessions on logout, so no
+	// database pointers are kept across the async hops - each hop comes
+	// back to the main thread and re-resolves its database from a weak
+	// session pointer, skipping the sessions that are already gone.
+	const auto sessions = std::make_shared<
+		std::vector<base::weak_ptr<Main::Session>>>();
+	sessions->push_back(base::make_weak(_session.get()));
+	for (const auto &[index, account] : Core::App().domain().accounts()) {
+		if (const auto session = account->maybeSession()) {
+			if (session != _session) {
+				sessions->push_back(base::make_weak(session));
+			}
+		}
+	}
+	const auto tag = _cacheTag;
+	const auto handle = std::make_shared<decltype(process)>(
+		std::move(process));
+	const auto lookup = std::make_shared<Fn<void(int)>>();
+	*lookup = [=](int index) {
+		const auto miss = [=] {
+			if (index + 1 < int(sessions->size())) {
+				(*lookup)(index + 1);
+				return;
+			}
+			const auto own = sessions->front().get();
+			if (!own) {
+				(*handle)(QByteArray(), true);
+				return;
+			}
+			own->data().cache().get(
+				Data::DownloadPartialCacheKey(key),
+				[=](QByteArray &&value) mutable {
+					(*handle)(std::move(value), true);
+				});
+		};
+		const auto session = (*sessions)[index].get();
+		if (!session) {
+			miss();
+			return;
+		}
+		session->data().cache().get(key, [=](QByteArray &&value) mutable {
+			crl::on_main([=, value = std::move(value)]() mutable {
+				// Legacy versions stored partial downloads under the full
+				// file key with an in-band "partial:" prefix, so the prefix
+				// check can't tell them from a real file starting with the
+				// same bytes. Treat such records as a miss, they get written
+				// over when the download finishes.
+				if (value.isEmpty() || value.startsWith("partial:")) {
+					miss();
+					return;
+				}
+				if (index > 0) {
+					if (const auto own = sessions->front().get()) {
+						own->data().cache().put(
+							key,
+							Storage::Cache::Database::TaggedValue(
+								base::duplicate(value),
+								tag));
+					}
+				}
+				(*handle)(std::move(value), false);
+			});
+		});
+	};
+	(*lookup)(0);
 }
 
 bool FileLoader::tryLoadLocal() {
@@ -339,6 +471,8 @@ void FileLoader::cancel(FailureReason fail) {
 
 	_cancelled = true;
 	_finished = true;
+	_stagedParts.clear();
+	_stagedBytes = 0;
 	if (_fileIsOpen) {
 		_file.close();
 		_fileIsOpen = false;
@@ -359,7 +493,8 @@ void FileLoader::cancel(FailureReason fail) {
 }
 
 int64 FileLoader::currentOffset() const {
-	return (_fileIsOpen ? _file.size() : _data.size()) - _skippedBytes;
+	return (_fileIsOpen ? (_file.size() + _stagedBytes) : _data.size())
+		- _skippedBytes;
 }
 
 bool FileLoader::writeResultPart(int64 offset, bytes::const_span buffer) {
@@ -369,18 +504,13 @@ bool FileLoader::writeResultPart(int64 offset, bytes::const_span buffer) {
 		return true;
 	}
 	if (_fileIsOpen) {
-		auto fsize = _file.size();
+		auto fsize = stagedFileSize();
 		if (offset < fsize) {
 			_skippedBytes -= buffer.size();
 		} else if (offset > fsize) {
 			_skippedBytes += offset - fsize;
 		}
-		_file.seek(offset);
-		if (_file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size()) != qint64(buffer.size())) {
-			cancel(FailureReason::FileWriteFailure);
-			return false;
-		}
-		return true;
+		return writeStagedPart(offset, buffer);
 	}
 	_data.reserve(offset + buffer.size());
 	if (offset > _data.size()) {
@@ -402,10 +532,77 @@ bool FileLoader::writeResultPart(int64 offset, bytes::const_span buffer) {
 	return true;
 }
 
+bool FileLoader::writeStagedPart(int64 offset, bytes::const_span buffer) {
+	if (offset < _file.size()) {
+		// Overwrite of already flushed bytes, write it through directly.
+		_file.seek(offset);
+		if (_file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size()) != qint64(buffer.size())) {
+			cancel(FailureReason::FileWriteFailure);
+			return false;
+		}
+		return true;
+	}
+	auto &part = _stagedParts[offset];
+	_stagedBytes += int64(buffer.size()) - part.size();
+	part = QByteArray(
+		reinterpret_cast<const char*>(buffer.data()),
+		buffer.size());
+	return flushStagedParts(false);
+}
+
+bool FileLoader::flushStagedParts(bool all) {
+	while (!_stagedParts.empty()) {
+		const auto from = begin(_stagedParts);
+		const auto offset = from->first;
+		auto run = int64(from->second.size());
+		auto till = from + 1;
+		while (till != end(_stagedParts) && till->first == offset + run) {
+			run += till->second.size();
+			++till;
+		}
+		if (!all
+			&& (run < kCombinedWriteMinSize)
+			&& (_stagedBytes < kStagedPartsLimit)) {
+			return true;
+		}
+		if (!_file.seek(offset)) {
+			cancel(FailureReason::FileWriteFailure);
+			return false;
+		}
+		for (auto i = from; i != till; ++i) {
+			const auto &bytes = i->second;
+			if (_file.write(bytes.constData(), bytes.size()) != qint64(bytes.size())) {
+				cancel(FailureReason::FileWriteFailure);
+				return false;
+			}
+			_stagedBytes -= bytes.size();
+		}
+		_stagedParts.erase(from, till);
+	}
+	return true;
+}
+
+int64 FileLoader::stagedFileSize() const {
+	const auto fsize = int64(_file.size());
+	if (_stagedParts.empty()) {
+		return fsize;
+	}
+	const auto &last = *(end(_stagedParts) - 1);
+	return std::max(fsize, last.first + int64(last.second.size()));
+}
+
 QByteArray FileLoader::readLoadedPartBack(int64 offset, int size) {
 	Expects(offset >= 0 && size > 0);
 
 	if (_fileIsOpen) {
+		const auto i = _stagedParts.find(offset);
+		if (i != end(_stagedParts) && i->second.size() >= size) {
+			return (i->second.size() == size)
+				? i->second
+				: i->second.mid(0, size);
+		} else if (!flushStagedParts(true)) {
+			return QByteArray();
+		}
 		if (_file.openMode() == QIODevice::WriteOnly) {
 			_file.close();
 			_fileIsOpen = _file.open(QIODevice::ReadWrite);
@@ -428,6 +625,9 @@ QByteArray FileLoader::readLoadedPartBack(int64 offset, int size) {
 bool FileLoader::finalizeResult() {
 	Expects(!_finished);
 
+	if (_fileIsOpen && !flushStagedParts(true)) {
+		return false;
+	}
 	if (!_filename.isEmpty() && (_toCache == LoadToCacheAsWell)) {
 		if (!_fileIsOpen) {
 			_fileIsOpen = _file.open(QIODevice::WriteOnly);
@@ -458,18 +658,15 @@ bool FileLoader::finalizeResult() {
 		if ((_toCache == LoadToCacheAsWell)
 			&& (_data.size() <= Storage::kMaxFileInMemory)
 			&& (key.low || key.high)) {
+			const auto full = !_fullSize || (_data.size() == _fullSize);
 			_session->data().cache().put(
-				cacheKey(),
+				full ? key : Data::DownloadPartialCacheKey(key),
 				Storage::Cache::Database::TaggedValue(
-					base::duplicate((!_fullSize || _data.size() == _fullSize)
-						? _data
-						: ("partial:" + _data)),
+					base::duplicate(_data),
 					_cacheTag));
 		}
 	}
-	const auto session = _session;
-	_updates.fire_done();
-	session->notifyDownloaderTaskFinished();
+	notifyFinished();
 	return true;
 }
 
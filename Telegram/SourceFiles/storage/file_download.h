@@ -122,7 +122,8 @@ public:
 	void localLoaded(
 		const StorageImageSaved &result,
 		const QByteArray &imageFormat,
-		const QImage &imageData);
+		const QImage &imageData,
+		bool partial);
 
 	[[nodiscard]] rpl::producer<rpl::empty_value, Error> updates() const {
 		return _updates.events();
@@ -155,12 +156,17 @@ protected:
 
 	void cancel(FailureReason failed);
 
+	void notifyFinished();
 	void notifyAboutProgress();
 
 	bool writeResultPart(int64 offset, bytes::const_span buffer);
 	bool finalizeResult();
 	[[nodiscard]] QByteArray readLoadedPartBack(int64 offset, int size);
 
+	bool writeStagedPart(int64 offset, bytes::const_span buffer);
+	bool flushStagedParts(bool all);
+	[[nodiscard]] int64 stagedFileSize() const;
+
 	const not_null<Main::Session*> _session;
 
 	bool _autoLoading = false;
@@ -181,9 +187,12 @@ protected:
 	int64 _loadSize = 0;
 	int64 _fullSize = 0;
 	int64 _skippedBytes = 0;
+	base::flat_map<int64, QByteArray> _stagedParts;
+	int64 _stagedBytes = 0;
 	LocationType _locationType = LocationType();
 
 	base::binary_guard _localLoading;
+	base::binary_guard _asyncImageReading;
 	mutable QByteArray _imageFormat;
 	mutable QImage _imageData;
 
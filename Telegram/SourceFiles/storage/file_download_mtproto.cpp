@@ -181,18 +181,17 @@ bool mtpFileLoader::setWebFileSizeHook(int64 size) {
 }
 
 void mtpFileLoader::startLoading() {
-	addToQueue();
+	addToQueue(autoLoading()
+		? Storage::kBackgroundDownloadPriority
+		: Storage::kInteractiveDownloadPriority);
 }
 
 void mtpFileLoader::startLoadingWithPartial(const QByteArray &data) {
-	Expects(data.startsWith("partial:"));
-
-	constexpr auto kPrefix = 8;
-	const auto parts = (data.size() - kPrefix) / Storage::kDownloadPartSize;
+	const auto parts = data.size() / Storage::kDownloadPartSize;
 	const auto use = parts * int64(Storage::kDownloadPartSize);
 	if (use > 0) {
 		_nextRequestOffset = use;
-		feedPart(0, QByteArray::fromRawData(data.data() + kPrefix, use));
+		feedPart(0, QByteArray::fromRawData(data.data(), use));
 	}
 	startLoading();
 }
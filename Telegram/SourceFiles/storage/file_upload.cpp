@@ -20,6 +20,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "history/history.h"
 #include "core/file_location.h"
 #include "core/mime_type.h"
+#include "core/send_latency.h"
 #include "main/main_session.h"
 #include "apiwrap.h"
 
@@ -70,9 +71,12 @@ constexpr auto kAcceptAsFastIfTotalAtLeast = 512 * 1024;
 } // namespace
 
 struct Uploader::Entry {
-	Entry(FullMsgId itemId, const std::shared_ptr<FilePrepareResult> &file);
+	Entry(
+		FullMsgId itemId,
+		const std::shared_ptr<FilePrepareResult> &file,
+		int minDocPartSize);
 
-	void setDocSize(int64 size);
+	void setDocSize(int64 size, int minPartSize);
 	bool setPartSize(int partSize);
 
 	// const, but non-const for the move-assignment in the
@@ -95,6 +99,10 @@ struct Uploader::Entry {
 	ushort docPartsCount = 0;
 	ushort docPartsWaiting = 0;
 
+	int64 docPrefetchOffset = -1;
+	QByteArray docPrefetchBytes;
+	bool docPrefetchRequested = false;
+
 };
 
 struct Uploader::Request {
@@ -111,7 +119,8 @@ struct Uploader::Request {
 
 Uploader::Entry::Entry(
 	FullMsgId itemId,
-	const std::shared_ptr<FilePrepareResult> &file)
+	const std::shared_ptr<FilePrepareResult> &file,
+	int minDocPartSize)
 : itemId(itemId)
 , file(file)
 , parts((file->type == SendMediaType::Photo
@@ -126,18 +135,21 @@ Uploader::Entry::Entry(
 		|| file->type == SendMediaType::ThemeFile
 		|| file->type == SendMediaType::Audio
 		|| file->type == SendMediaType::Round) {
-		setDocSize(file->filesize);
+		setDocSize(file->filesize, minDocPartSize);
 	}
 }
 
-void Uploader::Entry::setDocSize(int64 size) {
+void Uploader::Entry::setDocSize(int64 size, int minPartSize) {
 	docSize = size;
 	constexpr auto limit0 = 1024 * 1024;
 	constexpr auto limit1 = 32 * limit0;
-	if (docSize >= limit0 || !setPartSize(kDocumentUploadPartSize0)) {
-		if (docSize > limit1 || !setPartSize(kDocumentUploadPartSize1)) {
-			if (!setPartSize(kDocumentUploadPartSize2)) {
-				if (!setPartSize(kDocumentUploadPartSize3)) {
+	const auto tryPartSize = [&](int partSize) {
+		return (partSize >= minPartSize) && setPartSize(partSize);
+	};
+	if (docSize >= limit0 || !tryPartSize(kDocumentUploadPartSize0)) {
+		if (docSize > limit1 || !tryPartSize(kDocumentUploadPartSize1)) {
+			if (!tryPartSize(kDocumentUploadPartSize2)) {
+				if (!tryPartSize(kDocumentUploadPartSize3)) {
 					setPartSize(kDocumentUploadPartSize4);
 				}
 			}
@@ -336,13 +348,28 @@ void Uploader::upload(
 			document->checkWallPaperProperties();
 		}
 	}
-	_queue.push_back({ itemId, file });
+	Core::SendLatency::Instance().mark(
+		itemId,
+		Core::SendLatency::Stage::UploadStarted);
+	_queue.push_back({ itemId, file, chooseMinDocPartSize() });
 	if (!_nextTimer.isActive()) {
 		maybeSend();
 	}
 }
 
+int Uploader::chooseMinDocPartSize() const {
+	// The part size is fixed for the whole file (the parts count is
+	// promised in each upload.saveBigFilePart), so we can adapt only
+	// when a new file starts. On a connection that already proved fast
+	// the fixed per-request overhead dominates at 32-64kb parts, so
+	// start new files from larger parts right away.
+	return _dcIndicesWithFastRequests.empty()
+		? 0
+		: kDocumentUploadPartSize3;
+}
+
 void Uploader::failed(FullMsgId itemId) {
+	Core::SendLatency::Instance().discard(itemId);
 	const auto i = ranges::find(_queue, itemId, &Entry::itemId);
 	if (i != end(_queue)) {
 		const auto entry = std::move(*i);
@@ -409,16 +436,70 @@ QByteArray Uploader::readDocPart(not_null<Entry*> entry) {
 	if (!content.isEmpty()) {
 		const auto offset = entry->docPartsSent * entry->docPartSize;
 		return checked(content.mid(offset, entry->docPartSize));
-	} else if (!entry->docFile) {
+	}
+	const auto offset = int64(entry->docPartsSent) * entry->docPartSize;
+	if (entry->docPrefetchOffset == offset
+		&& !entry->docPrefetchBytes.isEmpty()) {
+		entry->docPrefetchOffset = -1;
+		return checked(base::take(entry->docPrefetchBytes));
+	}
+	if (!entry->docFile) {
 		const auto filepath = entry->file->filepath;
 		entry->docFile = std::make_unique<QFile>(filepath);
 		if (!entry->docFile->open(QIODevice::ReadOnly)) {
 			return QByteArray();
 		}
 	}
+	if (!entry->docFile->seek(offset)) {
+		return QByteArray();
+	}
 	return checked(entry->docFile->read(entry->docPartSize));
 }
 
+void Uploader::prefetchNextDocPart(not_null<Entry*> entry) {
+	if (entry->docPrefetchRequested
+		|| !entry->file->content.isEmpty()
+		|| entry->file->filepath.isEmpty()
+		|| entry->docPartsSent >= entry->docPartsCount) {
+		return;
+	}
+	const auto itemId = entry->itemId;
+	const auto filepath = entry->file->filepath;
+	const auto offset = int64(entry->docPartsSent) * entry->docPartSize;
+	const auto size = entry->docPartSize;
+	entry->docPrefetchRequested = true;
+
+	const auto weak = base::make_weak(this);
+	crl::async([weak, itemId, filepath, offset, size] {
+		auto file = QFile(filepath);
+		auto bytes = QByteArray();
+		if (file.open(QIODevice::ReadOnly) && file.seek(offset)) {
+			bytes = file.read(size);
+		}
+		crl::on_main([weak, itemId, offset, bytes = std::move(bytes)] {
+			if (const auto that = weak.get()) {
+				that->docPartPrefetched(itemId, offset, bytes);
+			}
+		});
+	});
+}
+
+void Uploader::docPartPrefetched(
+		FullMsgId itemId,
+		int64 offset,
+		const QByteArray &bytes) {
+	const auto i = ranges::find(_queue, itemId, &Entry::itemId);
+	if (i == end(_queue)) {
+		return;
+	}
+	i->docPrefetchRequested = false;
+	const auto next = int64(i->docPartsSent) * i->docPartSize;
+	if (offset == next && !bytes.isEmpty()) {
+		i->docPrefetchOffset = offset;
+		i->docPrefetchBytes = bytes;
+	}
+}
+
 bool Uploader::canAddDcIndex() const {
 	const auto count = int(_sentPerDcIndex.size());
 	return (count < kMaxSessionsCount)
@@ -569,6 +650,10 @@ auto Uploader::sendDocPart(not_null<Entry*> entry, uchar dcIndex)
 			MTP_bytes(partBytes)
 		), false);
 	}
+
+	// Overlap reading the next part from disk with this network send.
+	prefetchNextDocPart(entry);
+
 	return SendResult::Success;
 }
 
@@ -832,6 +917,10 @@ void Uploader::finishFront() {
 	auto entry = std::move(_queue.front());
 	_queue.erase(_queue.begin());
 
+	Core::SendLatency::Instance().mark(
+		entry.itemId,
+		Core::SendLatency::Stage::UploadFinished);
+
 	const auto options = entry.file
 		? entry.file->to.options
 		: Api::SendOptions();
@@ -122,6 +122,12 @@ private:
 	[[nodiscard]] auto sendSlicedPart(not_null<Entry*> entry, uchar dcIndex)
 		-> SendResult;
 	[[nodiscard]] QByteArray readDocPart(not_null<Entry*> entry);
+	[[nodiscard]] int chooseMinDocPartSize() const;
+	void prefetchNextDocPart(not_null<Entry*> entry);
+	void docPartPrefetched(
+		FullMsgId itemId,
+		int64 offset,
+		const QByteArray &bytes);
 	void removeDcIndex();
 
 	template <typename Prepared>
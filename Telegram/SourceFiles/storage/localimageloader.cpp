@@ -243,6 +243,18 @@ TaskId TaskQueue::addTask(std::unique_ptr<Task> &&task) {
 	return result;
 }
 
+TaskId TaskQueue::addPriorityTask(std::unique_ptr<Task> &&task) {
+	const auto result = task->id();
+	{
+		QMutexLocker lock(&_tasksToProcessMutex);
+		_tasksToProcess.push_front(std::move(task));
+	}
+
+	wakeThread();
+
+	return result;
+}
+
 void TaskQueue::addTasks(std::vector<std::unique_ptr<Task>> &&tasks) {
 	{
 		QMutexLocker lock(&_tasksToProcessMutex);
@@ -688,6 +700,7 @@ void FileLoadTask::process(Args &&args) {
 		.spoiler = _spoiler,
 		.album = _album,
 	});
+	_result->queuedAt = _queuedAt;
 
 	QString filename, filemime;
 	qint64 filesize = 0;
@@ -940,6 +953,13 @@ void FileLoadTask::process(Args &&args) {
 				}
 				auto medium = (w > 320 || h > 320) ? fullimage.scaled(320, 320, Qt::KeepAspectRatio, Qt::SmoothTransformation) : fullimage;
 
+				if (_type == SendMediaType::Photo && !_to.replaceMediaOf) {
+					// Let the bubble appear with the blurred preview
+					// right away, the full-size scaling and re-encode
+					// below may take a while for a large album.
+					sendPreview(medium);
+				}
+
 				const auto limit = PhotoSideLimitAtomic();
 				const auto downscaled = (w > limit || h > limit);
 				auto full = downscaled ? fullimage.scaled(limit, limit, Qt::KeepAspectRatio, Qt::SmoothTransformation) : fullimage;
@@ -1050,6 +1070,51 @@ void FileLoadTask::process(Args &&args) {
 	_result->photoThumbs = photoThumbs;
 }
 
+void FileLoadTask::sendPreview(const QImage &medium) {
+	Expects(_type == SendMediaType::Photo);
+
+	auto preview = MakePreparedFile({
+		.taskId = id(),
+		.id = _id,
+		.to = _to,
+		.caption = _caption,
+		.spoiler = _spoiler,
+		.album = _album,
+	});
+	preview->type = SendMediaType::Photo;
+	preview->previewOnly = true;
+	preview->filesize = _result->filesize;
+	preview->photoThumbs.emplace('m', PreparedPhotoThumb{ .image = medium });
+	preview->photo = MTP_photo(
+		MTP_flags(0),
+		MTP_long(_id),
+		MTP_long(0),
+		MTP_bytes(),
+		MTP_int(base::unixtime::now()),
+		MTP_vector<MTPPhotoSize>(1, MTP_photoSize(
+			MTP_string("m"),
+			MTP_int(medium.width()),
+			MTP_int(medium.height()),
+			MTP_int(0))),
+		MTPVector<MTPVideoSize>(),
+		MTP_int(_dcId));
+	_previewResult = preview;
+	crl::on_main([weak = _session, preview] {
+		if (const auto session = weak.get()) {
+			Api::SendConfirmedFile(session, preview);
+		}
+	});
+}
+
+void FileLoadTask::destroyPreviewMessage(not_null<Main::Session*> session) {
+	if (!_previewResult || !_previewResult->sentId) {
+		return;
+	}
+	if (const auto item = session->data().message(_previewResult->sentId)) {
+		item->destroy();
+	}
+}
+
 void FileLoadTask::finish() {
 	const auto session = _session.get();
 	if (!session) {
@@ -1062,12 +1127,16 @@ void FileLoadTask::finish() {
 				tr::lng_send_image_empty(tr::now, lt_name, _filepath)),
 			Ui::LayerOption::KeepOther);
 		removeFromAlbum();
+		destroyPreviewMessage(session);
 	} else if (_result->filesize > kFileSizePremiumLimit
 		|| (_result->filesize > kFileSizeLimit && !premium)) {
 		Ui::show(
 			Box(FileSizeLimitBox, session, _result->filesize, nullptr),
 			Ui::LayerOption::KeepOther);
 		removeFromAlbum();
+		destroyPreviewMessage(session);
+	} else if (_previewResult && _previewResult->sentId) {
+		Api::FinishConfirmedFile(session, _result, _previewResult->sentId);
 	} else {
 		Api::SendConfirmedFile(session, _result);
 	}
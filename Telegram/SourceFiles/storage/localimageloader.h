@@ -60,6 +60,12 @@ public:
 	explicit TaskQueue(crl::time stopTimeoutMs = 0); // <= 0 - never stop worker
 
 	TaskId addTask(std::unique_ptr<Task> &&task);
+
+	// Puts the task in front of the queue, for content that is already
+	// prepared in memory and only needs the cheap finishing steps, like
+	// a recorded voice message that shouldn't wait behind photo resizes.
+	TaskId addPriorityTask(std::unique_ptr<Task> &&task);
+
 	void addTasks(std::vector<std::unique_ptr<Task>> &&tasks);
 	void cancelTask(TaskId id); // this task finish() won't be called
 
@@ -164,6 +170,7 @@ struct FilePrepareResult {
 
 	TaskId taskId = kEmptyTaskId;
 	uint64 id = 0;
+	crl::time queuedAt = 0; // When the user initiated the send.
 	FileLoadTo to;
 	std::shared_ptr<SendingAlbum> album;
 	SendMediaType type = SendMediaType::File;
@@ -194,6 +201,13 @@ struct FilePrepareResult {
 	TextWithTags caption;
 	bool spoiler = false;
 
+	// An early photo-only result sent while the full-size photo is still
+	// being prepared, so the bubble appears right away with the preview.
+	bool previewOnly = false;
+
+	// The message created from this result, filled by SendConfirmedFile.
+	FullMsgId sentId;
+
 	std::vector<MTPInputDocument> attachedStickers;
 
 	void setFileData(const QByteArray &filedata);
@@ -273,6 +287,8 @@ private:
 
 	std::unique_ptr<Ui::PreparedFileInformation> readMediaInformation(const QString &filemime) const;
 	void removeFromAlbum();
+	void sendPreview(const QImage &medium);
+	void destroyPreviewMessage(not_null<Main::Session*> session);
 
 	uint64 _id = 0;
 	base::weak_ptr<Main::Session> _session;
@@ -287,7 +303,9 @@ private:
 	SendMediaType _type;
 	TextWithTags _caption;
 	bool _spoiler = false;
+	crl::time _queuedAt = crl::now();
 
 	std::shared_ptr<FilePrepareResult> _result;
+	std::shared_ptr<FilePrepareResult> _previewResult;
 
 };
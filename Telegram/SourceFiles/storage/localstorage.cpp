@@ -444,7 +444,9 @@ void writeSettings() {
 	// We dropped old test authorizations when migrated to multi auth.
 	//const auto name = cTestMode() ? u"settings_test"_q : u"settings"_q;
 	const auto name = u"settings"_q;
-	FileWriteDescriptor settings(name, _basePath);
+	const auto sync = false;
+	const auto backup = true;
+	FileWriteDescriptor settings(name, _basePath, sync, backup);
 	if (_settingsSalt.isEmpty() || !SettingsKey) {
 		_settingsSalt.resize(LocalEncryptSaltSize);
 		base::RandomFill(_settingsSalt.data(), _settingsSalt.size());
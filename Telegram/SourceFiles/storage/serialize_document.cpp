@@ -9,6 +9,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "storage/serialize_common.h"
 #include "storage/serialize_peer.h"
+#include "data/data_document.h"
 #include "data/data_session.h"
 #include "data/stickers/data_stickers.h"
 #include "ui/image/image.h"
@@ -18,7 +19,7 @@ namespace Serialize {
 namespace {
 
 constexpr auto kVersionTag = int32(0x7FFFFFFF);
-constexpr auto kVersion = 6;
+constexpr auto kVersion = 7;
 
 enum StickerSetType {
 	StickerSetTypeEmpty = 0,
@@ -72,6 +73,14 @@ void Document::writeToStream(QDataStream &stream, DocumentData *document) {
 		<< qint32(document->videoThumbnailByteSize())
 		<< qint32(document->inlineThumbnailIsPath() ? 1 : 0)
 		<< document->inlineThumbnailBytes();
+
+	// Counted waveform, so it isn't computed from the media file again.
+	const auto voice = document->voice()
+		? document->voice()
+		: document->round();
+	stream << ((voice && !voice->waveform.isEmpty() && voice->waveform[0] >= 0)
+		? documentWaveformEncode5bit(voice->waveform)
+		: QByteArray());
 }
 
 DocumentData *Document::readFromStreamHelper(
@@ -185,6 +194,7 @@ DocumentData *Document::readFromStreamHelper(
 	qint32 thumbnailByteSize = 0, videoThumbnailByteSize = 0;
 	qint32 inlineThumbnailIsPath = 0;
 	QByteArray inlineThumbnailBytes;
+	QByteArray waveformBytes;
 	const auto thumb = readImageLocation(streamAppVersion, stream);
 	if (version >= 1) {
 		stream >> thumbnailByteSize;
@@ -193,6 +203,9 @@ DocumentData *Document::readFromStreamHelper(
 		if (version >= 2) {
 			stream >> inlineThumbnailIsPath >> inlineThumbnailBytes;
 		}
+		if (version >= 7) {
+			stream >> waveformBytes;
+		}
 	} else {
 		videoThumb = ImageLocation();
 	}
@@ -233,7 +246,7 @@ DocumentData *Document::readFromStreamHelper(
 		// size letter ('s' or 'm') is lost, it was not saved in legacy.
 		return nullptr;
 	}
-	return session->data().document(
+	const auto result = session->data().document(
 		id,
 		access,
 		fileReference,
@@ -255,6 +268,18 @@ DocumentData *Document::readFromStreamHelper(
 		(isPremiumSticker == 1),
 		dc,
 		int64(uint32(size)));
+	if (!waveformBytes.isEmpty()) {
+		const auto voice = result->voice()
+			? result->voice()
+			: result->round();
+		if (voice && voice->waveform.isEmpty()) {
+			voice->waveform = documentWaveformDecode(waveformBytes);
+			voice->wavemax = voice->waveform.isEmpty()
+				? char(0)
+				: *ranges::max_element(voice->waveform);
+		}
+	}
+	return result;
 }
 
 DocumentData *Document::readStickerFromStream(
@@ -301,6 +326,12 @@ int Document::sizeInStream(DocumentData *document) {
 
 	result += sizeof(qint32) + Serialize::bytearraySize(document->inlineThumbnailBytes());
 
+	// + waveform
+	const auto voice = document->voice()
+		? document->voice()
+		: document->round();
+	result += sizeof(quint32) + (voice ? voice->waveform.size() : 0);
+
 	return result;
 }
 
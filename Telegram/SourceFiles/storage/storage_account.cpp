@@ -28,6 +28,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/core_settings.h"
 #include "core/file_location.h"
+#include "data/components/chat_list_snapshot.h"
 #include "data/components/recent_peers.h"
 #include "data/components/top_peers.h"
 #include "data/stickers/data_stickers.h"
@@ -39,6 +40,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "webview/webview_interface.h"
 #include "window/themes/window_theme.h"
 
+#include <xxhash.h>
+
 namespace Storage {
 namespace {
 
@@ -47,6 +50,8 @@ using Database = Cache::Database;
 
 constexpr auto kDelayedWriteTimeout = crl::time(1000);
 constexpr auto kWriteSearchSuggestionsDelay = 5 * crl::time(1000);
+constexpr auto kWriteRecentStickersDelay = 3 * crl::time(1000);
+constexpr auto kWriteDownloadsWindow = 5 * crl::time(1000);
 
 constexpr auto kStickersVersionTag = quint32(-1);
 constexpr auto kStickersSerializeVersion = 4;
@@ -66,6 +71,11 @@ constexpr auto kMultiDraftCursorsTagOld = quint64(0xFFFF'FFFF'FFFF'FF02ULL);
 constexpr auto kMultiDraftTag = quint64(0xFFFF'FFFF'FFFF'FF03ULL);
 constexpr auto kMultiDraftCursorsTag = quint64(0xFFFF'FFFF'FFFF'FF04ULL);
 constexpr auto kRichDraftsTag = quint64(0xFFFF'FFFF'FFFF'FF05ULL);
+constexpr auto kMapJournalTag = quint32(0x544A'4C31U); // "TJL1"
+constexpr auto kMapJournalCompactLimit = 1024;
+constexpr auto kDraftsJournalTag = quint32(0x544A'4431U); // "TJD1"
+constexpr auto kDraftsJournalCompactLimit = 1024;
+constexpr auto kDraftsJournalRecordSizeLimit = 512 * 1024;
 
 enum { // Local Storage Keys
 	lskUserMap = 0x00,
@@ -96,6 +106,7 @@ enum { // Local Storage Keys
 	lskWebviewTokens = 0x19, // data: QByteArray bots, QByteArray other
 	lskRoundPlaceholder = 0x1a, // no data
 	lskInlineBotsDownloads = 0x1b, // no data
+	lskChatListSnapshot = 0x1c, // no data
 };
 
 auto EmptyMessageDraftSources()
@@ -147,11 +158,13 @@ Account::Account(not_null<Main::Account*> owner, const QString &dataName)
 , _cacheBigFileTotalTimeLimit(Database::Settings().totalTimeLimit)
 , _writeMapTimer([=] { writeMap(); })
 , _writeLocationsTimer([=] { writeLocations(); })
-, _writeSearchSuggestionsTimer([=] { writeSearchSuggestions(); }) {
+, _writeSearchSuggestionsTimer([=] { writeSearchSuggestions(); })
+, _writeRecentStickersTimer([=] { writeRecentStickers(); }) {
 }
 
 Account::~Account() {
 	Expects(!_writeSearchSuggestionsTimer.isActive());
+	Expects(!_writeRecentStickersTimer.isActive());
 
 	if (_localKey && _mapChanged) {
 		writeMap();
@@ -222,6 +235,7 @@ base::flat_set<QString> Account::collectGoodNames() const {
 		_featuredCustomEmojiKey,
 		_archivedCustomEmojiKey,
 		_searchSuggestionsKey,
+		_chatListSnapshotKey,
 		_roundPlaceholderKey,
 		_inlineBotsDownloadsKey,
 	};
@@ -310,6 +324,7 @@ Account::ReadMapResult Account::readMapWith(
 	quint64 legacyBackgroundKeyDay = 0, legacyBackgroundKeyNight = 0;
 	quint64 userSettingsKey = 0, recentHashtagsAndBotsKey = 0, exportSettingsKey = 0;
 	quint64 searchSuggestionsKey = 0;
+	quint64 chatListSnapshotKey = 0;
 	quint64 roundPlaceholderKey = 0;
 	quint64 inlineBotsDownloadsKey = 0;
 	QByteArray webviewStorageTokenBots, webviewStorageTokenOther;
@@ -421,6 +436,9 @@ Account::ReadMapResult Account::readMapWith(
 		case lskSearchSuggestions: {
 			map.stream >> searchSuggestionsKey;
 		} break;
+		case lskChatListSnapshot: {
+			map.stream >> chatListSnapshotKey;
+		} break;
 		case lskRoundPlaceholder: {
 			map.stream >> roundPlaceholderKey;
 		} break;
@@ -468,18 +486,57 @@ Account::ReadMapResult Account::readMapWith(
 	_recentHashtagsAndBotsKey = recentHashtagsAndBotsKey;
 	_exportSettingsKey = exportSettingsKey;
 	_searchSuggestionsKey = searchSuggestionsKey;
+	_chatListSnapshotKey = chatListSnapshotKey;
 	_roundPlaceholderKey = roundPlaceholderKey;
 	_inlineBotsDownloadsKey = inlineBotsDownloadsKey;
 	_oldMapVersion = mapData.version;
 	_webviewStorageIdBots.token = webviewStorageTokenBots;
 	_webviewStorageIdOther.token = webviewStorageTokenOther;
 
+	// The startup sequence reads these files one by one, decrypting
+	// each before opening the next. Warm the OS file cache for all of
+	// them upfront, so that on a cold HDD or network storage the IO
+	// overlaps with the decryption instead of serializing with it.
+	for (const auto key : {
+		_locationsKey,
+		_trustedBotsKey,
+		_installedStickersKey,
+		_featuredStickersKey,
+		_recentStickersKey,
+		_favedStickersKey,
+		_archivedStickersKey,
+		_savedGifsKey,
+		_installedMasksKey,
+		_recentMasksKey,
+		_archivedMasksKey,
+		_installedCustomEmojiKey,
+		_featuredCustomEmojiKey,
+		_archivedCustomEmojiKey,
+		_settingsKey,
+		_recentHashtagsAndBotsKey,
+		_exportSettingsKey,
+		_searchSuggestionsKey,
+		_chatListSnapshotKey,
+		_roundPlaceholderKey,
+		_inlineBotsDownloadsKey,
+	}) {
+		if (key) {
+			PrefetchFile(ToFilePart(key), _basePath);
+		}
+	}
+	if (_dataNameKey) {
+		PrefetchFile(ToFilePart(_dataNameKey), BaseGlobalPath());
+	}
+
 	if (_oldMapVersion < AppVersion) {
 		writeMapDelayed();
 	} else {
 		_mapChanged = false;
 	}
 
+	readMapJournal();
+	compactDraftsJournal();
+
 	if (_locationsKey) {
 		readLocations();
 	}
@@ -578,6 +635,7 @@ void Account::writeMap() {
 		mapSize += sizeof(quint32) + 3 * sizeof(quint64);
 	}
 	if (_searchSuggestionsKey) mapSize += sizeof(quint32) + sizeof(quint64);
+	if (_chatListSnapshotKey) mapSize += sizeof(quint32) + sizeof(quint64);
 	if (!_webviewStorageIdBots.token.isEmpty()
 		|| !_webviewStorageIdOther.token.isEmpty()) {
 		mapSize += sizeof(quint32)
@@ -649,6 +707,10 @@ void Account::writeMap() {
 		mapData.stream << quint32(lskSearchSuggestions);
 		mapData.stream << quint64(_searchSuggestionsKey);
 	}
+	if (_chatListSnapshotKey) {
+		mapData.stream << quint32(lskChatListSnapshot);
+		mapData.stream << quint64(_chatListSnapshotKey);
+	}
 	if (!_webviewStorageIdBots.token.isEmpty()
 		|| !_webviewStorageIdOther.token.isEmpty()) {
 		mapData.stream << quint32(lskWebviewTokens);
@@ -667,15 +729,339 @@ void Account::writeMap() {
 	map.writeEncrypted(mapData, _localKey);
 
 	_mapChanged = false;
+	clearMapJournal();
+}
+
+void Account::writeMapJournal(
+		quint32 recordType,
+		PeerId peerId,
+		FileKey key) {
+	if (!_localKey) {
+		return;
+	} else if (_mapJournalRecords >= kMapJournalCompactLimit) {
+		// Compact by a full map rewrite instead of growing further.
+		writeMapQueued();
+		return;
+	}
+	if (!QDir().exists(_basePath)) {
+		QDir().mkpath(_basePath);
+	}
+	QFile file(_basePath + u"mapjournal"_q);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+		writeMapQueued();
+		return;
+	}
+	if (!file.size()) {
+		auto magic = kMapJournalTag;
+		file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+	}
+	EncryptedDescriptor record(
+		sizeof(quint32) + sizeof(quint64) + sizeof(quint64));
+	record.stream
+		<< quint32(recordType)
+		<< SerializePeerId(peerId)
+		<< quint64(key);
+	const auto encrypted = PrepareEncrypted(record, _localKey);
+	auto size = quint32(encrypted.size());
+	file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+	file.write(encrypted);
+	file.flush();
+	++_mapJournalRecords;
+}
+
+void Account::readMapJournal() {
+	Expects(_localKey != nullptr);
+
+	QFile file(_basePath + u"mapjournal"_q);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return;
+	}
+	auto magic = quint32(0);
+	if (file.read(reinterpret_cast<char*>(&magic), sizeof(magic))
+			!= sizeof(magic)
+		|| magic != kMapJournalTag) {
+		writeMapDelayed();
+		return;
+	}
+	const auto apply = [&](
+			quint32 recordType,
+			PeerId peerId,
+			FileKey key) {
+		const auto applyTo = [&](base::flat_map<PeerId, FileKey> &map) {
+			if (key) {
+				map[peerId] = key;
+			} else {
+				map.remove(peerId);
+			}
+		};
+		switch (recordType) {
+		case lskDraft:
+			applyTo(_draftsMap);
+			if (key) {
+				_draftsNotReadMap.emplace(peerId, true);
+			} else {
+				_draftsNotReadMap.remove(peerId);
+			}
+			return true;
+		case lskDraftPosition:
+			applyTo(_draftCursorsMap);
+			return true;
+		}
+		return false;
+	};
+	while (!file.atEnd()) {
+		auto size = quint32(0);
+		if (file.read(reinterpret_cast<char*>(&size), sizeof(size))
+				!= sizeof(size)
+			|| !size
+			|| size > kMapJournalCompactLimit * sizeof(quint64)) {
+			writeMapDelayed();
+			return;
+		}
+		const auto encrypted = file.read(size);
+		EncryptedDescriptor record;
+		if (encrypted.size() != int(size)
+			|| !DecryptLocal(record, encrypted, _localKey)) {
+			LOG(("App Error: could not decrypt map journal record."));
+			writeMapDelayed();
+			return;
+		}
+		quint32 recordType = 0;
+		quint64 peerIdSerialized = 0, key = 0;
+		record.stream >> recordType >> peerIdSerialized >> key;
+		if (!CheckStreamStatus(record.stream)
+			|| !apply(
+				recordType,
+				DeserializePeerId(peerIdSerialized),
+				FileKey(key))) {
+			LOG(("App Error: bad map journal record type %1"
+				).arg(recordType));
+			writeMapDelayed();
+			return;
+		}
+		++_mapJournalRecords;
+	}
+}
+
+void Account::clearMapJournal() {
+	QFile::remove(_basePath + u"mapjournal"_q);
+	_mapJournalRecords = 0;
+}
+
+bool Account::appendDraftsJournal(
+		PeerId peerId,
+		qint64 draftKey,
+		quint32 prefix,
+		quint32 suffix,
+		const QString &middle,
+		const QByteArray &tags) {
+	if (!_localKey) {
+		return false;
+	}
+	if (!QDir().exists(_basePath)) {
+		QDir().mkpath(_basePath);
+	}
+	QFile file(_basePath + u"draftsjournal"_q);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+		return false;
+	}
+	if (!file.size()) {
+		auto magic = kDraftsJournalTag;
+		file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+	}
+	EncryptedDescriptor record(sizeof(quint64)
+		+ sizeof(qint64)
+		+ sizeof(quint32) * 2
+		+ Serialize::stringSize(middle)
+		+ Serialize::bytearraySize(tags));
+	record.stream
+		<< SerializePeerId(peerId)
+		<< draftKey
+		<< prefix
+		<< suffix
+		<< middle
+		<< tags;
+	const auto encrypted = PrepareEncrypted(record, _localKey);
+	auto size = quint32(encrypted.size());
+	file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+	file.write(encrypted);
+	file.flush();
+	++_draftsJournalRecords;
+	return true;
+}
+
+void Account::compactDraftsJournal() {
+	Expects(_localKey != nullptr);
+
+	QFile file(_basePath + u"draftsjournal"_q);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return;
+	}
+	auto magic = quint32(0);
+	auto deltas = base::flat_map<PeerId, std::vector<DraftJournalDelta>>();
+	if (file.read(reinterpret_cast<char*>(&magic), sizeof(magic))
+			== sizeof(magic)
+		&& magic == kDraftsJournalTag) {
+		while (!file.atEnd()) {
+			auto size = quint32(0);
+			if (file.read(reinterpret_cast<char*>(&size), sizeof(size))
+					!= sizeof(size)
+				|| !size
+				|| size > kDraftsJournalRecordSizeLimit) {
+				LOG(("App Error: bad drafts journal record size."));
+				break;
+			}
+			const auto encrypted = file.read(size);
+			EncryptedDescriptor record;
+			if (encrypted.size() != int(size)
+				|| !DecryptLocal(record, encrypted, _localKey)) {
+				LOG(("App Error: could not decrypt drafts journal record."));
+				break;
+			}
+			auto peerIdSerialized = quint64(0);
+			auto delta = DraftJournalDelta();
+			record.stream
+				>> peerIdSerialized
+				>> delta.key
+				>> delta.prefix
+				>> delta.suffix
+				>> delta.middle
+				>> delta.tags;
+			if (!CheckStreamStatus(record.stream)) {
+				LOG(("App Error: bad drafts journal record."));
+				break;
+			}
+			const auto peerId = DeserializePeerId(peerIdSerialized);
+			if (!delta.key) {
+				// A full snapshot was written after these deltas.
+				deltas.remove(peerId);
+			} else {
+				deltas[peerId].push_back(std::move(delta));
+			}
+		}
+	}
+	file.close();
+	for (const auto &[peerId, list] : deltas) {
+		applyDraftsJournal(peerId, list);
+	}
+	clearDraftsJournal();
+}
+
+void Account::applyDraftsJournal(
+		PeerId peerId,
+		const std::vector<DraftJournalDelta> &deltas) {
+	const auto j = _draftsMap.find(peerId);
+	if (j == _draftsMap.cend()) {
+		return;
+	}
+	FileReadDescriptor draft;
+	if (!ReadEncryptedFile(draft, j->second, _basePath, _localKey)) {
+		return;
+	}
+	quint64 tag = 0;
+	quint64 draftPeerSerialized = 0;
+	quint32 count = 0;
+	draft.stream >> tag >> draftPeerSerialized >> count;
+	if (tag != kRichDraftsTag
+		|| DeserializePeerId(draftPeerSerialized) != peerId
+		|| !count
+		|| count > 1000) {
+		return;
+	}
+	struct Record {
+		qint64 key = 0;
+		QString text;
+		QByteArray tags;
+		qint64 messageIdPeer = 0;
+		qint64 messageIdMsg = 0;
+		QString webpageUrl;
+		qint32 webpageForceLargeMedia = 0;
+		qint32 webpageForceSmallMedia = 0;
+		qint32 webpageInvert = 0;
+		qint32 webpageManual = 0;
+		qint32 webpageRemoved = 0;
+	};
+	auto records = std::vector<Record>(count);
+	for (auto &record : records) {
+		draft.stream
+			>> record.key
+			>> record.text
+			>> record.tags
+			>> record.messageIdPeer
+			>> record.messageIdMsg
+			>> record.webpageUrl
+			>> record.webpageForceLargeMedia
+			>> record.webpageForceSmallMedia
+			>> record.webpageInvert
+			>> record.webpageManual
+			>> record.webpageRemoved;
+	}
+	if (draft.stream.status() != QDataStream::Ok) {
+		return;
+	}
+	for (const auto &delta : deltas) {
+		const auto k = ranges::find(records, delta.key, &Record::key);
+		if (k == end(records)
+			|| delta.prefix + delta.suffix > quint32(k->text.size())) {
+			LOG(("App Error: bad drafts journal delta for peer %1."
+				).arg(peerId.value));
+			return;
+		}
+		k->text = k->text.left(delta.prefix)
+			+ delta.middle
+			+ k->text.right(delta.suffix);
+		k->tags = delta.tags;
+	}
+	auto size = int(sizeof(quint64) * 2 + sizeof(quint32));
+	for (const auto &record : records) {
+		size += sizeof(qint64)
+			+ Serialize::stringSize(record.text)
+			+ Serialize::bytearraySize(record.tags)
+			+ sizeof(qint64) + sizeof(qint64)
+			+ Serialize::stringSize(record.webpageUrl)
+			+ sizeof(qint32) * 5;
+	}
+	EncryptedDescriptor data(size);
+	data.stream
+		<< quint64(kRichDraftsTag)
+		<< SerializePeerId(peerId)
+		<< quint32(records.size());
+	for (const auto &record : records) {
+		data.stream
+			<< record.key
+			<< record.text
+			<< record.tags
+			<< record.messageIdPeer
+			<< record.messageIdMsg
+			<< record.webpageUrl
+			<< record.webpageForceLargeMedia
+			<< record.webpageForceSmallMedia
+			<< record.webpageInvert
+			<< record.webpageManual
+			<< record.webpageRemoved;
+	}
+	// Written synchronously so that opening the chat can't read the
+	// file before the compacted version lands on disk.
+	FileWriteDescriptor file(j->second, _basePath, true);
+	file.writeEncrypted(data, _localKey);
+}
+
+void Account::clearDraftsJournal() {
+	QFile::remove(_basePath + u"draftsjournal"_q);
+	_draftsJournalRecords = 0;
 }
 
 void Account::reset() {
 	_writeSearchSuggestionsTimer.cancel();
+	_writeRecentStickersTimer.cancel();
 
 	auto names = collectGoodNames();
 	_draftsMap.clear();
 	_draftCursorsMap.clear();
 	_draftsNotReadMap.clear();
+	_draftsWritten.clear();
+	_draftsJournalPeers.clear();
+	clearDraftsJournal();
 	_locationsKey = _trustedBotsKey = 0;
 	_recentStickersKeyOld = 0;
 	_installedStickersKey = 0;
@@ -693,6 +1079,7 @@ void Account::reset() {
 	_legacyBackgroundKeyDay = _legacyBackgroundKeyNight = 0;
 	_settingsKey = _recentHashtagsAndBotsKey = _exportSettingsKey = 0;
 	_searchSuggestionsKey = 0;
+	_chatListSnapshotKey = 0;
 	_roundPlaceholderKey = 0;
 	_inlineBotsDownloadsKey = 0;
 	_oldMapVersion = 0;
@@ -838,6 +1225,12 @@ void Account::writeLocationsDelayed() {
 	_writeLocationsTimer.callOnce(kDelayedWriteTimeout);
 }
 
+void Account::writeLocationsIfNeeded() {
+	if (_writeLocationsTimer.isActive()) {
+		writeLocations();
+	}
+}
+
 void Account::readLocations() {
 	FileReadDescriptor locations;
 	if (!ReadEncryptedFile(locations, _locationsKey, _basePath, _localKey)) {
@@ -905,7 +1298,16 @@ void Account::readLocations() {
 void Account::updateDownloads(
 		Fn<std::optional<QByteArray>()> downloadsSerialize) {
 	_downloadsSerialize = std::move(downloadsSerialize);
-	writeLocationsDelayed();
+	_locationsChanged = true;
+
+	// Finished downloads arrive in bursts when an album is saved and
+	// every write re-serializes the whole locations blob, so schedule
+	// a fixed coalescing window from the first change instead of
+	// restarting the short delay on each one: a slow bulk save then
+	// writes once per window, not once per file.
+	if (!_writeLocationsTimer.isActive()) {
+		_writeLocationsTimer.callOnce(kWriteDownloadsWindow);
+	}
 }
 
 QByteArray Account::downloadsSerialized() const {
@@ -1157,6 +1559,24 @@ void EnumerateDrafts(
 	}
 }
 
+[[nodiscard]] QByteArray SerializeDraftRest(
+		const FullReplyTo &reply,
+		const Data::WebPageDraft &webpage) {
+	auto result = QByteArray();
+	QDataStream stream(&result, QIODevice::WriteOnly);
+	stream.setVersion(QDataStream::Qt_5_1);
+	stream
+		<< qint64(reply.messageId.peer.value)
+		<< qint64(reply.messageId.msg.bare)
+		<< webpage.url
+		<< qint32(webpage.forceLargeMedia ? 1 : 0)
+		<< qint32(webpage.forceSmallMedia ? 1 : 0)
+		<< qint32(webpage.invert ? 1 : 0)
+		<< qint32(webpage.manual ? 1 : 0)
+		<< qint32(webpage.removed ? 1 : 0);
+	return result;
+}
+
 void Account::registerDraftSource(
 		not_null<History*> history,
 		Data::DraftKey key,
@@ -1198,17 +1618,109 @@ void Account::writeDrafts(not_null<History*> history) {
 		if (i != _draftsMap.cend()) {
 			ClearKey(i->second, _basePath);
 			_draftsMap.erase(i);
-			writeMapDelayed();
+			writeMapJournal(lskDraft, peerId, 0);
 		}
 
 		_draftsNotReadMap.remove(peerId);
+		_draftsWritten.remove(peerId);
+		if (_draftsJournalPeers.remove(peerId)
+			&& _draftsJournalPeers.empty()) {
+			clearDraftsJournal();
+		}
 		return;
 	}
 
+	// Collect the current drafts and try to append text deltas to the
+	// journal instead of rewriting the whole file on each batched save.
+	struct Current {
+		qint64 key = 0;
+		QString text;
+		QByteArray tags;
+		QByteArray rest;
+	};
+	auto currents = std::vector<Current>();
+	currents.reserve(count);
+	EnumerateDrafts(
+		map,
+		supportMode,
+		sources,
+		[&](
+				const Data::DraftKey &key,
+				const FullReplyTo &reply,
+				const TextWithTags &text,
+				const Data::WebPageDraft &webpage,
+				auto&&) { // cursor
+			currents.push_back({
+				key.serialize(),
+				text.text,
+				TextUtilities::SerializeTags(text.tags),
+				SerializeDraftRest(reply, webpage) });
+		});
+
+	const auto written = _draftsWritten.find(peerId);
+	auto canDelta = (written != end(_draftsWritten))
+		&& _draftsMap.contains(peerId)
+		&& !_draftsNotReadMap.contains(peerId)
+		&& (_draftsJournalRecords < kDraftsJournalCompactLimit)
+		&& (int(written->second.size()) == count);
+	auto changed = std::vector<int>();
+	if (canDelta) {
+		for (auto index = 0; index != int(currents.size()); ++index) {
+			const auto &current = currents[index];
+			const auto j = written->second.find(current.key);
+			if (j == end(written->second)
+				|| j->second.rest != current.rest) {
+				canDelta = false;
+				break;
+			} else if (j->second.text != current.text
+				|| j->second.tags != current.tags) {
+				changed.push_back(index);
+			}
+		}
+	}
+	if (canDelta) {
+		for (const auto index : changed) {
+			const auto &current = currents[index];
+			auto &was = written->second[current.key];
+			const auto &old = was.text;
+			const auto &now = current.text;
+			const auto minLength = int(std::min(old.size(), now.size()));
+			auto prefix = 0;
+			while (prefix != minLength && old[prefix] == now[prefix]) {
+				++prefix;
+			}
+			auto suffix = 0;
+			while (suffix != minLength - prefix
+				&& (old[old.size() - 1 - suffix]
+					== now[now.size() - 1 - suffix])) {
+				++suffix;
+			}
+			const auto middle = now.mid(
+				prefix,
+				now.size() - prefix - suffix);
+			if (!appendDraftsJournal(
+					peerId,
+					current.key,
+					quint32(prefix),
+					quint32(suffix),
+					middle,
+					current.tags)) {
+				canDelta = false;
+				break;
+			}
+			was.text = current.text;
+			was.tags = current.tags;
+			_draftsJournalPeers.emplace(peerId);
+		}
+		if (canDelta) {
+			return;
+		}
+	}
+
 	auto i = _draftsMap.find(peerId);
 	if (i == _draftsMap.cend()) {
 		i = _draftsMap.emplace(peerId, GenerateKey(_basePath)).first;
-		writeMapQueued();
+		writeMapJournal(lskDraft, peerId, i->second);
 	}
 
 	auto size = int(sizeof(quint64) * 2 + sizeof(quint32));
@@ -1269,6 +1781,23 @@ void Account::writeDrafts(not_null<History*> history) {
 	FileWriteDescriptor file(i->second, _basePath);
 	file.writeEncrypted(data, _localKey);
 
+	auto &nowWritten = _draftsWritten[peerId];
+	nowWritten.clear();
+	for (auto &current : currents) {
+		nowWritten.emplace(current.key, WrittenDraft{
+			std::move(current.text),
+			std::move(current.tags),
+			std::move(current.rest) });
+	}
+	if (_draftsJournalPeers.remove(peerId)) {
+		if (_draftsJournalPeers.empty()) {
+			clearDraftsJournal();
+		} else {
+			// Invalidate the deltas journaled before this snapshot.
+			appendDraftsJournal(peerId, 0, 0, 0, QString(), QByteArray());
+		}
+	}
+
 	_draftsNotReadMap.remove(peerId);
 }
 
@@ -1293,7 +1822,7 @@ void Account::writeDraftCursors(not_null<History*> history) {
 	auto i = _draftCursorsMap.find(peerId);
 	if (i == _draftCursorsMap.cend()) {
 		i = _draftCursorsMap.emplace(peerId, GenerateKey(_basePath)).first;
-		writeMapQueued();
+		writeMapJournal(lskDraftPosition, peerId, i->second);
 	}
 
 	auto size = int(sizeof(quint64) * 2
@@ -1333,7 +1862,7 @@ void Account::clearDraftCursors(PeerId peerId) {
 	if (i != _draftCursorsMap.cend()) {
 		ClearKey(i->second, _basePath);
 		_draftCursorsMap.erase(i);
-		writeMapDelayed();
+		writeMapJournal(lskDraftPosition, peerId, 0);
 	}
 }
 
@@ -1444,6 +1973,7 @@ void Account::readDraftsWithCursors(not_null<History*> history) {
 	if (!ReadEncryptedFile(draft, j->second, _basePath, _localKey)) {
 		ClearKey(j->second, _basePath);
 		_draftsMap.erase(j);
+		writeMapJournal(lskDraft, peerId, 0);
 		clearDraftCursors(peerId);
 		return;
 	}
@@ -1467,6 +1997,7 @@ void Account::readDraftsWithCursors(not_null<History*> history) {
 		return;
 	}
 	auto map = Data::HistoryDrafts();
+	auto seed = base::flat_map<qint64, WrittenDraft>();
 	const auto keysOld = (tag == kMultiDraftTagOld);
 	const auto rich = (tag == kRichDraftsTag);
 	for (auto i = 0; i != count; ++i) {
@@ -1522,23 +2053,31 @@ void Account::readDraftsWithCursors(not_null<History*> history) {
 			? Data::DraftKey::FromSerializedOld(keyValueOld)
 			: Data::DraftKey::FromSerialized(keyValue);
 		if (key && !key.isCloud()) {
+			const auto reply = FullReplyTo{
+				.messageId = FullMsgId(
+					PeerId(messageIdPeer),
+					MsgId(messageIdMsg)),
+				.topicRootId = key.topicRootId(),
+			};
+			const auto webpage = Data::WebPageDraft{
+				.url = webpageUrl,
+				.forceLargeMedia = (webpageForceLargeMedia == 1),
+				.forceSmallMedia = (webpageForceSmallMedia == 1),
+				.invert = (webpageInvert == 1),
+				.manual = (webpageManual == 1),
+				.removed = (webpageRemoved == 1),
+			};
+			if (rich) {
+				seed.emplace(key.serialize(), WrittenDraft{
+					text.text,
+					textTagsSerialized,
+					SerializeDraftRest(reply, webpage) });
+			}
 			map.emplace(key, std::make_unique<Data::Draft>(
 				text,
-				FullReplyTo{
-					.messageId = FullMsgId(
-						PeerId(messageIdPeer),
-						MsgId(messageIdMsg)),
-					.topicRootId = key.topicRootId(),
-				},
+				reply,
 				MessageCursor(),
-				Data::WebPageDraft{
-					.url = webpageUrl,
-					.forceLargeMedia = (webpageForceLargeMedia == 1),
-					.forceSmallMedia = (webpageForceSmallMedia == 1),
-					.invert = (webpageInvert == 1),
-					.manual = (webpageManual == 1),
-					.removed = (webpageRemoved == 1),
-				}));
+				webpage));
 		}
 	}
 	if (draft.stream.status() != QDataStream::Ok) {
@@ -1547,6 +2086,10 @@ void Account::readDraftsWithCursors(not_null<History*> history) {
 		clearDraftCursors(peerId);
 		return;
 	}
+	if (rich) {
+		// Lets the first save of the session append a delta right away.
+		_draftsWritten[peerId] = std::move(seed);
+	}
 	readDraftCursors(peerId, map);
 	history->setDraftsMap(std::move(map));
 }
@@ -2253,6 +2796,7 @@ void Account::writeFeaturedCustomEmoji() {
 }
 
 void Account::writeRecentStickers() {
+	_writeRecentStickersTimer.cancel();
 	writeStickerSets(_recentStickersKey, [](const Data::StickersSet &set) {
 		if (set.id != Data::Stickers::CloudRecentSetId
 			|| set.stickers.isEmpty()) {
@@ -2262,6 +2806,23 @@ void Account::writeRecentStickers() {
 	}, Data::StickersSetsOrder());
 }
 
+void Account::writeRecentStickersDelayed() {
+	Expects(_owner->sessionExists());
+
+	// The recent set is serialized with the full document metadata for
+	// each sticker, so writing it on every sent sticker rewrites quite
+	// a large blob - coalesce the writes from a sending burst instead.
+	if (!_writeRecentStickersTimer.isActive()) {
+		_writeRecentStickersTimer.callOnce(kWriteRecentStickersDelay);
+	}
+}
+
+void Account::writeRecentStickersIfNeeded() {
+	if (_writeRecentStickersTimer.isActive()) {
+		writeRecentStickers();
+	}
+}
+
 void Account::writeFavedStickers() {
 	writeStickerSets(_favedStickersKey, [](const Data::StickersSet &set) {
 		if (set.id != Data::Stickers::FavedSetId || set.stickers.isEmpty()) {
@@ -2961,10 +3522,22 @@ void Account::writeSearchSuggestions() {
 		if (_searchSuggestionsKey) {
 			ClearKey(_searchSuggestionsKey, _basePath);
 			_searchSuggestionsKey = 0;
+			_searchSuggestionsWrittenHash = 0;
 			writeMapDelayed();
 		}
 		return;
 	}
+	// The delayed write is often scheduled by updates that in the end
+	// don't change the stored part of the lists, so don't re-encrypt
+	// and rewrite the file if the payload is exactly the same.
+	const auto hash = XXH64(
+		recent.constData(),
+		recent.size(),
+		XXH64(top.constData(), top.size(), 0));
+	if (_searchSuggestionsKey && hash == _searchSuggestionsWrittenHash) {
+		return;
+	}
+	_searchSuggestionsWrittenHash = hash;
 	if (!_searchSuggestionsKey) {
 		_searchSuggestionsKey = GenerateKey(_basePath);
 		writeMapQueued();
@@ -3001,6 +3574,10 @@ void Account::readSearchSuggestions() {
 	auto recent = QByteArray();
 	suggestions.stream >> top >> recent;
 	if (CheckStreamStatus(suggestions.stream)) {
+		_searchSuggestionsWrittenHash = XXH64(
+			recent.constData(),
+			recent.size(),
+			XXH64(top.constData(), top.size(), 0));
 		_owner->session().topPeers().applyLocal(top);
 		_owner->session().recentPeers().applyLocal(recent);
 	} else {
@@ -3008,6 +3585,68 @@ void Account::readSearchSuggestions() {
 	}
 }
 
+void Account::writeChatListSnapshot() {
+	Expects(_owner->sessionExists());
+
+	const auto serialized = _owner->session().chatListSnapshot().serialize();
+	if (serialized.isEmpty()) {
+		if (_chatListSnapshotKey) {
+			ClearKey(_chatListSnapshotKey, _basePath);
+			_chatListSnapshotKey = 0;
+			writeMapDelayed();
+		}
+		return;
+	}
+	if (!_chatListSnapshotKey) {
+		_chatListSnapshotKey = GenerateKey(_basePath);
+		writeMapQueued();
+	}
+	// The snapshot is thousands of similarly-shaped serialized peers,
+	// it deflates to a fraction of its size and the startup read from
+	// a slow disk shrinks with it.
+	const auto compressed = qCompress(serialized, 9);
+	quint32 size = Serialize::bytearraySize(compressed);
+	EncryptedDescriptor data(size);
+	data.stream << compressed;
+
+	FileWriteDescriptor file(_chatListSnapshotKey, _basePath);
+	file.writeEncrypted(data, _localKey);
+}
+
+void Account::readChatListSnapshot() {
+	if (_chatListSnapshotRead) {
+		return;
+	}
+	_chatListSnapshotRead = true;
+	if (!_chatListSnapshotKey) {
+		DEBUG_LOG(("ChatList Snapshot: No key."));
+		return;
+	}
+
+	FileReadDescriptor snapshot;
+	if (!ReadEncryptedFile(snapshot, _chatListSnapshotKey, _basePath, _localKey)) {
+		DEBUG_LOG(("ChatList Snapshot: Could not read file."));
+		ClearKey(_chatListSnapshotKey, _basePath);
+		_chatListSnapshotKey = 0;
+		writeMapDelayed();
+		return;
+	}
+
+	auto read = QByteArray();
+	snapshot.stream >> read;
+	if (CheckStreamStatus(snapshot.stream)) {
+		// Snapshots written before compression was added are applied
+		// as they are.
+		auto serialized = qUncompress(read);
+		if (serialized.isEmpty()) {
+			serialized = std::move(read);
+		}
+		_owner->session().chatListSnapshot().applyLocal(serialized);
+	} else {
+		DEBUG_LOG(("ChatList Snapshot: Could not read content."));
+	}
+}
+
 void Account::writeSelf() {
 	writeMapDelayed();
 }
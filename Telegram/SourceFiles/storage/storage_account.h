@@ -121,6 +121,8 @@ public:
 	void writeInstalledStickers();
 	void writeFeaturedStickers();
 	void writeRecentStickers();
+	void writeRecentStickersDelayed();
+	void writeRecentStickersIfNeeded();
 	void writeFavedStickers();
 	void writeArchivedStickers();
 	void writeArchivedMasks();
@@ -154,6 +156,9 @@ public:
 	void writeSearchSuggestions();
 	void readSearchSuggestions();
 
+	void writeChatListSnapshot();
+	void readChatListSnapshot();
+
 	void writeSelf();
 
 	// Read self is special, it can't get session from account, because
@@ -206,6 +211,19 @@ private:
 	};
 	friend inline constexpr bool is_flag_type(BotTrustFlag) { return true; };
 
+	struct DraftJournalDelta {
+		qint64 key = 0;
+		quint32 prefix = 0;
+		quint32 suffix = 0;
+		QString middle;
+		QByteArray tags;
+	};
+	struct WrittenDraft {
+		QString text;
+		QByteArray tags;
+		QByteArray rest;
+	};
+
 	[[nodiscard]] base::flat_set<QString> collectGoodNames() const;
 	[[nodiscard]] auto prepareReadSettingsContext() const
 		-> details::ReadSettingsContext;
@@ -218,10 +236,17 @@ private:
 	void writeMapQueued();
 	void writeMap();
 
+	// Draft map mutations are appended to a small journal instead of
+	// rewriting the whole map, writeMap() compacts and clears it.
+	void writeMapJournal(quint32 recordType, PeerId peerId, FileKey key);
+	void readMapJournal();
+	void clearMapJournal();
+
 	void readLocations();
 	void writeLocations();
 	void writeLocationsQueued();
 	void writeLocationsDelayed();
+	void writeLocationsIfNeeded();
 
 	std::unique_ptr<Main::SessionSettings> readSessionSettings();
 	void writeSessionSettings(Main::SessionSettings *stored);
@@ -231,6 +256,21 @@ private:
 	std::unique_ptr<Main::SessionSettings> applyReadContext(
 		details::ReadSettingsContext &&context);
 
+	// Keystroke-batched draft saves are appended to a journal as text
+	// deltas against the last full snapshot, compacted on startup.
+	bool appendDraftsJournal(
+		PeerId peerId,
+		qint64 draftKey,
+		quint32 prefix,
+		quint32 suffix,
+		const QString &middle,
+		const QByteArray &tags);
+	void compactDraftsJournal();
+	void applyDraftsJournal(
+		PeerId peerId,
+		const std::vector<DraftJournalDelta> &deltas);
+	void clearDraftsJournal();
+
 	void readDraftCursors(PeerId peerId, Data::HistoryDrafts &map);
 	void readDraftCursorsLegacy(
 		PeerId peerId,
@@ -279,6 +319,11 @@ private:
 	base::flat_map<
 		not_null<History*>,
 		base::flat_map<Data::DraftKey, MessageDraftSource>> _draftSources;
+	base::flat_map<
+		PeerId,
+		base::flat_map<qint64, WrittenDraft>> _draftsWritten;
+	base::flat_set<PeerId> _draftsJournalPeers;
+	int _draftsJournalRecords = 0;
 
 	QMultiMap<MediaKey, Core::FileLocation> _fileLocations;
 	QMap<QString, QPair<MediaKey, Core::FileLocation>> _fileLocationPairs;
@@ -308,6 +353,8 @@ private:
 	FileKey _featuredCustomEmojiKey = 0;
 	FileKey _archivedCustomEmojiKey = 0;
 	FileKey _searchSuggestionsKey = 0;
+	quint64 _searchSuggestionsWrittenHash = 0;
+	FileKey _chatListSnapshotKey = 0;
 	FileKey _roundPlaceholderKey = 0;
 	FileKey _inlineBotsDownloadsKey = 0;
 
@@ -321,6 +368,7 @@ private:
 	bool _readingUserSettings = false;
 	bool _recentHashtagsAndBotsWereRead = false;
 	bool _searchSuggestionsRead = false;
+	bool _chatListSnapshotRead = false;
 	bool _inlineBotsDownloadsRead = false;
 
 	Webview::StorageId _webviewStorageIdBots;
@@ -331,7 +379,9 @@ private:
 	base::Timer _writeMapTimer;
 	base::Timer _writeLocationsTimer;
 	base::Timer _writeSearchSuggestionsTimer;
+	base::Timer _writeRecentStickersTimer;
 	bool _mapChanged = false;
+	int _mapJournalRecords = 0;
 	bool _locationsChanged = false;
 
 	QImage _roundPlaceholder;
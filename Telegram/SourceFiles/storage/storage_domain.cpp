@@ -167,6 +167,12 @@ Domain::StartModernResult Domain::startModern(
 
 	_oldVersion = keyData.version;
 
+	struct PendingStart {
+		qint32 index = 0;
+		not_null<Main::Account*> account;
+		std::unique_ptr<MTP::Config> config;
+	};
+	auto pending = std::vector<PendingStart>();
 	auto tried = base::flat_set<int>();
 	auto sessions = base::flat_set<uint64>();
 	auto active = 0;
@@ -188,7 +194,11 @@ Domain::StartModernResult Domain::startModern(
 				if (sessions.empty()) {
 					active = index;
 				}
-				account->start(std::move(config));
+				pending.push_back({
+					.index = index,
+					.account = account.get(),
+					.config = std::move(config),
+				});
 				_owner->accountAddedInStorage({
 					.index = index,
 					.account = std::move(account)
@@ -207,6 +217,35 @@ Domain::StartModernResult Domain::startModern(
 	}
 	_owner->activateFromStorage(active);
 
+	// Start only the account that will be activated right away and
+	// postpone the others to the next event loop iteration, so that
+	// the first window shows after a single account initialization.
+	const auto activeIt = ranges::find(pending, active, &PendingStart::index);
+	const auto startNow = (activeIt != end(pending))
+		? activeIt
+		: begin(pending);
+	startNow->account->start(std::move(startNow->config));
+	pending.erase(startNow);
+	if (!pending.empty()) {
+		using PendingOther = std::pair<
+			base::weak_ptr<Main::Account>,
+			std::unique_ptr<MTP::Config>>;
+		auto others = std::vector<PendingOther>();
+		others.reserve(pending.size());
+		for (auto &entry : pending) {
+			others.emplace_back(
+				base::make_weak(entry.account.get()),
+				std::move(entry.config));
+		}
+		crl::on_main(_owner.get(), [others = std::move(others)]() mutable {
+			for (auto &[weak, config] : others) {
+				if (const auto account = weak.get()) {
+					account->start(std::move(config));
+				}
+			}
+		});
+	}
+
 	Ensures(!sessions.empty());
 	return StartModernResult::Success;
 }
@@ -0,0 +1,56 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "storage/storage_hot_blob_cache.h"
+
+namespace Storage {
+namespace {
+
+constexpr auto kMaxEntrySize = 128 * 1024;
+constexpr auto kTotalSizeLimit = int64(8 * 1024 * 1024);
+
+} // namespace
+
+std::optional<QByteArray> HotBlobCache::get(const Cache::Key &key) {
+	const auto i = _map.find(key);
+	if (i == end(_map)) {
+		return std::nullopt;
+	}
+	_entries.splice(begin(_entries), _entries, i->second);
+	return i->second->value;
+}
+
+void HotBlobCache::put(const Cache::Key &key, const QByteArray &value) {
+	if (value.isEmpty() || value.size() > kMaxEntrySize) {
+		return;
+	}
+	const auto i = _map.find(key);
+	if (i != end(_map)) {
+		_totalSize += value.size() - i->second->value.size();
+		i->second->value = value;
+		_entries.splice(begin(_entries), _entries, i->second);
+	} else {
+		_entries.push_front({ key, value });
+		_map.emplace(key, begin(_entries));
+		_totalSize += value.size();
+	}
+	while (_totalSize > kTotalSizeLimit) {
+		Assert(!_entries.empty());
+		const auto &last = _entries.back();
+		_totalSize -= last.value.size();
+		_map.remove(last.key);
+		_entries.pop_back();
+	}
+}
+
+void HotBlobCache::clear() {
+	_entries.clear();
+	_map.clear();
+	_totalSize = 0;
+}
+
+} // namespace Storage
@@ -0,0 +1,38 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/flat_map.h"
+#include "storage/cache/storage_cache_types.h"
+
+#include <list>
+
+namespace Storage {
+
+// An in-memory LRU layer in front of Cache::Database reads, keeping
+// recently used small blobs (thumbnails and such) so that switching
+// back to a chat doesn't hit the disk cache again. Main thread only.
+class HotBlobCache final {
+public:
+	[[nodiscard]] std::optional<QByteArray> get(const Cache::Key &key);
+	void put(const Cache::Key &key, const QByteArray &value);
+	void clear();
+
+private:
+	struct Entry {
+		Cache::Key key;
+		QByteArray value;
+	};
+
+	std::list<Entry> _entries; // Most recently used first.
+	base::flat_map<Cache::Key, std::list<Entry>::iterator> _map;
+	int64 _totalSize = 0;
+
+};
+
+} // namespace Storage
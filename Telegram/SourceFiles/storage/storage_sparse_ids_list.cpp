@@ -23,7 +23,17 @@ void SparseIdsList::Slice::merge(
 	Expects(moreNoSkipRange.from <= range.till);
 	Expects(range.from <= moreNoSkipRange.till);
 
-	messages.merge(std::begin(moreMessages), std::end(moreMessages));
+	// Linear set-union instead of per-element insertion, so merging
+	// k ids into an n-ids slice costs O(n + k log k) and not O(k * n).
+	auto incoming = std::vector<MsgId>(
+		std::begin(moreMessages),
+		std::end(moreMessages));
+	ranges::sort(incoming);
+	incoming.erase(ranges::unique(incoming), incoming.end());
+	auto united = std::vector<MsgId>();
+	united.reserve(messages.size() + incoming.size());
+	ranges::set_union(messages, incoming, std::back_inserter(united));
+	messages = base::flat_set<MsgId>(united.begin(), united.end());
 	range = {
 		qMin(range.from, moreNoSkipRange.from),
 		qMax(range.till, moreNoSkipRange.till)
@@ -238,8 +248,9 @@ SparseIdsListResult SparseIdsList::queryFromSlice(
 	auto haveEqualOrAfter = int(slice.messages.end() - position);
 	auto before = qMin(haveBefore, query.limitBefore);
 	auto equalOrAfter = qMin(haveEqualOrAfter, query.limitAfter + 1);
-	auto ids = std::vector<MsgId>(position - before, position + equalOrAfter);
-	result.messageIds.merge(ids.begin(), ids.end());
+	result.messageIds = base::flat_set<MsgId>(
+		position - before,
+		position + equalOrAfter);
 	if (slice.range.from == 0) {
 		result.skippedBefore = haveBefore - before;
 	}
@@ -7,8 +7,12 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "storage/streamed_file_downloader.h"
 
+#include "data/data_session.h"
+#include "data/data_types.h"
+#include "main/main_session.h"
 #include "media/streaming/media_streaming_loader.h"
 #include "media/streaming/media_streaming_reader.h"
+#include "storage/cache/storage_cache_database.h"
 
 namespace Storage {
 namespace {
@@ -127,6 +131,8 @@ std::optional<MediaKey> StreamedFileDownloader::fileLocationKey() const {
 }
 
 void StreamedFileDownloader::cancelHook() {
+	savePartialToCache();
+
 	_partsRequested = 0;
 	_nextPartIndex = 0;
 
@@ -137,6 +143,61 @@ void StreamedFileDownloader::startLoading() {
 	requestParts();
 }
 
+void StreamedFileDownloader::startLoadingWithPartial(const QByteArray &data) {
+	const auto parts = std::min(
+		int(data.size() / kPartSize),
+		_partsCount);
+	if (parts > 0) {
+		for (auto i = 0; i != parts; ++i) {
+			_partIsSaved[i] = true;
+		}
+		_partsSaved = parts;
+		_nextPartIndex = parts;
+		if (!writeResultPart(
+				0,
+				bytes::make_span(data).subspan(
+					0,
+					parts * int64(kPartSize)))) {
+			return;
+		}
+	}
+	if (_partsSaved == _partsCount) {
+		finalizeResult();
+	} else {
+		startLoading();
+	}
+}
+
+void StreamedFileDownloader::savePartialToCache() {
+	// Persist the downloaded prefix under the partial record key for the
+	// document cache key, so the next loader for this document resumes
+	// from it instead of refetching. Parts past the first hole stay
+	// covered by the streaming parts cache.
+	if (_finished
+		|| _fileIsOpen
+		|| !_filename.isEmpty()
+		|| (_toCache != LoadToCacheAsWell)
+		|| (!_cacheKey.low && !_cacheKey.high)) {
+		return;
+	}
+	const auto tillIndex = std::find(
+		begin(_partIsSaved),
+		end(_partIsSaved),
+		false
+	) - begin(_partIsSaved);
+	const auto use = std::min(
+		int64(tillIndex) * kPartSize,
+		int64(_data.size()));
+	if (use <= 0 || use > Storage::kMaxFileInMemory) {
+		return;
+	}
+	_session->data().cache().put(
+		Data::DownloadPartialCacheKey(_cacheKey),
+		Storage::Cache::Database::TaggedValue(
+			_data.left(use),
+			_cacheTag));
+}
+
 void StreamedFileDownloader::savePart(const LoadedPart &part) {
 	Expects(part.offset >= 0 && part.offset < _reader->size());
 	Expects(part.offset % kPartSize == 0);
@@ -49,11 +49,13 @@ public:
 
 private:
 	void startLoading() override;
+	void startLoadingWithPartial(const QByteArray &data) override;
 	Cache::Key cacheKey() const override;
 	std::optional<MediaKey> fileLocationKey() const override;
 	void cancelHook() override;
 	void requestParts();
 	void requestPart();
+	void savePartialToCache();
 
 	void savePart(const Media::Streaming::LoadedPart &part);
 
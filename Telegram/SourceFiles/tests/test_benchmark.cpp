@@ -0,0 +1,170 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "tests/test_main.h"
+
+#include "data/data_messages.h"
+#include "storage/storage_sparse_ids_list.h"
+#include "ui/text/text.h"
+#include "ui/widgets/rp_window.h"
+#include "ui/painter.h"
+
+#include <QApplication>
+#include <QRandomGenerator>
+
+namespace Test {
+namespace {
+
+constexpr auto kHistorySize = 100'000;
+constexpr auto kPageSize = 100;
+constexpr auto kQueryLimit = 64;
+constexpr auto kBuildRounds = 10;
+constexpr auto kQueryRounds = 10'000;
+constexpr auto kShapeRounds = 2'000;
+
+template <typename Method>
+[[nodiscard]] double MillisecondsPerCall(int rounds, Method method) {
+	method(); // Warmup.
+	const auto start = crl::now();
+	for (auto i = 0; i != rounds; ++i) {
+		method();
+	}
+	return double(crl::now() - start) / rounds;
+}
+
+[[nodiscard]] Data::MessagePosition Position(int id) {
+	return Data::MessagePosition{
+		.fullId = FullMsgId(PeerId(), MsgId(id)),
+		.date = TimeId(id),
+	};
+}
+
+// Pages overlap by one message on the border, the way consecutive
+// history loads from the API do, so each addSlice unites with the
+// previously added slice instead of starting a separate one.
+[[nodiscard]] Data::MessagesList BuildMessagesList() {
+	auto result = Data::MessagesList();
+	for (auto from = 1; from < kHistorySize; from += kPageSize) {
+		auto ids = std::vector<Data::MessagePosition>();
+		ids.reserve(kPageSize);
+		for (auto id = from; id != from + kPageSize; ++id) {
+			ids.push_back(Position(id));
+		}
+		result.addSlice(std::move(ids), {
+			.from = Position(std::max(from - 1, 1)),
+			.till = Position(from + kPageSize - 1),
+		}, std::nullopt);
+	}
+	return result;
+}
+
+[[nodiscard]] Storage::SparseIdsList BuildSparseIdsList() {
+	auto result = Storage::SparseIdsList();
+	for (auto from = 1; from < kHistorySize; from += kPageSize) {
+		auto ids = std::vector<MsgId>();
+		for (auto id = from; id != from + kPageSize; ++id) {
+			if (!(id % 3)) { // Every third message has a photo.
+				ids.push_back(MsgId(id));
+			}
+		}
+		result.addSlice(std::move(ids), {
+			MsgId(std::max(from - 1, 1)),
+			MsgId(from + kPageSize - 1),
+		}, std::nullopt);
+	}
+	return result;
+}
+
+[[nodiscard]] TextWithEntities ShapingSample() {
+	auto result = TextWithEntities();
+	result.append(
+		u"Lorem ipsum dolor sit amet, "_q
+	).append(Ui::Text::Bold(
+		u"consectetur adipiscing elit"_q
+	)).append(
+		u", sed do eiusmod tempor incididunt ut labore et dolore magna \
+aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco \
+laboris nisi ut aliquip ex ea commodo consequat."_q);
+	return result;
+}
+
+} // namespace
+
+QString name() {
+	return u"benchmark"_q;
+}
+
+void test(not_null<Ui::RpWindow*> window, not_null<Ui::RpWidget*> body) {
+	auto lines = QStringList();
+
+	const auto buildList = MillisecondsPerCall(kBuildRounds, [] {
+		[[maybe_unused]] const auto list = BuildMessagesList();
+	});
+	lines.push_back(u"MessagesList: add %1 ids in pages of %2: %3 ms"_q
+		.arg(kHistorySize)
+		.arg(kPageSize)
+		.arg(buildList, 0, 'f', 2));
+
+	const auto messages = BuildMessagesList();
+	const auto random = QRandomGenerator::global();
+	const auto queryList = MillisecondsPerCall(kQueryRounds, [&] {
+		const auto around = 1 + int(random->bounded(kHistorySize));
+		[[maybe_unused]] const auto slice = messages.snapshot({
+			.aroundId = Position(around),
+			.limitBefore = kQueryLimit,
+			.limitAfter = kQueryLimit,
+		});
+	});
+	lines.push_back(u"MessagesList: snapshot %1 around random id: %2 ms"_q
+		.arg(kQueryLimit * 2)
+		.arg(queryList, 0, 'f', 4));
+
+	const auto buildSparse = MillisecondsPerCall(kBuildRounds, [] {
+		[[maybe_unused]] const auto list = BuildSparseIdsList();
+	});
+	lines.push_back(u"SparseIdsList: merge %1 pages: %2 ms"_q
+		.arg((kHistorySize + kPageSize - 1) / kPageSize)
+		.arg(buildSparse, 0, 'f', 2));
+
+	const auto sparse = BuildSparseIdsList();
+	const auto querySparse = MillisecondsPerCall(kQueryRounds, [&] {
+		const auto around = 1 + int(random->bounded(kHistorySize));
+		[[maybe_unused]] const auto slice = sparse.snapshot({
+			MsgId(around),
+			kQueryLimit,
+			kQueryLimit,
+		});
+	});
+	lines.push_back(u"SparseIdsList: snapshot %1 around random id: %2 ms"_q
+		.arg(kQueryLimit * 2)
+		.arg(querySparse, 0, 'f', 4));
+
+	const auto sample = ShapingSample();
+	auto string = Ui::Text::String(scale(64));
+	const auto shape = MillisecondsPerCall(kShapeRounds, [&] {
+		string.setMarkedText(st::defaultTextStyle, sample);
+		[[maybe_unused]] const auto height = string.countHeight(scale(360));
+	});
+	lines.push_back(u"Text: shape and lay out %1 chars: %2 ms"_q
+		.arg(sample.text.size())
+		.arg(shape, 0, 'f', 4));
+
+	const auto text = lines.join('\n');
+
+	body->paintRequest() | rpl::start_with_next([=](QRect clip) {
+		auto p = QPainter(body);
+		p.fillRect(clip, QColor(255, 255, 255));
+		p.setPen(QColor(0, 0, 0));
+		const auto skip = scale(20);
+		p.drawText(
+			body->rect().marginsRemoved({ skip, skip, skip, skip }),
+			Qt::AlignLeft | Qt::AlignTop,
+			text);
+	}, body->lifetime());
+}
+
+} // namespace Test
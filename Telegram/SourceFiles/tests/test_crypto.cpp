@@ -0,0 +1,150 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "tests/test_main.h"
+
+#include "mtproto/details/mtproto_aes_ige.h"
+#include "ui/widgets/rp_window.h"
+#include "ui/rp_widget.h"
+#include "ui/painter.h"
+
+#include <QApplication>
+#include <QRandomGenerator>
+
+#include <openssl/aes.h>
+
+namespace Test {
+namespace {
+
+constexpr auto kPayloadSize = 512 * 1024;
+constexpr auto kRounds = 256;
+
+[[nodiscard]] QByteArray RandomBytes(int size) {
+	auto result = QByteArray(size, Qt::Uninitialized);
+	QRandomGenerator::global()->fillRange(
+		reinterpret_cast<quint32*>(result.data()),
+		size / sizeof(quint32));
+	return result;
+}
+
+template <typename Method>
+[[nodiscard]] double MegabytesPerSecond(Method method) {
+	method(); // Warmup.
+	const auto start = crl::now();
+	for (auto i = 0; i != kRounds; ++i) {
+		method();
+	}
+	const auto elapsed = crl::now() - start;
+	const auto processed = double(kPayloadSize) * kRounds;
+	return elapsed
+		? (processed * 1000. / elapsed) / (1024. * 1024.)
+		: 0.;
+}
+
+} // namespace
+
+QString name() {
+	return u"crypto"_q;
+}
+
+void test(not_null<Ui::RpWindow*> window, not_null<Ui::RpWidget*> body) {
+	const auto key = RandomBytes(32);
+	const auto iv = RandomBytes(32);
+	const auto source = RandomBytes(kPayloadSize);
+	auto opensslOut = QByteArray(kPayloadSize, Qt::Uninitialized);
+	auto hardwareOut = QByteArray(kPayloadSize, Qt::Uninitialized);
+
+	const auto opensslEncrypt = [&] {
+		AES_KEY aes;
+		AES_set_encrypt_key(
+			reinterpret_cast<const uchar*>(key.constData()),
+			256,
+			&aes);
+		uchar ivCopy[32];
+		memcpy(ivCopy, iv.constData(), 32);
+		AES_ige_encrypt(
+			reinterpret_cast<const uchar*>(source.constData()),
+			reinterpret_cast<uchar*>(opensslOut.data()),
+			kPayloadSize,
+			&aes,
+			ivCopy,
+			AES_ENCRYPT);
+	};
+	const auto opensslDecrypt = [&] {
+		AES_KEY aes;
+		AES_set_decrypt_key(
+			reinterpret_cast<const uchar*>(key.constData()),
+			256,
+			&aes);
+		uchar ivCopy[32];
+		memcpy(ivCopy, iv.constData(), 32);
+		AES_ige_encrypt(
+			reinterpret_cast<const uchar*>(opensslOut.constData()),
+			reinterpret_cast<uchar*>(hardwareOut.data()),
+			kPayloadSize,
+			&aes,
+			ivCopy,
+			AES_DECRYPT);
+	};
+	const auto hardwareEncrypt = [&] {
+		MTP::details::AesIgeEncryptHardware(
+			source.constData(),
+			hardwareOut.data(),
+			kPayloadSize,
+			key.constData(),
+			iv.constData());
+	};
+	const auto hardwareDecrypt = [&] {
+		MTP::details::AesIgeDecryptHardware(
+			opensslOut.constData(),
+			hardwareOut.data(),
+			kPayloadSize,
+			key.constData(),
+			iv.constData());
+	};
+
+	auto lines = QStringList();
+	lines.push_back(u"AES-256-IGE, %1 KiB x %2 rounds"_q
+		.arg(kPayloadSize / 1024)
+		.arg(kRounds));
+
+	opensslEncrypt();
+	const auto available = MTP::details::AesIgeHardwareAvailable();
+	if (available) {
+		hardwareEncrypt();
+		Assert(hardwareOut == opensslOut);
+		hardwareDecrypt();
+		Assert(hardwareOut == source);
+	}
+
+	lines.push_back(u"openssl encrypt: %1 MiB/s"_q
+		.arg(MegabytesPerSecond(opensslEncrypt), 0, 'f', 1));
+	lines.push_back(u"openssl decrypt: %1 MiB/s"_q
+		.arg(MegabytesPerSecond(opensslDecrypt), 0, 'f', 1));
+	if (available) {
+		lines.push_back(u"hardware encrypt: %1 MiB/s"_q
+			.arg(MegabytesPerSecond(hardwareEncrypt), 0, 'f', 1));
+		lines.push_back(u"hardware decrypt: %1 MiB/s"_q
+			.arg(MegabytesPerSecond(hardwareDecrypt), 0, 'f', 1));
+	} else {
+		lines.push_back(u"hardware: not available"_q);
+	}
+	const auto text = lines.join('\n');
+
+	body->paintRequest() | rpl::start_with_next([=](QRect clip) {
+		auto p = QPainter(body);
+		p.fillRect(clip, QColor(255, 255, 255));
+		p.setPen(QColor(0, 0, 0));
+		const auto skip = scale(20);
+		p.drawText(
+			body->rect().marginsRemoved({ skip, skip, skip, skip }),
+			Qt::AlignLeft | Qt::AlignTop,
+			text);
+	}, body->lifetime());
+}
+
+} // namespace Test
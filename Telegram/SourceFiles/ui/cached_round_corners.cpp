@@ -23,6 +23,7 @@ constexpr auto kCachedCornerRadiusCount = int(CachedCornerRadius::kCount);
 
 std::vector<CornersPixmaps> Corners;
 QImage CornersMaskLarge[4], CornersMaskSmall[4];
+base::flat_map<uint64, CornersPixmaps> DynamicCorners;
 rpl::lifetime PaletteChangedLifetime;
 
 std::array<std::array<QImage, 4>, kCachedCornerRadiusCount> CachedMasks;
@@ -75,44 +76,28 @@ void CreateMaskCorners() {
 	}
 }
 
-void CreatePaletteCorners() {
-	PrepareCorners(MenuCorners, st::roundRadiusSmall, st::menuBg);
-	PrepareCorners(BoxCorners, st::boxRadius, st::boxBg);
-	PrepareCorners(DateCorners, st::dateRadius, st::msgDateImgBg);
-	PrepareCorners(OverviewVideoCorners, st::overviewVideoStatusRadius, st::msgDateImgBg);
-	PrepareCorners(OverviewVideoSelectedCorners, st::overviewVideoStatusRadius, st::msgDateImgBgSelected);
-	PrepareCorners(ForwardCorners, st::roundRadiusLarge, st::historyForwardChooseBg);
-	PrepareCorners(MediaviewSaveCorners, st::mediaviewControllerRadius, st::mediaviewSaveMsgBg);
-	PrepareCorners(StickerHoverCorners, st::roundRadiusSmall, st::emojiPanHover);
-	PrepareCorners(BotKeyboardCorners, st::roundRadiusSmall, st::botKbBg);
-
-	PrepareCorners(Doc1Corners, st::roundRadiusSmall, st::msgFile1Bg);
-	PrepareCorners(Doc2Corners, st::roundRadiusSmall, st::msgFile2Bg);
-	PrepareCorners(Doc3Corners, st::roundRadiusSmall, st::msgFile3Bg);
-	PrepareCorners(Doc4Corners, st::roundRadiusSmall, st::msgFile4Bg);
-}
-
-} // namespace
+void PreparePaletteCorners(CachedRoundCorners index) {
+	switch (index) {
+	case MenuCorners: PrepareCorners(index, st::roundRadiusSmall, st::menuBg); break;
+	case BoxCorners: PrepareCorners(index, st::boxRadius, st::boxBg); break;
+	case DateCorners: PrepareCorners(index, st::dateRadius, st::msgDateImgBg); break;
+	case OverviewVideoCorners: PrepareCorners(index, st::overviewVideoStatusRadius, st::msgDateImgBg); break;
+	case OverviewVideoSelectedCorners: PrepareCorners(index, st::overviewVideoStatusRadius, st::msgDateImgBgSelected); break;
+	case ForwardCorners: PrepareCorners(index, st::roundRadiusLarge, st::historyForwardChooseBg); break;
+	case MediaviewSaveCorners: PrepareCorners(index, st::mediaviewControllerRadius, st::mediaviewSaveMsgBg); break;
+	case StickerHoverCorners: PrepareCorners(index, st::roundRadiusSmall, st::emojiPanHover); break;
+	case BotKeyboardCorners: PrepareCorners(index, st::roundRadiusSmall, st::botKbBg); break;
 
-void StartCachedCorners() {
-	Corners.resize(RoundCornersCount);
-	CreateMaskCorners();
-	CreatePaletteCorners();
-
-	style::PaletteChanged(
-	) | rpl::start_with_next([=] {
-		CreatePaletteCorners();
-	}, PaletteChangedLifetime);
-}
+	case Doc1Corners: PrepareCorners(index, st::roundRadiusSmall, st::msgFile1Bg); break;
+	case Doc2Corners: PrepareCorners(index, st::roundRadiusSmall, st::msgFile2Bg); break;
+	case Doc3Corners: PrepareCorners(index, st::roundRadiusSmall, st::msgFile3Bg); break;
+	case Doc4Corners: PrepareCorners(index, st::roundRadiusSmall, st::msgFile4Bg); break;
 
-void FinishCachedCorners() {
-	Corners.clear();
-	PaletteChangedLifetime.destroy();
+	default: Unexpected("Index in PreparePaletteCorners.");
+	}
 }
 
-void FillRoundRect(QPainter &p, int32 x, int32 y, int32 w, int32 h, style::color bg, const CornersPixmaps &corners) {
-	using namespace Images;
-
+void FillRoundRect(QPainter &p, int32 x, int32 y, int32 w, int32 h, const QBrush &bg, const CornersPixmaps &corners) {
 	const auto fillBg = [&](QRect rect) {
 		p.fillRect(rect, bg);
 	};
@@ -183,8 +168,38 @@ void FillRoundRect(QPainter &p, int32 x, int32 y, int32 w, int32 h, style::color
 	}
 }
 
+} // namespace
+
+void StartCachedCorners() {
+	Corners.resize(RoundCornersCount);
+	CreateMaskCorners();
+
+	// The palette corner sets are rasterized lazily on first use, so a
+	// theme switch just drops them instead of regenerating every set,
+	// including the ones the current layout never draws.
+	style::PaletteChanged(
+	) | rpl::start_with_next([=] {
+		ranges::fill(Corners, CornersPixmaps());
+		DynamicCorners.clear();
+	}, PaletteChangedLifetime);
+}
+
+void FinishCachedCorners() {
+	Corners.clear();
+	DynamicCorners.clear();
+	PaletteChangedLifetime.destroy();
+}
+
+void FillRoundRect(QPainter &p, int32 x, int32 y, int32 w, int32 h, style::color bg, const CornersPixmaps &corners) {
+	FillRoundRect(p, x, y, w, h, bg->b, corners);
+}
+
 void FillRoundRect(QPainter &p, int32 x, int32 y, int32 w, int32 h, style::color bg, CachedRoundCorners index) {
-	FillRoundRect(p, x, y, w, h, bg, CachedCornerPixmaps(index));
+	FillRoundRect(p, x, y, w, h, bg->b, CachedCornerPixmaps(index));
+}
+
+void FillRoundRect(QPainter &p, int32 x, int32 y, int32 w, int32 h, const QColor &bg, int radius) {
+	FillRoundRect(p, x, y, w, h, QBrush(bg), CachedCornerPixmaps(radius, bg));
 }
 
 void FillRoundShadow(QPainter &p, int32 x, int32 y, int32 w, int32 h, style::color shadow, const CornersPixmaps &corners) {
@@ -217,9 +232,32 @@ void FillRoundShadow(QPainter &p, int32 x, int32 y, int32 w, int32 h, style::col
 const CornersPixmaps &CachedCornerPixmaps(CachedRoundCorners index) {
 	Expects(index >= 0 && index < RoundCornersCount);
 
+	if (Corners[index].p[0].isNull()) {
+		PreparePaletteCorners(index);
+	}
 	return Corners[index];
 }
 
+const CornersPixmaps &CachedCornerPixmaps(int radius, const QColor &color) {
+	Expects(radius > 0);
+
+	// Custom radii (pill-shaped buttons, thumbnail previews and so on)
+	// used to rasterize a full rounded path on each paint. Cache them
+	// keyed by radius and color, the cache is dropped on palette change.
+	const auto key = (uint64(uint32(radius)) << 32) | uint64(color.rgba());
+	const auto i = DynamicCorners.find(key);
+	if (i != end(DynamicCorners)) {
+		return i->second;
+	}
+	auto images = PrepareCorners(radius, color);
+	auto prepared = CornersPixmaps();
+	for (auto j = 0; j != 4; ++j) {
+		prepared.p[j] = PixmapFromImage(std::move(images[j]));
+		prepared.p[j].setDevicePixelRatio(style::DevicePixelRatio());
+	}
+	return DynamicCorners.emplace(key, std::move(prepared)).first->second;
+}
+
 CornersPixmaps PrepareCornerPixmaps(int radius, style::color bg, const style::color *sh) {
 	auto images = PrepareCorners(radius, bg, sh);
 	auto result = CornersPixmaps();
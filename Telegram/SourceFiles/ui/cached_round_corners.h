@@ -42,6 +42,9 @@ inline void FillRoundRect(QPainter &p, const QRect &rect, style::color bg, Cache
 }
 
 [[nodiscard]] const CornersPixmaps &CachedCornerPixmaps(CachedRoundCorners index);
+[[nodiscard]] const CornersPixmaps &CachedCornerPixmaps(
+	int radius,
+	const QColor &color);
 [[nodiscard]] CornersPixmaps PrepareCornerPixmaps(
 	int radius,
 	style::color bg,
@@ -57,6 +60,10 @@ void FillRoundRect(QPainter &p, int x, int y, int w, int h, style::color bg, con
 inline void FillRoundRect(QPainter &p, const QRect &rect, style::color bg, const CornersPixmaps &corners) {
 	return FillRoundRect(p, rect.x(), rect.y(), rect.width(), rect.height(), bg, corners);
 }
+void FillRoundRect(QPainter &p, int x, int y, int w, int h, const QColor &bg, int radius);
+inline void FillRoundRect(QPainter &p, const QRect &rect, const QColor &bg, int radius) {
+	FillRoundRect(p, rect.x(), rect.y(), rect.width(), rect.height(), bg, radius);
+}
 void FillRoundShadow(QPainter &p, int x, int y, int w, int h, style::color shadow, const CornersPixmaps &corners);
 inline void FillRoundShadow(QPainter &p, const QRect &rect, style::color shadow, const CornersPixmaps &corners) {
 	FillRoundShadow(p, rect.x(), rect.y(), rect.width(), rect.height(), shadow, corners);
@@ -1050,7 +1050,7 @@ uint8 DecideColorIndex(uint64 id) {
 uint8 ColorIndexToPaletteIndex(uint8 colorIndex) {
 	Expects(colorIndex >= 0 && colorIndex < kColorIndexCount);
 
-	const int8 map[] = { 0, 7, 4, 1, 6, 3, 5 };
+	static constexpr int8 map[] = { 0, 7, 4, 1, 6, 3, 5 };
 	return map[colorIndex % kSimpleColorIndexCount];
 }
 
@@ -79,6 +79,7 @@ constexpr auto kMinAcceptableContrast = 1.14;// 4.5;
 				Qt::IgnoreAspectRatio,
 				Qt::SmoothTransformation);
 		result.setDevicePixelRatio(ratio);
+		auto patternScaled = QImage();
 		if (!request.background.prepared.isNull()) {
 			QPainter p(&result);
 			if (!gradient.isNull()) {
@@ -90,12 +91,23 @@ constexpr auto kMinAcceptableContrast = 1.14;// 4.5;
 						QPainter::CompositionMode_DestinationIn);
 				}
 			}
-			const auto tiled = request.background.isPattern
-				? request.background.prepared.scaled(
-					request.area.height() * ratio,
-					request.area.height() * ratio,
+			// Smooth-scaling a megapixel pattern is the most expensive
+			// part of the recache, so reuse the tile from the previous
+			// caching while only the window width is changing.
+			const auto side = request.area.height() * ratio;
+			const auto scaledSize = request.background.prepared.size()
+				.scaled(side, side, Qt::KeepAspectRatio);
+			patternScaled = !request.background.isPattern
+				? QImage()
+				: (request.patternScaled.size() == scaledSize)
+				? request.patternScaled
+				: request.background.prepared.scaled(
+					side,
+					side,
 					Qt::KeepAspectRatio,
-					Qt::SmoothTransformation)
+					Qt::SmoothTransformation);
+			const auto &tiled = request.background.isPattern
+				? patternScaled
 				: request.background.preparedForTiled;
 			const auto w = tiled.width() / float(ratio);
 			const auto h = tiled.height() / float(ratio);
@@ -126,6 +138,7 @@ constexpr auto kMinAcceptableContrast = 1.14;// 4.5;
 			.image = std::move(result).convertToFormat(
 				QImage::Format_ARGB32_Premultiplied),
 			.gradient = gradient,
+			.patternScaled = std::move(patternScaled),
 			.area = request.area,
 			.waitingForNegativePattern
 				= request.background.waitingForNegativePattern()
@@ -405,6 +418,7 @@ void ChatTheme::setBackground(ChatThemeBackground &&background) {
 	_mutableBackground = std::move(background);
 	_backgroundState = {};
 	_backgroundNext = {};
+	_backgroundPatternScaled = QImage();
 	_backgroundFade.stop();
 	if (_cacheBackgroundTimer) {
 		_cacheBackgroundTimer->cancel();
@@ -417,6 +431,7 @@ void ChatTheme::updateBackgroundImageFrom(ChatThemeBackground &&background) {
 	_mutableBackground.prepared = std::move(background.prepared);
 	_mutableBackground.preparedForTiled = std::move(
 		background.preparedForTiled);
+	_backgroundPatternScaled = QImage();
 	if (!_backgroundState.now.pixmap.isNull()) {
 		if (_cacheBackgroundTimer) {
 			_cacheBackgroundTimer->cancel();
@@ -573,6 +588,7 @@ auto ChatTheme::cacheBackgroundRequest(QSize area, int addRotation) const
 		.background = background(),
 		.area = area,
 		.gradientRotationAdd = addRotation,
+		.patternScaled = _backgroundPatternScaled,
 	};
 }
 
@@ -624,6 +640,7 @@ void ChatTheme::cacheBackgroundAsync(
 
 void ChatTheme::setCachedBackground(CacheBackgroundResult &&cached) {
 	_backgroundNext = {};
+	_backgroundPatternScaled = std::move(cached.patternScaled);
 
 	if (background().gradientForFill.isNull()
 		|| _backgroundState.now.pixmap.isNull()
@@ -67,6 +67,7 @@ struct CacheBackgroundRequest {
 	QSize area;
 	int gradientRotationAdd = 0;
 	float64 gradientProgress = 1.;
+	QImage patternScaled; // Reusable result of the previous caching.
 
 	explicit operator bool() const {
 		return !background.prepared.isNull()
@@ -84,6 +85,7 @@ bool operator!=(
 struct CacheBackgroundResult {
 	QImage image;
 	QImage gradient;
+	QImage patternScaled;
 	QSize area;
 	int x = 0;
 	int y = 0;
@@ -201,6 +203,7 @@ private:
 	Animations::Simple _backgroundFade;
 	CacheBackgroundRequest _backgroundCachingRequest;
 	CacheBackgroundResult _backgroundNext;
+	QImage _backgroundPatternScaled;
 	QSize _cacheBackgroundArea;
 	crl::time _lastBackgroundAreaChangeTime = 0;
 	std::optional<base::Timer> _cacheBackgroundTimer;
@@ -16,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/chat/message_bubble.h"
 #include "ui/wrap/vertical_layout.h"
 #include "ui/painter.h"
+#include "ui/render_async.h"
 #include "main/main_session.h"
 #include "window/window_session_controller.h"
 #include "window/themes/window_theme.h"
@@ -38,11 +39,40 @@ namespace {
 
 const auto kDisableElement = [] { return u"disable"_q; };
 
-[[nodiscard]] QImage GeneratePreview(not_null<Ui::ChatTheme*> theme) {
+// Plain copies of everything the preview rendering reads, so that it
+// can run on a background thread while the theme and the palette live
+// their lives on the main one.
+struct PreviewRequest {
+	QImage prepared;
+	std::vector<QColor> colors;
+	int gradientRotation = 0;
+	float64 patternOpacity = 1.;
+	bool waitingForNegativePattern = false;
+	QImage bubblesPattern;
+	QColor msgOutBg;
+	QColor msgInBg;
+};
+
+[[nodiscard]] PreviewRequest PreparePreviewRequest(
+		not_null<Ui::ChatTheme*> theme) {
 	const auto &background = theme->background();
-	const auto &colors = background.colors;
+	const auto pattern = theme->bubblesBackgroundPattern();
+	return {
+		.prepared = background.prepared,
+		.colors = background.colors,
+		.gradientRotation = background.gradientRotation,
+		.patternOpacity = background.patternOpacity,
+		.waitingForNegativePattern = background.waitingForNegativePattern(),
+		.bubblesPattern = pattern ? pattern->pixmap.toImage() : QImage(),
+		.msgOutBg = theme->palette()->msgOutBg()->c,
+		.msgInBg = theme->palette()->msgInBg()->c,
+	};
+}
+
+[[nodiscard]] QImage GeneratePreview(const PreviewRequest &request) {
+	const auto &colors = request.colors;
 	const auto size = st::chatThemePreviewSize;
-	auto prepared = background.prepared;
+	auto prepared = request.prepared;
 	const auto paintPattern = [&](QPainter &p, bool inverted) {
 		if (prepared.isNull()) {
 			return;
@@ -72,17 +102,17 @@ const auto kDisableElement = [] { return u"disable"_q; };
 			small);
 	};
 	const auto fullsize = size * style::DevicePixelRatio();
-	auto result = background.waitingForNegativePattern()
+	auto result = request.waitingForNegativePattern
 		? QImage(
 			fullsize,
 			QImage::Format_ARGB32_Premultiplied)
 		: Ui::GenerateBackgroundImage(
 			fullsize,
 			colors.empty() ? std::vector{ 1, QColor(0, 0, 0) } : colors,
-			background.gradientRotation,
-			background.patternOpacity,
+			request.gradientRotation,
+			request.patternOpacity,
 			paintPattern);
-	if (background.waitingForNegativePattern()) {
+	if (request.waitingForNegativePattern) {
 		result.fill(Qt::black);
 	}
 	result.setDevicePixelRatio(style::DevicePixelRatio());
@@ -104,8 +134,8 @@ const auto kDisableElement = [] { return u"disable"_q; };
 
 		PainterHighQualityEnabler hq(p);
 		p.setPen(Qt::NoPen);
-		if (const auto pattern = theme->bubblesBackgroundPattern()) {
-			auto bubble = pattern->pixmap.toImage().scaled(
+		if (!request.bubblesPattern.isNull()) {
+			auto bubble = request.bubblesPattern.scaled(
 				sent.size() * style::DevicePixelRatio(),
 				Qt::IgnoreAspectRatio,
 				Qt::SmoothTransformation
@@ -113,10 +143,10 @@ const auto kDisableElement = [] { return u"disable"_q; };
 			const auto corners = Images::CornersMask(radius);
 			p.drawImage(sent, Images::Round(std::move(bubble), corners));
 		} else {
-			p.setBrush(theme->palette()->msgOutBg()->c);
+			p.setBrush(request.msgOutBg);
 			p.drawRoundedRect(sent, radius, radius);
 		}
-		p.setBrush(theme->palette()->msgInBg()->c);
+		p.setBrush(request.msgInBg);
 		p.drawRoundedRect(received, radius, radius);
 	}
 	return Images::Round(std::move(result), ImageRoundRadius::Large);
@@ -604,7 +634,15 @@ void ChooseThemeController::fill(
 				}
 				const auto theme = data.get();
 				i->theme = std::move(data);
-				i->preview = GeneratePreview(theme);
+				RenderAsync([request = PreparePreviewRequest(theme)] {
+					return GeneratePreview(request);
+				}) | rpl::start_with_next([=](QImage &&image) {
+					const auto i = ranges::find(_entries, key, &Entry::key);
+					if (i != end(_entries)) {
+						i->preview = std::move(image);
+						_inner->update();
+					}
+				}, _cachingLifetime);
 				if (_chosen.current() == i->emoji->text()) {
 					_controller->overridePeerTheme(
 						_peer,
@@ -634,8 +672,18 @@ void ChooseThemeController::fill(
 					if (i == end(_entries)) {
 						return;
 					}
-					i->preview = GeneratePreview(theme);
-					_inner->update();
+					RenderAsync([request = PreparePreviewRequest(theme)] {
+						return GeneratePreview(request);
+					}) | rpl::start_with_next([=](QImage &&image) {
+						const auto i = ranges::find(
+							_entries,
+							key,
+							&Entry::key);
+						if (i != end(_entries)) {
+							i->preview = std::move(image);
+							_inner->update();
+						}
+					}, _cachingLifetime);
 				}, _cachingLifetime);
 			}, _cachingLifetime);
 			x += single.width() + skip;
@@ -49,6 +49,13 @@ MiniStars::MiniStars(
 	}
 	if (_rectToUpdate.isValid()) {
 		updateCallback(base::take(_rectToUpdate));
+	} else if (_paused
+		&& ranges::all_of(_ministars, [&](const MiniStar &star) {
+			return (now >= star.deathTime);
+		})) {
+		// No stars will be born till unpause and all the old ones
+		// are dead already, no reason to tick every frame.
+		_animation.stop();
 	}
 }) {
 	if (type == Type::BiStars) {
@@ -138,7 +145,13 @@ void MiniStars::paint(QPainter &p, const QRectF &rect) {
 }
 
 void MiniStars::setPaused(bool paused) {
+	if (_paused == paused) {
+		return;
+	}
 	_paused = paused;
+	if (!_paused && !anim::Disabled() && !_animation.animating()) {
+		_animation.start();
+	}
 }
 
 void MiniStars::createStar(crl::time now) {
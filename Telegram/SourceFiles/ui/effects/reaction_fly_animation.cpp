@@ -120,13 +120,18 @@ ReactionFlyAnimation::ReactionFlyAnimation(
 		});
 		return true;
 	};
-	generateMiniCopies(size + size / 2, args.miniCopyMultiplier);
+	_effectSlotTaken = owner->takeEffectAnimationSlot();
+	if (_effectSlotTaken) {
+		generateMiniCopies(size + size / 2, args.miniCopyMultiplier);
+	}
 	if (args.effectOnly) {
 		_effectOnly = true;
 	} else if (!_custom && !resolve(_center, centerIcon, size)) {
 		return;
 	}
-	resolve(_effect, aroundAnimation, size * 2);
+	if (_effectSlotTaken || _effectOnly) {
+		resolve(_effect, aroundAnimation, size * 2);
+	}
 	if (!args.flyIcon.isNull()) {
 		_flyIcon = std::move(args.flyIcon);
 		_fly.start(flyCallback(), 0., 1., kFlyDuration);
@@ -138,7 +143,11 @@ ReactionFlyAnimation::ReactionFlyAnimation(
 	_valid = true;
 }
 
-ReactionFlyAnimation::~ReactionFlyAnimation() = default;
+ReactionFlyAnimation::~ReactionFlyAnimation() {
+	if (_effectSlotTaken) {
+		_owner->releaseEffectAnimationSlot();
+	}
+}
 
 QRect ReactionFlyAnimation::paintGetArea(
 		QPainter &p,
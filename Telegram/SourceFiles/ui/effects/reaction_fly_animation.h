@@ -125,6 +125,7 @@ private:
 	bool _noEffectScaleStarted = false;
 	bool _forceFirstFrame = false;
 	bool _effectOnly = false;
+	bool _effectSlotTaken = false;
 	bool _valid = false;
 
 	mutable Parabolic _cached;
@@ -168,11 +168,20 @@ void Snowflakes::paint(QPainter &p, const QRectF &rect) {
 void Snowflakes::setPaused(bool paused) {
 	paused |= anim::Disabled();
 	if (paused) {
-		_paused.diff = 0;
-		_paused.at = crl::now();
+		if (!_paused.at) {
+			_paused.diff = 0;
+			_paused.at = crl::now();
+
+			// The paused state paints frozen in time, each paint would
+			// just reschedule an identical repaint through the ticker.
+			_animation.stop();
+		}
 	} else {
 		_paused.diff = _paused.at ? (crl::now() - _paused.at) : 0;
 		_paused.at = 0;
+		if (!anim::Disabled() && !_animation.animating()) {
+			_animation.start();
+		}
 	}
 }
 
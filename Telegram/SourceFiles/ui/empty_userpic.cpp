@@ -259,7 +259,9 @@ uint8 EmptyUserpic::ColorIndex(uint64 id) {
 }
 
 EmptyUserpic::BgColors EmptyUserpic::UserpicColor(uint8 colorIndex) {
-	const EmptyUserpic::BgColors colors[] = {
+	// The entries reference palette values, so they follow theme
+	// switches and the table can be built once.
+	static const EmptyUserpic::BgColors colors[] = {
 		{ st::historyPeer1UserpicBg, st::historyPeer1UserpicBg2 },
 		{ st::historyPeer2UserpicBg, st::historyPeer2UserpicBg2 },
 		{ st::historyPeer3UserpicBg, st::historyPeer3UserpicBg2 },
@@ -10,6 +10,16 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace Ui {
 namespace {
 
+constexpr auto kLayoutsCacheLimit = 64;
+
+struct CachedLayout {
+	std::vector<QSize> sizes;
+	int maxWidth = 0;
+	int minWidth = 0;
+	int spacing = 0;
+	std::vector<GroupMediaLayout> result;
+};
+
 int Round(float64 value) {
 	return int(base::SafeRound(value));
 }
@@ -571,7 +581,27 @@ std::vector<GroupMediaLayout> LayoutMediaGroup(
 		int maxWidth,
 		int minWidth,
 		int spacing) {
-	return Layouter(sizes, maxWidth, minWidth, spacing).layout();
+	// The grid depends only on the arguments and is recomputed on every
+	// relayout of every visible album, so keep a small LRU cache of the
+	// recent results. It is per-thread because layouts are counted on
+	// background threads as well, for example for Instant View pages.
+	static thread_local auto cache = std::vector<CachedLayout>();
+	const auto i = ranges::find_if(cache, [&](const CachedLayout &entry) {
+		return (entry.maxWidth == maxWidth)
+			&& (entry.minWidth == minWidth)
+			&& (entry.spacing == spacing)
+			&& (entry.sizes == sizes);
+	});
+	if (i != end(cache)) {
+		ranges::rotate(begin(cache), i, i + 1);
+		return cache.front().result;
+	}
+	auto result = Layouter(sizes, maxWidth, minWidth, spacing).layout();
+	cache.insert(begin(cache), { sizes, maxWidth, minWidth, spacing, result });
+	if (cache.size() > kLayoutsCacheLimit) {
+		cache.pop_back();
+	}
+	return result;
 }
 
 RectParts GetCornersFromSides(RectParts sides) {
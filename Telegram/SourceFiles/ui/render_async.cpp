@@ -0,0 +1,40 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "ui/render_async.h"
+
+namespace Ui {
+
+rpl::producer<QImage> RenderAsync(Fn<QImage()> render) {
+	Expects(render != nullptr);
+
+	return rpl::make_producer<QImage>([render = std::move(render)](
+			const auto &consumer) {
+		auto lifetime = rpl::lifetime();
+		const auto alive = std::make_shared<std::atomic<bool>>(true);
+		lifetime.add([alive] { alive->store(false); });
+		crl::async([=] {
+			if (!alive->load()) {
+				return;
+			}
+			auto image = render();
+			crl::on_main([
+				consumer,
+				alive,
+				image = std::move(image)
+			]() mutable {
+				if (alive->load()) {
+					consumer.put_next(std::move(image));
+					consumer.put_done();
+				}
+			});
+		});
+		return lifetime;
+	});
+}
+
+} // namespace Ui
@@ -0,0 +1,19 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Ui {
+
+// Runs the rasterization callback on a background thread and delivers
+// the resulting image on the main thread, once per subscription.
+// Dropping the subscription drops the result. The callback must own
+// everything it paints with: no QPixmap, no live style or theme
+// objects that the main thread may mutate meanwhile.
+[[nodiscard]] rpl::producer<QImage> RenderAsync(Fn<QImage()> render);
+
+} // namespace Ui
@@ -90,6 +90,13 @@ public:
 	[[nodiscard]] bool isActive() const {
 		return !isHidden() && _isActive;
 	}
+
+	// True while the window can't show frames to the user (hidden to
+	// tray or minimized), so animation-driven repaints may be skipped
+	// for it. The expose on restore repaints everything anyway.
+	[[nodiscard]] bool framesHidden() const {
+		return isHidden() || (windowState() & Qt::WindowMinimized);
+	}
 	[[nodiscard]] virtual bool isActiveForTrayMenu() {
 		updateIsActive();
 		return isActive();
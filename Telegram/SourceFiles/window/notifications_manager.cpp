@@ -538,8 +538,10 @@ void System::showGrouped() {
 			_manager->showNotification({
 				.item = lastItem,
 				.forwardedCount = _lastForwardedCount,
+				.digestCount = _lastDigestCount,
 			});
 			_lastForwardedCount = 0;
+			_lastDigestCount = 0;
 			_lastHistoryItemId = FullMsgId();
 			_lastHistorySessionId = 0;
 		}
@@ -564,7 +566,9 @@ void System::showNext() {
 			_lastHistoryItemId);
 		if (lastItem) {
 			return (lastItem->groupId() == item->groupId())
-				|| (lastItem->author() == item->author());
+				|| (lastItem->author() == item->author())
+				|| (_lastDigestCount > 0
+					&& lastItem->history() == item->history());
 		}
 		return false;
 	};
@@ -696,6 +700,14 @@ void System::showNext() {
 			: nullptr;
 		auto forwardedCount = isForwarded ? 1 : 0;
 
+		// A backlog of plain messages in one chat is coalesced into
+		// a single digest notification instead of a separate platform
+		// notification (with its own userpic) per message.
+		auto digestItem = (messageType && !groupedItem)
+			? notifyItem.get()
+			: nullptr;
+		auto digestCount = 1;
+
 		const auto thread = notifyItem->notificationThread();
 		const auto j = _whenMaps.find(thread);
 		if (j == _whenMaps.cend()) {
@@ -709,7 +721,11 @@ void System::showNext() {
 				}
 
 				j->second.remove({
-					(groupedItem ? groupedItem : notifyItem.get())->id,
+					(groupedItem
+						? groupedItem
+						: digestItem
+						? digestItem
+						: notifyItem.get())->id,
 					notify->type,
 				});
 				do {
@@ -725,7 +741,7 @@ void System::showNext() {
 					}
 					thread->skipNotification();
 				} while (thread->hasNotification());
-				if (!nextNotify || !groupedItem) {
+				if (!nextNotify || (!groupedItem && !digestItem)) {
 					break;
 				}
 				const auto nextMessageNotification
@@ -752,6 +768,14 @@ void System::showNext() {
 						continue;
 					}
 				}
+				if (digestItem
+					&& nextMessageNotification
+					&& !nextNotify->item->Has<HistoryMessageForwarded>()
+					&& !nextNotify->item->groupId()) {
+					++digestCount;
+					digestItem = nextNotify->item.get();
+					continue;
+				}
 				break;
 			}
 		}
@@ -761,22 +785,27 @@ void System::showNext() {
 			_lastHistoryItemId = groupedItem->fullId();
 		}
 
+		const auto isDigest = (digestCount > 1);
+		const auto lastGroupedItem = groupedItem ? groupedItem : digestItem;
+
 		// If the current notification is grouped.
-		if (isAlbum || isForwarded) {
+		if (isAlbum || isForwarded || isDigest) {
 			// If the previous notification is grouped
 			// then reset the timer.
 			if (_waitForAllGroupedTimer.isActive()) {
 				_waitForAllGroupedTimer.cancel();
 				// If this is not the same group
 				// then show the previous group immediately.
-				if (!isSameGroup(groupedItem)) {
+				if (!isSameGroup(lastGroupedItem)) {
 					showGrouped();
 				}
 			}
 			// We have to wait until all the messages in this group are loaded.
 			_lastForwardedCount += forwardedCount;
-			_lastHistorySessionId = groupedItem->history()->session().uniqueId();
-			_lastHistoryItemId = groupedItem->fullId();
+			_lastDigestCount += isDigest ? digestCount : 0;
+			_lastHistorySessionId
+				= lastGroupedItem->history()->session().uniqueId();
+			_lastHistoryItemId = lastGroupedItem->fullId();
 			_waitForAllGroupedTimer.callOnce(kWaitingForAllGroupedDelay);
 		} else {
 			// If the current notification is not grouped
@@ -1200,6 +1229,11 @@ void NativeManager::doShowNotification(NotificationFields &&fields) {
 			options.hideMessageText))
 		: options.hideMessageText
 		? tr::lng_notification_preview(tr::now)
+		: (fields.digestCount > 1)
+		? tr::lng_notification_new_messages(
+			tr::now,
+			lt_count,
+			fields.digestCount)
 		: (fields.forwardedCount > 1)
 		? tr::lng_forward_messages(tr::now, lt_count, fields.forwardedCount)
 		: item->groupId()
@@ -215,6 +215,7 @@ private:
 		rpl::lifetime> _watchedTopics;
 
 	int _lastForwardedCount = 0;
+	int _lastDigestCount = 0;
 	uint64 _lastHistorySessionId = 0;
 	FullMsgId _lastHistoryItemId;
 
@@ -275,6 +276,7 @@ public:
 	struct NotificationFields {
 		not_null<HistoryItem*> item;
 		int forwardedCount = 0;
+		int digestCount = 0;
 		PeerData *reactionFrom = nullptr;
 		Data::ReactionId reactionId;
 	};
@@ -93,8 +93,11 @@ Manager::QueuedNotification::QueuedNotification(NotificationFields &&fields)
 	: (fields.reactionFrom != peer)
 	? fields.reactionFrom->name()
 	: QString())
-, item((fields.forwardedCount < 2) ? fields.item.get() : nullptr)
+, item((fields.forwardedCount < 2 && fields.digestCount < 2)
+	? fields.item.get()
+	: nullptr)
 , forwardedCount(fields.forwardedCount)
+, digestCount(fields.digestCount)
 , fromScheduled(reaction.empty() && (fields.item->out() || peer->isSelf())
 	&& fields.item->isFromScheduled()) {
 }
@@ -247,6 +250,7 @@ void Manager::showNextFromQueue() {
 			queued.item,
 			queued.reaction,
 			queued.forwardedCount,
+			queued.digestCount,
 			queued.fromScheduled,
 			startPosition,
 			startShift,
@@ -619,6 +623,7 @@ Notification::Notification(
 	HistoryItem *item,
 	const Data::ReactionId &reaction,
 	int forwardedCount,
+	int digestCount,
 	bool fromScheduled,
 	QPoint startPosition,
 	int shift,
@@ -634,6 +639,7 @@ Notification::Notification(
 , _reaction(reaction)
 , _item(item)
 , _forwardedCount(forwardedCount)
+, _digestCount(digestCount)
 , _fromScheduled(fromScheduled)
 , _close(this, st::notifyClose)
 , _reply(this, tr::lng_notification_reply(), st::defaultBoxButton) {
@@ -838,7 +844,7 @@ void Notification::paintText(Painter &p) {
 }
 
 void Notification::updateNotifyDisplay() {
-	if (!_history || (!_item && _forwardedCount < 2)) {
+	if (!_history || (!_item && _forwardedCount < 2 && _digestCount < 2)) {
 		return;
 	}
 
@@ -936,11 +942,18 @@ void Notification::updateNotifyDisplay() {
 							tr::now,
 							lt_count,
 							_forwardedCount))
+						: _digestCount > 1
+						? ('\n' + tr::lng_notification_new_messages(
+							tr::now,
+							lt_count,
+							_digestCount))
 						: QString()));
 			const auto options = TextParseOptions{
 				(TextParseColorized
 					| TextParseMarkdown
-					| (_forwardedCount > 1 ? TextParseMultiline : 0)),
+					| ((_forwardedCount > 1 || _digestCount > 1)
+					? TextParseMultiline
+					: 0)),
 				0,
 				0,
 				Qt::LayoutDirectionAuto,
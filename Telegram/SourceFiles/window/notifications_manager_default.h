@@ -116,6 +116,7 @@ private:
 		QString author;
 		HistoryItem *item = nullptr;
 		int forwardedCount = 0;
+		int digestCount = 0;
 		bool fromScheduled = false;
 	};
 	std::deque<QueuedNotification> _queuedNotifications;
@@ -208,6 +209,7 @@ public:
 		HistoryItem *item,
 		const Data::ReactionId &reaction,
 		int forwardedCount,
+		int digestCount,
 		bool fromScheduled,
 		QPoint startPosition,
 		int shift,
@@ -290,6 +292,7 @@ private:
 	Data::ReactionId _reaction;
 	HistoryItem *_item = nullptr;
 	int _forwardedCount = 0;
+	int _digestCount = 0;
 	bool _fromScheduled = false;
 	object_ptr<Ui::IconButton> _close;
 	object_ptr<Ui::RoundButton> _reply;
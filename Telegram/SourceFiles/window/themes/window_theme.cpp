@@ -409,6 +409,37 @@ bool InitializeFromCache(
 	return true;
 }
 
+bool LoadThemeUsingCache(
+		const QByteArray &content,
+		const Cached &cache,
+		not_null<Instance*> out) {
+	if (cache.colors.isEmpty()
+		|| cache.paletteChecksum != style::palette::Checksum()
+		|| cache.contentChecksum != base::crc32(
+			content.constData(),
+			content.size())) {
+		return false;
+	}
+
+	QImage background;
+	if (!cache.background.isEmpty()) {
+		QDataStream stream(cache.background);
+		QImageReader reader(stream.device());
+		reader.setAutoTransform(true);
+		if (!reader.read(&background) || background.isNull()) {
+			return false;
+		}
+	}
+
+	if (!out->palette.load(cache.colors)) {
+		return false;
+	}
+	if (!background.isNull()) {
+		applyBackground(std::move(background), cache.tiled, out);
+	}
+	return true;
+}
+
 [[nodiscard]] std::optional<QByteArray> ReadEditingPalette() {
 	auto file = QFile(EditingPalettePath());
 	return file.open(QIODevice::ReadOnly)
@@ -1170,12 +1201,19 @@ void ChatBackground::reapplyWithNightMode(
 		auto preview = std::make_unique<Preview>();
 		preview->object = std::move(read.object);
 		preview->instance.cached = std::move(read.cache);
-		const auto loaded = LoadTheme(
+		// Restore the precomputed palette and the decoded background
+		// from the theme cache, so that switching between day and night
+		// themes is a palette swap without the zip / parse / image work.
+		const auto loaded = LoadThemeUsingCache(
 			preview->object.content,
-			ColorizerForTheme(path),
-			std::nullopt,
-			&preview->instance.cached,
-			&preview->instance);
+			preview->instance.cached,
+			&preview->instance)
+			|| LoadTheme(
+				preview->object.content,
+				ColorizerForTheme(path),
+				std::nullopt,
+				&preview->instance.cached,
+				&preview->instance);
 		if (!loaded) {
 			return false;
 		}
@@ -19,6 +19,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_session_settings.h"
 #include "main/main_app_config.h"
 #include "media/view/media_view_open_common.h"
+#include "data/data_session.h"
 #include "lang/lang_keys.h"
 #include "intro/intro_widget.h"
 #include "mtproto/mtproto_config.h"
@@ -388,6 +389,26 @@ void Controller::setupMain(
 
 	_widget.setupMain(singlePeerShowAtMsgId, std::move(oldContentCache));
 
+	if (isPrimary()) {
+		const auto session = &_sessionController->session();
+		const auto peerId = session->settings().lastOpenedPeerId();
+		const auto peer = peerId
+			? session->data().peerLoaded(peerId)
+			: nullptr;
+		if (peer) {
+			// The peer is resolvable locally through the chat list
+			// snapshot, so the chat shows before the first dialogs
+			// load finishes.
+			const auto msgId = session->settings().lastOpenedMsgId();
+			_sessionController->showPeerHistory(
+				peer,
+				SectionShow(
+					SectionShow::Way::ClearStack,
+					anim::type::instant),
+				msgId ? msgId : ShowAtUnreadMsgId);
+		}
+	}
+
 	if (const auto id = Ui::Emoji::NeedToSwitchBackToId()) {
 		Ui::Emoji::LoadAndSwitchTo(&_sessionController->session(), id);
 	}
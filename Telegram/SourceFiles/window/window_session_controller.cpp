@@ -1778,6 +1778,12 @@ void SessionController::setActiveChatEntry(Dialogs::RowDescriptor row) {
 	if (session().supportMode()) {
 		pushToChatEntryHistory(row);
 	}
+	if (_isPrimary) {
+		session().settings().setLastOpenedChat(
+			now ? now->peer->id : PeerId(),
+			row.fullId.msg);
+		session().saveSettingsDelayed();
+	}
 	checkInvitePeek();
 }
 
@@ -13,6 +13,8 @@ nice_target_sources(td_mtproto ${src_loc}
 PRIVATE
     mtproto/details/mtproto_abstract_socket.cpp
     mtproto/details/mtproto_abstract_socket.h
+    mtproto/details/mtproto_aes_ige.cpp
+    mtproto/details/mtproto_aes_ige.h
     mtproto/details/mtproto_bound_key_creator.cpp
     mtproto/details/mtproto_bound_key_creator.h
     mtproto/details/mtproto_dc_key_binder.cpp
@@ -27,6 +29,8 @@ PRIVATE
     mtproto/details/mtproto_dump_to_text.h
     mtproto/details/mtproto_received_ids_manager.cpp
     mtproto/details/mtproto_received_ids_manager.h
+    mtproto/details/mtproto_received_queue.cpp
+    mtproto/details/mtproto_received_queue.h
     mtproto/details/mtproto_rsa_public_key.cpp
     mtproto/details/mtproto_rsa_public_key.h
     mtproto/details/mtproto_serialized_request.cpp
@@ -42,3 +42,92 @@ set_target_properties(test_text PROPERTIES RUNTIME_OUTPUT_DIRECTORY ${CMAKE_BINA
 add_dependencies(Telegram test_text)
 
 target_prepare_qrc(test_text)
+
+add_executable(test_crypto WIN32)
+init_target(test_crypto "(tests)")
+
+target_include_directories(test_crypto PRIVATE ${src_loc})
+
+nice_target_sources(test_crypto ${src_loc}
+PRIVATE
+    mtproto/details/mtproto_aes_ige.cpp
+    mtproto/details/mtproto_aes_ige.h
+    tests/test_crypto.cpp
+    tests/test_main.cpp
+    tests/test_main.h
+)
+
+nice_target_sources(test_crypto ${res_loc}
+PRIVATE
+    qrc/emoji_1.qrc
+    qrc/emoji_2.qrc
+    qrc/emoji_3.qrc
+    qrc/emoji_4.qrc
+    qrc/emoji_5.qrc
+    qrc/emoji_6.qrc
+    qrc/emoji_7.qrc
+    qrc/emoji_8.qrc
+)
+
+target_link_libraries(test_crypto
+PRIVATE
+    desktop-app::lib_base
+    desktop-app::lib_crl
+    desktop-app::lib_ui
+    desktop-app::external_openssl
+    desktop-app::external_qt
+    desktop-app::external_qt_static_plugins
+)
+
+set_target_properties(test_crypto PROPERTIES RUNTIME_OUTPUT_DIRECTORY ${CMAKE_BINARY_DIR})
+
+add_dependencies(Telegram test_crypto)
+
+target_prepare_qrc(test_crypto)
+
+add_executable(test_benchmark WIN32)
+init_target(test_benchmark "(tests)")
+
+# The benchmarked translation units rely on the main precompiled header.
+target_precompile_headers(test_benchmark PRIVATE $<$<COMPILE_LANGUAGE:CXX,OBJCXX>:${src_loc}/stdafx.h>)
+
+target_include_directories(test_benchmark PRIVATE ${src_loc})
+
+nice_target_sources(test_benchmark ${src_loc}
+PRIVATE
+    data/data_messages.cpp
+    data/data_messages.h
+    storage/storage_sparse_ids_list.cpp
+    storage/storage_sparse_ids_list.h
+    tests/test_benchmark.cpp
+    tests/test_main.cpp
+    tests/test_main.h
+)
+
+nice_target_sources(test_benchmark ${res_loc}
+PRIVATE
+    qrc/emoji_1.qrc
+    qrc/emoji_2.qrc
+    qrc/emoji_3.qrc
+    qrc/emoji_4.qrc
+    qrc/emoji_5.qrc
+    qrc/emoji_6.qrc
+    qrc/emoji_7.qrc
+    qrc/emoji_8.qrc
+)
+
+target_link_libraries(test_benchmark
+PRIVATE
+    tdesktop::td_scheme
+    desktop-app::lib_base
+    desktop-app::lib_crl
+    desktop-app::lib_ui
+    desktop-app::external_qt
+    desktop-app::external_qt_static_plugins
+)
+
+set_target_properties(test_benchmark PROPERTIES RUNTIME_OUTPUT_DIRECTORY ${CMAKE_BINARY_DIR})
+
+add_dependencies(Telegram test_benchmark)
+
+target_prepare_qrc(test_benchmark)